@@ -6,6 +6,7 @@
 #include <scendere/lib/work.hpp>
 #include <scendere/node/common.hpp>
 #include <scendere/node/lmdb/lmdb.hpp>
+#include <scendere/node/memory/memory.hpp>
 #include <scendere/node/rocksdb/rocksdb.hpp>
 #include <scendere/secure/ledger.hpp>
 #include <scendere/secure/utility.hpp>
@@ -108,6 +109,91 @@ TEST (block_store, sideband_serialization)
 	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
 }
 
+TEST (block_store, sideband_serialization_compact)
+{
+	scendere::block_sideband sideband1;
+	sideband1.balance = 2;
+	sideband1.height = 300;
+	sideband1.successor = 4;
+	sideband1.timestamp = 1600000000;
+	sideband1.details = scendere::block_details (scendere::epoch::epoch_1, false, true, false);
+	sideband1.source_epoch = scendere::epoch::epoch_1;
+	std::vector<uint8_t> vector;
+	{
+		scendere::vectorstream stream1 (vector);
+		sideband1.serialize_compact (stream1, scendere::block_type::state);
+	}
+	// successor, 2 byte height, 5 byte timestamp, details and source epoch
+	ASSERT_EQ (sizeof (scendere::block_hash) + 2 + 5 + 2, vector.size ());
+	ASSERT_LT (vector.size (), scendere::block_sideband::size (scendere::block_type::state));
+	scendere::bufferstream stream2 (vector.data (), vector.size ());
+	scendere::block_sideband sideband2;
+	ASSERT_FALSE (sideband2.deserialize_compact (stream2, scendere::block_type::state));
+	ASSERT_EQ (sideband1.height, sideband2.height);
+	ASSERT_EQ (sideband1.successor, sideband2.successor);
+	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
+	ASSERT_EQ (sideband1.details, sideband2.details);
+	ASSERT_EQ (sideband1.source_epoch, sideband2.source_epoch);
+
+	// The source epoch is only stored for receives
+	sideband1.details = scendere::block_details (scendere::epoch::epoch_1, true, false, false);
+	std::vector<uint8_t> vector2;
+	{
+		scendere::vectorstream stream3 (vector2);
+		sideband1.serialize_compact (stream3, scendere::block_type::state);
+	}
+	ASSERT_EQ (vector.size () - 1, vector2.size ());
+	scendere::bufferstream stream4 (vector2.data (), vector2.size ());
+	scendere::block_sideband sideband3;
+	ASSERT_FALSE (sideband3.deserialize_compact (stream4, scendere::block_type::state));
+	ASSERT_EQ (sideband1.details, sideband3.details);
+	ASSERT_EQ (scendere::epoch::epoch_0, sideband3.source_epoch);
+
+	// Truncated entries are rejected
+	scendere::bufferstream stream5 (vector2.data (), vector2.size () - 2);
+	scendere::block_sideband sideband4;
+	ASSERT_TRUE (sideband4.deserialize_compact (stream5, scendere::block_type::state));
+}
+
+TEST (block_store, latency)
+{
+	scendere::logger_mt logger;
+	auto store = scendere::make_store (logger, scendere::unique_path (), scendere::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	auto transaction (store->tx_begin_write ());
+	scendere::ledger_cache cache;
+	store->initialize (transaction, cache);
+	// Nothing is counted while disabled
+	ASSERT_NE (nullptr, store->block.get (transaction, scendere::dev::genesis->hash ()));
+	ASSERT_EQ (0, store->latency.count (scendere::tables::blocks, scendere::store_latency::operation::get));
+	store->latency.enable (1);
+	ASSERT_NE (nullptr, store->block.get (transaction, scendere::dev::genesis->hash ()));
+	ASSERT_TRUE (store->confirmation_height.exists (transaction, scendere::dev::genesis_key.pub));
+	store->account.del (transaction, scendere::dev::genesis_key.pub);
+	ASSERT_EQ (1, store->latency.count (scendere::tables::blocks, scendere::store_latency::operation::get));
+	ASSERT_EQ (1, store->latency.count (scendere::tables::confirmation_height, scendere::store_latency::operation::exists));
+	ASSERT_EQ (1, store->latency.count (scendere::tables::accounts, scendere::store_latency::operation::del));
+	ASSERT_EQ (0, store->latency.count (scendere::tables::accounts, scendere::store_latency::operation::put));
+	boost::property_tree::ptree tree;
+	store->latency.serialize (tree);
+	ASSERT_EQ (1, tree.get<uint64_t> ("tables.blocks.get.count"));
+	ASSERT_EQ (1, tree.get<uint64_t> ("tables.blocks.get.timed"));
+	ASSERT_FALSE (tree.get_child_optional ("tables.pending"));
+	store->latency.clear ();
+	ASSERT_EQ (0, store->latency.count (scendere::tables::blocks, scendere::store_latency::operation::get));
+	// Operations are sampled per table and operation, interleaving them does not skip any of them
+	store->latency.enable (2);
+	for (auto i (0); i < 2; ++i)
+	{
+		ASSERT_NE (nullptr, store->block.get (transaction, scendere::dev::genesis->hash ()));
+		ASSERT_TRUE (store->confirmation_height.exists (transaction, scendere::dev::genesis_key.pub));
+	}
+	boost::property_tree::ptree sampled;
+	store->latency.serialize (sampled);
+	ASSERT_EQ (1, sampled.get<uint64_t> ("tables.blocks.get.timed"));
+	ASSERT_EQ (1, sampled.get<uint64_t> ("tables.confirmation_height.exists.timed"));
+}
+
 TEST (block_store, add_item)
 {
 	scendere::logger_mt logger;
@@ -131,6 +217,38 @@ TEST (block_store, add_item)
 	ASSERT_EQ (nullptr, latest3);
 }
 
+// Batched lookups return results in request order whatever the key order, with gaps for missing keys
+TEST (block_store, get_many)
+{
+	scendere::logger_mt logger;
+	auto store = scendere::make_store (logger, scendere::unique_path (), scendere::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	scendere::open_block block1 (0, 1, 0, scendere::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	scendere::open_block block2 (0, 2, 0, scendere::keypair ().prv, 0, 0);
+	block2.sideband_set ({});
+	scendere::account_info info (block1.hash (), 1, block1.hash (), 100, 0, 1, scendere::epoch::epoch_0);
+	auto transaction (store->tx_begin_write ());
+	store->block.put (transaction, block1.hash (), block1);
+	store->block.put (transaction, block2.hash (), block2);
+	store->account.put (transaction, scendere::dev::genesis_key.pub, info);
+	auto blocks (store->block.get_many (transaction, { block2.hash (), scendere::block_hash (42), block1.hash (), block2.hash () }));
+	ASSERT_EQ (4, blocks.size ());
+	ASSERT_NE (nullptr, blocks[0]);
+	ASSERT_EQ (block2, *blocks[0]);
+	ASSERT_EQ (nullptr, blocks[1]);
+	ASSERT_NE (nullptr, blocks[2]);
+	ASSERT_EQ (block1, *blocks[2]);
+	ASSERT_NE (nullptr, blocks[3]);
+	ASSERT_EQ (block2, *blocks[3]);
+	ASSERT_TRUE (store->block.get_many (transaction, {}).empty ());
+	auto infos (store->account.get_many (transaction, { scendere::account (1), scendere::dev::genesis_key.pub }));
+	ASSERT_EQ (2, infos.size ());
+	ASSERT_FALSE (infos[0]);
+	ASSERT_TRUE (infos[1]);
+	ASSERT_EQ (info, *infos[1]);
+}
+
 TEST (block_store, clear_successor)
 {
 	scendere::logger_mt logger;
@@ -1011,6 +1129,109 @@ TEST (block_store, state_block)
 	ASSERT_EQ (1, count2);
 }
 
+TEST (mdb_block_store, cached_read_transaction)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	scendere::logger_mt logger;
+	scendere::mdb_store store (logger, scendere::unique_path (), scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	scendere::endpoint_key endpoint1 (boost::asio::ip::address_v6::any ().to_bytes (), 100);
+	scendere::endpoint_key endpoint2 (boost::asio::ip::address_v6::any ().to_bytes (), 101);
+	void * handle (nullptr);
+	{
+		auto transaction (store.tx_begin_read_cached ());
+		handle = transaction.get_handle ();
+		ASSERT_FALSE (store.peer.exists (transaction, endpoint1));
+		// Nested reads get their own transaction
+		auto nested (store.tx_begin_read_cached ());
+		ASSERT_NE (handle, nested.get_handle ());
+	}
+	store.peer.put (store.tx_begin_write (), endpoint1);
+	{
+		// Without a staleness window the same transaction is renewed and sees the latest writes
+		auto transaction (store.tx_begin_read_cached ());
+		ASSERT_EQ (handle, transaction.get_handle ());
+		ASSERT_TRUE (store.peer.exists (transaction, endpoint1));
+	}
+	scendere::lmdb_config config;
+	config.read_transaction_staleness = std::chrono::hours (1);
+	scendere::mdb_store stale_store (logger, scendere::unique_path (), scendere::dev::constants, scendere::txn_tracking_config{}, std::chrono::milliseconds (5000), config);
+	ASSERT_FALSE (stale_store.init_error ());
+	{
+		auto transaction (stale_store.tx_begin_read_cached ());
+		ASSERT_FALSE (stale_store.peer.exists (transaction, endpoint2));
+	}
+	stale_store.peer.put (stale_store.tx_begin_write (), endpoint2);
+	// The snapshot is kept within the staleness window
+	ASSERT_FALSE (stale_store.peer.exists (stale_store.tx_begin_read_cached (), endpoint2));
+	ASSERT_TRUE (stale_store.peer.exists (stale_store.tx_begin_read (), endpoint2));
+}
+
+// Cached read transactions are closed when their thread exits, freeing the reader slot
+TEST (mdb_block_store, cached_read_transaction_thread_exit)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	scendere::logger_mt logger;
+	scendere::mdb_store store (logger, scendere::unique_path (), scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	scendere::endpoint_key endpoint (boost::asio::ip::address_v6::any ().to_bytes (), 100);
+	ASSERT_FALSE (store.peer.exists (store.tx_begin_read_cached (), endpoint));
+	ASSERT_EQ (1, store.env.cached_open ());
+	std::thread thread ([&store, &endpoint] () {
+		ASSERT_FALSE (store.peer.exists (store.tx_begin_read_cached (), endpoint));
+		ASSERT_EQ (2, store.env.cached_open ());
+	});
+	thread.join ();
+	ASSERT_EQ (1, store.env.cached_open ());
+}
+
+// Tables are appended in key order into the copy, which opens as a complete store
+TEST (mdb_block_store, copy_db)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	scendere::logger_mt logger;
+	auto path (scendere::unique_path ());
+	auto copy_path (scendere::unique_path ());
+	std::vector<scendere::pending_key> keys;
+	{
+		scendere::mdb_store store (logger, path, scendere::dev::constants);
+		ASSERT_FALSE (store.init_error ());
+		scendere::ledger_cache cache;
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, cache);
+		for (auto i (0); i < 1000; ++i)
+		{
+			scendere::pending_key key (scendere::keypair ().pub, scendere::block_hash (i));
+			store.pending.put (transaction, key, scendere::pending_info (scendere::account (i), i, scendere::epoch::epoch_0));
+			keys.push_back (key);
+		}
+		transaction.commit ();
+		ASSERT_TRUE (store.copy_db (copy_path));
+	}
+	scendere::mdb_store copy (logger, copy_path, scendere::dev::constants);
+	ASSERT_FALSE (copy.init_error ());
+	auto transaction (copy.tx_begin_read ());
+	ASSERT_EQ (1000, copy.count (transaction, scendere::tables::pending));
+	ASSERT_EQ (1, copy.block.count (transaction));
+	ASSERT_TRUE (copy.block.exists (transaction, scendere::dev::genesis->hash ()));
+	for (auto const & key : keys)
+	{
+		ASSERT_TRUE (copy.pending.exists (transaction, key));
+	}
+}
+
 TEST (mdb_block_store, sideband_height)
 {
 	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
@@ -1576,10 +1797,15 @@ TEST (mdb_block_store, upgrade_v17_v18)
 	ASSERT_FALSE (store.init_error ());
 	auto transaction (store.tx_begin_read ());
 
-	// Size of state block should equal that set in db (no change)
+	// Size of state block should equal the compact layout written by the latest upgrade
 	scendere::mdb_val value;
 	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks_handle, scendere::mdb_val (state_send.hash ()), value));
-	ASSERT_EQ (value.size (), sizeof (scendere::block_type) + scendere::state_block::size + scendere::block_sideband::size (scendere::block_type::state));
+	std::vector<uint8_t> sideband_bytes;
+	{
+		scendere::vectorstream stream (sideband_bytes);
+		store.block.get (transaction, state_send.hash ())->sideband ().serialize_compact (stream, scendere::block_type::state);
+	}
+	ASSERT_EQ (value.size (), sizeof (scendere::block_type) + scendere::state_block::size + sideband_bytes.size ());
 
 	// Check that sidebands are correctly populated
 	{
@@ -1844,6 +2070,164 @@ TEST (mdb_block_store, upgrade_v20_v21)
 	ASSERT_LT (19, store.version.get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v21_v22)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (scendere::unique_path ());
+	scendere::logger_mt logger;
+	scendere::stat stats;
+	{
+		scendere::mdb_store store (logger, path, scendere::dev::constants);
+		scendere::ledger ledger (store, stats, scendere::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, ledger.cache);
+		// Delete account heights table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.account_heights_handle, 1));
+		store.version.put (transaction, 21);
+	}
+	// Upgrading should create the table
+	scendere::mdb_store store (logger, path, scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.account_heights_handle, 0);
+
+	// Version should be correct
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (21, store.version.get (transaction));
+	ASSERT_EQ (0, store.account_height.count (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v22_v23)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (scendere::unique_path ());
+	scendere::logger_mt logger;
+	scendere::stat stats;
+	{
+		scendere::mdb_store store (logger, path, scendere::dev::constants);
+		scendere::ledger ledger (store, stats, scendere::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, ledger.cache);
+		// Delete delegators table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.delegators_handle, 1));
+		store.version.put (transaction, 22);
+	}
+	// Upgrading should create the table
+	scendere::mdb_store store (logger, path, scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.delegators_handle, 0);
+
+	// Version should be correct
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (22, store.version.get (transaction));
+	ASSERT_EQ (0, store.delegator.count (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v23_v24)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (scendere::unique_path ());
+	scendere::logger_mt logger;
+	scendere::stat stats;
+	{
+		scendere::mdb_store store (logger, path, scendere::dev::constants);
+		scendere::ledger ledger (store, stats, scendere::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, ledger.cache);
+		// Delete pending amounts table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.pending_amounts_handle, 1));
+		store.version.put (transaction, 23);
+	}
+	// Upgrading should create the table
+	scendere::mdb_store store (logger, path, scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.pending_amounts_handle, 0);
+
+	// Version should be correct
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (23, store.version.get (transaction));
+	ASSERT_EQ (0, store.pending_amount.count (transaction));
+}
+
+TEST (mdb_block_store, upgrade_v24_v25)
+{
+	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (scendere::unique_path ());
+	scendere::logger_mt logger;
+	scendere::stat stats;
+	scendere::keypair key1;
+	scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	scendere::send_block send (scendere::dev::genesis->hash (), scendere::dev::genesis_key.pub, scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (scendere::dev::genesis->hash ()));
+	scendere::state_block state_send (scendere::dev::genesis_key.pub, send.hash (), scendere::dev::genesis_key.pub, scendere::dev::constants.genesis_amount - 2 * scendere::Gxrb_ratio, key1.pub, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (send.hash ()));
+	scendere::state_block state_open (key1.pub, 0, key1.pub, scendere::Gxrb_ratio, state_send.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	std::vector<scendere::block_hash> hashes{ scendere::dev::genesis->hash (), send.hash (), state_send.hash (), state_open.hash () };
+	std::unordered_map<scendere::block_hash, size_t> fixed_sizes;
+	{
+		scendere::mdb_store store (logger, path, scendere::dev::constants);
+		scendere::ledger ledger (store, stats, scendere::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, ledger.cache);
+		ASSERT_EQ (scendere::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (scendere::process_result::progress, ledger.process (transaction, state_send).code);
+		ASSERT_EQ (scendere::process_result::progress, ledger.process (transaction, state_open).code);
+		// Rewrite every block with the fixed size sideband used before version 25
+		for (auto const & hash : hashes)
+		{
+			auto block (store.block.get (transaction, hash));
+			ASSERT_NE (nullptr, block);
+			std::vector<uint8_t> data;
+			{
+				scendere::vectorstream stream (data);
+				scendere::serialize_block (stream, *block);
+				block->sideband ().serialize (stream, block->type ());
+			}
+			fixed_sizes[hash] = data.size ();
+			ASSERT_FALSE (mdb_put (store.env.tx (transaction), store.blocks_handle, scendere::mdb_val (hash), scendere::mdb_val (data.size (), data.data ()), 0));
+		}
+		store.version.put (transaction, 24);
+	}
+	// Upgrading should rewrite the blocks in the compact layout
+	scendere::mdb_store store (logger, path, scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (24, store.version.get (transaction));
+	ASSERT_EQ (hashes.size (), store.block.count (transaction));
+	for (auto const & hash : hashes)
+	{
+		scendere::mdb_val value;
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks_handle, scendere::mdb_val (hash), value));
+		ASSERT_LT (value.size (), fixed_sizes[hash]);
+	}
+	ASSERT_EQ (send.hash (), store.block.successor (transaction, scendere::dev::genesis->hash ()));
+	auto block1 (store.block.get (transaction, send.hash ()));
+	ASSERT_EQ (send, *block1);
+	ASSERT_EQ (2, block1->sideband ().height);
+	ASSERT_EQ (state_send.hash (), block1->sideband ().successor);
+	ASSERT_EQ (scendere::dev::genesis_key.pub, block1->sideband ().account);
+	auto block2 (store.block.get (transaction, state_send.hash ()));
+	ASSERT_EQ (3, block2->sideband ().height);
+	ASSERT_TRUE (block2->sideband ().details.is_send);
+	auto block3 (store.block.get (transaction, state_open.hash ()));
+	ASSERT_EQ (1, block3->sideband ().height);
+	ASSERT_TRUE (block3->sideband ().details.is_receive);
+	ASSERT_EQ (scendere::epoch::epoch_0, block3->sideband ().source_epoch);
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	if (scendere::rocksdb_config::using_rocksdb_in_tests ())
@@ -2038,6 +2422,137 @@ TEST (block_store, rocksdb_force_test_env_variable)
 	}
 }
 
+// Read transactions keep seeing the ledger as it was when they started while the writer moves on
+TEST (memory_store, snapshot_isolation)
+{
+	scendere::memory_store store (scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	scendere::account account1 (1);
+	scendere::account account2 (2);
+	store.confirmation_height.put (store.tx_begin_write (), account1, { 1, 1 });
+	auto before (store.tx_begin_read ());
+	{
+		auto transaction (store.tx_begin_write ());
+		store.confirmation_height.put (transaction, account1, { 2, 2 });
+		store.confirmation_height.put (transaction, account2, { 1, 3 });
+		// Writes are visible to their own transaction only until it commits
+		scendere::confirmation_height_info info;
+		ASSERT_FALSE (store.confirmation_height.get (transaction, account1, info));
+		ASSERT_EQ (2, info.height);
+		ASSERT_FALSE (store.confirmation_height.get (store.tx_begin_read (), account1, info));
+		ASSERT_EQ (1, info.height);
+	}
+	store.confirmation_height.del (store.tx_begin_write (), account1);
+	scendere::confirmation_height_info info;
+	ASSERT_FALSE (store.confirmation_height.get (before, account1, info));
+	ASSERT_EQ (1, info.height);
+	ASSERT_FALSE (store.confirmation_height.exists (before, account2));
+	ASSERT_EQ (1, store.confirmation_height.count (before));
+	auto after (store.tx_begin_read ());
+	ASSERT_FALSE (store.confirmation_height.exists (after, account1));
+	ASSERT_TRUE (store.confirmation_height.exists (after, account2));
+	ASSERT_EQ (1, store.confirmation_height.count (after));
+	before.refresh ();
+	ASSERT_FALSE (store.confirmation_height.exists (before, account1));
+}
+
+TEST (memory_store, iteration)
+{
+	scendere::memory_store store (scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	{
+		auto transaction (store.tx_begin_write ());
+		for (auto i (1); i <= 5; ++i)
+		{
+			store.online_weight.put (transaction, i, i);
+		}
+		store.online_weight.del (transaction, 3);
+	}
+	auto snapshot (store.tx_begin_read ());
+	store.online_weight.clear (store.tx_begin_write ());
+	std::vector<uint64_t> ascending;
+	for (auto i (store.online_weight.begin (snapshot)), n (store.online_weight.end ()); i != n; ++i)
+	{
+		ascending.push_back (i->first);
+	}
+	ASSERT_EQ ((std::vector<uint64_t>{ 1, 2, 4, 5 }), ascending);
+	std::vector<uint64_t> descending;
+	for (auto i (store.online_weight.rbegin (snapshot)), n (store.online_weight.end ()); i != n; --i)
+	{
+		descending.push_back (i->first);
+	}
+	ASSERT_EQ ((std::vector<uint64_t>{ 5, 4, 2, 1 }), descending);
+	ASSERT_EQ (0, store.online_weight.count (store.tx_begin_read ()));
+}
+
+// Committing a write transaction lets other writers in until it is renewed
+TEST (memory_store, write_commit_renew)
+{
+	scendere::memory_store store (scendere::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_write ());
+	store.online_weight.put (transaction, 1, 1);
+	transaction.commit ();
+	std::thread writer1 ([&store] () {
+		store.online_weight.put (store.tx_begin_write (), 2, 2);
+	});
+	writer1.join ();
+	transaction.renew ();
+	store.online_weight.put (transaction, 3, 3);
+	std::atomic<bool> written{ false };
+	std::thread writer2 ([&store, &written] () {
+		store.online_weight.put (store.tx_begin_write (), 4, 4);
+		written = true;
+	});
+	std::this_thread::sleep_for (100ms);
+	ASSERT_FALSE (written);
+	transaction.commit ();
+	writer2.join ();
+	ASSERT_TRUE (written);
+	ASSERT_EQ (4, store.online_weight.count (store.tx_begin_read ()));
+}
+
+// Tables read over parallel key ranges are loaded whole into another store
+TEST (block_store, table_sinks)
+{
+	scendere::logger_mt logger;
+	auto source = scendere::make_store (logger, scendere::unique_path (), scendere::dev::constants);
+	ASSERT_FALSE (source->init_error ());
+	scendere::memory_store destination{ scendere::dev::constants };
+	std::vector<scendere::pending_key> keys;
+	{
+		auto transaction (source->tx_begin_write ());
+		for (auto i (0); i < 100; ++i)
+		{
+			scendere::pending_key key (scendere::keypair ().pub, scendere::block_hash (i));
+			source->pending.put (transaction, key, scendere::pending_info (scendere::account (i), i, scendere::epoch::epoch_0));
+			keys.push_back (key);
+		}
+	}
+	std::vector<std::unique_ptr<scendere::table_sink>> sinks;
+	scendere::mutex sinks_mutex;
+	source->table_read_par (scendere::tables::pending, [&] () -> scendere::table_sink & {
+		scendere::lock_guard<scendere::mutex> guard (sinks_mutex);
+		sinks.push_back (destination.table_sink_make (scendere::tables::pending));
+		return *sinks.back ();
+	});
+	uint64_t count (0);
+	for (auto const & sink : sinks)
+	{
+		count += sink->count ();
+	}
+	ASSERT_EQ (100, count);
+	ASSERT_FALSE (destination.table_sinks_commit (scendere::tables::pending, sinks));
+	auto transaction (destination.tx_begin_read ());
+	ASSERT_EQ (100, destination.count (transaction, scendere::tables::pending));
+	for (auto const & key : keys)
+	{
+		scendere::pending_info info;
+		ASSERT_FALSE (destination.pending.get (transaction, key, info));
+		ASSERT_EQ (info.source, scendere::account (key.hash.number ()));
+	}
+}
+
 namespace scendere
 {
 // This thest ensures the tombstone_count is increased when there is a delete. The tombstone_count is part of a flush
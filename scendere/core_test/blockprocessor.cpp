@@ -38,4 +38,79 @@ TEST (block_processor, broadcast_block_on_arrival)
 	node1->process_active (send1);
 	// Checks whether the block was broadcast.
 	ASSERT_TIMELY (5s, node2->ledger.block_or_pruned_exists (send1->hash ()));
-}
\ No newline at end of file
+}
+
+TEST (block_processor, legacy_batch_verification)
+{
+	scendere::system system (1);
+	auto & node (*system.nodes[0]);
+	scendere::keypair key;
+	scendere::block_builder builder;
+	auto send1 = builder.send ()
+				 .previous (scendere::dev::genesis->hash ())
+				 .destination (key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 1)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*system.work.generate (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder.send ()
+				 .previous (send1->hash ())
+				 .destination (key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 2)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build_shared ();
+	// Signed by an account that does not own the chain, verified against that same account as if supplied by a malicious pull
+	auto forged = builder.send ()
+				  .previous (send1->hash ())
+				  .destination (key.pub)
+				  .balance (0)
+				  .sign (key.prv, key.pub)
+				  .work (*system.work.generate (send1->hash ()))
+				  .build_shared ();
+	node.block_processor.add (scendere::unchecked_info (send2, scendere::dev::genesis_key.pub, scendere::signature_verification::unknown));
+	node.block_processor.add (scendere::unchecked_info (forged, key.pub, scendere::signature_verification::unknown));
+	ASSERT_TIMELY (10s, 2 == node.unchecked.count (node.store.tx_begin_read ()));
+	{
+		auto blocks = node.unchecked.get (node.store.tx_begin_read (), send1->hash ());
+		ASSERT_EQ (2, blocks.size ());
+		ASSERT_EQ (scendere::signature_verification::valid, blocks[0].verified);
+		ASSERT_EQ (scendere::signature_verification::valid, blocks[1].verified);
+	}
+	node.block_processor.add (send1);
+	ASSERT_TIMELY (5s, node.store.block.exists (node.store.tx_begin_read (), send2->hash ()));
+	ASSERT_TIMELY (5s, 0 == node.unchecked.count (node.store.tx_begin_read ()));
+	ASSERT_FALSE (node.store.block.exists (node.store.tx_begin_read (), forged->hash ()));
+}
+
+TEST (block_processor, legacy_batch_verification_wrong_account)
+{
+	scendere::system system (1);
+	auto & node (*system.nodes[0]);
+	scendere::keypair key;
+	scendere::block_builder builder;
+	auto send1 = builder.send ()
+				 .previous (scendere::dev::genesis->hash ())
+				 .destination (key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 1)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*system.work.generate (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder.send ()
+				 .previous (send1->hash ())
+				 .destination (key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 2)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build_shared ();
+	// A wrong account hint fails batch verification and leaves the block to the ledger instead of dropping it
+	node.block_processor.add (scendere::unchecked_info (send2, key.pub, scendere::signature_verification::unknown));
+	ASSERT_TIMELY (10s, 1 == node.unchecked.count (node.store.tx_begin_read ()));
+	{
+		auto blocks = node.unchecked.get (node.store.tx_begin_read (), send1->hash ());
+		ASSERT_EQ (1, blocks.size ());
+		ASSERT_EQ (scendere::signature_verification::unknown, blocks[0].verified);
+	}
+	node.block_processor.add (send1);
+	ASSERT_TIMELY (5s, node.store.block.exists (node.store.tx_begin_read (), send2->hash ()));
+}
@@ -1,5 +1,6 @@
 #include <scendere/node/bootstrap/bootstrap_frontier.hpp>
 #include <scendere/node/bootstrap/bootstrap_lazy.hpp>
+#include <scendere/node/bootstrap/bootstrap_legacy.hpp>
 #include <scendere/test_common/system.hpp>
 #include <scendere/test_common/testutil.hpp>
 
@@ -167,6 +168,159 @@ TEST (bulk_pull, count_limit)
 	ASSERT_EQ (nullptr, block);
 }
 
+// Ascending pulls walk successors forward, starting after a block hash or at the open block of an account
+TEST (bulk_pull, ascending)
+{
+	scendere::system system (1);
+	auto node0 (system.nodes[0]);
+
+	auto send1 (std::make_shared<scendere::send_block> (node0->latest (scendere::dev::genesis_key.pub), scendere::dev::genesis_key.pub, 1, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *system.work.generate (node0->latest (scendere::dev::genesis_key.pub))));
+	ASSERT_EQ (scendere::process_result::progress, node0->process (*send1).code);
+	auto receive1 (std::make_shared<scendere::receive_block> (send1->hash (), send1->hash (), scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *system.work.generate (send1->hash ())));
+	ASSERT_EQ (scendere::process_result::progress, node0->process (*receive1).code);
+
+	auto connection (std::make_shared<scendere::bootstrap_server> (std::make_shared<scendere::socket> (*node0, scendere::socket::endpoint_type_t::server), node0));
+	auto req = std::make_unique<scendere::bulk_pull> (scendere::dev::network_params.network);
+	req->start = scendere::dev::genesis->hash ();
+	req->end = scendere::dev::genesis->hash ();
+	req->set_ascending (true);
+	connection->requests.push (std::unique_ptr<scendere::message>{});
+	auto request (std::make_shared<scendere::bulk_pull_server> (connection, std::move (req)));
+	ASSERT_EQ (send1->hash (), request->current);
+	ASSERT_TRUE (request->request->end.is_zero ());
+
+	auto block (request->get_next ());
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (send1->hash (), block->hash ());
+	block = request->get_next ();
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (receive1->hash (), block->hash ());
+	ASSERT_EQ (nullptr, request->get_next ());
+
+	auto req_account = std::make_unique<scendere::bulk_pull> (scendere::dev::network_params.network);
+	req_account->start = scendere::dev::genesis_key.pub;
+	req_account->set_ascending (true);
+	req_account->set_count_present (true);
+	req_account->count = 2;
+	connection->requests.push (std::unique_ptr<scendere::message>{});
+	auto request_account (std::make_shared<scendere::bulk_pull_server> (connection, std::move (req_account)));
+	block = request_account->get_next ();
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (scendere::dev::genesis->hash (), block->hash ());
+	block = request_account->get_next ();
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (send1->hash (), block->hash ());
+	ASSERT_EQ (nullptr, request_account->get_next ());
+}
+
+TEST (bulk_pull, compact_codec)
+{
+	scendere::keypair key1;
+	scendere::keypair rep;
+	scendere::state_block_builder builder;
+	std::vector<std::shared_ptr<scendere::block>> blocks;
+	blocks.push_back (std::make_shared<scendere::send_block> (1, key1.pub, 100, key1.prv, key1.pub, 0));
+	scendere::block_hash previous (0);
+	scendere::uint128_t balance (1000);
+	for (auto i (0); i < 4; ++i)
+	{
+		// Balance goes up and down by small amounts, the last block jumps by more than a varint saves
+		balance = i == 3 ? std::numeric_limits<scendere::uint128_t>::max () : i % 2 == 0 ? balance - 7 : balance + 300;
+		auto block = builder.make_block ()
+					 .account (key1.pub)
+					 .previous (previous)
+					 .representative (i < 2 ? key1.pub : rep.pub)
+					 .balance (balance)
+					 .link (key1.pub)
+					 .sign (key1.prv, key1.pub)
+					 .work (i)
+					 .build_shared ();
+		previous = block->hash ();
+		blocks.push_back (block);
+	}
+	std::vector<uint8_t> compact_bytes;
+	std::vector<uint8_t> regular_bytes;
+	{
+		scendere::bulk_pull_compact_codec encoder;
+		scendere::vectorstream compact_stream (compact_bytes);
+		scendere::vectorstream regular_stream (regular_bytes);
+		std::size_t written (0);
+		for (auto const & block : blocks)
+		{
+			written += encoder.serialize (compact_stream, *block);
+			scendere::serialize_block (regular_stream, *block);
+		}
+		compact_stream.pubsync ();
+		ASSERT_EQ (compact_bytes.size (), written);
+	}
+	ASSERT_LT (compact_bytes.size (), regular_bytes.size ());
+	scendere::bulk_pull_compact_codec decoder;
+	scendere::bufferstream stream (compact_bytes.data (), compact_bytes.size ());
+	for (auto const & expected : blocks)
+	{
+		uint8_t type (0);
+		ASSERT_FALSE (scendere::try_read (stream, type));
+		std::shared_ptr<scendere::block> block;
+		if (type == scendere::bulk_pull_compact_codec::entry_type)
+		{
+			uint8_t size (0);
+			ASSERT_FALSE (scendere::try_read (stream, size));
+			std::vector<uint8_t> body;
+			scendere::read (stream, body, size);
+			std::vector<uint8_t> full;
+			ASSERT_FALSE (decoder.deserialize (body.data (), body.size (), full));
+			scendere::bufferstream full_stream (full.data (), full.size ());
+			block = scendere::deserialize_block (full_stream, scendere::block_type::state);
+		}
+		else
+		{
+			block = scendere::deserialize_block (stream, static_cast<scendere::block_type> (type));
+		}
+		ASSERT_NE (nullptr, block);
+		ASSERT_EQ (*expected, *block);
+		decoder.update (*block);
+	}
+	// Context references without a context are rejected
+	scendere::bulk_pull_compact_codec empty;
+	std::vector<uint8_t> body (1 + 32 + 32 + 1 + 104, 0);
+	body[0] = scendere::bulk_pull_compact_codec::account_implied;
+	std::vector<uint8_t> full;
+	ASSERT_TRUE (empty.deserialize (body.data (), body.size (), full));
+}
+
+TEST (bulk_pull, compact_pull)
+{
+	scendere::system system;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 = system.add_node (node_flags);
+	scendere::keypair key1;
+	scendere::state_block_builder builder;
+	auto latest (scendere::dev::genesis->hash ());
+	for (auto i (1); i <= 3; ++i)
+	{
+		auto send = builder.make_block ()
+					.account (scendere::dev::genesis_key.pub)
+					.previous (latest)
+					.representative (scendere::dev::genesis_key.pub)
+					.balance (scendere::dev::constants.genesis_amount - i * scendere::Gxrb_ratio)
+					.link (key1.pub)
+					.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+					.work (*system.work.generate (latest))
+					.build_shared ();
+		latest = send->hash ();
+		ASSERT_EQ (scendere::process_result::progress, node0->process (*send).code);
+	}
+	node_flags.enable_compact_bulk_pull = true;
+	auto node1 (std::make_shared<scendere::node> (system.io_ctx, scendere::get_available_port (), scendere::unique_path (), system.logging, system.work, node_flags));
+	ASSERT_FALSE (node1->init_error ());
+	node1->start ();
+	system.nodes.push_back (node1);
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint (), false);
+	ASSERT_TIMELY (10s, node1->latest (scendere::dev::genesis_key.pub) == latest);
+	ASSERT_EQ (0, node1->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::bulk_pull_deserialize_receive_block, scendere::stat::dir::in));
+}
+
 TEST (bootstrap_processor, DISABLED_process_none)
 {
 	scendere::system system (1);
@@ -234,6 +388,76 @@ TEST (bootstrap_processor, process_two)
 	node1->stop ();
 }
 
+// Chains longer than a single bulk pull batch are served in several writes
+TEST (bootstrap_processor, process_batches)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	scendere::state_block_builder builder;
+	auto latest (node0->latest (scendere::dev::genesis_key.pub));
+	auto const chain_length ((scendere::bulk_pull_server::batch_size_max / scendere::state_block::size) * 2 + 1);
+	for (std::size_t i (1); i <= chain_length; ++i)
+	{
+		auto send = builder.make_block ()
+					.account (scendere::dev::genesis_key.pub)
+					.previous (latest)
+					.representative (scendere::dev::genesis_key.pub)
+					.balance (scendere::dev::constants.genesis_amount - i)
+					.link (scendere::dev::genesis_key.pub)
+					.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+					.work (*system.work.generate (latest))
+					.build ();
+		ASSERT_EQ (scendere::process_result::progress, node0->process (*send).code);
+		latest = send->hash ();
+	}
+
+	auto node1 (std::make_shared<scendere::node> (system.io_ctx, scendere::get_available_port (), scendere::unique_path (), system.logging, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint (), false);
+	ASSERT_TIMELY (20s, node1->latest (scendere::dev::genesis_key.pub) == latest);
+	ASSERT_EQ (node0->ledger.cache.block_count, node1->ledger.cache.block_count);
+	node1->stop ();
+}
+
+// Batches are capped at the bootstrap burst of the bandwidth limiter, which here holds about 16 blocks
+TEST (bootstrap_processor, pull_batch_bandwidth_limited)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	config.bandwidth_limit = 8 * 16 * (scendere::state_block::size + 1);
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	ASSERT_GE (node0->network.limiter.burst (scendere::bandwidth_limit_type::bootstrap), 16 * (scendere::state_block::size + 1));
+	scendere::state_block_builder builder;
+	auto latest (node0->latest (scendere::dev::genesis_key.pub));
+	for (std::size_t i (1); i <= 40; ++i)
+	{
+		auto send = builder.make_block ()
+					.account (scendere::dev::genesis_key.pub)
+					.previous (latest)
+					.representative (scendere::dev::genesis_key.pub)
+					.balance (scendere::dev::constants.genesis_amount - i)
+					.link (scendere::dev::genesis_key.pub)
+					.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+					.work (*system.work.generate (latest))
+					.build ();
+		ASSERT_EQ (scendere::process_result::progress, node0->process (*send).code);
+		latest = send->hash ();
+	}
+
+	auto node1 (std::make_shared<scendere::node> (system.io_ctx, scendere::get_available_port (), scendere::unique_path (), system.logging, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint (), false);
+	ASSERT_TIMELY (20s, node1->latest (scendere::dev::genesis_key.pub) == latest);
+	node1->stop ();
+}
+
 // Bootstrap can pull universal blocks
 TEST (bootstrap_processor, process_state)
 {
@@ -311,6 +535,85 @@ TEST (bootstrap_processor, process_new)
 	node3->stop ();
 }
 
+// Frontiers are requested in account ranges over several connections
+TEST (bootstrap_processor, frontier_ranges)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	// One account in each quarter of the account space
+	std::vector<scendere::keypair> keys;
+	for (uint8_t quarter (0); quarter < 4; ++quarter)
+	{
+		scendere::keypair key;
+		while (key.pub.bytes[0] >> 6 != quarter)
+		{
+			key = scendere::keypair ();
+		}
+		keys.push_back (key);
+	}
+	scendere::state_block_builder builder;
+	auto latest (node0->latest (scendere::dev::genesis_key.pub));
+	auto balance (scendere::dev::constants.genesis_amount);
+	for (auto const & key : keys)
+	{
+		balance -= 1;
+		auto send = builder.make_block ()
+					.account (scendere::dev::genesis_key.pub)
+					.previous (latest)
+					.representative (scendere::dev::genesis_key.pub)
+					.balance (balance)
+					.link (key.pub)
+					.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+					.work (*system.work.generate (latest))
+					.build ();
+		ASSERT_EQ (scendere::process_result::progress, node0->process (*send).code);
+		latest = send->hash ();
+		auto open = builder.make_block ()
+					.account (key.pub)
+					.previous (0)
+					.representative (key.pub)
+					.balance (1)
+					.link (send->hash ())
+					.sign (key.prv, key.pub)
+					.work (*system.work.generate (key.pub))
+					.build ();
+		ASSERT_EQ (scendere::process_result::progress, node0->process (*open).code);
+	}
+
+	scendere::node_config config1 (scendere::get_available_port (), system.logging);
+	config1.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	config1.bootstrap_connections = 4;
+	auto node1 (system.add_node (config1, node_flags));
+	// The account space is split into contiguous ranges, each one starting after the end of the previous one
+	auto attempt (std::make_shared<scendere::bootstrap_attempt_legacy> (node1, 0, "", std::numeric_limits<uint32_t>::max (), 0));
+	auto const & ranges (attempt->frontier_ranges);
+	ASSERT_EQ (4, ranges.size ());
+	ASSERT_TRUE (ranges.front ().first.is_zero ());
+	ASSERT_EQ (std::numeric_limits<scendere::uint256_t>::max (), ranges.back ().second.number ());
+	for (std::size_t i (1); i < ranges.size (); ++i)
+	{
+		ASSERT_EQ (ranges[i - 1].second.number (), ranges[i].first.number () + 1);
+	}
+	// Each account falls in the range of its quarter
+	for (std::size_t i (0); i < keys.size (); ++i)
+	{
+		ASSERT_LT (ranges[i].first, keys[i].pub);
+		ASSERT_LT (keys[i].pub, ranges[i].second);
+	}
+	auto range_count (ranges.size ());
+	attempt.reset ();
+	auto frontier_requests (node0->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::frontier_req, scendere::stat::dir::in));
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint (), false);
+	ASSERT_TIMELY (10s, std::all_of (keys.begin (), keys.end (), [&node1] (auto const & key_a) { return node1->balance (key_a.pub) == 1; }));
+	ASSERT_EQ (node0->latest (scendere::dev::genesis_key.pub), node1->latest (scendere::dev::genesis_key.pub));
+	// One frontier request per range
+	ASSERT_TIMELY (10s, node0->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::frontier_req, scendere::stat::dir::in) >= frontier_requests + range_count);
+}
+
 TEST (bootstrap_processor, pull_diamond)
 {
 	scendere::system system;
@@ -1439,6 +1742,50 @@ TEST (frontier_req, end)
 	ASSERT_TRUE (request->current.is_zero ());
 }
 
+// The server stops at the end of the requested account range
+TEST (frontier_req, end_account)
+{
+	scendere::system system (1);
+	auto connection (std::make_shared<scendere::bootstrap_server> (std::make_shared<scendere::socket> (*system.nodes[0], scendere::socket::endpoint_type_t::server), system.nodes[0]));
+	auto req = std::make_unique<scendere::frontier_req> (scendere::dev::network_params.network);
+	req->start.clear ();
+	req->age = std::numeric_limits<decltype (req->age)>::max ();
+	req->count = std::numeric_limits<decltype (req->count)>::max ();
+	req->end = scendere::dev::genesis_key.pub;
+	ASSERT_FALSE (req->header.frontier_req_is_end_present ());
+	req->header.flag_set (scendere::message_header::frontier_req_end_present_flag);
+	ASSERT_TRUE (req->header.frontier_req_is_end_present ());
+	ASSERT_EQ (scendere::frontier_req::size + sizeof (scendere::account), req->header.payload_length_bytes ());
+	// The end account survives a round trip
+	std::vector<uint8_t> bytes;
+	{
+		scendere::vectorstream stream (bytes);
+		req->serialize (stream);
+	}
+	auto error (false);
+	scendere::bufferstream stream (bytes.data (), bytes.size ());
+	scendere::message_header header (error, stream);
+	ASSERT_FALSE (error);
+	scendere::frontier_req req2 (error, stream, header);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (*req, req2);
+	// The end is exclusive so genesis is not sent
+	connection->requests.push (std::unique_ptr<scendere::message>{});
+	auto request (std::make_shared<scendere::frontier_req_server> (connection, std::move (req)));
+	ASSERT_TRUE (request->current.is_zero ());
+	auto connection2 (std::make_shared<scendere::bootstrap_server> (std::make_shared<scendere::socket> (*system.nodes[0], scendere::socket::endpoint_type_t::server), system.nodes[0]));
+	auto req3 = std::make_unique<scendere::frontier_req> (scendere::dev::network_params.network);
+	req3->start.clear ();
+	req3->age = std::numeric_limits<decltype (req3->age)>::max ();
+	req3->count = std::numeric_limits<decltype (req3->count)>::max ();
+	req3->end = scendere::dev::genesis_key.pub.number () + 1;
+	req3->header.flag_set (scendere::message_header::frontier_req_end_present_flag);
+	connection2->requests.push (std::unique_ptr<scendere::message>{});
+	auto request2 (std::make_shared<scendere::frontier_req_server> (connection2, std::move (req3)));
+	ASSERT_EQ (scendere::dev::genesis_key.pub, request2->current);
+	ASSERT_EQ (scendere::dev::genesis->hash (), request2->frontier);
+}
+
 TEST (frontier_req, count)
 {
 	scendere::system system (1);
@@ -1895,3 +2242,267 @@ TEST (bulk_pull_account, basics)
 		ASSERT_EQ (nullptr, block_data.second.get ());
 	}
 }
+
+// A block with a missing previous prioritizes its account, which ascending bootstrap then pulls forward from the local frontier
+TEST (bootstrap_processor, ascending_gap_previous)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	node_flags.disable_ongoing_bootstrap = true;
+	auto node0 = system.add_node (config, node_flags);
+	scendere::keypair key1;
+	scendere::state_block_builder builder;
+	auto send1 = builder
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (scendere::dev::genesis->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node0->work_generate_blocking (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder
+				 .make_block ()
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 2 * scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node0->work_generate_blocking (send1->hash ()))
+				 .build_shared ();
+	auto send3 = builder
+				 .make_block ()
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 3 * scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node0->work_generate_blocking (send2->hash ()))
+				 .build_shared ();
+	node0->block_processor.add (send1);
+	node0->block_processor.add (send2);
+	node0->block_processor.flush ();
+
+	config.peering_port = scendere::get_available_port ();
+	node_flags.enable_ascending_bootstrap = true;
+	node_flags.disable_lazy_bootstrap = true;
+	auto node1 = system.add_node (config, node_flags);
+	ASSERT_EQ (0, node1->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::initiate_ascending, scendere::stat::dir::out));
+	// send3 is unknown to both nodes, its gap prioritizes the genesis account on node1
+	node1->process_active (send3);
+	ASSERT_TIMELY (10s, node1->ledger.block_or_pruned_exists (send2->hash ()));
+	ASSERT_TIMELY (10s, node1->ledger.block_or_pruned_exists (send3->hash ()));
+	ASSERT_LE (1, node1->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::initiate_ascending, scendere::stat::dir::out));
+}
+
+// Live blocks which extend the local frontier of their account leave nothing to pull, neither for the account nor for the destination
+TEST (bootstrap_processor, ascending_live_in_ledger)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	node_flags.disable_ongoing_bootstrap = true;
+	node_flags.disable_lazy_bootstrap = true;
+	node_flags.enable_ascending_bootstrap = true;
+	auto node = system.add_node (config, node_flags);
+	scendere::keypair key1;
+	scendere::state_block_builder builder;
+	auto send1 = builder
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (scendere::dev::genesis->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node->work_generate_blocking (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	node->process_active (send1);
+	ASSERT_TIMELY (10s, node->ledger.block_or_pruned_exists (send1->hash ()));
+	node->block_processor.flush ();
+	ASSERT_EQ (0, node->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::initiate_ascending, scendere::stat::dir::out));
+}
+
+TEST (lazy_fingerprint_set, insert_erase)
+{
+	scendere::lazy_fingerprint_set set;
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (0, set.memory_usage ());
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		ASSERT_TRUE (set.insert (scendere::block_hash (i)));
+	}
+	ASSERT_FALSE (set.insert (scendere::block_hash (1)));
+	ASSERT_EQ (1000, set.size ());
+	ASSERT_LE (1000 * sizeof (uint64_t), set.memory_usage ());
+	for (uint64_t i (1); i <= 1000; i += 2)
+	{
+		ASSERT_TRUE (set.erase (scendere::block_hash (i)));
+	}
+	ASSERT_FALSE (set.erase (scendere::block_hash (1)));
+	ASSERT_EQ (500, set.size ());
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		ASSERT_EQ (i % 2 == 0, set.contains (scendere::block_hash (i)));
+	}
+	set.clear ();
+	ASSERT_TRUE (set.empty ());
+	ASSERT_FALSE (set.contains (scendere::block_hash (2)));
+}
+
+TEST (lazy_hash_table, insert_erase)
+{
+	scendere::lazy_hash_table<scendere::amount> table;
+	ASSERT_EQ (nullptr, table.find (scendere::block_hash (1)));
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		ASSERT_TRUE (table.insert (scendere::block_hash (i), scendere::amount (i)));
+	}
+	// Existing entries are kept
+	ASSERT_FALSE (table.insert (scendere::block_hash (1), scendere::amount (2)));
+	ASSERT_EQ (1000, table.size ());
+	for (uint64_t i (1); i <= 1000; i += 2)
+	{
+		ASSERT_TRUE (table.erase (scendere::block_hash (i)));
+	}
+	ASSERT_EQ (500, table.size ());
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		auto value (table.find (scendere::block_hash (i)));
+		if (i % 2 == 0)
+		{
+			ASSERT_NE (nullptr, value);
+			ASSERT_EQ (scendere::amount (i), *value);
+		}
+		else
+		{
+			ASSERT_EQ (nullptr, value);
+		}
+	}
+	std::size_t count (0);
+	table.for_each ([&count] (scendere::block_hash const & key_a, scendere::amount const & value_a) {
+		ASSERT_EQ (scendere::amount (static_cast<uint64_t> (key_a.number ())), value_a);
+		++count;
+	});
+	ASSERT_EQ (500, count);
+}
+
+TEST (bootstrap_checkpoint, load)
+{
+	scendere::keypair key1;
+	scendere::block_hash hash1 (1);
+	std::stringstream stream;
+	stream << "# account frontier height\n\n"
+		   << key1.pub.to_account () << " " << hash1.to_string () << " 5\n";
+	scendere::bootstrap_checkpoint checkpoint;
+	ASSERT_FALSE (checkpoint.load (stream));
+	ASSERT_EQ (1, checkpoint.size ());
+	auto entries (checkpoint.entries ());
+	ASSERT_EQ (key1.pub, entries[0].account);
+	ASSERT_EQ (hash1, entries[0].frontier);
+	ASSERT_EQ (5, entries[0].height);
+	std::stringstream invalid;
+	invalid << key1.pub.to_account () << " " << hash1.to_string () << "\n";
+	ASSERT_TRUE (checkpoint.load (invalid));
+	// Two frontiers for one account cannot be a cut of a ledger
+	std::stringstream duplicate;
+	duplicate << key1.pub.to_account () << " " << hash1.to_string () << " 5\n"
+			  << key1.pub.to_account () << " " << scendere::block_hash (2).to_string () << " 6\n";
+	scendere::bootstrap_checkpoint checkpoint2;
+	ASSERT_TRUE (checkpoint2.load (duplicate));
+}
+
+TEST (bootstrap_processor, checkpoint_cement)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	node_flags.disable_ongoing_bootstrap = true;
+	auto node = system.add_node (config, node_flags);
+	scendere::keypair key1;
+	scendere::state_block_builder builder;
+	auto send1 = builder
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (scendere::dev::genesis->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node->work_generate_blocking (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder
+				 .make_block ()
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - 2 * scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node->work_generate_blocking (send1->hash ()))
+				 .build_shared ();
+	node->bootstrap_initiator.checkpoint.add (scendere::dev::genesis_key.pub, send2->hash (), 3);
+	// Blocks arrive from the frontier down, as in a bulk pull
+	node->block_processor.add (send2);
+	node->block_processor.add (send1);
+	node->block_processor.flush ();
+	ASSERT_TIMELY (5s, node->ledger.cache.block_count == 3);
+	ASSERT_TIMELY (5s, node->ledger.cache.cemented_count == 3);
+	ASSERT_TRUE (node->ledger.block_confirmed (node->store.tx_begin_read (), send2->hash ()));
+	ASSERT_EQ (1, node->stats.count (scendere::stat::type::bootstrap, scendere::stat::detail::checkpoint_cemented));
+	ASSERT_EQ (0, node->active.size ());
+}
+
+// Cementing a checkpoint frontier also cements the blocks it depends on in other chains
+TEST (bootstrap_processor, checkpoint_cement_dependencies)
+{
+	scendere::system system;
+	scendere::node_config config (scendere::get_available_port (), system.logging);
+	config.frontiers_confirmation = scendere::frontiers_confirmation_mode::disabled;
+	scendere::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	node_flags.disable_ongoing_bootstrap = true;
+	auto node = system.add_node (config, node_flags);
+	scendere::keypair key1;
+	scendere::state_block_builder builder;
+	auto send1 = builder
+				 .account (scendere::dev::genesis_key.pub)
+				 .previous (scendere::dev::genesis->hash ())
+				 .representative (scendere::dev::genesis_key.pub)
+				 .balance (scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				 .work (*node->work_generate_blocking (scendere::dev::genesis->hash ()))
+				 .build_shared ();
+	auto open1 = builder
+				 .make_block ()
+				 .account (key1.pub)
+				 .previous (0)
+				 .representative (key1.pub)
+				 .balance (scendere::Gxrb_ratio)
+				 .link (send1->hash ())
+				 .sign (key1.prv, key1.pub)
+				 .work (*node->work_generate_blocking (key1.pub))
+				 .build_shared ();
+	// Only the receiving account is in the checkpoint
+	node->bootstrap_initiator.checkpoint.add (key1.pub, open1->hash (), 1);
+	node->block_processor.add (send1);
+	node->block_processor.add (open1);
+	node->block_processor.flush ();
+	ASSERT_TIMELY (5s, node->ledger.cache.cemented_count == 3);
+	auto transaction (node->store.tx_begin_read ());
+	ASSERT_TRUE (node->ledger.block_confirmed (transaction, open1->hash ()));
+	ASSERT_TRUE (node->ledger.block_confirmed (transaction, send1->hash ()));
+	ASSERT_EQ (0, node->active.size ());
+}
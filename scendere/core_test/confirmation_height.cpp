@@ -759,6 +759,7 @@ TEST (confirmation_heightDeathTest, rollback_added_block)
 		scendere::stat stats;
 		scendere::ledger ledger (*store, stats, scendere::dev::constants);
 		scendere::write_database_queue write_database_queue (false);
+		scendere::write_coordinator write_coordinator (*store, stats);
 		scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		scendere::keypair key1;
 		auto send = std::make_shared<scendere::send_block> (scendere::dev::genesis->hash (), key1.pub, scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (scendere::dev::genesis->hash ()));
@@ -770,13 +771,13 @@ TEST (confirmation_heightDeathTest, rollback_added_block)
 		uint64_t batch_write_size = 2048;
 		std::atomic<bool> stopped{ false };
 		scendere::confirmation_height_unbounded unbounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 
 		// Processing a block which doesn't exist should bail
 		ASSERT_DEATH_IF_SUPPORTED (unbounded_processor.process (send), "");
 
 		scendere::confirmation_height_bounded bounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 		// Processing a block which doesn't exist should bail
 		ASSERT_DEATH_IF_SUPPORTED (bounded_processor.process (send), "");
 	}
@@ -835,6 +836,7 @@ TEST (confirmation_heightDeathTest, modified_chain)
 		scendere::stat stats;
 		scendere::ledger ledger (*store, stats, scendere::dev::constants);
 		scendere::write_database_queue write_database_queue (false);
+		scendere::write_coordinator write_coordinator (*store, stats);
 		scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		scendere::keypair key1;
 		auto send = std::make_shared<scendere::send_block> (scendere::dev::genesis->hash (), key1.pub, scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (scendere::dev::genesis->hash ()));
@@ -847,7 +849,7 @@ TEST (confirmation_heightDeathTest, modified_chain)
 		uint64_t batch_write_size = 2048;
 		std::atomic<bool> stopped{ false };
 		scendere::confirmation_height_bounded bounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 
 		{
 			// This reads the blocks in the account, but prevents any writes from occuring yet
@@ -866,7 +868,7 @@ TEST (confirmation_heightDeathTest, modified_chain)
 		store->confirmation_height.put (store->tx_begin_write (), scendere::dev::genesis->account (), { 1, scendere::dev::genesis->hash () });
 
 		scendere::confirmation_height_unbounded unbounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 
 		{
 			// This reads the blocks in the account, but prevents any writes from occuring yet
@@ -905,6 +907,7 @@ TEST (confirmation_heightDeathTest, modified_chain_account_removed)
 		scendere::stat stats;
 		scendere::ledger ledger (*store, stats, scendere::dev::constants);
 		scendere::write_database_queue write_database_queue (false);
+		scendere::write_coordinator write_coordinator (*store, stats);
 		scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		scendere::keypair key1;
 		auto send = std::make_shared<scendere::send_block> (scendere::dev::genesis->hash (), key1.pub, scendere::dev::constants.genesis_amount - scendere::Gxrb_ratio, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (scendere::dev::genesis->hash ()));
@@ -919,7 +922,7 @@ TEST (confirmation_heightDeathTest, modified_chain_account_removed)
 		uint64_t batch_write_size = 2048;
 		std::atomic<bool> stopped{ false };
 		scendere::confirmation_height_unbounded unbounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 
 		{
 			// This reads the blocks in the account, but prevents any writes from occuring yet
@@ -939,7 +942,7 @@ TEST (confirmation_heightDeathTest, modified_chain_account_removed)
 		store->confirmation_height.put (store->tx_begin_write (), scendere::dev::genesis->account (), { 1, scendere::dev::genesis->hash () });
 
 		scendere::confirmation_height_bounded bounded_processor (
-		ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
+		ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [] (auto const &) {}, [] (auto const &) {}, [] () { return 0; });
 
 		{
 			// This reads the blocks in the account, but prevents any writes from occuring yet
@@ -1394,6 +1397,7 @@ TEST (confirmation_height, unbounded_block_cache_iteration)
 	scendere::stat stats;
 	scendere::ledger ledger (*store, stats, scendere::dev::constants);
 	scendere::write_database_queue write_database_queue (false);
+	scendere::write_coordinator write_coordinator (*store, stats);
 	boost::latch initialized_latch{ 0 };
 	scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 	scendere::logging logging;
@@ -1407,7 +1411,7 @@ TEST (confirmation_height, unbounded_block_cache_iteration)
 		ASSERT_EQ (scendere::process_result::progress, ledger.process (transaction, *send1).code);
 	}
 
-	scendere::confirmation_height_processor confirmation_height_processor (ledger, write_database_queue, 10ms, logging, logger, initialized_latch, scendere::confirmation_height_mode::unbounded);
+	scendere::confirmation_height_processor confirmation_height_processor (ledger, write_database_queue, write_coordinator, 10ms, logging, logger, initialized_latch, scendere::confirmation_height_mode::unbounded);
 	scendere::timer<> timer;
 	timer.start ();
 	{
@@ -1432,6 +1436,8 @@ TEST (confirmation_height, unbounded_block_cache_iteration)
 	ASSERT_EQ (2, stats.count (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed, scendere::stat::dir::in));
 	ASSERT_EQ (2, stats.count (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed_unbounded, scendere::stat::dir::in));
 	ASSERT_EQ (3, ledger.cache.cemented_count);
+	// Cementing is committed through the write coordinator
+	ASSERT_LE (1, stats.count (scendere::stat::type::write_coordinator, scendere::stat::detail::operations, scendere::stat::dir::in));
 }
 
 TEST (confirmation_height, pruned_source)
@@ -1445,6 +1451,7 @@ TEST (confirmation_height, pruned_source)
 	scendere::ledger ledger (*store, stats, scendere::dev::constants);
 	ledger.pruning = true;
 	scendere::write_database_queue write_database_queue (false);
+	scendere::write_coordinator write_coordinator (*store, stats);
 	scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 	scendere::keypair key1, key2;
 	auto send1 = std::make_shared<scendere::state_block> (scendere::dev::genesis_key.pub, scendere::dev::genesis->hash (), scendere::dev::genesis_key.pub, scendere::dev::constants.genesis_amount - 100, key1.pub, scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub, *pool.generate (scendere::dev::genesis->hash ()));
@@ -1465,7 +1472,7 @@ TEST (confirmation_height, pruned_source)
 	std::atomic<bool> stopped{ false };
 	bool first_time{ true };
 	scendere::confirmation_height_bounded bounded_processor (
-	ledger, write_database_queue, 10ms, logging, logger, stopped, batch_write_size, [&] (auto const & cemented_blocks_a) {
+	ledger, write_database_queue, write_coordinator, 10ms, logging, logger, stopped, batch_write_size, [&] (auto const & cemented_blocks_a) {
 		if (first_time)
 		{
 			// Prune the send
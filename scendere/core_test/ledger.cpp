@@ -3708,3 +3708,262 @@ TEST (ledger, unconfirmed_frontiers)
 	ASSERT_EQ (uncemented_info1.cemented_frontier, uncemented_info2.cemented_frontier);
 	ASSERT_EQ (uncemented_info1.frontier, uncemented_info2.frontier);
 }
+
+TEST (ledger, cache_snapshot)
+{
+	scendere::logger_mt logger;
+	auto path (scendere::unique_path ());
+	auto store = scendere::make_store (logger, path, scendere::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	scendere::stat stats;
+	scendere::ledger ledger (*store, stats, scendere::dev::constants);
+	store->initialize (store->tx_begin_write (), ledger.cache);
+	scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	scendere::state_block_builder builder;
+	scendere::keypair key;
+	auto const latest = ledger.latest (store->tx_begin_read (), scendere::dev::genesis->account ());
+	auto send = builder.make_block ()
+				.account (scendere::dev::genesis->account ())
+				.previous (latest)
+				.representative (key.pub)
+				.balance (scendere::dev::constants.genesis_amount - 100)
+				.link (key.pub)
+				.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				.work (*pool.generate (latest))
+				.build ();
+	ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *send).code);
+	auto snapshot (scendere::unique_path ());
+	ASSERT_FALSE (ledger.cache_snapshot_write (snapshot));
+
+	// Nothing is scanned, the cache comes from the snapshot which is consumed
+	scendere::generate_cache generate_cache;
+	generate_cache.reps = generate_cache.cemented_count = generate_cache.account_count = generate_cache.block_count = false;
+	{
+		scendere::ledger ledger2 (*store, stats, scendere::dev::constants, generate_cache, snapshot);
+		ASSERT_EQ (2, ledger2.cache.block_count);
+		ASSERT_EQ (1, ledger2.cache.cemented_count);
+		ASSERT_EQ (1, ledger2.cache.account_count);
+		ASSERT_EQ (scendere::dev::constants.genesis_amount - 100, ledger2.cache.rep_weights.representation_get (key.pub));
+		ASSERT_FALSE (boost::filesystem::exists (snapshot));
+	}
+
+	// A write after the snapshot was saved makes it stale
+	ASSERT_FALSE (ledger.cache_snapshot_write (snapshot));
+	store->confirmation_height.put (store->tx_begin_write (), scendere::dev::genesis->account (), { 2, send->hash () });
+	scendere::ledger ledger3 (*store, stats, scendere::dev::constants, generate_cache, snapshot);
+	ASSERT_EQ (0, ledger3.cache.block_count);
+	ASSERT_EQ (0, ledger3.cache.rep_weights.representation_get (key.pub));
+	ASSERT_FALSE (boost::filesystem::exists (snapshot));
+
+	// The cache was neither loaded nor generated so it is not saved
+	ASSERT_TRUE (ledger3.cache_snapshot_write (snapshot));
+	ASSERT_FALSE (boost::filesystem::exists (snapshot));
+}
+
+namespace
+{
+/** Initialized dev ledger on a fresh store, for the tests of the optional ledger indexes */
+class index_ledger final
+{
+public:
+	index_ledger () :
+		store (scendere::make_store (logger, scendere::unique_path (), scendere::dev::constants)),
+		ledger (*store, stats, scendere::dev::constants)
+	{
+		if (!store->init_error ())
+		{
+			store->initialize (store->tx_begin_write (), ledger.cache);
+		}
+	}
+	scendere::logger_mt logger;
+	std::unique_ptr<scendere::store> store;
+	scendere::stat stats;
+	scendere::ledger ledger;
+	scendere::work_pool pool{ scendere::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+};
+}
+
+TEST (ledger, account_heights)
+{
+	index_ledger context;
+	ASSERT_FALSE (context.store->init_error ());
+	auto & store (context.store);
+	auto & ledger (context.ledger);
+	auto & pool (context.pool);
+	scendere::state_block_builder builder;
+	scendere::keypair key;
+	std::vector<scendere::block_hash> hashes{ scendere::dev::genesis->hash () };
+	auto process_send = [&] () {
+		auto send (builder.make_block ()
+				   .account (scendere::dev::genesis->account ())
+				   .previous (hashes.back ())
+				   .representative (scendere::dev::genesis->account ())
+				   .balance (scendere::dev::constants.genesis_amount - hashes.size ())
+				   .link (key.pub)
+				   .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				   .work (*pool.generate (hashes.back ()))
+				   .build ());
+		ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *send).code);
+		hashes.push_back (send->hash ());
+	};
+	process_send ();
+	process_send ();
+
+	// Without the index the chain is walked
+	ASSERT_FALSE (ledger.account_heights_complete (store->tx_begin_read ()));
+	ASSERT_EQ (hashes[1], ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 2));
+	ASSERT_TRUE (ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 4).is_zero ());
+
+	ASSERT_EQ (3, ledger.account_heights_build ());
+	ledger.account_heights = true;
+	ASSERT_TRUE (ledger.account_heights_complete (store->tx_begin_read ()));
+	process_send ();
+	for (auto i (0); i < hashes.size (); ++i)
+	{
+		ASSERT_EQ (hashes[i], ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), i + 1));
+	}
+	ASSERT_TRUE (ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 0).is_zero ());
+	ASSERT_TRUE (ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 5).is_zero ());
+
+	// Rolled back blocks are removed from the index
+	ASSERT_FALSE (ledger.rollback (store->tx_begin_write (), hashes[3]));
+	ASSERT_TRUE (ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 4).is_zero ());
+	ASSERT_EQ (hashes[2], ledger.block_at_height (store->tx_begin_read (), scendere::dev::genesis->account (), 3));
+	ASSERT_TRUE (ledger.account_heights_complete (store->tx_begin_read ()));
+}
+
+TEST (ledger, delegators)
+{
+	index_ledger context;
+	ASSERT_FALSE (context.store->init_error ());
+	auto & store (context.store);
+	auto & ledger (context.ledger);
+	auto & pool (context.pool);
+	ASSERT_FALSE (ledger.delegators_complete (store->tx_begin_read ()));
+	ASSERT_EQ (1, ledger.delegators_build ());
+	ledger.delegators = true;
+	ASSERT_TRUE (ledger.delegators_complete (store->tx_begin_read ()));
+	ASSERT_TRUE (store->delegator.exists (store->tx_begin_read (), scendere::dev::genesis->account (), scendere::dev::genesis->account ()));
+
+	scendere::keypair key;
+	scendere::keypair rep1;
+	scendere::keypair rep2;
+	scendere::state_block_builder builder;
+	auto send = builder.make_block ()
+				.account (scendere::dev::genesis->account ())
+				.previous (scendere::dev::genesis->hash ())
+				.representative (scendere::dev::genesis->account ())
+				.balance (scendere::dev::constants.genesis_amount - 1)
+				.link (key.pub)
+				.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+				.work (*pool.generate (scendere::dev::genesis->hash ()))
+				.build ();
+	ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *send).code);
+	auto open = builder.make_block ()
+				.account (key.pub)
+				.previous (0)
+				.representative (rep1.pub)
+				.balance (1)
+				.link (send->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *open).code);
+	auto change = builder.make_block ()
+				  .account (key.pub)
+				  .previous (open->hash ())
+				  .representative (rep2.pub)
+				  .balance (1)
+				  .link (0)
+				  .sign (key.prv, key.pub)
+				  .work (*pool.generate (open->hash ()))
+				  .build ();
+	ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *change).code);
+	ASSERT_TRUE (store->delegator.exists (store->tx_begin_read (), scendere::dev::genesis->account (), scendere::dev::genesis->account ()));
+	ASSERT_FALSE (store->delegator.exists (store->tx_begin_read (), rep1.pub, key.pub));
+	ASSERT_TRUE (store->delegator.exists (store->tx_begin_read (), rep2.pub, key.pub));
+
+	// Rolling back the change and then the open restores the previous entries
+	ASSERT_FALSE (ledger.rollback (store->tx_begin_write (), change->hash ()));
+	ASSERT_TRUE (store->delegator.exists (store->tx_begin_read (), rep1.pub, key.pub));
+	ASSERT_FALSE (store->delegator.exists (store->tx_begin_read (), rep2.pub, key.pub));
+	ASSERT_FALSE (ledger.rollback (store->tx_begin_write (), open->hash ()));
+	ASSERT_FALSE (store->delegator.exists (store->tx_begin_read (), rep1.pub, key.pub));
+
+	// A rebuild matches the maintained index
+	ASSERT_EQ (1, ledger.delegators_build ());
+	ASSERT_TRUE (ledger.delegators_complete (store->tx_begin_read ()));
+	ASSERT_TRUE (store->delegator.exists (store->tx_begin_read (), scendere::dev::genesis->account (), scendere::dev::genesis->account ()));
+	ASSERT_FALSE (store->delegator.exists (store->tx_begin_read (), rep1.pub, key.pub));
+}
+
+TEST (ledger, pending_amounts)
+{
+	index_ledger context;
+	ASSERT_FALSE (context.store->init_error ());
+	auto & store (context.store);
+	auto & ledger (context.ledger);
+	auto & pool (context.pool);
+	ASSERT_FALSE (ledger.pending_amounts_complete (store->tx_begin_read ()));
+	ASSERT_EQ (0, ledger.pending_amounts_build ());
+	ledger.pending_amounts = true;
+	ASSERT_TRUE (ledger.pending_amounts_complete (store->tx_begin_read ()));
+
+	scendere::keypair key;
+	scendere::state_block_builder builder;
+	std::vector<std::shared_ptr<scendere::block>> sends;
+	auto balance (scendere::dev::constants.genesis_amount);
+	for (auto amount : { 1, 100, 10 })
+	{
+		auto previous (sends.empty () ? scendere::dev::genesis->hash () : sends.back ()->hash ());
+		balance -= amount;
+		sends.push_back (builder.make_block ()
+						 .account (scendere::dev::genesis->account ())
+						 .previous (previous)
+						 .representative (scendere::dev::genesis->account ())
+						 .balance (balance)
+						 .link (key.pub)
+						 .sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+						 .work (*pool.generate (previous))
+						 .build ());
+		ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *sends.back ()).code);
+	}
+	auto amounts = [&] (scendere::uint128_t const & minimum_a, size_t max_a = std::numeric_limits<size_t>::max ()) {
+		std::vector<scendere::uint128_t> result;
+		ledger.receivable_for_each (store->tx_begin_read (), key.pub, minimum_a, [&] (scendere::pending_key const & key_a, scendere::pending_info const & info_a) {
+			EXPECT_EQ (key.pub, key_a.account);
+			result.push_back (info_a.amount.number ());
+			return result.size () < max_a;
+		});
+		return result;
+	};
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100, 10, 1 }), amounts (0));
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100, 10 }), amounts (10));
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100 }), amounts (0, 1));
+	ASSERT_TRUE (amounts (101).empty ());
+
+	// Receiving removes the entry, rolling the receive back restores it
+	auto open = builder.make_block ()
+				.account (key.pub)
+				.previous (0)
+				.representative (key.pub)
+				.balance (100)
+				.link (sends[1]->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	ASSERT_EQ (scendere::process_result::progress, ledger.process (store->tx_begin_write (), *open).code);
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 10, 1 }), amounts (0));
+	ASSERT_FALSE (ledger.rollback (store->tx_begin_write (), open->hash ()));
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100, 10, 1 }), amounts (0));
+
+	// Rolling back a send removes its entry
+	ASSERT_FALSE (ledger.rollback (store->tx_begin_write (), sends[2]->hash ()));
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100, 1 }), amounts (0));
+	ASSERT_EQ (2, ledger.pending_amounts_build ());
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100, 1 }), amounts (0));
+
+	// Without the index entries are filtered from the pending table
+	ledger.pending_amounts = false;
+	ASSERT_EQ ((std::vector<scendere::uint128_t>{ 100 }), amounts (2));
+}
@@ -1,3 +1,4 @@
+#include <scendere/crypto_lib/random_pool.hpp>
 #include <scendere/node/nodeconfig.hpp>
 #include <scendere/node/transport/udp.hpp>
 #include <scendere/test_common/network.hpp>
@@ -1064,6 +1065,77 @@ TEST (network, bandwidth_limiter)
 	node.stop ();
 }
 
+TEST (network, bandwidth_limiter_priority)
+{
+	// 1600 byte bursts at 160 bytes/s, classes hold one second of their share: keepalives 10 bytes, publishes 30 and final votes 40 out of 160
+	scendere::bandwidth_limiter limiter (10.0, 160);
+	ASSERT_EQ (10, limiter.burst (scendere::bandwidth_limit_type::keepalive));
+	// Idle capacity above the shares of the other classes can be borrowed by any class
+	ASSERT_FALSE (limiter.should_drop (1400, scendere::bandwidth_limit_type::keepalive));
+	ASSERT_TRUE (limiter.should_drop (100, scendere::bandwidth_limit_type::keepalive));
+	ASSERT_TRUE (limiter.should_drop (250, scendere::bandwidth_limit_type::publish));
+	// Each class still gets its guaranteed share
+	ASSERT_FALSE (limiter.should_drop (10, scendere::bandwidth_limit_type::keepalive));
+	ASSERT_FALSE (limiter.should_drop (40, scendere::bandwidth_limit_type::final_vote));
+	ASSERT_FALSE (limiter.should_drop (30, scendere::bandwidth_limit_type::publish));
+	ASSERT_FALSE (limiter.should_drop (40, scendere::bandwidth_limit_type::vote));
+	ASSERT_FALSE (limiter.should_drop (20, scendere::bandwidth_limit_type::confirm_req));
+	ASSERT_FALSE (limiter.should_drop (20, scendere::bandwidth_limit_type::bootstrap));
+	// The shared bucket is the hard cap, 1560 of its 1600 bytes are used
+	ASSERT_TRUE (limiter.should_drop (80, scendere::bandwidth_limit_type::keepalive));
+	ASSERT_FALSE (limiter.should_drop (40, scendere::bandwidth_limit_type::keepalive));
+	ASSERT_TRUE (limiter.should_drop (20, scendere::bandwidth_limit_type::publish));
+
+	// Unlimited
+	limiter.reset (1.0, 0);
+	ASSERT_FALSE (limiter.should_drop (1000000, scendere::bandwidth_limit_type::bootstrap));
+}
+
+TEST (network, recent_hash_filter)
+{
+	scendere::transport::recent_hash_filter filter;
+	scendere::block_hash hash1 (1);
+	ASSERT_FALSE (filter.contains (hash1));
+	filter.insert (hash1);
+	ASSERT_TRUE (filter.contains (hash1));
+	// Entries survive one generation rotation and age out after the second
+	for (std::size_t i (0); i < scendere::transport::recent_hash_filter::generation_capacity; ++i)
+	{
+		scendere::block_hash hash;
+		scendere::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		filter.insert (hash);
+	}
+	ASSERT_TRUE (filter.contains (hash1));
+	for (std::size_t i (0); i < scendere::transport::recent_hash_filter::generation_capacity; ++i)
+	{
+		scendere::block_hash hash;
+		scendere::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		filter.insert (hash);
+	}
+	ASSERT_FALSE (filter.contains (hash1));
+}
+
+TEST (network, relay_skips_known_peers)
+{
+	scendere::system system (2);
+	auto & node1 (*system.nodes[0]);
+	auto & node2 (*system.nodes[1]);
+	auto channel (node1.network.find_node_id (node2.node_id.pub));
+	ASSERT_NE (nullptr, channel);
+	// The only peer already has the block, so relaying it sends nothing
+	channel->set_known (scendere::dev::genesis->hash ());
+	node1.network.relay_block (scendere::dev::genesis);
+	ASSERT_EQ (1, node1.stats.count (scendere::stat::type::filter, scendere::stat::detail::flood_known_by_peer, scendere::stat::dir::out));
+	ASSERT_EQ (0, node1.stats.count (scendere::stat::type::message, scendere::stat::detail::publish, scendere::stat::dir::out));
+	// Explicit floods are not filtered and mark the peer as knowing the block
+	scendere::keypair key;
+	auto block (std::make_shared<scendere::send_block> (1, key.pub, 2, key.prv, key.pub, 0));
+	ASSERT_FALSE (channel->is_known (block->hash ()));
+	node1.network.flood_block (block);
+	ASSERT_TRUE (channel->is_known (block->hash ()));
+	ASSERT_EQ (1, node1.stats.count (scendere::stat::type::message, scendere::stat::detail::publish, scendere::stat::dir::out));
+}
+
 namespace scendere
 {
 TEST (peer_exclusion, validate)
@@ -1156,6 +1228,29 @@ TEST (network, tcp_no_connect_excluded_peers)
 	ASSERT_TIMELY (5s, node0->network.size () == 1);
 }
 
+TEST (network, tcp_channels_snapshot)
+{
+	scendere::system system (2);
+	auto node0 (system.nodes[0]);
+	auto node1 (system.nodes[1]);
+	ASSERT_TIMELY (5s, node0->network.tcp_channels.snapshot ()->node_ids.count (node1->node_id.pub) == 1);
+	auto snapshot (node0->network.tcp_channels.snapshot ());
+	ASSERT_EQ (1, snapshot->channels.size ());
+	auto channel (snapshot->channels.front ());
+	ASSERT_EQ (channel, snapshot->endpoints.at (channel->get_tcp_endpoint ()));
+	ASSERT_EQ (channel, node0->network.tcp_channels.find_node_id (node1->node_id.pub));
+	ASSERT_EQ (channel, node0->network.tcp_channels.find_channel (channel->get_tcp_endpoint ()));
+	node0->network.tcp_channels.erase (channel->get_tcp_endpoint ());
+	// Readers holding the previous snapshot are unaffected
+	ASSERT_EQ (1, snapshot->channels.size ());
+	ASSERT_EQ (0, node0->network.tcp_channels.size ());
+	ASSERT_EQ (nullptr, node0->network.tcp_channels.find_node_id (node1->node_id.pub));
+	ASSERT_EQ (nullptr, node0->network.tcp_channels.find_channel (channel->get_tcp_endpoint ()));
+	std::deque<std::shared_ptr<scendere::transport::channel>> list;
+	node0->network.tcp_channels.list (list);
+	ASSERT_TRUE (list.empty ());
+}
+
 namespace scendere
 {
 TEST (network, tcp_message_manager)
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 TEST (network_filter, unit)
 {
 	scendere::network_filter filter (1);
@@ -126,3 +128,55 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+TEST (network_filter, bucket)
+{
+	// A single bucket of four slots keeps four distinct digests alive at once
+	scendere::network_filter filter (4, 4);
+	std::vector<std::vector<uint8_t>> items{ { 1 }, { 2 }, { 3 }, { 4 } };
+	for (auto const & item : items)
+	{
+		ASSERT_FALSE (filter.apply (item.data (), item.size ()));
+	}
+	for (auto const & item : items)
+	{
+		ASSERT_TRUE (filter.apply (item.data (), item.size ()));
+	}
+	filter.clear (items[2].data (), items[2].size ());
+	ASSERT_TRUE (filter.apply (items[0].data (), items[0].size ()));
+	ASSERT_FALSE (filter.apply (items[2].data (), items[2].size ()));
+	filter.clear ();
+	for (auto const & item : items)
+	{
+		ASSERT_FALSE (filter.apply (item.data (), item.size ()));
+	}
+}
+
+TEST (network_filter, concurrent)
+{
+	scendere::network_filter filter (1024 * 1024, 4);
+	size_t const thread_count (4);
+	uint32_t const item_count (10000);
+	std::atomic<size_t> duplicates{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t i (0); i < thread_count; ++i)
+	{
+		threads.emplace_back ([&filter, &duplicates, i, item_count] () {
+			for (uint32_t j (0); j < item_count; ++j)
+			{
+				// Every thread applies the same items, in a different order
+				uint32_t value ((j * static_cast<uint32_t> (i + 1)) % item_count);
+				if (filter.apply (reinterpret_cast<uint8_t const *> (&value), sizeof (value)))
+				{
+					++duplicates;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	// Thread 0 covers every value, so each distinct value is unique exactly once across all threads
+	ASSERT_EQ ((thread_count - 1) * item_count, duplicates.load ());
+}
@@ -2058,6 +2058,61 @@ TEST (node, bootstrap_connection_scaling)
 	ASSERT_EQ (1, node1.bootstrap_initiator.connections->target_connections (50000, 1));
 }
 
+TEST (node, bootstrap_connection_ingest_scaling)
+{
+	scendere::system system (1);
+	// A separate instance, the node's own connections are scaled by its populate timer
+	auto connections_l (std::make_shared<scendere::bootstrap_connections> (*system.nodes[0]));
+	auto & connections (*connections_l);
+	auto now (std::chrono::steady_clock::now ());
+	auto window (scendere::bootstrap_connections::ingest_window);
+	// Starts from the floor and holds until a window has passed
+	ASSERT_EQ (4, connections.ingest_target (4, 64, 100.0, now));
+	ASSERT_EQ (4, connections.ingest_target (4, 64, 1000.0, now + window / 2));
+	// Rising rate adds connections, a plateau holds them
+	ASSERT_EQ (5, connections.ingest_target (4, 64, 1000.0, now += window));
+	ASSERT_EQ (6, connections.ingest_target (4, 64, 2000.0, now += window));
+	ASSERT_EQ (6, connections.ingest_target (4, 64, 2050.0, now += window));
+	// Falling rate removes connections down to the floor
+	ASSERT_EQ (5, connections.ingest_target (4, 64, 1000.0, now += window));
+	ASSERT_EQ (4, connections.ingest_target (4, 64, 500.0, now += window));
+	ASSERT_EQ (4, connections.ingest_target (4, 64, 100.0, now += window));
+	// Pending pulls bound the target
+	ASSERT_EQ (2, connections.ingest_target (1, 2, 100000.0, now += window));
+}
+
+TEST (node, bootstrap_peer_scores)
+{
+	scendere::bootstrap_peer_scores scores;
+	scendere::tcp_endpoint fast (boost::asio::ip::address_v6::loopback (), 1000);
+	scendere::tcp_endpoint slow (boost::asio::ip::address_v6::loopback (), 1001);
+	ASSERT_FALSE (scores.score (fast));
+	// Failures are not counted for peers without samples, so no entry is created
+	scores.failure (fast);
+	ASSERT_EQ (0, scores.size ());
+	ASSERT_EQ (0.0, scores.average ());
+	scores.sample_rate (fast, 1000.0);
+	scores.sample_rate (slow, 100.0);
+	ASSERT_TRUE (scores.score (fast));
+	ASSERT_GT (*scores.score (fast), *scores.score (slow));
+	// Unmeasured peers are ranked with the average, between the fast and the slow peer
+	ASSERT_DOUBLE_EQ (550.0, scores.average ());
+	scores.sample_rate (fast, 0.0);
+	ASSERT_DOUBLE_EQ (750.0, scores.list ().front ().block_rate);
+	scores.failure (fast);
+	scores.failure (fast);
+	scores.sample_latency (fast, std::chrono::seconds (1));
+	// 750 blocks per second, halved by latency and divided by three by failures
+	ASSERT_DOUBLE_EQ (125.0, *scores.score (fast));
+	auto list (scores.list ());
+	ASSERT_EQ (2, list.size ());
+	ASSERT_EQ (fast, list[0].endpoint);
+	ASSERT_EQ (2, list[0].failures);
+	// Serving blocks clears failures
+	scores.sample_rate (fast, 750.0);
+	ASSERT_EQ (0, scores.list ()[0].failures);
+}
+
 // Test stat counting at both type and detail levels
 TEST (node, stat_counting)
 {
@@ -3362,6 +3417,40 @@ TEST (node, dont_write_lock_node)
 	finished_promise.set_value ();
 }
 
+// Command line tools run writable inactive nodes, which must not leave a usable ledger cache snapshot behind
+TEST (node, ledger_cache_snapshot_inactive)
+{
+	auto path (scendere::unique_path ());
+	auto snapshot (path / "ledger_cache.snapshot");
+	auto node_flags (scendere::inactive_node_flag_defaults ());
+	node_flags.read_only = false;
+	{
+		scendere::inactive_node node (path, node_flags);
+		ASSERT_FALSE (node.node->init_error ());
+	}
+	ASSERT_FALSE (boost::filesystem::exists (snapshot));
+	{
+		scendere::system system;
+		auto node (std::make_shared<scendere::node> (system.io_ctx, path, scendere::node_config (scendere::get_available_port (), system.logging), system.work));
+		ASSERT_FALSE (node->init_error ());
+		node->stop ();
+	}
+	// The snapshot saved by a regular node is left alone and made stale by the command line write
+	{
+		scendere::inactive_node node (path, node_flags);
+		node.node->store.peer.clear (node.node->store.tx_begin_write ());
+	}
+	scendere::logger_mt logger;
+	auto store = scendere::make_store (logger, path, scendere::dev::constants);
+	ASSERT_FALSE (store->init_error ());
+	scendere::stat stats;
+	scendere::generate_cache generate_cache;
+	generate_cache.reps = generate_cache.cemented_count = generate_cache.account_count = generate_cache.block_count = false;
+	scendere::ledger ledger (*store, stats, scendere::dev::constants, generate_cache, snapshot);
+	ASSERT_EQ (0, ledger.cache.block_count);
+	ASSERT_EQ (0, ledger.cache.cemented_count);
+}
+
 TEST (node, bidirectional_tcp)
 {
 #ifdef _WIN32
@@ -115,6 +115,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	std::stringstream ss;
 	ss << R"toml(
 	[node]
+	[node.diagnostics.store_latency]
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
@@ -160,6 +161,9 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_EQ (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_EQ (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
+	ASSERT_EQ (conf.node.enable_account_height_index, defaults.node.enable_account_height_index);
+	ASSERT_EQ (conf.node.enable_delegator_index, defaults.node.enable_delegator_index);
+	ASSERT_EQ (conf.node.enable_receivable_amount_index, defaults.node.enable_receivable_amount_index);
 	ASSERT_EQ (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
@@ -238,6 +242,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
+	ASSERT_EQ (conf.node.diagnostics_config.store_latency.enable, defaults.node.diagnostics_config.store_latency.enable);
+	ASSERT_EQ (conf.node.diagnostics_config.store_latency.sample_interval, defaults.node.diagnostics_config.store_latency.sample_interval);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.min_read_txn_time, defaults.node.diagnostics_config.txn_tracking.min_read_txn_time);
@@ -256,6 +262,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_EQ (conf.node.lmdb_config.read_transaction_staleness, defaults.node.lmdb_config.read_transaction_staleness);
 
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
@@ -402,6 +409,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	bootstrap_fraction_numerator = 999
 	conf_height_processor_batch_min_time = 999
 	confirmation_history_size = 999
+	enable_account_height_index = true
+	enable_delegator_index = true
+	enable_receivable_amount_index = true
 	enable_voting = false
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
@@ -430,6 +440,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
 	frontiers_confirmation = "always"
+	[node.diagnostics.store_latency]
+	enable = true
+	sample_interval = 999
+
 	[node.diagnostics.txn_tracking]
 	enable = true
 	ignore_writes_below_block_processor_max_time = false
@@ -510,6 +524,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	sync = "nosync_safe"
 	max_databases = 999
 	map_size = 999
+	read_transaction_staleness = 999
 
 	[node.rocksdb]
 	enable = true
@@ -566,6 +581,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_NE (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_NE (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
+	ASSERT_NE (conf.node.enable_account_height_index, defaults.node.enable_account_height_index);
+	ASSERT_NE (conf.node.enable_delegator_index, defaults.node.enable_delegator_index);
+	ASSERT_NE (conf.node.enable_receivable_amount_index, defaults.node.enable_receivable_amount_index);
 	ASSERT_NE (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
@@ -647,6 +665,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
+	ASSERT_NE (conf.node.diagnostics_config.store_latency.enable, defaults.node.diagnostics_config.store_latency.enable);
+	ASSERT_NE (conf.node.diagnostics_config.store_latency.sample_interval, defaults.node.diagnostics_config.store_latency.sample_interval);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.min_read_txn_time, defaults.node.diagnostics_config.txn_tracking.min_read_txn_time);
@@ -665,6 +685,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_NE (conf.node.lmdb_config.read_transaction_staleness, defaults.node.lmdb_config.read_transaction_staleness);
 
 	ASSERT_TRUE (conf.node.rocksdb_config.enable);
 	ASSERT_EQ (scendere::rocksdb_config::using_rocksdb_in_tests (), defaults.node.rocksdb_config.enable);
@@ -680,6 +701,7 @@ TEST (toml, daemon_config_no_required)
 	// A config with no values, only categories
 	ss << R"toml(
 	[node]
+	[node.diagnostics.store_latency]
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
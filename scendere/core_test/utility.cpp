@@ -85,6 +85,33 @@ TEST (rate, reset)
 	ASSERT_TRUE (bucket.try_consume (1000000));
 }
 
+TEST (rate, consume_leaving)
+{
+	scendere::rate::token_bucket bucket (10, 1);
+	ASSERT_EQ (10, bucket.capacity ());
+	ASSERT_FALSE (bucket.try_consume_leaving (7, 4));
+	ASSERT_EQ (10, bucket.available ());
+	ASSERT_TRUE (bucket.try_consume_leaving (6, 4));
+	ASSERT_EQ (4, bucket.available ());
+	ASSERT_FALSE (bucket.try_consume_leaving (1, 4));
+	ASSERT_TRUE (bucket.try_consume (4));
+
+	// Unlimited buckets never hold back
+	bucket.reset (0, 0);
+	ASSERT_TRUE (bucket.try_consume_leaving (1000000, 1000000000));
+}
+
+TEST (rate, refund)
+{
+	scendere::rate::token_bucket bucket (10, 1);
+	ASSERT_TRUE (bucket.try_consume (6));
+	bucket.refund (4);
+	ASSERT_EQ (8, bucket.available ());
+	// Never filled above capacity
+	bucket.refund (5);
+	ASSERT_EQ (10, bucket.available ());
+}
+
 TEST (rate, unlimited)
 {
 	scendere::rate::token_bucket bucket (0, 0);
@@ -0,0 +1,93 @@
+#include <scendere/lib/logger_mt.hpp>
+#include <scendere/lib/stats.hpp>
+#include <scendere/node/write_coordinator.hpp>
+#include <scendere/secure/store.hpp>
+#include <scendere/secure/utility.hpp>
+#include <scendere/test_common/system.hpp>
+#include <scendere/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+class context
+{
+public:
+	context () :
+		store{ scendere::make_store (logger, scendere::unique_path (), scendere::dev::constants) },
+		write_coordinator{ *store, stats }
+	{
+	}
+	scendere::logger_mt logger;
+	std::unique_ptr<scendere::store> store;
+	scendere::stat stats;
+	scendere::write_coordinator write_coordinator;
+};
+}
+
+// Writes queued while a round is being written are committed together in the next round, taking turns between writers
+TEST (write_coordinator, group_commit)
+{
+	context context;
+	ASSERT_FALSE (context.store->init_error ());
+	std::promise<void> release;
+	auto released (release.get_future ().share ());
+	auto blocking (context.write_coordinator.submit (scendere::writer::testing, {}, [released] (scendere::write_transaction const &) {
+		released.wait ();
+	}));
+	ASSERT_TIMELY (5s, context.write_coordinator.size () == 0);
+	std::vector<scendere::writer> order;
+	auto record = [&order] (scendere::writer writer_a) {
+		return [&order, writer_a] (scendere::write_transaction const &) { order.push_back (writer_a); };
+	};
+	std::vector<std::future<void>> written;
+	for (auto i (0); i < 3; ++i)
+	{
+		written.push_back (context.write_coordinator.submit (scendere::writer::unchecked, { scendere::tables::unchecked }, record (scendere::writer::unchecked)));
+	}
+	written.push_back (context.write_coordinator.submit (scendere::writer::final_votes, { scendere::tables::final_votes }, record (scendere::writer::final_votes)));
+	ASSERT_EQ (4, context.write_coordinator.size ());
+	release.set_value ();
+	for (auto & future : written)
+	{
+		ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	}
+	context.write_coordinator.flush ();
+	ASSERT_EQ (2, context.stats.count (scendere::stat::type::write_coordinator, scendere::stat::detail::commit));
+	ASSERT_EQ (5, context.stats.count (scendere::stat::type::write_coordinator, scendere::stat::detail::operations));
+	std::vector<scendere::writer> expected{ scendere::writer::unchecked, scendere::writer::final_votes, scendere::writer::unchecked, scendere::writer::unchecked };
+	ASSERT_EQ (expected, order);
+}
+
+TEST (write_coordinator, stopped)
+{
+	context context;
+	ASSERT_FALSE (context.store->init_error ());
+	context.write_coordinator.stop ();
+	auto written (false);
+	auto future (context.write_coordinator.submit (scendere::writer::testing, {}, [&written] (scendere::write_transaction const &) { written = true; }));
+	ASSERT_EQ (std::future_status::ready, future.wait_for (0s));
+	ASSERT_TRUE (written);
+}
+
+// Batch writes are given the budget of their writer, measured from the start of their turn
+TEST (write_coordinator, batch_deadline)
+{
+	context context;
+	ASSERT_FALSE (context.store->init_error ());
+	std::chrono::steady_clock::time_point deadline;
+	auto before (std::chrono::steady_clock::now ());
+	auto future (context.write_coordinator.submit (
+	scendere::writer::confirmation_height, { scendere::tables::confirmation_height }, [&deadline] (scendere::write_transaction const &, std::chrono::steady_clock::time_point deadline_a) {
+		deadline = deadline_a;
+	},
+	250ms));
+	ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	ASSERT_GE (deadline, before + 250ms);
+	ASSERT_LE (deadline, std::chrono::steady_clock::now () + 250ms);
+	ASSERT_EQ (1, context.stats.count (scendere::stat::type::write_coordinator, scendere::stat::detail::operations));
+}
@@ -1,5 +1,15 @@
 #include <scendere/lib/asio.hpp>
 
+#ifdef SCENDERE_IO_URING
+#include <liburing.h>
+
+#include <array>
+#include <climits>
+#include <iostream>
+
+#include <unistd.h>
+#endif
+
 scendere::shared_const_buffer::shared_const_buffer (std::vector<uint8_t> const & data) :
 	m_data (std::make_shared<std::vector<uint8_t>> (data)),
 	m_buffer (boost::asio::buffer (*m_data))
@@ -43,3 +53,57 @@ std::size_t scendere::shared_const_buffer::size () const
 {
 	return m_buffer.size ();
 }
+
+char const * scendere::asio_backend ()
+{
+#if defined(SCENDERE_IO_URING)
+	return "io_uring";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+	return "iocp";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+	return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+	return "kqueue";
+#else
+	return "select";
+#endif
+}
+
+bool scendere::asio_backend_supported ()
+{
+#ifdef SCENDERE_IO_URING
+	// Kernels older than 5.1, or with io_uring disabled through sysctl or seccomp, fail to create a ring
+	io_uring ring;
+	auto result (io_uring_queue_init (8, &ring, 0) == 0);
+	if (result)
+	{
+		io_uring_queue_exit (&ring);
+	}
+	return result;
+#else
+	return true;
+#endif
+}
+
+void scendere::asio_backend_fallback (char * const * argv)
+{
+#ifdef SCENDERE_IO_URING
+	if (!asio_backend_supported ())
+	{
+		// Asio selects its reactor at compile time, builds with SCENDERE_IO_URING_FALLBACK have an epoll build of each program next to it
+		std::array<char, PATH_MAX> path{};
+		auto length (readlink ("/proc/self/exe", path.data (), path.size () - 1));
+		if (length > 0)
+		{
+			std::string fallback (path.data (), static_cast<std::size_t> (length));
+			fallback += "_epoll";
+			if (access (fallback.c_str (), X_OK) == 0)
+			{
+				std::cerr << "The running kernel does not support io_uring, running " << fallback << std::endl;
+				// Only returns on failure
+				execv (fallback.c_str (), argv);
+			}
+		}
+	}
+#endif
+}
@@ -28,6 +28,15 @@ private:
 
 static_assert (boost::asio::is_const_buffer_sequence<shared_const_buffer>::value, "Not ConstBufferSequence compliant");
 
+/** Name of the reactor boost::asio uses for socket operations in this build */
+char const * asio_backend ();
+
+/** Returns false when this build requires io_uring and the running kernel does not provide it */
+bool asio_backend_supported ();
+
+/** Replaces the process with the epoll build of the same program when io_uring is required but not supported, returns if there is none */
+void asio_backend_fallback (char * const * argv);
+
 template <typename AsyncWriteStream, typename WriteHandler>
 BOOST_ASIO_INITFN_RESULT_TYPE (WriteHandler, void (boost::system::error_code, std::size_t))
 async_write (AsyncWriteStream & s, scendere::shared_const_buffer const & buffer, WriteHandler && handler)
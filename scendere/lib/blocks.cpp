@@ -1855,6 +1855,75 @@ bool scendere::block_sideband::deserialize (scendere::stream & stream_a, scender
 	return result;
 }
 
+void scendere::block_sideband::serialize_compact (scendere::stream & stream_a, scendere::block_type type_a) const
+{
+	scendere::write (stream_a, successor.bytes);
+	if (type_a != scendere::block_type::state && type_a != scendere::block_type::open)
+	{
+		scendere::write (stream_a, account.bytes);
+	}
+	if (type_a != scendere::block_type::open)
+	{
+		scendere::write_varint (stream_a, height);
+	}
+	if (type_a == scendere::block_type::receive || type_a == scendere::block_type::change || type_a == scendere::block_type::open)
+	{
+		scendere::write (stream_a, balance.bytes);
+	}
+	scendere::write_varint (stream_a, timestamp);
+	if (type_a == scendere::block_type::state)
+	{
+		details.serialize (stream_a);
+		if (details.is_receive)
+		{
+			scendere::write (stream_a, static_cast<uint8_t> (source_epoch));
+		}
+	}
+}
+
+bool scendere::block_sideband::deserialize_compact (scendere::stream & stream_a, scendere::block_type type_a)
+{
+	bool result (false);
+	try
+	{
+		scendere::read (stream_a, successor.bytes);
+		if (type_a != scendere::block_type::state && type_a != scendere::block_type::open)
+		{
+			scendere::read (stream_a, account.bytes);
+		}
+		if (type_a != scendere::block_type::open)
+		{
+			result = scendere::try_read_varint (stream_a, height);
+		}
+		else
+		{
+			height = 1;
+		}
+		if (type_a == scendere::block_type::receive || type_a == scendere::block_type::change || type_a == scendere::block_type::open)
+		{
+			scendere::read (stream_a, balance.bytes);
+		}
+		result = result || scendere::try_read_varint (stream_a, timestamp);
+		if (!result && type_a == scendere::block_type::state)
+		{
+			result = details.deserialize (stream_a);
+			source_epoch = scendere::epoch::epoch_0;
+			if (!result && details.is_receive)
+			{
+				uint8_t source_epoch_uint8_t{ 0 };
+				scendere::read (stream_a, source_epoch_uint8_t);
+				source_epoch = static_cast<scendere::epoch> (source_epoch_uint8_t);
+			}
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+
+	return result;
+}
+
 std::shared_ptr<scendere::block> scendere::block_uniquer::unique (std::shared_ptr<scendere::block> const & block_a)
 {
 	auto result (block_a);
@@ -62,6 +62,10 @@ public:
 	block_sideband (scendere::account const &, scendere::block_hash const &, scendere::amount const &, uint64_t const, uint64_t const, scendere::epoch const epoch_a, bool const is_send, bool const is_receive, bool const is_epoch, scendere::epoch const source_epoch_a);
 	void serialize (scendere::stream &, scendere::block_type) const;
 	bool deserialize (scendere::stream &, scendere::block_type);
+	/** Variable length layout used by the block store since version 25. The successor stays first so it can still be updated in place, height and timestamp are varints and the source epoch is only stored for receives */
+	void serialize_compact (scendere::stream &, scendere::block_type) const;
+	bool deserialize_compact (scendere::stream &, scendere::block_type);
+	/** Size of the fixed layout written by serialize */
 	static size_t size (scendere::block_type);
 	scendere::block_hash successor{ 0 };
 	scendere::account account{};
@@ -275,9 +275,11 @@ public:
 	/** Initial value is ACTIVE_NETWORK compile flag, but can be overridden by a CLI flag */
 	static scendere::networks active_network;
 	/** Current protocol version */
-	uint8_t const protocol_version = 0x12;
+	uint8_t const protocol_version = 0x13;
 	/** Minimum accepted protocol version */
 	uint8_t const protocol_version_min = 0x12;
+	/** Minimum protocol version of peers that stop frontier requests at the requested end account */
+	uint8_t const frontier_req_end_version_min = 0x13;
 };
 
 std::string get_node_toml_config_path (boost::filesystem::path const & data_path);
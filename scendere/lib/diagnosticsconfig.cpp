@@ -9,6 +9,11 @@ scendere::error scendere::diagnostics_config::serialize_toml (scendere::tomlconf
 	txn_tracking_l.put ("min_write_txn_time", txn_tracking.min_write_txn_time.count (), "Log stacktrace when write transactions are held longer than this duration.\ntype:milliseconds");
 	txn_tracking_l.put ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time, "Ignore any block processor writes less than block_processor_batch_max_time.\ntype:bool");
 	toml.put_child ("txn_tracking", txn_tracking_l);
+
+	scendere::tomlconfig store_latency_l;
+	store_latency_l.put ("enable", store_latency.enable, "Enable or disable per table database operation counters and latency histograms, reported by the stats RPC.\ntype:bool");
+	store_latency_l.put ("sample_interval", store_latency.sample_interval, "Time one in this many database operations. Lower values are more accurate but add overhead to every operation.\ntype:uint32,[1..]");
+	toml.put_child ("store_latency", store_latency_l);
 	return toml.get_error ();
 }
 
@@ -28,5 +33,16 @@ scendere::error scendere::diagnostics_config::deserialize_toml (scendere::tomlco
 
 		txn_tracking_l->get_optional<bool> ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time);
 	}
+
+	auto store_latency_l (toml.get_optional_child ("store_latency"));
+	if (store_latency_l)
+	{
+		store_latency_l->get_optional<bool> ("enable", store_latency.enable);
+		store_latency_l->get_optional ("sample_interval", store_latency.sample_interval);
+		if (store_latency.sample_interval == 0)
+		{
+			toml.get_error ().set ("store_latency.sample_interval must be at least 1");
+		}
+	}
 	return toml.get_error ();
 }
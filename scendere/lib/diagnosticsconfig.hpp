@@ -18,6 +18,15 @@ public:
 	bool ignore_writes_below_block_processor_max_time{ true };
 };
 
+class store_latency_config final
+{
+public:
+	/** If true, count store operations per table and collect their latency histograms */
+	bool enable{ false };
+	/** Time one in this many operations, counts always include every operation */
+	unsigned sample_interval{ 16 };
+};
+
 /** Configuration options for diagnostics information */
 class diagnostics_config final
 {
@@ -26,5 +35,6 @@ public:
 	scendere::error deserialize_toml (scendere::tomlconfig &);
 
 	txn_tracking_config txn_tracking;
+	store_latency_config store_latency;
 };
 }
@@ -26,6 +26,7 @@ scendere::error scendere::lmdb_config::serialize_toml (scendere::tomlconfig & to
 	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.scendere.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
+	toml.put ("read_transaction_staleness", read_transaction_staleness.count (), "How long cached read transactions used for single lookups may keep reading an older snapshot. Longer windows save snapshot renewals but keep old pages from being reused.\ntype:milliseconds");
 	return toml.get_error ();
 }
 
@@ -34,6 +35,9 @@ scendere::error scendere::lmdb_config::deserialize_toml (scendere::tomlconfig &
 	auto default_max_databases = max_databases;
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
+	auto read_transaction_staleness_l (read_transaction_staleness.count ());
+	toml.get_optional ("read_transaction_staleness", read_transaction_staleness_l);
+	read_transaction_staleness = std::chrono::milliseconds (read_transaction_staleness_l);
 
 	if (!toml.get_error ())
 	{
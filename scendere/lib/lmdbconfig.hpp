@@ -2,6 +2,7 @@
 
 #include <scendere/lib/errors.hpp>
 
+#include <chrono>
 #include <thread>
 
 namespace scendere
@@ -46,5 +47,7 @@ public:
 	sync_strategy sync{ always };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 256ULL * 1024 * 1024 * 1024 };
+	/** How long a thread's cached read transaction may keep its snapshot between reads, zero takes a new snapshot for every read */
+	std::chrono::milliseconds read_transaction_staleness{ 0 };
 };
 }
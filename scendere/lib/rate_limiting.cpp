@@ -30,6 +30,39 @@ bool scendere::rate::token_bucket::try_consume (unsigned tokens_required_a)
 	return possible || refill_rate == 1e9;
 }
 
+bool scendere::rate::token_bucket::try_consume_leaving (unsigned tokens_required_a, size_t reserve_a)
+{
+	debug_assert (tokens_required_a <= 1e9);
+	scendere::lock_guard<scendere::mutex> lk (bucket_mutex);
+	refill ();
+	bool possible = current_size >= tokens_required_a + reserve_a;
+	if (possible)
+	{
+		current_size -= tokens_required_a;
+	}
+	smallest_size = std::min (smallest_size, current_size);
+	return possible || refill_rate == 1e9;
+}
+
+void scendere::rate::token_bucket::refund (unsigned tokens_a)
+{
+	scendere::lock_guard<scendere::mutex> lk (bucket_mutex);
+	current_size = std::min (current_size + tokens_a, max_token_count);
+}
+
+size_t scendere::rate::token_bucket::available ()
+{
+	scendere::lock_guard<scendere::mutex> lk (bucket_mutex);
+	refill ();
+	return current_size;
+}
+
+size_t scendere::rate::token_bucket::capacity () const
+{
+	scendere::lock_guard<scendere::mutex> lk (bucket_mutex);
+	return max_token_count;
+}
+
 void scendere::rate::token_bucket::refill ()
 {
 	auto now (std::chrono::steady_clock::now ());
@@ -38,6 +38,21 @@ namespace rate
 		 */
 		bool try_consume (unsigned tokens_required_a = 1);
 
+		/**
+		 * Like try_consume, but only succeeds if at least \p reserve_a tokens are left in the bucket afterwards.
+		 * This lets an operation borrow capacity while keeping tokens set aside for others.
+		 */
+		bool try_consume_leaving (unsigned tokens_required_a, size_t reserve_a);
+
+		/** Returns \p tokens_a taken by an operation which did not go ahead, the bucket is never filled above its capacity */
+		void refund (unsigned tokens_a);
+
+		/** Number of tokens currently in the bucket */
+		size_t available ();
+
+		/** Maximum number of tokens in the bucket, no single operation can consume more */
+		size_t capacity () const;
+
 		/** Returns the largest burst observed */
 		size_t largest_burst () const;
 
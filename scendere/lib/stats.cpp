@@ -534,6 +534,12 @@ std::string scendere::stat::type_to_string (uint32_t key)
 		case scendere::stat::type::vote_generator:
 			res = "vote_generator";
 			break;
+		case scendere::stat::type::bandwidth_limiter:
+			res = "bandwidth_limiter";
+			break;
+		case scendere::stat::type::write_coordinator:
+			res = "write_coordinator";
+			break;
 	}
 	return res;
 }
@@ -621,6 +627,9 @@ std::string scendere::stat::detail_to_string (stat::detail detail)
 		case scendere::stat::detail::frontier_confirmation_successful:
 			res = "frontier_confirmation_successful";
 			break;
+		case scendere::stat::detail::checkpoint_cemented:
+			res = "checkpoint_cemented";
+			break;
 		case scendere::stat::detail::frontier_req:
 			res = "frontier_req";
 			break;
@@ -642,6 +651,9 @@ std::string scendere::stat::detail_to_string (stat::detail detail)
 		case scendere::stat::detail::initiate_wallet_lazy:
 			res = "initiate_wallet_lazy";
 			break;
+		case scendere::stat::detail::initiate_ascending:
+			res = "initiate_ascending";
+			break;
 		case scendere::stat::detail::insufficient_work:
 			res = "insufficient_work";
 			break;
@@ -855,6 +867,9 @@ std::string scendere::stat::detail_to_string (stat::detail detail)
 		case scendere::stat::detail::duplicate_publish:
 			res = "duplicate_publish";
 			break;
+		case scendere::stat::detail::flood_known_by_peer:
+			res = "flood_known_by_peer";
+			break;
 		case scendere::stat::detail::different_genesis_hash:
 			res = "different_genesis_hash";
 			break;
@@ -888,6 +903,27 @@ std::string scendere::stat::detail_to_string (stat::detail detail)
 		case scendere::stat::detail::generator_spacing:
 			res = "generator_spacing";
 			break;
+		case scendere::stat::detail::final_vote:
+			res = "final_vote";
+			break;
+		case scendere::stat::detail::bootstrap_serving:
+			res = "bootstrap_serving";
+			break;
+		case scendere::stat::detail::bootstrap_serving_delay:
+			res = "bootstrap_serving_delay";
+			break;
+		case scendere::stat::detail::commit:
+			res = "commit";
+			break;
+		case scendere::stat::detail::operations:
+			res = "operations";
+			break;
+		case scendere::stat::detail::batch_size:
+			res = "batch_size";
+			break;
+		case scendere::stat::detail::commit_latency:
+			res = "commit_latency";
+			break;
 		case scendere::stat::detail::invalid_network:
 			res = "invalid_network";
 			break;
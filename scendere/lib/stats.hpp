@@ -241,7 +241,9 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		bandwidth_limiter,
+		write_coordinator
 	};
 
 	/** Optional detail type */
@@ -289,6 +291,7 @@ public:
 		initiate_legacy_age,
 		initiate_lazy,
 		initiate_wallet_lazy,
+		initiate_ascending,
 
 		// bootstrap specific
 		bulk_pull,
@@ -299,6 +302,7 @@ public:
 		bulk_pull_receive_block_failure,
 		bulk_pull_request_failure,
 		bulk_push,
+		checkpoint_cemented,
 		frontier_req,
 		frontier_confirmation_failed,
 		frontier_confirmation_successful,
@@ -384,6 +388,7 @@ public:
 
 		// duplicate
 		duplicate_publish,
+		flood_known_by_peer,
 
 		// telemetry
 		invalid_signature,
@@ -398,7 +403,18 @@ public:
 		generator_broadcasts,
 		generator_replies,
 		generator_replies_discarded,
-		generator_spacing
+		generator_spacing,
+
+		// bandwidth limiter
+		final_vote,
+		bootstrap_serving,
+		bootstrap_serving_delay,
+
+		// write coordinator
+		commit,
+		operations,
+		batch_size,
+		commit_latency
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -51,4 +51,34 @@ inline void write (scendere::stream & stream_a, std::vector<uint8_t> const & val
 	(void)amount_written;
 	debug_assert (amount_written == value_a.size ());
 }
+
+// Write an unsigned integer as a little endian base 128 varint, 7 bits per byte with the high bit set on every byte but the last
+inline void write_varint (scendere::stream & stream_a, uint64_t value_a)
+{
+	while (value_a >= 0x80)
+	{
+		scendere::write (stream_a, static_cast<uint8_t> (value_a | 0x80));
+		value_a >>= 7;
+	}
+	scendere::write (stream_a, static_cast<uint8_t> (value_a));
+}
+
+// Read a varint written by write_varint. Returns true if the stream ended early or the value does not fit in 64 bits
+inline bool try_read_varint (scendere::stream & stream_a, uint64_t & value_a)
+{
+	value_a = 0;
+	auto error (false);
+	auto done (false);
+	for (unsigned shift (0); !done && !error; shift += 7)
+	{
+		uint8_t byte (0);
+		error = shift > 63 || try_read (stream_a, byte);
+		if (!error)
+		{
+			value_a |= static_cast<uint64_t> (byte & 0x7f) << shift;
+			done = (byte & 0x80) == 0;
+		}
+	}
+	return error;
+}
 }
@@ -90,6 +90,12 @@ std::string scendere::thread_role::get_string (scendere::thread_role::name role)
 		case scendere::thread_role::name::unchecked:
 			thread_role_name_string = "Unchecked";
 			break;
+		case scendere::thread_role::name::write_coordinator:
+			thread_role_name_string = "Write coord";
+			break;
+		case scendere::thread_role::name::db_read_sweeper:
+			thread_role_name_string = "DB read sweep";
+			break;
 		default:
 			debug_assert (false && "scendere::thread_role::get_string unhandled thread role");
 	}
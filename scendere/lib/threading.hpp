@@ -42,6 +42,8 @@ namespace thread_role
 		db_parallel_traversal,
 		election_scheduler,
 		unchecked,
+		write_coordinator,
+		db_read_sweeper,
 	};
 
 	/*
@@ -12,14 +12,20 @@
 #include <scendere/test_common/testutil.hpp>
 
 #include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/format.hpp>
 #include <boost/program_options.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <csignal>
+#include <fstream>
 #include <future>
 #include <iomanip>
 #include <random>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
 #if BOOST_VERSION < 107000
 using socket_type = boost::asio::ip::tcp::socket;
@@ -272,6 +278,112 @@ account_info account_info_rpc (boost::asio::io_context & ioc, tcp::resolver::res
 	return account_info;
 }
 
+uint64_t message_count_rpc (boost::asio::io_context & ioc, tcp::resolver::results_type const & results)
+{
+	boost::property_tree::ptree request;
+	request.put ("action", "stats");
+	request.put ("type", "counters");
+
+	uint64_t count (0);
+	auto json = rpc_request (request, ioc, results);
+	for (auto const & entry : json.get_child ("entries"))
+	{
+		if (entry.second.get<std::string> ("type") == "message" && entry.second.get<std::string> ("detail") != "all")
+		{
+			count += entry.second.get<uint64_t> ("value");
+		}
+	}
+	return count;
+}
+
+std::string networking_backend_rpc (boost::asio::io_context & ioc, tcp::resolver::results_type const & results)
+{
+	boost::property_tree::ptree request;
+	request.put ("action", "version");
+	auto json = rpc_request (request, ioc, results);
+	return json.get<std::string> ("networking_backend", "unknown");
+}
+
+class process_usage
+{
+public:
+	double user_seconds{ 0 };
+	/** Kernel time of all threads, including io_uring workers, covers every syscall such as epoll_wait and io_uring_enter */
+	double system_seconds{ 0 };
+	uint64_t syscalls{ 0 };
+	uint64_t context_switches{ 0 };
+};
+
+/** Reads the resource usage of a child process from procfs, only available on Linux */
+boost::optional<process_usage> read_process_usage (int pid)
+{
+	boost::optional<process_usage> result;
+#ifdef __linux__
+	auto proc (boost::filesystem::path ("/proc") / std::to_string (pid));
+	std::ifstream stat_file ((proc / "stat").string ());
+	std::ifstream io_file ((proc / "io").string ());
+	std::ifstream status_file ((proc / "status").string ());
+	if (stat_file && io_file && status_file)
+	{
+		process_usage usage;
+		// utime and stime are fields 14 and 15, the command name in field 2 may contain spaces
+		std::string stat_line;
+		std::getline (stat_file, stat_line);
+		auto command_end (stat_line.rfind (')'));
+		if (command_end != std::string::npos)
+		{
+			std::istringstream fields (stat_line.substr (command_end + 1));
+			std::string field;
+			for (auto i (3); i < 14 && fields >> field; ++i)
+			{
+			}
+			uint64_t utime (0);
+			uint64_t stime (0);
+			fields >> utime >> stime;
+			usage.user_seconds = static_cast<double> (utime) / sysconf (_SC_CLK_TCK);
+			usage.system_seconds = static_cast<double> (stime) / sysconf (_SC_CLK_TCK);
+		}
+		// Only counts read and write style syscalls, the cost of epoll_wait and io_uring_enter is part of the system time
+		std::string key;
+		uint64_t value;
+		while (io_file >> key >> value)
+		{
+			if (key == "syscr:" || key == "syscw:")
+			{
+				usage.syscalls += value;
+			}
+		}
+		std::string line;
+		while (std::getline (status_file, line))
+		{
+			std::istringstream line_stream (line);
+			if (line_stream >> key >> value && (key == "voluntary_ctxt_switches:" || key == "nonvoluntary_ctxt_switches:"))
+			{
+				usage.context_switches += value;
+			}
+		}
+		result = usage;
+	}
+#endif
+	return result;
+}
+
+void print_usage (boost::asio::io_context & ioc, tcp::resolver::results_type const & results, boost::process::child const & node, int index)
+{
+	auto messages (std::max<uint64_t> (message_count_rpc (ioc, results), 1));
+	// The node may be a different build than this program
+	auto backend (networking_backend_rpc (ioc, results));
+	auto usage (read_process_usage (node.id ()));
+	if (usage)
+	{
+		std::cout << boost::str (boost::format ("Node %1% (%2%): %3% messages, %4$.2f user and %5$.2f system cpu seconds (%6$.1f and %7$.1f us/message), %8% read/write syscalls (%9$.2f/message), %10% context switches (%11$.2f/message)\n") % index % backend % messages % usage->user_seconds % usage->system_seconds % (usage->user_seconds * 1000000 / messages) % (usage->system_seconds * 1000000 / messages) % usage->syscalls % (static_cast<double> (usage->syscalls) / messages) % usage->context_switches % (static_cast<double> (usage->context_switches) / messages));
+	}
+	else
+	{
+		std::cout << boost::str (boost::format ("Node %1%: %2% messages, process usage is not available on this platform\n") % index % messages);
+	}
+}
+
 /** This launches a node and fires a lot of send/recieve RPC requests at it (configurable), then other nodes are tested to make sure they observe these blocks as well. */
 int main (int argc, char * const * argv)
 {
@@ -287,7 +399,8 @@ int main (int argc, char * const * argv)
 		("simultaneous_process_calls", boost::program_options::value<int> ()->default_value (20), "Number of simultaneous rpc sends to do")
 		("destination_count", boost::program_options::value<int> ()->default_value (2), "How many destination accounts to choose between")
 		("node_path", boost::program_options::value<std::string> (), "The path to the scendere_node to test")
-		("rpc_path", boost::program_options::value<std::string> (), "The path to the scendere_rpc to test");
+		("rpc_path", boost::program_options::value<std::string> (), "The path to the scendere_rpc to test")
+		("profile_usage", "Print user and system CPU time, read/write syscalls and context switches per network message of each node before stopping it, to compare networking backends. System time includes the cost of epoll_wait and io_uring_enter");
 	// clang-format on
 
 	boost::program_options::variables_map vm;
@@ -306,6 +419,7 @@ int main (int argc, char * const * argv)
 	auto destination_count = vm.find ("destination_count")->second.as<int> ();
 	auto send_count = vm.find ("send_count")->second.as<int> ();
 	auto simultaneous_process_calls = vm.find ("simultaneous_process_calls")->second.as<int> ();
+	auto profile_usage = vm.count ("profile_usage") > 0;
 
 	boost::system::error_code err;
 	auto running_executable_filepath = boost::dll::program_location (err);
@@ -387,7 +501,7 @@ int main (int argc, char * const * argv)
 	tcp::resolver resolver{ ioc };
 	auto const primary_node_results = resolver.resolve ("::1", std::to_string (rpc_port_start));
 
-	std::thread t ([send_count, &ioc, &primary_node_results, &resolver, &node_count, &destination_count] () {
+	std::thread t ([send_count, &ioc, &primary_node_results, &resolver, &node_count, &destination_count, &nodes, profile_usage] () {
 		for (int i = 0; i < node_count; ++i)
 		{
 			keepalive_rpc (ioc, primary_node_results, peering_port_start + i);
@@ -489,10 +603,18 @@ int main (int argc, char * const * argv)
 				}
 			}
 
+			if (profile_usage)
+			{
+				print_usage (ioc, results, *nodes[i], i);
+			}
 			stop_rpc (ioc, results);
 		}
 
 		// Stop main node
+		if (profile_usage)
+		{
+			print_usage (ioc, primary_node_results, *nodes[0], 0);
+		}
 		stop_rpc (ioc, primary_node_results);
 	});
 	scendere::thread_runner runner (ioc, simultaneous_process_calls);
@@ -22,8 +22,8 @@ scendere::active_transactions::active_transactions (scendere::node & node_a, sce
 	scheduler{ node_a.scheduler }, // Move dependencies requiring this circular reference
 	confirmation_height_processor{ confirmation_height_processor_a },
 	node{ node_a },
-	generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, false },
-	final_generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, true },
+	generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, node_a.write_coordinator, false },
+	final_generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, node_a.write_coordinator, true },
 	election_time_to_live{ node_a.network_params.network.is_dev_network () ? 0s : 2s },
 	thread ([this] () {
 		scendere::thread_role::set (scendere::thread_role::name::request_loop);
@@ -814,7 +814,7 @@ scendere::election_insertion_result scendere::active_transactions::insert_impl (
 				debug_assert (!(previous_balance_a.value_or (0) > 0 && block_a->previous ().is_zero ()));
 				if (!previous_balance_a.is_initialized () && !block_a->previous ().is_zero ())
 				{
-					auto transaction (node.store.tx_begin_read ());
+					auto transaction (node.store.tx_begin_read_cached ());
 					if (node.store.block.exists (transaction, block_a->previous ()))
 					{
 						previous_balance = node.ledger.balance (transaction, block_a->previous ());
@@ -920,7 +920,7 @@ scendere::vote_code scendere::active_transactions::vote (std::shared_ptr<scender
 			auto const reps (node.wallets.reps ());
 			if (!reps.have_half_rep () && !reps.exists (vote_a->account))
 			{
-				node.network.flood_vote (vote_a, 0.5f);
+				node.network.relay_vote (vote_a, 0.5f);
 			}
 		}
 		result = replay ? scendere::vote_code::replay : scendere::vote_code::vote;
@@ -1279,7 +1279,7 @@ scendere::inactive_cache_status scendere::active_transactions::inactive_votes_bo
 
 	if ((status.election_started && !previously_a.election_started) || (status.bootstrap_started && !previously_a.bootstrap_started))
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		auto block = node.store.block.get (transaction, hash_a);
 		if (block && status.election_started && !previously_a.election_started && !node.block_confirmed_or_being_confirmed (transaction, hash_a))
 		{
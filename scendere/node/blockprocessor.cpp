@@ -220,6 +220,13 @@ void scendere::block_processor::process_verified_state_blocks (std::deque<scende
 				verified = scendere::signature_verification::valid;
 				blocks.emplace_back (block, account, verified);
 			}
+			else if (block->account ().is_zero ())
+			{
+				// Legacy send/receive/change blocks were checked against a supplied account which may not be the chain owner, leave them to the ledger
+				verified = scendere::signature_verification::unknown;
+				account.clear ();
+				blocks.emplace_back (block, account, verified);
+			}
 			else
 			{
 				requeue_invalid (hashes[i], { block, account, verified });
@@ -234,7 +241,7 @@ void scendere::block_processor::process_batch (scendere::unique_lock<scendere::m
 {
 	auto scoped_write_guard = write_database_queue.wait (scendere::writer::process_batch);
 	block_post_events post_events ([&store = node.store] { return store.tx_begin_read (); });
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }));
+	auto transaction (node.store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_amounts, tables::unchecked }));
 	scendere::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -332,7 +339,7 @@ void scendere::block_processor::process_live (scendere::transaction const & tran
 	}
 	else if (!node.flags.disable_block_processor_republishing)
 	{
-		node.network.flood_block (block_a, scendere::buffer_drop_policy::limiter);
+		node.network.relay_block (block_a);
 	}
 
 	if (node.websocket_server && node.websocket_server->any_subscriber (scendere::websocket::topic::new_unconfirmed_block))
@@ -346,6 +353,17 @@ scendere::process_return scendere::block_processor::process_one (scendere::write
 	scendere::process_return result;
 	auto block (info_a.block);
 	auto hash (block->hash ());
+	if (info_a.verified == scendere::signature_verification::valid && block->account ().is_zero () && !info_a.account.is_zero ())
+	{
+		// Legacy blocks were verified against a supplied account, only trust that if it owns the previous block.
+		// Without a frontier the ledger rejects the block or stores it as unchecked, and it is checked again here when requeued
+		auto account (node.store.frontier.get (transaction_a, block->previous ()));
+		if (!account.is_zero () && account != info_a.account)
+		{
+			info_a.verified = scendere::signature_verification::unknown;
+			info_a.account.clear ();
+		}
+	}
 	result = node.ledger.process (transaction_a, *block, info_a.verified);
 	switch (result.code)
 	{
@@ -362,6 +380,14 @@ scendere::process_return scendere::block_processor::process_one (scendere::write
 			{
 				events_a.events.emplace_back ([this, hash, block = info_a.block, result, origin_a] (scendere::transaction const & post_event_transaction_a) { process_live (post_event_transaction_a, hash, block, result, origin_a); });
 			}
+			if (node.bootstrap_initiator.checkpoint.contains (*block, hash))
+			{
+				// Cemented once the block is committed, together with the blocks it depends on
+				events_a.events.emplace_back ([this, block = info_a.block] (scendere::transaction const & /* unused */) {
+					node.stats.inc (scendere::stat::type::bootstrap, scendere::stat::detail::checkpoint_cemented);
+					node.confirmation_height_processor.add (block);
+				});
+			}
 			queue_unchecked (transaction_a, hash);
 			/* For send blocks check epoch open unchecked (gap pending).
 			For state blocks check only send subtype and only if block epoch is not last epoch.
@@ -383,6 +409,15 @@ scendere::process_return scendere::block_processor::process_one (scendere::write
 			info_a.verified = result.verified;
 			node.unchecked.put (block->previous (), info_a);
 			events_a.events.emplace_back ([this, hash] (scendere::transaction const & /* unused */) { this->node.gap_cache.add (hash); });
+			if (node.flags.enable_ascending_bootstrap)
+			{
+				// The account chain is behind, pull it forward from the local frontier
+				auto account (block->account ().is_zero () ? info_a.account : block->account ());
+				if (!account.is_zero ())
+				{
+					events_a.events.emplace_back ([this, account] (scendere::transaction const & /* unused */) { this->node.bootstrap_initiator.bootstrap_ascending (account); });
+				}
+			}
 			node.stats.inc (scendere::stat::type::ledger, scendere::stat::detail::gap_previous);
 			break;
 		}
@@ -1,5 +1,6 @@
 #include <scendere/lib/threading.hpp>
 #include <scendere/node/bootstrap/bootstrap.hpp>
+#include <scendere/node/bootstrap/bootstrap_ascending.hpp>
 #include <scendere/node/bootstrap/bootstrap_lazy.hpp>
 #include <scendere/node/bootstrap/bootstrap_legacy.hpp>
 #include <scendere/node/common.hpp>
@@ -12,6 +13,17 @@
 scendere::bootstrap_initiator::bootstrap_initiator (scendere::node & node_a) :
 	node (node_a)
 {
+	if (!node.flags.bootstrap_checkpoint.empty ())
+	{
+		if (!checkpoint.load (node.flags.bootstrap_checkpoint))
+		{
+			node.logger.always_log (boost::str (boost::format ("Loaded bootstrap checkpoint with %1% frontiers") % checkpoint.size ()));
+		}
+		else
+		{
+			node.logger.always_log (scendere::severity_level::error, boost::str (boost::format ("Error loading bootstrap checkpoint %1%") % node.flags.bootstrap_checkpoint));
+		}
+	}
 	connections = std::make_shared<scendere::bootstrap_connections> (node);
 	bootstrap_initiator_threads.push_back (boost::thread ([this] () {
 		scendere::thread_role::set (scendere::thread_role::name::bootstrap_connections);
@@ -127,6 +139,30 @@ void scendere::bootstrap_initiator::bootstrap_wallet (std::deque<scendere::accou
 	condition.notify_all ();
 }
 
+void scendere::bootstrap_initiator::bootstrap_ascending (scendere::account const & account_a)
+{
+	if (node.flags.enable_ascending_bootstrap && !stopped)
+	{
+		scendere::unique_lock<scendere::mutex> lock (mutex);
+		auto ascending_attempt (find_attempt (scendere::bootstrap_mode::ascending));
+		if (ascending_attempt == nullptr)
+		{
+			node.stats.inc (scendere::stat::type::bootstrap, scendere::stat::detail::initiate_ascending, scendere::stat::dir::out);
+			ascending_attempt = std::make_shared<scendere::bootstrap_attempt_ascending> (node.shared (), attempts.incremental++);
+			// Prioritize before the attempt is visible so it doesn't start with an empty set and finish immediately
+			ascending_attempt->ascending_prioritize (account_a);
+			attempts_list.push_back (ascending_attempt);
+			attempts.add (ascending_attempt);
+		}
+		else
+		{
+			lock.unlock ();
+			ascending_attempt->ascending_prioritize (account_a);
+		}
+		condition.notify_all ();
+	}
+}
+
 void scendere::bootstrap_initiator::run_bootstrap ()
 {
 	scendere::unique_lock<scendere::mutex> lock (mutex);
@@ -245,6 +281,12 @@ std::shared_ptr<scendere::bootstrap_attempt> scendere::bootstrap_initiator::curr
 	return find_attempt (scendere::bootstrap_mode::wallet_lazy);
 }
 
+std::shared_ptr<scendere::bootstrap_attempt> scendere::bootstrap_initiator::current_ascending_attempt ()
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	return find_attempt (scendere::bootstrap_mode::ascending);
+}
+
 void scendere::bootstrap_initiator::stop_attempts ()
 {
 	scendere::unique_lock<scendere::mutex> lock (mutex);
@@ -303,6 +345,15 @@ std::unique_ptr<scendere::container_info_component> scendere::collect_container_
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "observers", count, sizeof_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pulls_cache", cache_count, sizeof_cache_element }));
+	if (!bootstrap_initiator.checkpoint.empty ())
+	{
+		composite->add_component (collect_container_info (bootstrap_initiator.checkpoint, "checkpoint"));
+	}
+	auto lazy_attempt (bootstrap_initiator.current_lazy_attempt ());
+	if (lazy_attempt != nullptr)
+	{
+		composite->add_component (collect_container_info (*std::static_pointer_cast<scendere::bootstrap_attempt_lazy> (lazy_attempt), "lazy_attempt"));
+	}
 	return composite;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <scendere/node/bootstrap/bootstrap_checkpoint.hpp>
 #include <scendere/node/bootstrap/bootstrap_connections.hpp>
 #include <scendere/node/common.hpp>
 
@@ -27,7 +28,8 @@ enum class bootstrap_mode
 {
 	legacy,
 	lazy,
-	wallet_lazy
+	wallet_lazy,
+	ascending
 };
 enum class sync_result
 {
@@ -93,6 +95,8 @@ public:
 	void bootstrap (bool force = false, std::string id_a = "", uint32_t const frontiers_age_a = std::numeric_limits<uint32_t>::max (), scendere::account const & start_account_a = scendere::account{});
 	bool bootstrap_lazy (scendere::hash_or_account const &, bool force = false, bool confirmed = true, std::string id_a = "");
 	void bootstrap_wallet (std::deque<scendere::account> &);
+	/** Raises the ascending bootstrap priority of an account, starting an ascending session if none is running */
+	void bootstrap_ascending (scendere::account const &);
 	void run_bootstrap ();
 	void lazy_requeue (scendere::block_hash const &, scendere::block_hash const &);
 	void notify_listeners (bool);
@@ -105,8 +109,11 @@ public:
 	std::shared_ptr<scendere::bootstrap_attempt> current_attempt ();
 	std::shared_ptr<scendere::bootstrap_attempt> current_lazy_attempt ();
 	std::shared_ptr<scendere::bootstrap_attempt> current_wallet_attempt ();
+	std::shared_ptr<scendere::bootstrap_attempt> current_ascending_attempt ();
 	scendere::pulls_cache cache;
 	scendere::bootstrap_attempts attempts;
+	/** Trusted frontiers loaded from node_flags::bootstrap_checkpoint, cemented directly by the block processor when reached */
+	scendere::bootstrap_checkpoint checkpoint;
 	void stop ();
 
 private:
@@ -0,0 +1,177 @@
+#include <scendere/node/bootstrap/bootstrap_ascending.hpp>
+#include <scendere/node/bootstrap/bootstrap_bulk_pull.hpp>
+#include <scendere/node/node.hpp>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+constexpr float scendere::bootstrap_attempt_ascending::priority_initial;
+constexpr float scendere::bootstrap_attempt_ascending::priority_max;
+constexpr std::chrono::minutes scendere::bootstrap_attempt_ascending::max_time;
+
+scendere::bootstrap_attempt_ascending::bootstrap_attempt_ascending (std::shared_ptr<scendere::node> const & node_a, uint64_t incremental_id_a, std::string const & id_a) :
+	scendere::bootstrap_attempt (node_a, scendere::bootstrap_mode::ascending, incremental_id_a, id_a)
+{
+	node->bootstrap_initiator.notify_listeners (true);
+}
+
+scendere::bootstrap_attempt_ascending::~bootstrap_attempt_ascending ()
+{
+	node->bootstrap_initiator.notify_listeners (false);
+}
+
+void scendere::bootstrap_attempt_ascending::request_pull (scendere::unique_lock<scendere::mutex> & lock_a)
+{
+	lock_a.unlock ();
+	auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this ()));
+	lock_a.lock ();
+	if (connection_l && !stopped && !priorities.empty ())
+	{
+		auto & priorities_by_priority (priorities.get<tag_priority> ());
+		auto top (priorities_by_priority.begin ());
+		auto entry (*top);
+		priorities_by_priority.erase (top);
+		in_flight[entry.account] = entry;
+		++pulling;
+		auto this_l (shared_from_this ());
+		// The bulk_pull_client destructor calls back into the attempt which can cause a deadlock if this is the last reference
+		// Dispatch request in an external thread in case it needs to be destroyed
+		node->background ([connection_l, this_l, entry] () {
+			auto head (entry.head);
+			if (head.is_zero ())
+			{
+				scendere::account_info info;
+				auto transaction (this_l->node->store.tx_begin_read ());
+				if (!this_l->node->store.account.get (transaction, entry.account, info))
+				{
+					head = info.head;
+				}
+			}
+			// End equals the start so that peers without ascending support reply with that single block only
+			scendere::pull_info pull (entry.account, head, head, this_l->incremental_id, pull_count, 0);
+			auto client (std::make_shared<scendere::bulk_pull_client> (connection_l, this_l, pull));
+			client->request ();
+		});
+	}
+	else if (connection_l)
+	{
+		node->bootstrap_initiator.connections->pool_connection (connection_l);
+	}
+}
+
+void scendere::bootstrap_attempt_ascending::ascending_prioritize (scendere::account const & account_a)
+{
+	if (!account_a.is_zero ())
+	{
+		{
+			scendere::lock_guard<scendere::mutex> lock (mutex);
+			auto in_flight_l (in_flight.find (account_a));
+			if (in_flight_l != in_flight.end ())
+			{
+				in_flight_l->second.priority = std::min (in_flight_l->second.priority + priority_initial, priority_max);
+			}
+			else
+			{
+				auto existing (priorities.get<tag_account> ().find (account_a));
+				if (existing != priorities.get<tag_account> ().end ())
+				{
+					priorities.get<tag_account> ().modify (existing, [] (scendere::ascending_priority & entry_a) {
+						entry_a.priority = std::min (entry_a.priority + priority_initial, priority_max);
+					});
+				}
+				else
+				{
+					priorities.get<tag_account> ().insert (scendere::ascending_priority{ account_a, priority_initial, 0 });
+					if (priorities.size () > priorities_max)
+					{
+						// Evict the lowest priority account
+						priorities.get<tag_priority> ().erase (std::prev (priorities.get<tag_priority> ().end ()));
+					}
+				}
+			}
+		}
+		condition.notify_all ();
+	}
+}
+
+void scendere::bootstrap_attempt_ascending::ascending_pull_finished (scendere::account const & account_a, scendere::block_hash const & last_a, uint64_t blocks_a)
+{
+	{
+		scendere::lock_guard<scendere::mutex> lock (mutex);
+		auto in_flight_l (in_flight.find (account_a));
+		if (in_flight_l != in_flight.end ())
+		{
+			auto entry (in_flight_l->second);
+			in_flight.erase (in_flight_l);
+			if (blocks_a > 0)
+			{
+				// The chain was extended, continue from the last block received as it may not be in the ledger yet
+				entry.priority = std::min (entry.priority * 2.0f, priority_max);
+				entry.head = last_a;
+			}
+			else
+			{
+				entry.priority /= 4.0f;
+				entry.head.clear ();
+			}
+			if (entry.priority >= priority_cutoff && !stopped)
+			{
+				auto existing (priorities.get<tag_account> ().find (account_a));
+				if (existing == priorities.get<tag_account> ().end ())
+				{
+					priorities.get<tag_account> ().insert (entry);
+				}
+			}
+		}
+	}
+	condition.notify_all ();
+}
+
+bool scendere::bootstrap_attempt_ascending::ascending_finished ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto running (!stopped);
+	auto more_accounts (!priorities.empty ());
+	auto still_pulling (pulling > 0);
+	return running && (more_accounts || still_pulling);
+}
+
+void scendere::bootstrap_attempt_ascending::run ()
+{
+	debug_assert (started);
+	node->bootstrap_initiator.connections->populate_connections (false);
+	auto start_time (std::chrono::steady_clock::now ());
+	scendere::unique_lock<scendere::mutex> lock (mutex);
+	while (ascending_finished () && std::chrono::steady_clock::now () - start_time < max_time)
+	{
+		if (!priorities.empty () && pulling < pulls_max)
+		{
+			request_pull (lock);
+		}
+		else
+		{
+			condition.wait_for (lock, std::chrono::seconds (1));
+		}
+	}
+	if (!stopped)
+	{
+		node->logger.try_log (boost::str (boost::format ("Completed ascending pulls, %1% accounts left") % priorities.size ()));
+	}
+	lock.unlock ();
+	stop ();
+	condition.notify_all ();
+}
+
+std::size_t scendere::bootstrap_attempt_ascending::priorities_size ()
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	return priorities.size ();
+}
+
+void scendere::bootstrap_attempt_ascending::get_information (boost::property_tree::ptree & tree_a)
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	tree_a.put ("priority_accounts", std::to_string (priorities.size ()));
+	tree_a.put ("in_flight_accounts", std::to_string (in_flight.size ()));
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <scendere/node/bootstrap/bootstrap_attempt.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <unordered_map>
+
+namespace mi = boost::multi_index;
+
+namespace scendere
+{
+class node;
+class ascending_priority final
+{
+public:
+	scendere::account account{ 0 };
+	float priority{ 0.0f };
+	/** Last block pulled for the account, used as the next start while the block processor catches up */
+	scendere::block_hash head{ 0 };
+};
+
+/**
+ * Ascending bootstrap session. Keeps a bounded set of accounts whose frontier is not in the local ledger, found through blocks with a missing previous and failed pulls,
+ * and pulls small batches of blocks forward from the local frontier of the highest priority account first.
+ * Accounts whose pulls extend their chain move up, accounts whose pulls return nothing back off until they are dropped.
+ */
+class bootstrap_attempt_ascending final : public bootstrap_attempt
+{
+public:
+	explicit bootstrap_attempt_ascending (std::shared_ptr<scendere::node> const & node_a, uint64_t incremental_id_a, std::string const & id_a = "");
+	~bootstrap_attempt_ascending ();
+	void run () override;
+	void request_pull (scendere::unique_lock<scendere::mutex> &);
+	bool ascending_finished ();
+	void ascending_prioritize (scendere::account const &) override;
+	void ascending_pull_finished (scendere::account const &, scendere::block_hash const &, uint64_t) override;
+	std::size_t priorities_size ();
+	void get_information (boost::property_tree::ptree &) override;
+	class tag_account
+	{
+	};
+	class tag_priority
+	{
+	};
+	// clang-format off
+	boost::multi_index_container<scendere::ascending_priority,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_account>,
+			mi::member<scendere::ascending_priority, scendere::account, &scendere::ascending_priority::account>>,
+		mi::ordered_non_unique<mi::tag<tag_priority>,
+			mi::member<scendere::ascending_priority, float, &scendere::ascending_priority::priority>, std::greater<float>>>>
+	priorities;
+	// clang-format on
+	/** Accounts with a pull in progress, taken out of the priority set until the pull finishes */
+	std::unordered_map<scendere::account, scendere::ascending_priority> in_flight;
+	static std::size_t constexpr priorities_max = 256 * 1024;
+	static unsigned constexpr pulls_max = 64;
+	static scendere::bulk_pull::count_t constexpr pull_count = 128;
+	static float constexpr priority_initial = 1.0f;
+	static float constexpr priority_max = 32.0f;
+	static float constexpr priority_cutoff = 0.25f;
+	static std::chrono::minutes constexpr max_time{ 10 };
+};
+}
@@ -110,6 +110,10 @@ std::string scendere::bootstrap_attempt::mode_text ()
 	{
 		mode_text = "wallet_lazy";
 	}
+	else if (mode == scendere::bootstrap_mode::ascending)
+	{
+		mode_text = "ascending";
+	}
 	return mode_text;
 }
 
@@ -118,7 +122,7 @@ void scendere::bootstrap_attempt::add_frontier (scendere::pull_info const &)
 	debug_assert (mode == scendere::bootstrap_mode::legacy);
 }
 
-void scendere::bootstrap_attempt::add_bulk_push_target (scendere::block_hash const &, scendere::block_hash const &)
+void scendere::bootstrap_attempt::add_bulk_push_target (scendere::tcp_endpoint const &, scendere::block_hash const &, scendere::block_hash const &)
 {
 	debug_assert (mode == scendere::bootstrap_mode::legacy);
 }
@@ -129,7 +133,7 @@ bool scendere::bootstrap_attempt::request_bulk_push_target (std::pair<scendere::
 	return true;
 }
 
-void scendere::bootstrap_attempt::set_start_account (scendere::account const &)
+void scendere::bootstrap_attempt::set_start_account (scendere::account const &, scendere::account const &)
 {
 	debug_assert (mode == scendere::bootstrap_mode::legacy);
 }
@@ -199,3 +203,13 @@ std::size_t scendere::bootstrap_attempt::wallet_size ()
 	debug_assert (mode == scendere::bootstrap_mode::wallet_lazy);
 	return 0;
 }
+
+void scendere::bootstrap_attempt::ascending_prioritize (scendere::account const &)
+{
+	debug_assert (mode == scendere::bootstrap_mode::ascending);
+}
+
+void scendere::bootstrap_attempt::ascending_pull_finished (scendere::account const &, scendere::block_hash const &, uint64_t)
+{
+	debug_assert (mode == scendere::bootstrap_mode::ascending);
+}
@@ -28,9 +28,11 @@ public:
 	bool should_log ();
 	std::string mode_text ();
 	virtual void add_frontier (scendere::pull_info const &);
-	virtual void add_bulk_push_target (scendere::block_hash const &, scendere::block_hash const &);
+	/** Records blocks missing from the peer at the given endpoint, found while reading its frontiers */
+	virtual void add_bulk_push_target (scendere::tcp_endpoint const &, scendere::block_hash const &, scendere::block_hash const &);
 	virtual bool request_bulk_push_target (std::pair<scendere::block_hash, scendere::block_hash> &);
-	virtual void set_start_account (scendere::account const &);
+	/** Records where frontier requests for the account range ending at the second account continue */
+	virtual void set_start_account (scendere::account const &, scendere::account const &);
 	virtual bool lazy_start (scendere::hash_or_account const &, bool confirmed = true);
 	virtual void lazy_add (scendere::pull_info const &);
 	virtual void lazy_requeue (scendere::block_hash const &, scendere::block_hash const &);
@@ -41,6 +43,9 @@ public:
 	virtual void requeue_pending (scendere::account const &);
 	virtual void wallet_start (std::deque<scendere::account> &);
 	virtual std::size_t wallet_size ();
+	virtual void ascending_prioritize (scendere::account const &);
+	/** Rescores an account once its ascending pull completes, given the last block received and the number of blocks that extended the chain */
+	virtual void ascending_pull_finished (scendere::account const &, scendere::block_hash const &, uint64_t);
 	virtual void get_information (boost::property_tree::ptree &) = 0;
 	scendere::mutex next_log_mutex;
 	std::chrono::steady_clock::time_point next_log{ std::chrono::steady_clock::now () };
@@ -7,6 +7,175 @@
 
 #include <boost/format.hpp>
 
+constexpr uint8_t scendere::bulk_pull_compact_codec::entry_type;
+
+std::size_t scendere::bulk_pull_compact_codec::serialize (scendere::stream & stream_a, scendere::block const & block_a)
+{
+	std::size_t result (0);
+	if (block_a.type () == scendere::block_type::state)
+	{
+		std::vector<uint8_t> full;
+		{
+			scendere::vectorstream full_stream (full);
+			block_a.serialize (full_stream);
+		}
+		debug_assert (full.size () == scendere::state_block::size);
+		// Body fields follow the state block serialization order: account, previous, representative, balance, link, signature, work
+		uint8_t flags (0);
+		std::vector<uint8_t> body (1);
+		auto append = [&body, &full] (std::size_t offset_a, std::size_t size_a) {
+			body.insert (body.end (), full.begin () + offset_a, full.begin () + offset_a + size_a);
+		};
+		if (context && block_a.account () == account)
+		{
+			flags |= account_implied;
+		}
+		else
+		{
+			append (0, sizeof (scendere::account));
+		}
+		if (context && block_a.previous () == hash)
+		{
+			flags |= previous_implied;
+		}
+		else
+		{
+			append (32, sizeof (scendere::block_hash));
+		}
+		if (context && block_a.representative () == representative)
+		{
+			flags |= representative_implied;
+		}
+		else
+		{
+			append (64, sizeof (scendere::account));
+		}
+		std::vector<uint8_t> varint;
+		auto decrease (block_a.balance ().number () < balance.number ());
+		if (context)
+		{
+			scendere::uint128_t delta (decrease ? balance.number () - block_a.balance ().number () : block_a.balance ().number () - balance.number ());
+			do
+			{
+				auto byte (static_cast<uint8_t> (delta & 0x7f));
+				delta >>= 7;
+				varint.push_back (delta != 0 ? byte | 0x80 : byte);
+			} while (delta != 0);
+		}
+		if (context && varint.size () < sizeof (scendere::amount))
+		{
+			flags |= balance_delta;
+			if (decrease)
+			{
+				flags |= balance_decrease;
+			}
+			body.insert (body.end (), varint.begin (), varint.end ());
+		}
+		else
+		{
+			append (96, sizeof (scendere::amount));
+		}
+		append (112, scendere::state_block::size - 112);
+		body[0] = flags;
+		scendere::write (stream_a, entry_type);
+		scendere::write (stream_a, static_cast<uint8_t> (body.size ()));
+		scendere::write (stream_a, body);
+		result = 2 + body.size ();
+	}
+	else
+	{
+		scendere::serialize_block (stream_a, block_a);
+		result = sizeof (scendere::block_type) + scendere::block::size (block_a.type ());
+	}
+	update (block_a);
+	return result;
+}
+
+bool scendere::bulk_pull_compact_codec::deserialize (uint8_t const * data_a, std::size_t size_a, std::vector<uint8_t> & block_a) const
+{
+	auto error (size_a == 0);
+	std::size_t offset (1);
+	block_a.clear ();
+	block_a.reserve (scendere::state_block::size);
+	auto take = [data_a, size_a, &offset, &block_a, &error] (std::size_t size_l) {
+		error = error || offset + size_l > size_a;
+		if (!error)
+		{
+			block_a.insert (block_a.end (), data_a + offset, data_a + offset + size_l);
+			offset += size_l;
+		}
+	};
+	auto flags (error ? uint8_t (0) : data_a[0]);
+	error = error || (!context && (flags & (account_implied | previous_implied | representative_implied | balance_delta)) != 0);
+	if (flags & account_implied)
+	{
+		block_a.insert (block_a.end (), account.bytes.begin (), account.bytes.end ());
+	}
+	else
+	{
+		take (sizeof (scendere::account));
+	}
+	if (flags & previous_implied)
+	{
+		block_a.insert (block_a.end (), hash.bytes.begin (), hash.bytes.end ());
+	}
+	else
+	{
+		take (sizeof (scendere::block_hash));
+	}
+	if (flags & representative_implied)
+	{
+		block_a.insert (block_a.end (), representative.bytes.begin (), representative.bytes.end ());
+	}
+	else
+	{
+		take (sizeof (scendere::account));
+	}
+	if (flags & balance_delta)
+	{
+		scendere::uint128_t delta (0);
+		auto done (false);
+		for (unsigned shift (0); !error && !done; shift += 7)
+		{
+			error = offset >= size_a || shift > 126;
+			if (!error)
+			{
+				auto byte (data_a[offset++]);
+				delta |= scendere::uint128_t (byte & 0x7f) << shift;
+				done = (byte & 0x80) == 0;
+			}
+		}
+		if (!error)
+		{
+			auto decrease ((flags & balance_decrease) != 0);
+			error = decrease ? delta > balance.number () : delta > std::numeric_limits<scendere::uint128_t>::max () - balance.number ();
+			if (!error)
+			{
+				scendere::amount balance_l (decrease ? balance.number () - delta : balance.number () + delta);
+				block_a.insert (block_a.end (), balance_l.bytes.begin (), balance_l.bytes.end ());
+			}
+		}
+	}
+	else
+	{
+		take (sizeof (scendere::amount));
+	}
+	take (scendere::state_block::size - 112);
+	return error || offset != size_a;
+}
+
+void scendere::bulk_pull_compact_codec::update (scendere::block const & block_a)
+{
+	context = block_a.type () == scendere::block_type::state;
+	if (context)
+	{
+		hash = block_a.hash ();
+		account = block_a.account ();
+		representative = block_a.representative ();
+		balance = block_a.balance ();
+	}
+}
+
 scendere::pull_info::pull_info (scendere::hash_or_account const & account_or_head_a, scendere::block_hash const & head_a, scendere::block_hash const & end_a, uint64_t bootstrap_id_a, count_t count_a, unsigned retry_limit_a) :
 	account_or_head (account_or_head_a),
 	head (head_a),
@@ -31,9 +200,14 @@ scendere::bulk_pull_client::bulk_pull_client (std::shared_ptr<scendere::bootstra
 
 scendere::bulk_pull_client::~bulk_pull_client ()
 {
+	if (attempt->mode == scendere::bootstrap_mode::ascending)
+	{
+		// Ascending pulls are not requeued, the attempt rescores the account instead
+		attempt->ascending_pull_finished (pull.account_or_head.as_account (), expected, pull_blocks - unexpected_count);
+	}
 	/* If received end block is not expected end block
 	Or if given start and end blocks are from different chains (i.e. forked node or malicious node) */
-	if (expected != pull.end && !expected.is_zero ())
+	else if (expected != pull.end && !expected.is_zero ())
 	{
 		pull.head = expected;
 		if (attempt->mode != scendere::bootstrap_mode::legacy)
@@ -41,6 +215,10 @@ scendere::bulk_pull_client::~bulk_pull_client ()
 			pull.account_or_head = expected;
 		}
 		pull.processed += pull_blocks - unexpected_count;
+		if (network_error)
+		{
+			connection->connections.scores.failure (connection->channel->get_tcp_endpoint ());
+		}
 		connection->node->bootstrap_initiator.connections->requeue_pull (pull, network_error);
 		if (connection->node->config.logging.bulk_pull_logging ())
 		{
@@ -56,10 +234,16 @@ scendere::bulk_pull_client::~bulk_pull_client ()
 
 void scendere::bulk_pull_client::request ()
 {
-	debug_assert (!pull.head.is_zero () || pull.retry_limit <= connection->node->network_params.bootstrap.lazy_retry_limit);
+	debug_assert (!pull.head.is_zero () || pull.retry_limit <= connection->node->network_params.bootstrap.lazy_retry_limit || attempt->mode == scendere::bootstrap_mode::ascending);
 	expected = pull.head;
 	scendere::bulk_pull req{ connection->node->network_params.network };
-	if (pull.head == pull.head_original && pull.attempts % 4 < 3)
+	if (attempt->mode == scendere::bootstrap_mode::ascending)
+	{
+		// Start after the local frontier, or at the open block for accounts missing locally
+		req.start = pull.head.is_zero () ? pull.account_or_head : pull.head;
+		req.set_ascending (true);
+	}
+	else if (pull.head == pull.head_original && pull.attempts % 4 < 3)
 	{
 		// Account for new pulls
 		req.start = pull.account_or_head;
@@ -72,6 +256,7 @@ void scendere::bulk_pull_client::request ()
 	req.end = pull.end;
 	req.count = pull.count;
 	req.set_count_present (pull.count != 0);
+	req.set_compact (connection->node->flags.enable_compact_bulk_pull);
 
 	if (connection->node->config.logging.bulk_pull_logging ())
 	{
@@ -86,6 +271,7 @@ void scendere::bulk_pull_client::request ()
 	req, [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 		if (!ec)
 		{
+			this_l->request_time = std::chrono::steady_clock::now ();
 			this_l->throttled_receive_block ();
 		}
 		else
@@ -109,6 +295,10 @@ void scendere::bulk_pull_client::throttled_receive_block ()
 	}
 	else
 	{
+		if (pull_blocks == 0)
+		{
+			request_time = std::chrono::steady_clock::time_point{};
+		}
 		auto this_l (shared_from_this ());
 		connection->node->workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::seconds (1), [this_l] () {
 			if (!this_l->connection->pending_stop && !this_l->attempt->stopped)
@@ -145,6 +335,20 @@ void scendere::bulk_pull_client::received_type ()
 	scendere::block_type type (static_cast<scendere::block_type> (connection->receive_buffer->data ()[0]));
 
 	auto const & socket_l = connection->socket;
+	if (connection->receive_buffer->data ()[0] == scendere::bulk_pull_compact_codec::entry_type)
+	{
+		socket_l->async_read (connection->receive_buffer, 1, [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
+			if (!ec)
+			{
+				this_l->received_compact_size ();
+			}
+			else
+			{
+				this_l->received_block (ec, size_a, scendere::block_type::state);
+			}
+		});
+		return;
+	}
 	switch (type)
 	{
 		case scendere::block_type::send:
@@ -185,7 +389,7 @@ void scendere::bulk_pull_client::received_type ()
 		case scendere::block_type::not_a_block:
 		{
 			// Avoid re-using slow peers, or peers that sent the wrong blocks.
-			if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks)))
+			if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks) || (attempt->mode == scendere::bootstrap_mode::ascending && unexpected_count == 0)))
 			{
 				connection->connections.pool_connection (connection);
 			}
@@ -202,12 +406,50 @@ void scendere::bulk_pull_client::received_type ()
 	}
 }
 
+void scendere::bulk_pull_client::received_compact_size ()
+{
+	auto this_l (shared_from_this ());
+	connection->socket->async_read (connection->receive_buffer, connection->receive_buffer->data ()[0], [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
+		this_l->received_compact (ec, size_a);
+	});
+}
+
+void scendere::bulk_pull_client::received_compact (boost::system::error_code const & ec, std::size_t size_a)
+{
+	if (!ec)
+	{
+		std::vector<uint8_t> block_l;
+		if (!compact.deserialize (connection->receive_buffer->data (), size_a, block_l))
+		{
+			std::copy (block_l.begin (), block_l.end (), connection->receive_buffer->begin ());
+			received_block (ec, block_l.size (), scendere::block_type::state);
+		}
+		else
+		{
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log ("Error decoding compact block received from pull request");
+			}
+			connection->node->stats.inc (scendere::stat::type::bootstrap, scendere::stat::detail::bulk_pull_deserialize_receive_block, scendere::stat::dir::in);
+		}
+	}
+	else
+	{
+		received_block (ec, size_a, scendere::block_type::state);
+	}
+}
+
 void scendere::bulk_pull_client::received_block (boost::system::error_code const & ec, std::size_t size_a, scendere::block_type type_a)
 {
 	if (!ec)
 	{
 		scendere::bufferstream stream (connection->receive_buffer->data (), size_a);
 		auto block (scendere::deserialize_block (stream, type_a));
+		if (block != nullptr)
+		{
+			// Later compact entries refer to this block
+			compact.update (*block);
+		}
 		if (block != nullptr && !connection->node->network_params.work.validate_entry (*block))
 		{
 			auto hash (block->hash ());
@@ -221,7 +463,20 @@ void scendere::bulk_pull_client::received_block (boost::system::error_code const
 			bool block_expected (false);
 			// Unconfirmed head is used only for lazy destinations if legacy bootstrap is not available, see scendere::bootstrap_attempt::lazy_destinations_increment (...)
 			bool unconfirmed_account_head (connection->node->flags.disable_legacy_bootstrap && pull_blocks == 0 && pull.retry_limit <= connection->node->network_params.bootstrap.lazy_retry_limit && expected == pull.account_or_head && block->account () == pull.account_or_head);
-			if (hash == expected || unconfirmed_account_head)
+			if (attempt->mode == scendere::bootstrap_mode::ascending)
+			{
+				// Ascending blocks arrive oldest first, each one extending the previous
+				if (block->previous () == expected)
+				{
+					expected = hash;
+					block_expected = true;
+				}
+				else
+				{
+					unexpected_count++;
+				}
+			}
+			else if (hash == expected || unconfirmed_account_head)
 			{
 				expected = block->previous ();
 				block_expected = true;
@@ -233,11 +488,20 @@ void scendere::bulk_pull_client::received_block (boost::system::error_code const
 			if (pull_blocks == 0 && block_expected)
 			{
 				known_account = block->account ();
+				if (known_account.is_zero () && (attempt->mode == scendere::bootstrap_mode::legacy || attempt->mode == scendere::bootstrap_mode::ascending))
+				{
+					// Legacy and ascending pulls are by account, which lets legacy blocks be batch verified before the block processor
+					known_account = pull.account_or_head.as_account ();
+				}
 			}
 			if (connection->block_count++ == 0)
 			{
 				connection->set_start_time (std::chrono::steady_clock::now ());
 			}
+			if (pull_blocks == 0 && request_time != std::chrono::steady_clock::time_point{})
+			{
+				connection->connections.scores.sample_latency (connection->channel->get_tcp_endpoint (), std::chrono::steady_clock::now () - request_time);
+			}
 			attempt->total_blocks++;
 			pull_blocks++;
 			bool stop_pull (attempt->process_block (block, known_account, pull_blocks, pull.count, block_expected, pull.retry_limit));
@@ -468,6 +732,23 @@ void scendere::bulk_pull_server::set_current_end ()
 		}
 	}
 
+	if (request->is_ascending ())
+	{
+		// Ascending pulls run up to the account frontier, a zero successor ends the stream
+		include_start = false;
+		request->end.clear ();
+		if (connection->node->store.block.exists (transaction, request->start.as_block_hash ()))
+		{
+			current = connection->node->store.block.successor (transaction, request->start.as_block_hash ());
+		}
+		else
+		{
+			scendere::account_info info;
+			auto no_address (connection->node->store.account.get (transaction, request->start.as_account (), info));
+			current = no_address ? request->end : info.open_block;
+		}
+	}
+
 	sent_count = 0;
 	if (request->is_count_present ())
 	{
@@ -481,21 +762,67 @@ void scendere::bulk_pull_server::set_current_end ()
 
 void scendere::bulk_pull_server::send_next ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	// Start with the entry which did not fit in the previous write
+	std::vector<uint8_t> send_buffer;
+	send_buffer.swap (pending_entry);
+	auto finished (false);
 	{
-		std::vector<uint8_t> send_buffer;
+		// Keep each write within the bootstrap burst of the bandwidth limiter so it is not charged in parts
+		auto batch_size (std::min (batch_size_max, connection->node->network.limiter.burst (scendere::bandwidth_limit_type::bootstrap)));
+		auto transaction (connection->node->store.tx_begin_read ());
+		while (!finished && pending_entry.empty ())
 		{
-			scendere::vectorstream stream (send_buffer);
-			scendere::serialize_block (stream, *block);
+			auto block (get_next (transaction));
+			if (block != nullptr)
+			{
+				if (connection->node->config.logging.bulk_pull_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+				}
+				std::vector<uint8_t> entry;
+				{
+					scendere::vectorstream stream (entry);
+					if (request->is_compact ())
+					{
+						compact.serialize (stream, *block);
+					}
+					else
+					{
+						scendere::serialize_block (stream, *block);
+					}
+				}
+				if (!send_buffer.empty () && send_buffer.size () + entry.size () > batch_size)
+				{
+					pending_entry = std::move (entry);
+				}
+				else
+				{
+					send_buffer.insert (send_buffer.end (), entry.begin (), entry.end ());
+				}
+			}
+			else
+			{
+				finished = true;
+			}
 		}
-		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
+		if (finished && !send_buffer.empty ())
 		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+			// Terminate the stream in the same write as the last blocks
+			send_buffer.push_back (static_cast<uint8_t> (scendere::block_type::not_a_block));
 		}
-		connection->socket->async_write (scendere::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
-			this_l->sent_action (ec, size_a);
+	}
+	if (!send_buffer.empty ())
+	{
+		auto this_l (shared_from_this ());
+		connection->write_limited (scendere::shared_const_buffer (std::move (send_buffer)), [this_l, finished] (boost::system::error_code const & ec, std::size_t size_a) {
+			if (finished)
+			{
+				this_l->no_block_sent (ec, size_a);
+			}
+			else
+			{
+				this_l->sent_action (ec, size_a);
+			}
 		});
 	}
 	else
@@ -505,6 +832,11 @@ void scendere::bulk_pull_server::send_next ()
 }
 
 std::shared_ptr<scendere::block> scendere::bulk_pull_server::get_next ()
+{
+	return get_next (connection->node->store.tx_begin_read ());
+}
+
+std::shared_ptr<scendere::block> scendere::bulk_pull_server::get_next (scendere::transaction const & transaction_a)
 {
 	std::shared_ptr<scendere::block> result;
 	bool send_current = false, set_current_to_end = false;
@@ -545,8 +877,12 @@ std::shared_ptr<scendere::block> scendere::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = connection->node->block (current);
-		if (result != nullptr && set_current_to_end == false)
+		result = connection->node->store.block.get (transaction_a, current);
+		if (result != nullptr && request->is_ascending ())
+		{
+			current = connection->node->store.block.successor (transaction_a, current);
+		}
+		else if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
 			if (!previous.is_zero ())
@@ -607,7 +943,7 @@ void scendere::bulk_pull_server::no_block_sent (boost::system::error_code const
 {
 	if (!ec)
 	{
-		debug_assert (size_a == 1);
+		debug_assert (size_a >= 1);
 		connection->finish_request ();
 	}
 	else
@@ -780,35 +1116,18 @@ std::pair<std::unique_ptr<scendere::pending_key>, std::unique_ptr<scendere::pend
 
 	while (true)
 	{
-		/*
-		 * For each iteration of this loop, establish and then
-		 * destroy a database transaction, to avoid locking the
-		 * database for a prolonged period.
-		 */
-		auto stream_transaction (connection->node->store.tx_begin_read ());
-		auto stream (connection->node->store.pending.begin (stream_transaction, current_key));
-
-		if (stream == scendere::store_iterator<scendere::pending_key, scendere::pending_info> (nullptr))
+		if (pending.empty ())
 		{
-			break;
+			if (pending_end)
+			{
+				break;
+			}
+			fill_pending ();
+			continue;
 		}
 
-		scendere::pending_key key (stream->first);
-		scendere::pending_info info (stream->second);
-
-		/*
-		 * Get the key for the next value, to use in the next call or iteration
-		 */
-		current_key.account = key.account;
-		current_key.hash = key.hash.number () + 1;
-
-		/*
-		 * Finish up if the response is for a different account
-		 */
-		if (key.account != request->account)
-		{
-			break;
-		}
+		auto [key, info] = pending.front ();
+		pending.pop_front ();
 
 		/*
 		 * Skip entries where the amount is less than the requested
@@ -853,6 +1172,38 @@ std::pair<std::unique_ptr<scendere::pending_key>, std::unique_ptr<scendere::pend
 	return result;
 }
 
+void scendere::bulk_pull_account_server::fill_pending ()
+{
+	/*
+	 * Read the next run of the account's entries with a short lived
+	 * database transaction, to avoid locking the database for a
+	 * prolonged period while they are sent.
+	 */
+	auto stream_transaction (connection->node->store.tx_begin_read ());
+	auto stream (connection->node->store.pending.begin (stream_transaction, current_key));
+	auto end (connection->node->store.pending.end ());
+	for (; stream != end && pending.size () < pending_batch_size; ++stream)
+	{
+		scendere::pending_key key (stream->first);
+
+		/*
+		 * Finish up if the response is for a different account
+		 */
+		if (key.account != request->account)
+		{
+			break;
+		}
+		pending.emplace_back (key, scendere::pending_info (stream->second));
+
+		/*
+		 * Get the key for the next value, to use in the next batch
+		 */
+		current_key.account = key.account;
+		current_key.hash = key.hash.number () + 1;
+	}
+	pending_end = pending.size () < pending_batch_size;
+}
+
 void scendere::bulk_pull_account_server::sent_action (boost::system::error_code const & ec, std::size_t size_a)
 {
 	if (!ec)
@@ -3,6 +3,7 @@
 #include <scendere/node/common.hpp>
 #include <scendere/node/socket.hpp>
 
+#include <deque>
 #include <unordered_set>
 
 namespace scendere
@@ -26,6 +27,35 @@ public:
 };
 class bootstrap_client;
 
+/**
+ * Compact chain encoding for state blocks in bulk_pull responses, negotiated with bulk_pull::set_compact. Each side keeps the last block streamed as context:
+ * previous, account and representative equal to the context are omitted and the balance is sent as a varint delta. Entries are
+ * [entry_type][body size][flags][fields], other block types keep the regular [type][block] entry and clear the context.
+ */
+class bulk_pull_compact_codec final
+{
+public:
+	/** Writes block_a as a compact or regular entry and updates the context. Returns the number of bytes written */
+	std::size_t serialize (scendere::stream &, scendere::block const & block_a);
+	/** Rebuilds the regular state block serialization from a compact entry body. Returns true on error */
+	bool deserialize (uint8_t const *, std::size_t, std::vector<uint8_t> &) const;
+	/** Updates the context with a block read from the stream, compact or not */
+	void update (scendere::block const &);
+	static uint8_t constexpr entry_type = 0x80;
+	static uint8_t constexpr previous_implied = 0x01;
+	static uint8_t constexpr account_implied = 0x02;
+	static uint8_t constexpr representative_implied = 0x04;
+	static uint8_t constexpr balance_delta = 0x08;
+	static uint8_t constexpr balance_decrease = 0x10;
+
+private:
+	bool context{ false };
+	scendere::block_hash hash{ 0 };
+	scendere::account account{ 0 };
+	scendere::account representative{ 0 };
+	scendere::amount balance{ 0 };
+};
+
 /**
  * Client side of a bulk_pull request. Created when the bootstrap_attempt wants to make a bulk_pull request to the remote side.
  */
@@ -39,6 +69,8 @@ public:
 	void throttled_receive_block ();
 	void received_type ();
 	void received_block (boost::system::error_code const &, std::size_t, scendere::block_type);
+	void received_compact_size ();
+	void received_compact (boost::system::error_code const &, std::size_t);
 	scendere::block_hash first ();
 	std::shared_ptr<scendere::bootstrap_client> connection;
 	std::shared_ptr<scendere::bootstrap_attempt> attempt;
@@ -48,6 +80,9 @@ public:
 	uint64_t pull_blocks;
 	uint64_t unexpected_count;
 	bool network_error{ false };
+	scendere::bulk_pull_compact_codec compact;
+	/** When the request was sent, cleared if receiving was throttled before the first block so the peer latency is not skewed */
+	std::chrono::steady_clock::time_point request_time;
 };
 class bulk_pull_account_client final : public std::enable_shared_from_this<scendere::bulk_pull_account_client>
 {
@@ -75,6 +110,8 @@ public:
 	bulk_pull_server (std::shared_ptr<scendere::bootstrap_server> const &, std::unique_ptr<scendere::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<scendere::block> get_next ();
+	std::shared_ptr<scendere::block> get_next (scendere::transaction const &);
+	/** Serializes blocks read under one transaction into a single write of up to batch_size_max bytes or the bootstrap burst, whichever is smaller */
 	void send_next ();
 	void sent_action (boost::system::error_code const &, std::size_t);
 	void send_finished ();
@@ -85,6 +122,10 @@ public:
 	bool include_start;
 	scendere::bulk_pull::count_t max_count;
 	scendere::bulk_pull::count_t sent_count;
+	scendere::bulk_pull_compact_codec compact;
+	/** Serialized entry which would have overflowed the previous write */
+	std::vector<uint8_t> pending_entry;
+	static std::size_t constexpr batch_size_max = 64 * 1024;
 };
 class bulk_pull_account;
 class bulk_pull_account_server final : public std::enable_shared_from_this<scendere::bulk_pull_account_server>
@@ -93,6 +134,7 @@ public:
 	bulk_pull_account_server (std::shared_ptr<scendere::bootstrap_server> const &, std::unique_ptr<scendere::bulk_pull_account>);
 	void set_params ();
 	std::pair<std::unique_ptr<scendere::pending_key>, std::unique_ptr<scendere::pending_info>> get_next ();
+	void fill_pending ();
 	void send_frontier ();
 	void send_next_block ();
 	void sent_action (boost::system::error_code const &, std::size_t);
@@ -102,6 +144,10 @@ public:
 	std::unique_ptr<scendere::bulk_pull_account> request;
 	std::unordered_set<scendere::uint256_union> deduplication;
 	scendere::pending_key current_key;
+	/** Entries of the account read ahead of current_key, refilled from the pending table pending_batch_size at a time */
+	std::deque<std::pair<scendere::pending_key, scendere::pending_info>> pending;
+	bool pending_end{ false };
+	static std::size_t constexpr pending_batch_size = 128;
 	bool pending_address_only;
 	bool pending_include_address;
 	bool invalid_request;
@@ -0,0 +1,125 @@
+#include <scendere/lib/blocks.hpp>
+#include <scendere/lib/utility.hpp>
+#include <scendere/node/bootstrap/bootstrap_checkpoint.hpp>
+#include <scendere/secure/ledger.hpp>
+#include <scendere/secure/store.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+bool scendere::bootstrap_checkpoint::load (boost::filesystem::path const & path_a)
+{
+	std::ifstream stream;
+	stream.open (path_a.string ());
+	auto error (stream.fail ());
+	if (!error)
+	{
+		error = load (stream);
+	}
+	return error;
+}
+
+bool scendere::bootstrap_checkpoint::load (std::istream & stream_a)
+{
+	auto error (false);
+	std::unordered_set<scendere::account> accounts;
+	std::string line;
+	while (!error && std::getline (stream_a, line))
+	{
+		std::istringstream fields (line);
+		std::string account_text;
+		if (!(fields >> account_text) || account_text[0] == '#')
+		{
+			continue;
+		}
+		std::string hash_text;
+		uint64_t height (0);
+		scendere::account account;
+		scendere::block_hash hash;
+		error = !(fields >> hash_text >> height) || account.decode_account (account_text) || hash.decode_hex (hash_text) || height == 0;
+		// An account has a single frontier in a cut of the ledger
+		error = error || !accounts.insert (account).second;
+		if (!error)
+		{
+			add (account, hash, height);
+		}
+	}
+	return error;
+}
+
+void scendere::bootstrap_checkpoint::add (scendere::account const & account_a, scendere::block_hash const & frontier_a, uint64_t height_a)
+{
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	frontiers[frontier_a] = scendere::checkpoint_entry{ account_a, frontier_a, height_a };
+	count = frontiers.size ();
+}
+
+std::vector<scendere::checkpoint_entry> scendere::bootstrap_checkpoint::entries () const
+{
+	std::vector<scendere::checkpoint_entry> result;
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	result.reserve (frontiers.size ());
+	for (auto const & [hash, entry] : frontiers)
+	{
+		result.push_back (entry);
+	}
+	return result;
+}
+
+bool scendere::bootstrap_checkpoint::contains (scendere::block const & block_a, scendere::block_hash const & hash_a) const
+{
+	auto result (false);
+	if (!empty ())
+	{
+		scendere::checkpoint_entry entry;
+		{
+			scendere::lock_guard<scendere::mutex> guard (mutex);
+			auto existing (frontiers.find (hash_a));
+			if (existing != frontiers.end ())
+			{
+				entry = existing->second;
+			}
+		}
+		result = !entry.frontier.is_zero () && matches (block_a, entry);
+	}
+	return result;
+}
+
+std::vector<std::shared_ptr<scendere::block>> scendere::bootstrap_checkpoint::uncemented (scendere::transaction const & transaction_a, scendere::ledger & ledger_a) const
+{
+	std::vector<std::shared_ptr<scendere::block>> result;
+	for (auto const & entry : entries ())
+	{
+		auto block (ledger_a.store.block.get (transaction_a, entry.frontier));
+		if (block != nullptr && matches (*block, entry) && !ledger_a.block_confirmed (transaction_a, entry.frontier))
+		{
+			result.push_back (block);
+		}
+	}
+	return result;
+}
+
+bool scendere::bootstrap_checkpoint::matches (scendere::block const & block_a, scendere::checkpoint_entry const & entry_a) const
+{
+	auto const & account (block_a.account ().is_zero () ? block_a.sideband ().account : block_a.account ());
+	// A mismatch means the checkpoint is not a cut of this ledger, the chain is left to normal confirmation
+	return account == entry_a.account && block_a.sideband ().height == entry_a.height;
+}
+
+bool scendere::bootstrap_checkpoint::empty () const
+{
+	return count == 0;
+}
+
+std::size_t scendere::bootstrap_checkpoint::size () const
+{
+	return count;
+}
+
+std::unique_ptr<scendere::container_info_component> scendere::collect_container_info (bootstrap_checkpoint & checkpoint, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "frontiers", checkpoint.size (), sizeof (decltype (checkpoint.frontiers)::value_type) }));
+	return composite;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <scendere/lib/locks.hpp>
+#include <scendere/lib/numbers.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scendere
+{
+class block;
+class container_info_component;
+class ledger;
+class transaction;
+
+class checkpoint_entry final
+{
+public:
+	scendere::account account{ 0 };
+	scendere::block_hash frontier{ 0 };
+	uint64_t height{ 0 };
+};
+
+/**
+ * Trusted set of confirmed account frontiers used for fast sync. When a checkpoint frontier is inserted into the ledger it is handed to the
+ * confirmation height processor without an election, which cements it together with every block it depends on in other chains.
+ * Entries are only used if the inserted block matches both their account and height.
+ */
+class bootstrap_checkpoint final
+{
+public:
+	/** Reads lines of "<account> <frontier hash> <height>", blank lines and lines starting with '#' are skipped. Returns true on error, including an account listed twice */
+	bool load (boost::filesystem::path const &);
+	bool load (std::istream &);
+	void add (scendere::account const &, scendere::block_hash const &, uint64_t);
+	std::vector<scendere::checkpoint_entry> entries () const;
+	/** True if block_a is a checkpoint frontier, checked against the account and height of the entry */
+	bool contains (scendere::block const & block_a, scendere::block_hash const &) const;
+	/** Checkpoint frontiers already in the ledger which are not cemented yet, such as after a restart */
+	std::vector<std::shared_ptr<scendere::block>> uncemented (scendere::transaction const &, scendere::ledger &) const;
+	bool empty () const;
+	std::size_t size () const;
+
+private:
+	bool matches (scendere::block const &, scendere::checkpoint_entry const &) const;
+	mutable scendere::mutex mutex;
+	/** Entries by frontier hash, looked up for every block inserted while the checkpoint is in use */
+	std::unordered_map<scendere::block_hash, scendere::checkpoint_entry> frontiers;
+	std::atomic<std::size_t> count{ 0 };
+
+	friend std::unique_ptr<container_info_component> collect_container_info (bootstrap_checkpoint &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (bootstrap_checkpoint &, std::string const &);
+}
@@ -7,11 +7,14 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 constexpr double scendere::bootstrap_limits::bootstrap_connection_scale_target_blocks;
 constexpr double scendere::bootstrap_limits::bootstrap_minimum_blocks_per_sec;
 constexpr double scendere::bootstrap_limits::bootstrap_minimum_termination_time_sec;
 constexpr unsigned scendere::bootstrap_limits::bootstrap_max_new_connections;
 constexpr unsigned scendere::bootstrap_limits::requeued_pulls_processed_blocks_factor;
+constexpr std::chrono::seconds scendere::bootstrap_connections::ingest_window;
 
 scendere::bootstrap_client::bootstrap_client (std::shared_ptr<scendere::node> const & node_a, scendere::bootstrap_connections & connections_a, std::shared_ptr<scendere::transport::channel_tcp> const & channel_a, std::shared_ptr<scendere::socket> const & socket_a) :
 	node (node_a),
@@ -59,6 +62,112 @@ void scendere::bootstrap_client::stop (bool force)
 	}
 }
 
+double scendere::bootstrap_peer_score::score () const
+{
+	return block_rate / (1.0 + latency_ms / 1000.0) / (1.0 + static_cast<double> (failures));
+}
+
+template <typename Modify>
+void scendere::bootstrap_peer_scores::update (scendere::tcp_endpoint const & endpoint_a, Modify modify_a)
+{
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	auto & scores_by_endpoint (scores.get<tag_endpoint> ());
+	auto existing (scores_by_endpoint.find (endpoint_a));
+	if (existing == scores_by_endpoint.end ())
+	{
+		existing = scores_by_endpoint.insert (scendere::bootstrap_peer_score{ endpoint_a }).first;
+		if (scores.size () > scores_max)
+		{
+			scores.get<tag_last_update> ().erase (scores.get<tag_last_update> ().begin ());
+		}
+	}
+	scores_by_endpoint.modify (existing, [&modify_a] (scendere::bootstrap_peer_score & score_a) {
+		modify_a (score_a);
+		score_a.last_update = std::chrono::steady_clock::now ();
+	});
+}
+
+void scendere::bootstrap_peer_scores::sample_rate (scendere::tcp_endpoint const & endpoint_a, double block_rate_a)
+{
+	update (endpoint_a, [block_rate_a] (scendere::bootstrap_peer_score & score_a) {
+		score_a.block_rate = score_a.rate_samples == 0 ? block_rate_a : score_a.block_rate + sample_weight * (block_rate_a - score_a.block_rate);
+		++score_a.rate_samples;
+		if (block_rate_a > 0.0)
+		{
+			score_a.failures = 0;
+		}
+	});
+}
+
+void scendere::bootstrap_peer_scores::sample_latency (scendere::tcp_endpoint const & endpoint_a, std::chrono::steady_clock::duration const & latency_a)
+{
+	auto latency_ms (std::chrono::duration_cast<std::chrono::duration<double, std::milli>> (latency_a).count ());
+	update (endpoint_a, [latency_ms] (scendere::bootstrap_peer_score & score_a) {
+		score_a.latency_ms = score_a.latency_samples == 0 ? latency_ms : score_a.latency_ms + sample_weight * (latency_ms - score_a.latency_ms);
+		++score_a.latency_samples;
+	});
+}
+
+void scendere::bootstrap_peer_scores::failure (scendere::tcp_endpoint const & endpoint_a)
+{
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	// Failures are only counted for peers which already have samples, failed connection attempts would otherwise evict useful scores
+	auto existing (scores.get<tag_endpoint> ().find (endpoint_a));
+	if (existing != scores.get<tag_endpoint> ().end ())
+	{
+		scores.get<tag_endpoint> ().modify (existing, [] (scendere::bootstrap_peer_score & score_a) {
+			++score_a.failures;
+		});
+	}
+}
+
+boost::optional<double> scendere::bootstrap_peer_scores::score (scendere::tcp_endpoint const & endpoint_a) const
+{
+	boost::optional<double> result;
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	auto existing (scores.get<tag_endpoint> ().find (endpoint_a));
+	if (existing != scores.get<tag_endpoint> ().end () && existing->rate_samples > 0)
+	{
+		result = existing->score ();
+	}
+	return result;
+}
+
+double scendere::bootstrap_peer_scores::average () const
+{
+	double total (0.0);
+	std::size_t count (0);
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	for (auto const & score : scores)
+	{
+		if (score.rate_samples > 0)
+		{
+			total += score.score ();
+			++count;
+		}
+	}
+	return count > 0 ? total / count : 0.0;
+}
+
+std::vector<scendere::bootstrap_peer_score> scendere::bootstrap_peer_scores::list () const
+{
+	std::vector<scendere::bootstrap_peer_score> result;
+	{
+		scendere::lock_guard<scendere::mutex> guard (mutex);
+		result.assign (scores.begin (), scores.end ());
+	}
+	std::sort (result.begin (), result.end (), [] (scendere::bootstrap_peer_score const & lhs, scendere::bootstrap_peer_score const & rhs) {
+		return lhs.score () > rhs.score ();
+	});
+	return result;
+}
+
+std::size_t scendere::bootstrap_peer_scores::size () const
+{
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	return scores.size ();
+}
+
 scendere::bootstrap_connections::bootstrap_connections (scendere::node & node_a) :
 	node (node_a)
 {
@@ -73,8 +182,9 @@ std::shared_ptr<scendere::bootstrap_client> scendere::bootstrap_connections::con
 	{
 		if (!use_front_connection)
 		{
-			result = idle.back ();
-			idle.pop_back ();
+			auto best (best_idle ());
+			result = *best;
+			idle.erase (best);
 		}
 		else
 		{
@@ -91,6 +201,40 @@ std::shared_ptr<scendere::bootstrap_client> scendere::bootstrap_connections::con
 	return result;
 }
 
+std::shared_ptr<scendere::bootstrap_client> scendere::bootstrap_connections::try_connection ()
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	std::shared_ptr<scendere::bootstrap_client> result;
+	if (!stopped && !idle.empty ())
+	{
+		auto best (best_idle ());
+		result = *best;
+		idle.erase (best);
+	}
+	return result;
+}
+
+std::deque<std::shared_ptr<scendere::bootstrap_client>>::iterator scendere::bootstrap_connections::best_idle ()
+{
+	debug_assert (!mutex.try_lock ());
+	debug_assert (!idle.empty ());
+	auto result (idle.end ());
+	auto best_score (-1.0);
+	// Peers which have not served blocks yet get the average score, they are tried ahead of slow peers but not of fast ones
+	auto const prior (scores.average ());
+	for (auto i (idle.begin ()), n (idle.end ()); i != n; ++i)
+	{
+		auto value (scores.score ((*i)->channel->get_tcp_endpoint ()).value_or (prior));
+		// Ties go to the most recently pooled connection
+		if (value >= best_score)
+		{
+			best_score = value;
+			result = i;
+		}
+	}
+	return result;
+}
+
 void scendere::bootstrap_connections::pool_connection (std::shared_ptr<scendere::bootstrap_client> const & client_a, bool new_client, bool push_front)
 {
 	scendere::unique_lock<scendere::mutex> lock (mutex);
@@ -146,10 +290,12 @@ void scendere::bootstrap_connections::connect_client (scendere::tcp_endpoint con
 	++connections_count;
 	auto socket (std::make_shared<scendere::client_socket> (node));
 	auto this_l (shared_from_this ());
+	auto connect_start (std::chrono::steady_clock::now ());
 	socket->async_connect (endpoint_a,
-	[this_l, socket, endpoint_a, push_front] (boost::system::error_code const & ec) {
+	[this_l, socket, endpoint_a, push_front, connect_start] (boost::system::error_code const & ec) {
 		if (!ec)
 		{
+			this_l->scores.sample_latency (endpoint_a, std::chrono::steady_clock::now () - connect_start);
 			if (this_l->node.config.logging.bulk_pull_logging ())
 			{
 				this_l->node.logger.try_log (boost::str (boost::format ("Connection established to %1%") % endpoint_a));
@@ -193,6 +339,38 @@ unsigned scendere::bootstrap_connections::target_connections (std::size_t pulls_
 	return std::max (1U, (unsigned)(target + 0.5f));
 }
 
+unsigned scendere::bootstrap_connections::ingest_target (unsigned floor_a, unsigned ceiling_a, double rate_a, std::chrono::steady_clock::time_point now_a)
+{
+	ceiling_a = std::max (1U, ceiling_a);
+	floor_a = std::max (1U, std::min (floor_a, ceiling_a));
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	auto target (ingest_target_m.load ());
+	if (target == 0)
+	{
+		target = floor_a;
+		ingest_rate = rate_a;
+		ingest_evaluated = now_a;
+	}
+	else if (now_a - ingest_evaluated >= ingest_window)
+	{
+		auto step (std::max (1U, target / 4));
+		if (rate_a > ingest_rate * 1.1)
+		{
+			// The last connections added still raised the rate, keep adding
+			target += step;
+		}
+		else if (rate_a < ingest_rate * 0.9)
+		{
+			target = target > step ? target - step : floor_a;
+		}
+		ingest_rate = rate_a;
+		ingest_evaluated = now_a;
+	}
+	target = std::max (floor_a, std::min (target, ceiling_a));
+	ingest_target_m = target;
+	return target;
+}
+
 struct block_rate_cmp
 {
 	bool operator() (std::shared_ptr<scendere::bootstrap_client> const & lhs, std::shared_ptr<scendere::bootstrap_client> const & rhs) const
@@ -224,6 +402,7 @@ void scendere::bootstrap_connections::populate_connections (bool repeat)
 				if (client->elapsed_seconds () > scendere::bootstrap_limits::bootstrap_connection_warmup_time_sec && client->block_count > 0)
 				{
 					sorted_connections.push (client);
+					scores.sample_rate (client->channel->get_tcp_endpoint (), blocks_per_sec);
 				}
 				// Force-stop the slowest peers, since they can take the whole bootstrap hostage by dribbling out blocks on the last remaining pull.
 				// This is ~1.5kilobits/sec.
@@ -234,6 +413,7 @@ void scendere::bootstrap_connections::populate_connections (bool repeat)
 						node.logger.try_log (boost::str (boost::format ("Stopping slow peer %1% (elapsed sec %2%s > %3%s and %4% blocks per second < %5%)") % client->channel->to_string () % elapsed_sec % scendere::bootstrap_limits::bootstrap_minimum_termination_time_sec % blocks_per_sec % scendere::bootstrap_limits::bootstrap_minimum_blocks_per_sec));
 					}
 
+					scores.failure (client->channel->get_tcp_endpoint ());
 					client->stop (true);
 					new_clients.pop_back ();
 				}
@@ -243,7 +423,8 @@ void scendere::bootstrap_connections::populate_connections (bool repeat)
 		clients.swap (new_clients);
 	}
 
-	auto target = target_connections (num_pulls, attempts_count);
+	// Pending pulls bound the connection count, within that bound it follows the measured ingest rate
+	auto target = ingest_target (target_connections (0, attempts_count), target_connections (num_pulls, attempts_count), rate_sum);
 
 	// We only want to drop slow peers when more than 2/3 are active. 2/3 because 1/2 is too aggressive, and 100% rarely happens.
 	// Probably needs more tuning.
@@ -425,6 +606,8 @@ void scendere::bootstrap_connections::requeue_pull (scendere::pull_info const &
 			else if (attempt_l->mode == scendere::bootstrap_mode::legacy)
 			{
 				node.bootstrap_initiator.cache.add (pull);
+				// Let ascending bootstrap retry the account in small batches from other peers
+				node.bootstrap_initiator.bootstrap_ascending (pull.account_or_head.as_account ());
 			}
 		}
 	}
@@ -4,8 +4,16 @@
 #include <scendere/node/common.hpp>
 #include <scendere/node/socket.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/optional/optional.hpp>
+
 #include <atomic>
 
+namespace mi = boost::multi_index;
+
 namespace scendere
 {
 class node;
@@ -46,6 +54,64 @@ private:
 	std::chrono::steady_clock::time_point start_time_m;
 };
 
+class bootstrap_peer_score final
+{
+public:
+	scendere::tcp_endpoint endpoint;
+	/** Rolling average of the blocks per second served over a connection to the peer */
+	double block_rate{ 0.0 };
+	/** Rolling average of the connection setup and first block delays */
+	double latency_ms{ 0.0 };
+	uint64_t rate_samples{ 0 };
+	uint64_t latency_samples{ 0 };
+	/** Network errors and slow peer stops since the peer last served blocks */
+	uint64_t failures{ 0 };
+	std::chrono::steady_clock::time_point last_update{ std::chrono::steady_clock::now () };
+	double score () const;
+};
+
+/**
+ * Bounded per-peer bootstrap throughput and latency statistics. Owned by bootstrap_connections so scores survive across bootstrap attempts,
+ * the least recently updated peers are evicted first.
+ */
+class bootstrap_peer_scores final
+{
+public:
+	void sample_rate (scendere::tcp_endpoint const &, double);
+	void sample_latency (scendere::tcp_endpoint const &, std::chrono::steady_clock::duration const &);
+	void failure (scendere::tcp_endpoint const &);
+	/** Returns the score of a peer, or none if it has not served blocks yet */
+	boost::optional<double> score (scendere::tcp_endpoint const &) const;
+	/** Average score of the peers which have served blocks, 0 if there are none */
+	double average () const;
+	/** Copies of all scores, highest score first */
+	std::vector<scendere::bootstrap_peer_score> list () const;
+	std::size_t size () const;
+	static std::size_t constexpr scores_max = 4096;
+	/** Weight of a new sample in the rolling averages */
+	static double constexpr sample_weight = 0.25;
+
+private:
+	template <typename Modify>
+	void update (scendere::tcp_endpoint const &, Modify);
+	class tag_endpoint
+	{
+	};
+	class tag_last_update
+	{
+	};
+	mutable scendere::mutex mutex;
+	// clang-format off
+	boost::multi_index_container<scendere::bootstrap_peer_score,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_endpoint>,
+			mi::member<scendere::bootstrap_peer_score, scendere::tcp_endpoint, &scendere::bootstrap_peer_score::endpoint>>,
+		mi::ordered_non_unique<mi::tag<tag_last_update>,
+			mi::member<scendere::bootstrap_peer_score, std::chrono::steady_clock::time_point, &scendere::bootstrap_peer_score::last_update>>>>
+	scores;
+	// clang-format on
+};
+
 /**
  * Container for bootstrap_client objects. Owned by bootstrap_initiator which pools open connections and makes them available
  * for use by different bootstrap sessions.
@@ -55,11 +121,18 @@ class bootstrap_connections final : public std::enable_shared_from_this<bootstra
 public:
 	explicit bootstrap_connections (scendere::node & node_a);
 	std::shared_ptr<scendere::bootstrap_client> connection (std::shared_ptr<scendere::bootstrap_attempt> const & attempt_a = nullptr, bool use_front_connection = false);
+	/** Returns an idle connection without waiting, or nullptr if there is none */
+	std::shared_ptr<scendere::bootstrap_client> try_connection ();
 	void pool_connection (std::shared_ptr<scendere::bootstrap_client> const & client_a, bool new_client = false, bool push_front = false);
 	void add_connection (scendere::endpoint const & endpoint_a);
 	std::shared_ptr<scendere::bootstrap_client> find_connection (scendere::tcp_endpoint const & endpoint_a);
 	void connect_client (scendere::tcp_endpoint const & endpoint_a, bool push_front = false);
 	unsigned target_connections (std::size_t pulls_remaining, std::size_t attempts_count) const;
+	/**
+	 * Adjusts the connection target within [floor, ceiling] from the measured aggregate block rate. The target grows while more connections keep raising
+	 * the rate and shrinks back when the rate falls, evaluated once per ingest_window
+	 */
+	unsigned ingest_target (unsigned floor_a, unsigned ceiling_a, double rate_a, std::chrono::steady_clock::time_point now_a = std::chrono::steady_clock::now ());
 	void populate_connections (bool repeat = true);
 	void start_populate_connections ();
 	void add_pull (scendere::pull_info const & pull_a);
@@ -73,10 +146,20 @@ public:
 	scendere::node & node;
 	std::deque<std::shared_ptr<scendere::bootstrap_client>> idle;
 	std::deque<scendere::pull_info> pulls;
+	scendere::bootstrap_peer_scores scores;
+	/** Connection target from the last ingest evaluation and the aggregate rate it was measured at, updated under mutex and read without it by RPC */
+	std::atomic<unsigned> ingest_target_m{ 0 };
+	std::atomic<double> ingest_rate{ 0.0 };
+	std::chrono::steady_clock::time_point ingest_evaluated;
+	static std::chrono::seconds constexpr ingest_window{ 5 };
 	std::atomic<bool> populate_connections_started{ false };
 	std::atomic<bool> new_connections_empty{ false };
 	std::atomic<bool> stopped{ false };
 	scendere::mutex mutex;
 	scendere::condition_variable condition;
+
+private:
+	/** Picks the idle connection to the best scoring peer, peers without a score yet count as average */
+	std::deque<std::shared_ptr<scendere::bootstrap_client>>::iterator best_idle ();
 };
 }
@@ -11,16 +11,28 @@ constexpr double scendere::bootstrap_limits::bootstrap_minimum_frontier_blocks_p
 constexpr unsigned scendere::bootstrap_limits::bulk_push_cost_limit;
 
 constexpr std::size_t scendere::frontier_req_client::size_frontier;
+constexpr std::size_t scendere::frontier_req_server::batch_size;
 
-void scendere::frontier_req_client::run (scendere::account const & start_account_a, uint32_t const frontiers_age_a, uint32_t const count_a)
+void scendere::frontier_req_client::run (scendere::account const & start_account_a, uint32_t const frontiers_age_a, uint32_t const count_a, scendere::account const & end_account_a)
 {
 	scendere::frontier_req request{ connection->node->network_params.network };
 	request.start = (start_account_a.is_zero () || start_account_a.number () == std::numeric_limits<scendere::uint256_t>::max ()) ? start_account_a : start_account_a.number () + 1;
 	request.age = frontiers_age_a;
 	request.count = count_a;
+	if (end_account_a.number () != std::numeric_limits<scendere::uint256_t>::max ())
+	{
+		// Only peers known to understand the range end are sent it, older ones would misread the longer payload
+		auto channel (connection->node->network.tcp_channels.find_channel (connection->channel->get_tcp_endpoint ()));
+		if (channel != nullptr && channel->get_network_version () >= connection->node->network_params.network.frontier_req_end_version_min)
+		{
+			request.end = end_account_a;
+			request.header.flag_set (scendere::message_header::frontier_req_end_present_flag);
+		}
+	}
 	current = start_account_a;
 	frontiers_age = frontiers_age_a;
 	count_limit = count_a;
+	end_account = end_account_a;
 	next (); // Load accounts from disk
 	auto this_l (shared_from_this ());
 	connection->channel->send (
@@ -77,7 +89,7 @@ void scendere::frontier_req_client::unsynced (scendere::block_hash const & head,
 {
 	if (bulk_push_available ())
 	{
-		attempt->add_bulk_push_target (head, end);
+		attempt->add_bulk_push_target (connection->channel->get_tcp_endpoint (), head, end);
 		if (end.is_zero ())
 		{
 			bulk_push_cost += 2;
@@ -124,7 +136,9 @@ void scendere::frontier_req_client::received_frontier (boost::system::error_code
 		{
 			connection->node->logger.always_log (boost::str (boost::format ("Received %1% frontiers from %2%") % std::to_string (count) % connection->channel->to_string ()));
 		}
-		if (!account.is_zero () && count <= count_limit)
+		// Servers not sent the range end keep streaming past it, everything after it belongs to another client
+		auto range_end (!account.is_zero () && account.number () >= end_account.number ());
+		if (!account.is_zero () && !range_end && count <= count_limit)
 		{
 			last_account = account;
 			while (!current.is_zero () && current < account)
@@ -150,7 +164,7 @@ void scendere::frontier_req_client::received_frontier (boost::system::error_code
 						}
 						else
 						{
-							attempt->add_frontier (scendere::pull_info (account, latest, frontier, attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit));
+							pulls.emplace_back (account, latest, frontier, attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit);
 							// Either we're behind or there's a fork we differ on
 							// Either way, bulk pushing will probably not be effective
 							bulk_push_cost += 5;
@@ -161,12 +175,12 @@ void scendere::frontier_req_client::received_frontier (boost::system::error_code
 				else
 				{
 					debug_assert (account < current);
-					attempt->add_frontier (scendere::pull_info (account, latest, scendere::block_hash (0), attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit));
+					pulls.emplace_back (account, latest, scendere::block_hash (0), attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit);
 				}
 			}
 			else
 			{
-				attempt->add_frontier (scendere::pull_info (account, latest, scendere::block_hash (0), attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit));
+				pulls.emplace_back (account, latest, scendere::block_hash (0), attempt->incremental_id, 0, connection->node->network_params.bootstrap.frontier_retry_limit);
 			}
 			receive_frontier ();
 		}
@@ -174,14 +188,14 @@ void scendere::frontier_req_client::received_frontier (boost::system::error_code
 		{
 			if (count <= count_limit)
 			{
-				while (!current.is_zero () && bulk_push_available ())
+				while (!current.is_zero () && current < end_account && bulk_push_available ())
 				{
 					// We know about an account they don't.
 					unsynced (frontier, 0);
 					next ();
 				}
 				// Prevent new frontier_req requests
-				attempt->set_start_account (std::numeric_limits<scendere::uint256_t>::max ());
+				attempt->set_start_account (std::numeric_limits<scendere::uint256_t>::max (), end_account);
 				if (connection->node->config.logging.bulk_pull_logging ())
 				{
 					connection->node->logger.try_log ("Bulk push cost: ", bulk_push_cost);
@@ -190,9 +204,22 @@ void scendere::frontier_req_client::received_frontier (boost::system::error_code
 			else
 			{
 				// Set last processed account as new start target
-				attempt->set_start_account (last_account);
+				attempt->set_start_account (last_account, end_account);
+			}
+			for (auto const & pull : pulls)
+			{
+				attempt->add_frontier (pull);
+			}
+			if (range_end)
+			{
+				// Unread frontiers are still in flight so the connection cannot be reused, open a fresh one to the same peer for the remaining ranges
+				connection->connections.connect_client (connection->channel->get_tcp_endpoint ());
+				connection->socket->close ();
+			}
+			else
+			{
+				connection->connections.pool_connection (connection);
 			}
-			connection->connections.pool_connection (connection);
 			try
 			{
 				promise.set_value (false);
@@ -254,18 +281,25 @@ void scendere::frontier_req_server::send_next ()
 	{
 		std::vector<uint8_t> send_buffer;
 		{
+			// Stream every frontier already read from the store in one write
 			scendere::vectorstream stream (send_buffer);
-			write (stream, current.bytes);
-			write (stream, frontier.bytes);
-			debug_assert (!current.is_zero ());
-			debug_assert (!frontier.is_zero ());
+			auto last (false);
+			do
+			{
+				write (stream, current.bytes);
+				write (stream, frontier.bytes);
+				debug_assert (!current.is_zero ());
+				debug_assert (!frontier.is_zero ());
+				if (connection->node->config.logging.bulk_pull_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
+				}
+				++count;
+				last = accounts.empty ();
+				next ();
+			} while (!last && !current.is_zero () && count < request->count);
 		}
 		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
-		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
-		}
-		next ();
 		connection->socket->async_write (scendere::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
 		});
@@ -314,7 +348,6 @@ void scendere::frontier_req_server::sent_action (boost::system::error_code const
 {
 	if (!ec)
 	{
-		count++;
 		send_next ();
 	}
 	else
@@ -333,11 +366,13 @@ void scendere::frontier_req_server::next ()
 	{
 		auto now (scendere::seconds_since_epoch ());
 		bool disable_age_filter (request->age == std::numeric_limits<decltype (request->age)>::max ());
-		std::size_t max_size (128);
+		auto max_size (batch_size);
+		// Stop at the end of the requested range so the client can reuse the connection
+		auto end_present (request->header.frontier_req_is_end_present ());
 		auto transaction (connection->node->store.tx_begin_read ());
 		if (!send_confirmed ())
 		{
-			for (auto i (connection->node->store.account.begin (transaction, current.number () + 1)), n (connection->node->store.account.end ()); i != n && accounts.size () != max_size; ++i)
+			for (auto i (connection->node->store.account.begin (transaction, current.number () + 1)), n (connection->node->store.account.end ()); i != n && accounts.size () != max_size && (!end_present || i->first < request->end); ++i)
 			{
 				scendere::account_info const & info (i->second);
 				if (disable_age_filter || (now - info.modified) <= request->age)
@@ -349,7 +384,7 @@ void scendere::frontier_req_server::next ()
 		}
 		else
 		{
-			for (auto i (connection->node->store.confirmation_height.begin (transaction, current.number () + 1)), n (connection->node->store.confirmation_height.end ()); i != n && accounts.size () != max_size; ++i)
+			for (auto i (connection->node->store.confirmation_height.begin (transaction, current.number () + 1)), n (connection->node->store.confirmation_height.end ()); i != n && accounts.size () != max_size && (!end_present || i->first < request->end); ++i)
 			{
 				scendere::confirmation_height_info const & info (i->second);
 				scendere::block_hash const & confirmed_frontier (info.frontier);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <scendere/node/bootstrap/bootstrap_bulk_pull.hpp>
 #include <scendere/node/common.hpp>
 
 #include <deque>
@@ -17,7 +18,8 @@ class frontier_req_client final : public std::enable_shared_from_this<scendere::
 {
 public:
 	explicit frontier_req_client (std::shared_ptr<scendere::bootstrap_client> const &, std::shared_ptr<scendere::bootstrap_attempt> const &);
-	void run (scendere::account const & start_account_a, uint32_t const frontiers_age_a, uint32_t const count_a);
+	/** Requests frontiers after \p start_account_a, stopping at \p end_account_a (exclusive) so several clients can split the account space */
+	void run (scendere::account const & start_account_a, uint32_t const frontiers_age_a, uint32_t const count_a, scendere::account const & end_account_a = std::numeric_limits<scendere::uint256_t>::max ());
 	void receive_frontier ();
 	void received_frontier (boost::system::error_code const &, std::size_t);
 	bool bulk_push_available ();
@@ -29,6 +31,9 @@ public:
 	scendere::block_hash frontier;
 	unsigned count;
 	scendere::account last_account{ std::numeric_limits<scendere::uint256_t>::max () }; // Using last possible account stop further frontier requests
+	scendere::account end_account{ std::numeric_limits<scendere::uint256_t>::max () };
+	/** Out of sync accounts found, only handed to the attempt when the whole request succeeds */
+	std::deque<scendere::pull_info> pulls;
 	std::chrono::steady_clock::time_point start_time;
 	std::promise<bool> promise;
 	/** A very rough estimate of the cost of `bulk_push`ing missing blocks */
@@ -60,5 +65,7 @@ public:
 	std::unique_ptr<scendere::frontier_req> request;
 	std::size_t count;
 	std::deque<std::pair<scendere::account, scendere::block_hash>> accounts;
+	/** Number of accounts read from the store at once, all of them are sent in a single write */
+	static std::size_t constexpr batch_size = 1024;
 };
 }
@@ -13,6 +13,124 @@ constexpr uint64_t scendere::bootstrap_limits::lazy_batch_pull_count_resize_bloc
 constexpr double scendere::bootstrap_limits::lazy_batch_pull_count_resize_ratio;
 constexpr std::size_t scendere::bootstrap_limits::lazy_blocks_restart_limit;
 
+bool scendere::lazy_fingerprint_set::insert (scendere::block_hash const & hash_a)
+{
+	auto fingerprint_l (fingerprint (hash_a));
+	auto result (false);
+	if (find_slot (fingerprint_l) == slots.size ())
+	{
+		if ((count + 1) * 4 > slots.size () * 3)
+		{
+			rehash (std::max<std::size_t> (16, slots.size () * 2));
+		}
+		auto mask (slots.size () - 1);
+		auto index (fingerprint_l & mask);
+		while (slots[index] != 0)
+		{
+			index = (index + 1) & mask;
+		}
+		slots[index] = fingerprint_l;
+		++count;
+		result = true;
+	}
+	return result;
+}
+
+bool scendere::lazy_fingerprint_set::erase (scendere::block_hash const & hash_a)
+{
+	auto index (find_slot (fingerprint (hash_a)));
+	auto result (index != slots.size ());
+	if (result)
+	{
+		// Backward shift deletion, see lazy_hash_table::erase
+		auto mask (slots.size () - 1);
+		auto hole (index);
+		for (auto next ((hole + 1) & mask); slots[next] != 0; next = (next + 1) & mask)
+		{
+			if (((next - slots[next]) & mask) >= ((next - hole) & mask))
+			{
+				slots[hole] = slots[next];
+				hole = next;
+			}
+		}
+		slots[hole] = 0;
+		--count;
+	}
+	return result;
+}
+
+bool scendere::lazy_fingerprint_set::contains (scendere::block_hash const & hash_a) const
+{
+	return find_slot (fingerprint (hash_a)) != slots.size ();
+}
+
+void scendere::lazy_fingerprint_set::clear ()
+{
+	slots.clear ();
+	slots.shrink_to_fit ();
+	count = 0;
+}
+
+std::size_t scendere::lazy_fingerprint_set::size () const
+{
+	return count;
+}
+
+bool scendere::lazy_fingerprint_set::empty () const
+{
+	return count == 0;
+}
+
+std::size_t scendere::lazy_fingerprint_set::memory_usage () const
+{
+	return slots.capacity () * sizeof (decltype (slots)::value_type);
+}
+
+uint64_t scendere::lazy_fingerprint_set::fingerprint (scendere::block_hash const & hash_a)
+{
+	// Zero marks empty slots
+	uint64_t result (std::hash<::scendere::block_hash> () (hash_a));
+	return result != 0 ? result : 1;
+}
+
+std::size_t scendere::lazy_fingerprint_set::find_slot (uint64_t fingerprint_a) const
+{
+	auto result (slots.size ());
+	if (!slots.empty ())
+	{
+		auto mask (slots.size () - 1);
+		for (auto index (fingerprint_a & mask); slots[index] != 0; index = (index + 1) & mask)
+		{
+			if (slots[index] == fingerprint_a)
+			{
+				result = index;
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+void scendere::lazy_fingerprint_set::rehash (std::size_t capacity_a)
+{
+	debug_assert ((capacity_a & (capacity_a - 1)) == 0);
+	std::vector<uint64_t> old_slots (capacity_a, 0);
+	old_slots.swap (slots);
+	auto mask (slots.size () - 1);
+	for (auto fingerprint_l : old_slots)
+	{
+		if (fingerprint_l != 0)
+		{
+			auto index (fingerprint_l & mask);
+			while (slots[index] != 0)
+			{
+				index = (index + 1) & mask;
+			}
+			slots[index] = fingerprint_l;
+		}
+	}
+}
+
 scendere::bootstrap_attempt_lazy::bootstrap_attempt_lazy (std::shared_ptr<scendere::node> const & node_a, uint64_t incremental_id_a, std::string const & id_a) :
 	scendere::bootstrap_attempt (node_a, scendere::bootstrap_mode::lazy, incremental_id_a, id_a)
 {
@@ -259,10 +377,10 @@ bool scendere::bootstrap_attempt_lazy::process_block_lazy (std::shared_ptr<scend
 		// Adding lazy balances for first processed block in pull
 		if (pull_blocks_processed == 1 && (block_a->type () == scendere::block_type::state || block_a->type () == scendere::block_type::send))
 		{
-			lazy_balances.emplace (hash, block_a->balance ().number ());
+			lazy_balances.insert (hash, block_a->balance ());
 		}
 		// Clearing lazy balances for previous block
-		if (!block_a->previous ().is_zero () && lazy_balances.find (block_a->previous ()) != lazy_balances.end ())
+		if (!block_a->previous ().is_zero ())
 		{
 			lazy_balances.erase (block_a->previous ());
 		}
@@ -314,19 +432,19 @@ void scendere::bootstrap_attempt_lazy::lazy_block_state (std::shared_ptr<scender
 			else if (lazy_blocks_processed (previous))
 			{
 				auto previous_balance (lazy_balances.find (previous));
-				if (previous_balance != lazy_balances.end ())
+				if (previous_balance != nullptr)
 				{
-					if (previous_balance->second <= balance)
+					if (previous_balance->number () <= balance)
 					{
 						lazy_add (link, retry_limit);
 					}
-					lazy_balances.erase (previous_balance);
+					lazy_balances.erase (previous);
 				}
 			}
 			// Insert in backlog state blocks if previous wasn't already processed
 			else
 			{
-				lazy_state_backlog.emplace (previous, scendere::lazy_state_backlog_item{ link, balance, retry_limit });
+				lazy_state_backlog.insert (previous, scendere::lazy_state_backlog_item{ link, balance, retry_limit });
 			}
 		}
 	}
@@ -336,55 +454,56 @@ void scendere::bootstrap_attempt_lazy::lazy_block_state_backlog_check (std::shar
 {
 	// Search unknown state blocks balances
 	auto find_state (lazy_state_backlog.find (hash_a));
-	if (find_state != lazy_state_backlog.end ())
+	if (find_state != nullptr)
 	{
-		auto next_block (find_state->second);
+		auto next_block (*find_state);
 		// Retrieve balance for previous state & send blocks
 		if (block_a->type () == scendere::block_type::state || block_a->type () == scendere::block_type::send)
 		{
-			if (block_a->balance ().number () <= next_block.balance) // balance
+			if (block_a->balance ().number () <= next_block.balance.number ()) // balance
 			{
 				lazy_add (next_block.link, next_block.retry_limit); // link
 			}
 		}
 		// Assumption for other legacy block types
-		else if (lazy_undefined_links.find (next_block.link.as_block_hash ()) == lazy_undefined_links.end ())
+		else if (lazy_undefined_links.insert (next_block.link.as_block_hash ()).second)
 		{
 			lazy_add (next_block.link, node->network_params.bootstrap.lazy_retry_limit); // Head is not confirmed. It can be account or hash or non-existing
-			lazy_undefined_links.insert (next_block.link.as_block_hash ());
 		}
-		lazy_state_backlog.erase (find_state);
+		lazy_state_backlog.erase (hash_a);
 	}
 }
 
 void scendere::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 {
 	uint64_t read_count (0);
+	std::vector<scendere::block_hash> processed;
 	auto transaction (node->store.tx_begin_read ());
-	for (auto it (lazy_state_backlog.begin ()), end (lazy_state_backlog.end ()); it != end && !stopped;)
-	{
-		if (node->ledger.block_or_pruned_exists (transaction, it->first))
+	lazy_state_backlog.for_each ([this, &read_count, &processed, &transaction] (scendere::block_hash const & previous_a, scendere::lazy_state_backlog_item const & next_block_a) {
+		if (stopped)
+		{
+			return;
+		}
+		if (node->ledger.block_or_pruned_exists (transaction, previous_a))
 		{
-			auto next_block (it->second);
 			bool error_or_pruned (false);
-			auto balance (node->ledger.balance_safe (transaction, it->first, error_or_pruned));
+			auto balance (node->ledger.balance_safe (transaction, previous_a, error_or_pruned));
 			if (!error_or_pruned)
 			{
-				if (balance <= next_block.balance) // balance
+				if (balance <= next_block_a.balance.number ()) // balance
 				{
-					lazy_add (next_block.link, next_block.retry_limit); // link
+					lazy_add (next_block_a.link, next_block_a.retry_limit); // link
 				}
 			}
 			else
 			{
-				lazy_add (next_block.link, node->network_params.bootstrap.lazy_retry_limit); // Not confirmed
+				lazy_add (next_block_a.link, node->network_params.bootstrap.lazy_retry_limit); // Not confirmed
 			}
-			it = lazy_state_backlog.erase (it);
+			processed.push_back (previous_a);
 		}
 		else
 		{
-			lazy_add (it->first, it->second.retry_limit);
-			++it;
+			lazy_add (previous_a, next_block_a.retry_limit);
 		}
 		// We don't want to open read transactions for too long
 		++read_count;
@@ -392,14 +511,18 @@ void scendere::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 		{
 			transaction.refresh ();
 		}
+	});
+	// Erasing shifts entries within the table, so it is deferred until iteration completes
+	for (auto const & previous : processed)
+	{
+		lazy_state_backlog.erase (previous);
 	}
 }
 
 void scendere::bootstrap_attempt_lazy::lazy_blocks_insert (scendere::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto inserted (lazy_blocks.insert (std::hash<::scendere::block_hash> () (hash_a)));
-	if (inserted.second)
+	if (lazy_blocks.insert (hash_a))
 	{
 		++lazy_blocks_count;
 		debug_assert (lazy_blocks_count > 0);
@@ -409,8 +532,7 @@ void scendere::bootstrap_attempt_lazy::lazy_blocks_insert (scendere::block_hash
 void scendere::bootstrap_attempt_lazy::lazy_blocks_erase (scendere::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto erased (lazy_blocks.erase (std::hash<::scendere::block_hash> () (hash_a)));
-	if (erased)
+	if (lazy_blocks.erase (hash_a))
 	{
 		--lazy_blocks_count;
 		debug_assert (lazy_blocks_count != std::numeric_limits<std::size_t>::max ());
@@ -419,7 +541,7 @@ void scendere::bootstrap_attempt_lazy::lazy_blocks_erase (scendere::block_hash c
 
 bool scendere::bootstrap_attempt_lazy::lazy_blocks_processed (scendere::block_hash const & hash_a)
 {
-	return lazy_blocks.find (std::hash<::scendere::block_hash> () (hash_a)) != lazy_blocks.end ();
+	return lazy_blocks.contains (hash_a);
 }
 
 bool scendere::bootstrap_attempt_lazy::lazy_processed_or_exists (scendere::block_hash const & hash_a)
@@ -441,6 +563,12 @@ bool scendere::bootstrap_attempt_lazy::lazy_processed_or_exists (scendere::block
 	return result;
 }
 
+std::size_t scendere::bootstrap_attempt_lazy::lazy_memory_usage ()
+{
+	debug_assert (!mutex.try_lock ());
+	return lazy_blocks.memory_usage () + lazy_state_backlog.memory_usage () + lazy_undefined_links.size () * sizeof (decltype (lazy_undefined_links)::value_type) + lazy_balances.memory_usage () + lazy_pulls.size () * sizeof (decltype (lazy_pulls)::value_type) + lazy_keys.size () * sizeof (decltype (lazy_keys)::value_type);
+}
+
 unsigned scendere::bootstrap_attempt_lazy::lazy_retry_limit_confirmed ()
 {
 	debug_assert (!mutex.try_lock ());
@@ -462,6 +590,7 @@ void scendere::bootstrap_attempt_lazy::get_information (boost::property_tree::pt
 	tree_a.put ("lazy_undefined_links", std::to_string (lazy_undefined_links.size ()));
 	tree_a.put ("lazy_pulls", std::to_string (lazy_pulls.size ()));
 	tree_a.put ("lazy_keys", std::to_string (lazy_keys.size ()));
+	tree_a.put ("lazy_memory", std::to_string (lazy_memory_usage ()));
 	if (!lazy_keys.empty ())
 	{
 		tree_a.put ("lazy_key_1", (*(lazy_keys.begin ())).to_string ());
@@ -566,3 +695,17 @@ void scendere::bootstrap_attempt_wallet::get_information (boost::property_tree::
 	scendere::lock_guard<scendere::mutex> lock (mutex);
 	tree_a.put ("wallet_accounts", std::to_string (wallet_accounts.size ()));
 }
+
+std::unique_ptr<scendere::container_info_component> scendere::collect_container_info (bootstrap_attempt_lazy & bootstrap_attempt_lazy, std::string const & name)
+{
+	scendere::lock_guard<scendere::mutex> lock (bootstrap_attempt_lazy.mutex);
+	auto composite = std::make_unique<container_info_composite> (name);
+	// Flat tables are reported by allocated slots so the leaves add up to their memory usage
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_blocks", bootstrap_attempt_lazy.lazy_blocks.memory_usage () / sizeof (uint64_t), sizeof (uint64_t) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_state_backlog", bootstrap_attempt_lazy.lazy_state_backlog.memory_usage () / sizeof (decltype (bootstrap_attempt_lazy.lazy_state_backlog)::entry), sizeof (decltype (bootstrap_attempt_lazy.lazy_state_backlog)::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_undefined_links", bootstrap_attempt_lazy.lazy_undefined_links.size (), sizeof (decltype (bootstrap_attempt_lazy.lazy_undefined_links)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_balances", bootstrap_attempt_lazy.lazy_balances.memory_usage () / sizeof (decltype (bootstrap_attempt_lazy.lazy_balances)::entry), sizeof (decltype (bootstrap_attempt_lazy.lazy_balances)::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_pulls", bootstrap_attempt_lazy.lazy_pulls.size (), sizeof (decltype (bootstrap_attempt_lazy.lazy_pulls)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "lazy_keys", bootstrap_attempt_lazy.lazy_keys.size (), sizeof (decltype (bootstrap_attempt_lazy.lazy_keys)::value_type) }));
+	return composite;
+}
@@ -7,9 +7,11 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <queue>
 #include <unordered_set>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -20,10 +22,174 @@ class lazy_state_backlog_item final
 {
 public:
 	scendere::link link{ 0 };
-	scendere::uint128_t balance{ 0 };
+	scendere::amount balance{ 0 };
 	unsigned retry_limit{ 0 };
 };
 
+/**
+ * Open addressing set of 64 bit block hash fingerprints using linear probing, around 11 bytes per entry at the maximum load factor.
+ * Distinct hashes sharing a fingerprint are treated as the same block, the same trade-off as hashing into std::size_t.
+ */
+class lazy_fingerprint_set final
+{
+public:
+	bool insert (scendere::block_hash const &);
+	bool erase (scendere::block_hash const &);
+	bool contains (scendere::block_hash const &) const;
+	void clear ();
+	std::size_t size () const;
+	bool empty () const;
+	std::size_t memory_usage () const;
+
+private:
+	static uint64_t fingerprint (scendere::block_hash const &);
+	std::size_t find_slot (uint64_t) const;
+	void rehash (std::size_t);
+	std::vector<uint64_t> slots;
+	std::size_t count{ 0 };
+};
+
+/**
+ * Flat open addressing table keyed by full block hashes, using linear probing with backward shift deletion so no tombstones accumulate.
+ * The zero hash marks an empty slot and cannot be stored.
+ */
+template <typename T>
+class lazy_hash_table final
+{
+public:
+	class entry final
+	{
+	public:
+		scendere::block_hash key{ 0 };
+		T value{};
+	};
+	T * find (scendere::block_hash const & key_a)
+	{
+		auto index (find_slot (key_a));
+		return index != slots.size () ? &slots[index].value : nullptr;
+	}
+	/** Inserts unless the key is already present, as std::unordered_map::emplace does */
+	bool insert (scendere::block_hash const & key_a, T const & value_a)
+	{
+		debug_assert (!key_a.is_zero ());
+		auto result (false);
+		if (find_slot (key_a) == slots.size ())
+		{
+			if ((count + 1) * 4 > slots.size () * 3)
+			{
+				rehash (std::max<std::size_t> (16, slots.size () * 2));
+			}
+			auto index (home (key_a));
+			while (!slots[index].key.is_zero ())
+			{
+				index = (index + 1) & mask ();
+			}
+			slots[index] = entry{ key_a, value_a };
+			++count;
+			result = true;
+		}
+		return result;
+	}
+	bool erase (scendere::block_hash const & key_a)
+	{
+		auto index (find_slot (key_a));
+		auto result (index != slots.size ());
+		if (result)
+		{
+			// Shift following entries of the probe sequence back into the hole when it is not before their home slot
+			auto hole (index);
+			for (auto next ((hole + 1) & mask ()); !slots[next].key.is_zero (); next = (next + 1) & mask ())
+			{
+				if (((next - home (slots[next].key)) & mask ()) >= ((next - hole) & mask ()))
+				{
+					slots[hole] = slots[next];
+					hole = next;
+				}
+			}
+			slots[hole] = entry{};
+			--count;
+		}
+		return result;
+	}
+	/** Calls the action with each key and value, entries must not be inserted or erased meanwhile */
+	template <typename F>
+	void for_each (F const & action_a) const
+	{
+		for (auto const & entry_l : slots)
+		{
+			if (!entry_l.key.is_zero ())
+			{
+				action_a (entry_l.key, entry_l.value);
+			}
+		}
+	}
+	void clear ()
+	{
+		slots.clear ();
+		slots.shrink_to_fit ();
+		count = 0;
+	}
+	std::size_t size () const
+	{
+		return count;
+	}
+	bool empty () const
+	{
+		return count == 0;
+	}
+	std::size_t memory_usage () const
+	{
+		return slots.capacity () * sizeof (entry);
+	}
+
+private:
+	std::size_t mask () const
+	{
+		return slots.size () - 1;
+	}
+	std::size_t home (scendere::block_hash const & key_a) const
+	{
+		return std::hash<::scendere::block_hash> () (key_a) & mask ();
+	}
+	/** Returns the slot holding the key, or the table size if it is absent */
+	std::size_t find_slot (scendere::block_hash const & key_a) const
+	{
+		auto result (slots.size ());
+		if (!slots.empty ())
+		{
+			for (auto index (home (key_a)); !slots[index].key.is_zero (); index = (index + 1) & mask ())
+			{
+				if (slots[index].key == key_a)
+				{
+					result = index;
+					break;
+				}
+			}
+		}
+		return result;
+	}
+	void rehash (std::size_t capacity_a)
+	{
+		debug_assert ((capacity_a & (capacity_a - 1)) == 0);
+		std::vector<entry> old_slots (capacity_a);
+		old_slots.swap (slots);
+		for (auto const & entry_l : old_slots)
+		{
+			if (!entry_l.key.is_zero ())
+			{
+				auto index (home (entry_l.key));
+				while (!slots[index].key.is_zero ())
+				{
+					index = (index + 1) & mask ();
+				}
+				slots[index] = entry_l;
+			}
+		}
+	}
+	std::vector<entry> slots;
+	std::size_t count{ 0 };
+};
+
 /**
  * Lazy bootstrap session. Started with a block hash, this will "trace down" the blocks obtained to find a connection to the ledger.
  * This attempts to quickly bootstrap a section of the ledger given a hash that's known to be confirmed.
@@ -53,10 +219,13 @@ public:
 	bool lazy_processed_or_exists (scendere::block_hash const &) override;
 	unsigned lazy_retry_limit_confirmed ();
 	void get_information (boost::property_tree::ptree &) override;
-	std::unordered_set<std::size_t> lazy_blocks;
-	std::unordered_map<scendere::block_hash, scendere::lazy_state_backlog_item> lazy_state_backlog;
+	/** Approximate heap usage of the lazy containers in bytes */
+	std::size_t lazy_memory_usage ();
+	scendere::lazy_fingerprint_set lazy_blocks;
+	scendere::lazy_hash_table<scendere::lazy_state_backlog_item> lazy_state_backlog;
+	/** Kept exact, a fingerprint collision would skip pulling a link which is not in the ledger */
 	std::unordered_set<scendere::block_hash> lazy_undefined_links;
-	std::unordered_map<scendere::block_hash, scendere::uint128_t> lazy_balances;
+	scendere::lazy_hash_table<scendere::amount> lazy_balances;
 	std::unordered_set<scendere::block_hash> lazy_keys;
 	std::deque<std::pair<scendere::hash_or_account, unsigned>> lazy_pulls;
 	std::chrono::steady_clock::time_point lazy_start_time;
@@ -83,4 +252,6 @@ public:
 	void get_information (boost::property_tree::ptree &) override;
 	std::deque<scendere::account> wallet_accounts;
 };
+
+std::unique_ptr<container_info_component> collect_container_info (bootstrap_attempt_lazy & bootstrap_attempt_lazy, std::string const & name);
 }
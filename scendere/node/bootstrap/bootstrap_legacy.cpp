@@ -7,9 +7,18 @@
 
 scendere::bootstrap_attempt_legacy::bootstrap_attempt_legacy (std::shared_ptr<scendere::node> const & node_a, uint64_t const incremental_id_a, std::string const & id_a, uint32_t const frontiers_age_a, scendere::account const & start_account_a) :
 	scendere::bootstrap_attempt (node_a, scendere::bootstrap_mode::legacy, incremental_id_a, id_a),
-	frontiers_age (frontiers_age_a),
-	start_account (start_account_a)
+	frontiers_age (frontiers_age_a)
 {
+	// A full frontier scan is split into equal account ranges requested from different peers in parallel
+	auto const max_account (std::numeric_limits<scendere::uint256_t>::max ());
+	unsigned ranges (start_account_a.is_zero () ? std::max (1u, node->config.bootstrap_connections) : 1);
+	scendere::uint256_t range_size (max_account / ranges);
+	for (unsigned i (0); i < ranges; ++i)
+	{
+		scendere::account start (i == 0 ? start_account_a : scendere::account (range_size * i - 1));
+		scendere::account end (i == ranges - 1 ? max_account : range_size * (i + 1));
+		frontier_ranges.emplace_back (start, end);
+	}
 	node->bootstrap_initiator.notify_listeners (true);
 }
 
@@ -34,14 +43,17 @@ void scendere::bootstrap_attempt_legacy::stop ()
 	lock.unlock ();
 	condition.notify_all ();
 	lock.lock ();
-	if (auto i = frontiers.lock ())
+	for (auto const & frontier : frontiers)
 	{
-		try
-		{
-			i->promise.set_value (true);
-		}
-		catch (std::future_error &)
+		if (auto i = frontier.lock ())
 		{
+			try
+			{
+				i->promise.set_value (true);
+			}
+			catch (std::future_error &)
+			{
+			}
 		}
 	}
 	if (auto i = push.lock ())
@@ -60,31 +72,39 @@ void scendere::bootstrap_attempt_legacy::stop ()
 
 void scendere::bootstrap_attempt_legacy::request_push (scendere::unique_lock<scendere::mutex> & lock_a)
 {
-	bool error (false);
-	lock_a.unlock ();
-	auto connection_l (node->bootstrap_initiator.connections->find_connection (endpoint_frontier_request));
-	lock_a.lock ();
-	if (connection_l)
+	// Push to every peer that served a frontier range, each only gets the blocks its own frontiers showed it was missing
+	while (!bulk_push_targets.empty () && !stopped)
 	{
-		std::future<bool> future;
-		{
-			auto this_l (shared_from_this ());
-			auto client (std::make_shared<scendere::bulk_push_client> (connection_l, this_l));
-			client->start ();
-			push = client;
-			future = client->promise.get_future ();
-		}
+		auto endpoint (bulk_push_targets.begin ()->first);
+		push_targets = std::move (bulk_push_targets.begin ()->second);
+		bulk_push_targets.erase (bulk_push_targets.begin ());
+		bool error (false);
 		lock_a.unlock ();
-		error = consume_future (future); // This is out of scope of `client' so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
+		auto connection_l (node->bootstrap_initiator.connections->find_connection (endpoint));
 		lock_a.lock ();
-	}
-	if (node->config.logging.network_logging ())
-	{
-		node->logger.try_log ("Exiting bulk push client");
-		if (error)
+		if (connection_l)
 		{
-			node->logger.try_log ("Bulk push client failed");
+			std::future<bool> future;
+			{
+				auto this_l (shared_from_this ());
+				auto client (std::make_shared<scendere::bulk_push_client> (connection_l, this_l));
+				client->start ();
+				push = client;
+				future = client->promise.get_future ();
+			}
+			lock_a.unlock ();
+			error = consume_future (future); // This is out of scope of `client' so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
+			lock_a.lock ();
 		}
+		if (node->config.logging.network_logging ())
+		{
+			node->logger.try_log (boost::str (boost::format ("Exiting bulk push client for %1%") % endpoint));
+			if (error)
+			{
+				node->logger.try_log ("Bulk push client failed");
+			}
+		}
+		push_targets.clear ();
 	}
 }
 
@@ -98,90 +118,112 @@ void scendere::bootstrap_attempt_legacy::add_frontier (scendere::pull_info const
 	}
 }
 
-void scendere::bootstrap_attempt_legacy::add_bulk_push_target (scendere::block_hash const & head, scendere::block_hash const & end)
+void scendere::bootstrap_attempt_legacy::add_bulk_push_target (scendere::tcp_endpoint const & endpoint_a, scendere::block_hash const & head, scendere::block_hash const & end)
 {
 	scendere::lock_guard<scendere::mutex> lock (mutex);
-	bulk_push_targets.emplace_back (head, end);
+	bulk_push_targets[endpoint_a].emplace_back (head, end);
 }
 
 bool scendere::bootstrap_attempt_legacy::request_bulk_push_target (std::pair<scendere::block_hash, scendere::block_hash> & current_target_a)
 {
 	scendere::lock_guard<scendere::mutex> lock (mutex);
-	auto empty (bulk_push_targets.empty ());
+	auto empty (push_targets.empty ());
 	if (!empty)
 	{
-		current_target_a = bulk_push_targets.back ();
-		bulk_push_targets.pop_back ();
+		current_target_a = push_targets.back ();
+		push_targets.pop_back ();
 	}
 	return empty;
 }
 
-void scendere::bootstrap_attempt_legacy::set_start_account (scendere::account const & start_account_a)
+void scendere::bootstrap_attempt_legacy::set_start_account (scendere::account const & start_account_a, scendere::account const & end_account_a)
 {
 	// Add last account fron frontier request
 	scendere::lock_guard<scendere::mutex> lock (mutex);
-	start_account = start_account_a;
+	auto existing (std::find_if (frontier_ranges.begin (), frontier_ranges.end (), [&end_account_a] (auto const & range_a) { return range_a.second == end_account_a; }));
+	if (existing != frontier_ranges.end ())
+	{
+		if (start_account_a.number () == std::numeric_limits<scendere::uint256_t>::max () || start_account_a.number () + 1 >= end_account_a.number ())
+		{
+			frontier_ranges.erase (existing);
+		}
+		else
+		{
+			existing->first = start_account_a;
+		}
+	}
 }
 
 bool scendere::bootstrap_attempt_legacy::request_frontier (scendere::unique_lock<scendere::mutex> & lock_a, bool first_attempt)
 {
-	auto result (true);
-	lock_a.unlock ();
-	auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this (), first_attempt));
-	lock_a.lock ();
-	if (connection_l && !stopped)
+	auto result (!frontier_ranges.empty ());
+	// One frontier request per remaining account range, each on its own connection. Only the first range waits for a connection, the others are requested in later rounds if none is idle
+	std::vector<std::future<bool>> futures;
+	std::vector<std::string> peers;
+	frontiers.clear ();
+	auto ranges (frontier_ranges);
+	for (auto i (ranges.begin ()), n (ranges.end ()); i != n && !stopped; ++i)
 	{
-		endpoint_frontier_request = connection_l->channel->get_tcp_endpoint ();
-		std::future<bool> future;
-		{
-			auto this_l (shared_from_this ());
-			auto client (std::make_shared<scendere::frontier_req_client> (connection_l, this_l));
-			client->run (start_account, frontiers_age, node->config.bootstrap_frontier_request_count);
-			frontiers = client;
-			future = client->promise.get_future ();
-		}
 		lock_a.unlock ();
-		result = consume_future (future); // This is out of scope of `client' so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
+		auto connection_l (i == ranges.begin () ? node->bootstrap_initiator.connections->connection (shared_from_this (), first_attempt) : node->bootstrap_initiator.connections->try_connection ());
 		lock_a.lock ();
-		if (result)
+		if (connection_l == nullptr || stopped)
 		{
-			frontier_pulls.clear ();
+			break;
 		}
-		else
+		auto this_l (shared_from_this ());
+		auto client (std::make_shared<scendere::frontier_req_client> (connection_l, this_l));
+		client->run (i->first, frontiers_age, node->config.bootstrap_frontier_request_count, i->second);
+		frontiers.push_back (client);
+		futures.push_back (client->promise.get_future ());
+		peers.push_back (connection_l->channel->to_string ());
+	}
+	for (std::size_t i (0); i < futures.size (); ++i)
+	{
+		lock_a.unlock ();
+		auto error (consume_future (futures[i])); // The client is out of scope so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
+		lock_a.lock ();
+		// Succeeding with any range is progress, failed ranges are retried in the next round
+		result = result && error;
+		if (node->config.logging.network_logging ())
 		{
-			account_count = scendere::narrow_cast<unsigned int> (frontier_pulls.size ());
-			// Shuffle pulls
-			release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
-			if (!frontier_pulls.empty ())
+			if (!error)
 			{
-				for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
-				{
-					auto k = scendere::random_pool::generate_word32 (0, i);
-					std::swap (frontier_pulls[i], frontier_pulls[k]);
-				}
+				node->logger.try_log (boost::str (boost::format ("Completed frontier request according to %1%") % peers[i]));
 			}
-			// Add to regular pulls
-			while (!frontier_pulls.empty ())
+			else
 			{
-				auto pull (frontier_pulls.front ());
-				lock_a.unlock ();
-				node->bootstrap_initiator.connections->add_pull (pull);
-				lock_a.lock ();
-				++pulling;
-				frontier_pulls.pop_front ();
+				node->stats.inc (scendere::stat::type::error, scendere::stat::detail::frontier_req, scendere::stat::dir::out);
 			}
 		}
-		if (node->config.logging.network_logging ())
+	}
+	if (!result)
+	{
+		account_count = scendere::narrow_cast<unsigned int> (frontier_pulls.size ());
+		// Shuffle pulls
+		release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
+		if (!frontier_pulls.empty ())
 		{
-			if (!result)
-			{
-				node->logger.try_log (boost::str (boost::format ("Completed frontier request, %1% out of sync accounts according to %2%") % account_count % connection_l->channel->to_string ()));
-			}
-			else
+			for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
 			{
-				node->stats.inc (scendere::stat::type::error, scendere::stat::detail::frontier_req, scendere::stat::dir::out);
+				auto k = scendere::random_pool::generate_word32 (0, i);
+				std::swap (frontier_pulls[i], frontier_pulls[k]);
 			}
 		}
+		// Add to regular pulls
+		while (!frontier_pulls.empty ())
+		{
+			auto pull (frontier_pulls.front ());
+			lock_a.unlock ();
+			node->bootstrap_initiator.connections->add_pull (pull);
+			lock_a.lock ();
+			++pulling;
+			frontier_pulls.pop_front ();
+		}
+		if (node->config.logging.network_logging ())
+		{
+			node->logger.try_log (boost::str (boost::format ("%1% out of sync accounts, %2% frontier ranges remaining") % account_count % frontier_ranges.size ()));
+		}
 	}
 	return result;
 }
@@ -191,7 +233,8 @@ void scendere::bootstrap_attempt_legacy::run_start (scendere::unique_lock<scende
 	frontiers_received = false;
 	auto frontier_failure (true);
 	uint64_t frontier_attempts (0);
-	while (!stopped && frontier_failure)
+	// Ranges that were in sync leave nothing to pull, so keep going until there is work or the account space is covered
+	while (!stopped && (frontier_failure || (pulling == 0 && !frontier_ranges.empty ())))
 	{
 		++frontier_attempts;
 		frontier_failure = request_frontier (lock_a, frontier_attempts == 1);
@@ -218,9 +261,9 @@ void scendere::bootstrap_attempt_legacy::run ()
 		lock.unlock ();
 		node->block_processor.flush ();
 		lock.lock ();
-		if (start_account.number () != std::numeric_limits<scendere::uint256_t>::max ())
+		if (!frontier_ranges.empty ())
 		{
-			node->logger.try_log (boost::str (boost::format ("Finished flushing unchecked blocks, requesting new frontiers after %1%") % start_account.to_account ()));
+			node->logger.try_log (boost::str (boost::format ("Finished flushing unchecked blocks, requesting new frontiers after %1%") % frontier_ranges.front ().first.to_account ()));
 			// Requesting new frontiers
 			run_start (lock);
 		}
@@ -252,5 +295,6 @@ void scendere::bootstrap_attempt_legacy::get_information (boost::property_tree::
 	tree_a.put ("frontier_pulls", std::to_string (frontier_pulls.size ()));
 	tree_a.put ("frontiers_received", static_cast<bool> (frontiers_received));
 	tree_a.put ("frontiers_age", std::to_string (frontiers_age));
-	tree_a.put ("last_account", start_account.to_account ());
+	tree_a.put ("last_account", frontier_ranges.empty () ? scendere::account (std::numeric_limits<scendere::uint256_t>::max ()).to_account () : frontier_ranges.front ().first.to_account ());
+	tree_a.put ("frontier_ranges", std::to_string (frontier_ranges.size ()));
 }
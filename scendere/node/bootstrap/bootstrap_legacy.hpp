@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <deque>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -26,17 +27,20 @@ public:
 	bool request_frontier (scendere::unique_lock<scendere::mutex> &, bool = false);
 	void request_push (scendere::unique_lock<scendere::mutex> &);
 	void add_frontier (scendere::pull_info const &) override;
-	void add_bulk_push_target (scendere::block_hash const &, scendere::block_hash const &) override;
+	void add_bulk_push_target (scendere::tcp_endpoint const &, scendere::block_hash const &, scendere::block_hash const &) override;
 	bool request_bulk_push_target (std::pair<scendere::block_hash, scendere::block_hash> &) override;
-	void set_start_account (scendere::account const &) override;
+	void set_start_account (scendere::account const &, scendere::account const &) override;
 	void run_start (scendere::unique_lock<scendere::mutex> &);
 	void get_information (boost::property_tree::ptree &) override;
-	scendere::tcp_endpoint endpoint_frontier_request;
-	std::weak_ptr<scendere::frontier_req_client> frontiers;
+	std::vector<std::weak_ptr<scendere::frontier_req_client>> frontiers;
 	std::weak_ptr<scendere::bulk_push_client> push;
 	std::deque<scendere::pull_info> frontier_pulls;
-	std::vector<std::pair<scendere::block_hash, scendere::block_hash>> bulk_push_targets;
-	scendere::account start_account{};
+	/** Blocks to push, grouped by the peer whose frontiers showed they were missing. Each account range can come from a different peer */
+	std::map<scendere::tcp_endpoint, std::vector<std::pair<scendere::block_hash, scendere::block_hash>>> bulk_push_targets;
+	/** Targets of the peer currently being pushed to */
+	std::vector<std::pair<scendere::block_hash, scendere::block_hash>> push_targets;
+	/** Account ranges still needing frontiers, as pairs of the last account received and the exclusive end of the range */
+	std::deque<std::pair<scendere::account, scendere::account>> frontier_ranges;
 	std::atomic<unsigned> account_count{ 0 };
 	uint32_t frontiers_age;
 };
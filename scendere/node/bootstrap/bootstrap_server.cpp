@@ -627,6 +627,40 @@ void scendere::bootstrap_server::finish_request_async ()
 	});
 }
 
+void scendere::bootstrap_server::write_limited (scendere::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, std::size_t charged_a)
+{
+	auto & limiter (node->network.limiter);
+	auto const burst (std::max<std::size_t> (limiter.burst (scendere::bandwidth_limit_type::bootstrap), 1));
+	while (charged_a < buffer_a.size ())
+	{
+		auto const part (std::min (buffer_a.size () - charged_a, burst));
+		if (limiter.should_drop (part, scendere::bandwidth_limit_type::bootstrap))
+		{
+			break;
+		}
+		charged_a += part;
+	}
+	if (charged_a >= buffer_a.size ())
+	{
+		socket->async_write (buffer_a, callback_a);
+	}
+	else
+	{
+		// Bootstrap responses are streams and cannot be dropped, so retry the remainder once the limiter has refilled
+		node->stats.inc (scendere::stat::type::bandwidth_limiter, scendere::stat::detail::bootstrap_serving_delay, scendere::stat::dir::out);
+		std::weak_ptr<scendere::bootstrap_server> this_w (shared_from_this ());
+		node->workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::milliseconds (10), [this_w, buffer_a, callback_a, charged_a] () {
+			if (auto this_l = this_w.lock ())
+			{
+				if (!this_l->stopped)
+				{
+					this_l->write_limited (buffer_a, callback_a, charged_a);
+				}
+			}
+		});
+	}
+}
+
 void scendere::bootstrap_server::timeout ()
 {
 	if (socket->has_timed_out ())
@@ -60,6 +60,11 @@ public:
 	void add_request (std::unique_ptr<scendere::message>);
 	void finish_request ();
 	void finish_request_async ();
+	/**
+	 * Writes a response, delaying it while the bootstrap share of the outbound bandwidth limit is exhausted.
+	 * Buffers larger than the bootstrap burst are charged against the limiter in parts before being written.
+	 */
+	void write_limited (scendere::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const &, std::size_t charged_a = 0);
 	void timeout ();
 	void run_next (scendere::unique_lock<scendere::mutex> & lock_a);
 	bool is_bootstrap_connection ();
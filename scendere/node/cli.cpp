@@ -59,7 +59,8 @@ void scendere::add_node_options (boost::program_options::options_description & d
 	("unchecked_clear", "Clear unchecked blocks")
 	("confirmation_height_clear", "Clear confirmation height")
 	("final_vote_clear", "Clear final votes")
-	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
+	("rebuild_delegator_index", "Rebuild the index of accounts by representative used when node.enable_delegator_index is set. The node must be stopped")
+	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction. Every vacuum rewrites all tables in key order into full pages, so this is the same as vacuum")
 	("migrate_database_lmdb_to_rocksdb", "Migrates LMDB database to RocksDB")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node, rpc or tls. See also use_defaults.")
@@ -109,8 +110,12 @@ void scendere::add_node_flag_options (boost::program_options::options_descriptio
 		("disable_providing_telemetry_metrics", "Disable using any node information in the telemetry_ack messages.")
 		("disable_block_processor_unchecked_deletion", "Disable deletion of unchecked blocks after processing")
 		("enable_pruning", "Enable experimental ledger pruning")
+		("enable_ascending_bootstrap", "Enable experimental ascending bootstrap, pulling accounts with recent activity or missing blocks forward from their local frontier. Shares bootstrap_initiator_threads with other bootstrap sessions")
+		("enable_compact_bulk_pull", "Request state blocks in the compact chain encoding when bootstrapping, omitting fields repeated from the previous block. Peers without support reply with regular blocks")
 		("allow_bootstrap_peers_duplicates", "Allow multiple connections to same peer in bootstrap attempts")
 		("fast_bootstrap", "Increase bootstrap speed for high end nodes with higher limits")
+		("memory_store", "Keep the ledger in memory instead of the configured database, nothing is written to disk and the ledger is lost when the node stops. For benchmarks and ephemeral nodes")
+		("bootstrap_checkpoint", boost::program_options::value<std::string>(), "Fast sync from a trusted checkpoint file of \"<account> <frontier hash> <height>\" lines. Blocks up to a checkpoint frontier are cemented directly without elections. Implies fast_bootstrap limits")
 		("block_processor_batch_size", boost::program_options::value<std::size_t>(), "Increase block processor transaction batch write size, default 0 (limited by config block_processor_batch_max_time), 256k for fast_bootstrap")
 		("block_processor_full_size", boost::program_options::value<std::size_t>(), "Increase block processor allowed blocks queue size before dropping live network packets and holding bootstrap download, default 65536, 1 million for fast_bootstrap")
 		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap")
@@ -150,8 +155,17 @@ std::error_code scendere::update_flags (scendere::node_flags & flags_a, boost::p
 	flags_a.disable_unchecked_drop = (vm.count ("disable_unchecked_drop") > 0);
 	flags_a.disable_block_processor_unchecked_deletion = (vm.count ("disable_block_processor_unchecked_deletion") > 0);
 	flags_a.enable_pruning = (vm.count ("enable_pruning") > 0);
+	flags_a.enable_ascending_bootstrap = (vm.count ("enable_ascending_bootstrap") > 0);
+	flags_a.enable_compact_bulk_pull = (vm.count ("enable_compact_bulk_pull") > 0);
 	flags_a.allow_bootstrap_peers_duplicates = (vm.count ("allow_bootstrap_peers_duplicates") > 0);
 	flags_a.fast_bootstrap = (vm.count ("fast_bootstrap") > 0);
+	flags_a.memory_store = (vm.count ("memory_store") > 0);
+	auto bootstrap_checkpoint_it = vm.find ("bootstrap_checkpoint");
+	if (bootstrap_checkpoint_it != vm.end ())
+	{
+		flags_a.bootstrap_checkpoint = bootstrap_checkpoint_it->second.as<std::string> ();
+		flags_a.fast_bootstrap = true;
+	}
 	if (flags_a.fast_bootstrap)
 	{
 		flags_a.disable_block_processor_unchecked_deletion = true;
@@ -667,6 +681,33 @@ std::error_code scendere::handle_node_options (boost::program_options::variables
 			database_write_lock_error (ec);
 		}
 	}
+	else if (vm.count ("rebuild_delegator_index"))
+	{
+		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : scendere::working_path ();
+		auto node_flags = scendere::inactive_node_flag_defaults ();
+		node_flags.read_only = false;
+		scendere::update_flags (node_flags, vm);
+		scendere::inactive_node node (data_path, node_flags);
+		if (!node.node->init_error ())
+		{
+			if (node.node->config.enable_delegator_index)
+			{
+				// The rebuild commits in batches, blocks processed by a running node in between would be missing from the index
+				std::cout << "Rebuilding delegator index, the node must not be running..." << std::endl;
+				auto indexed (node.node->ledger.delegators_build ());
+				std::cout << boost::str (boost::format ("Delegator index rebuilt with %1% accounts") % indexed) << std::endl;
+			}
+			else
+			{
+				std::cerr << "node.enable_delegator_index is not set, the index would be dropped at the next start\n";
+				ec = scendere::error_cli::invalid_arguments;
+			}
+		}
+		else
+		{
+			database_write_lock_error (ec);
+		}
+	}
 	else if (vm.count ("generate_config"))
 	{
 		auto type = vm["generate_config"].as<std::string> ();
@@ -227,6 +227,19 @@ bool scendere::message_header::frontier_req_is_only_confirmed_present () const
 	return result;
 }
 
+bool scendere::message_header::frontier_req_is_end_present () const
+{
+	auto result (false);
+	if (type == scendere::message_type::frontier_req)
+	{
+		if (extensions.test (frontier_req_end_present_flag))
+		{
+			result = true;
+		}
+	}
+	return result;
+}
+
 bool scendere::message_header::node_id_handshake_is_query () const
 {
 	auto result (false);
@@ -269,7 +282,7 @@ std::size_t scendere::message_header::payload_length_bytes () const
 		}
 		case scendere::message_type::frontier_req:
 		{
-			return scendere::frontier_req::size;
+			return scendere::frontier_req::size + (frontier_req_is_end_present () ? scendere::frontier_req::extended_parameters_size : 0);
 		}
 		case scendere::message_type::bulk_pull_account:
 		{
@@ -918,6 +931,10 @@ void scendere::frontier_req::serialize (scendere::stream & stream_a) const
 	write (stream_a, start.bytes);
 	write (stream_a, age);
 	write (stream_a, count);
+	if (header.frontier_req_is_end_present ())
+	{
+		write (stream_a, end.bytes);
+	}
 }
 
 bool scendere::frontier_req::deserialize (scendere::stream & stream_a)
@@ -929,6 +946,10 @@ bool scendere::frontier_req::deserialize (scendere::stream & stream_a)
 		scendere::read (stream_a, start.bytes);
 		scendere::read (stream_a, age);
 		scendere::read (stream_a, count);
+		if (header.frontier_req_is_end_present ())
+		{
+			scendere::read (stream_a, end.bytes);
+		}
 	}
 	catch (std::runtime_error const &)
 	{
@@ -945,7 +966,7 @@ void scendere::frontier_req::visit (scendere::message_visitor & visitor_a) const
 
 bool scendere::frontier_req::operator== (scendere::frontier_req const & other_a) const
 {
-	return start == other_a.start && age == other_a.age && count == other_a.count;
+	return start == other_a.start && age == other_a.age && count == other_a.count && end == other_a.end;
 }
 
 scendere::bulk_pull::bulk_pull (scendere::network_constants const & constants) :
@@ -1044,6 +1065,26 @@ void scendere::bulk_pull::set_count_present (bool value_a)
 	header.extensions.set (count_present_flag, value_a);
 }
 
+bool scendere::bulk_pull::is_ascending () const
+{
+	return header.extensions.test (ascending_flag);
+}
+
+void scendere::bulk_pull::set_ascending (bool value_a)
+{
+	header.extensions.set (ascending_flag, value_a);
+}
+
+bool scendere::bulk_pull::is_compact () const
+{
+	return header.extensions.test (compact_flag);
+}
+
+void scendere::bulk_pull::set_compact (bool value_a)
+{
+	header.extensions.set (compact_flag, value_a);
+}
+
 scendere::bulk_pull_account::bulk_pull_account (scendere::network_constants const & constants) :
 	message (constants, scendere::message_type::bulk_pull_account)
 {
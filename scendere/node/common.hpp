@@ -224,8 +224,12 @@ public:
 	void flag_set (uint8_t);
 	static uint8_t constexpr bulk_pull_count_present_flag = 0;
 	bool bulk_pull_is_count_present () const;
+	static uint8_t constexpr bulk_pull_ascending_flag = 1;
+	static uint8_t constexpr bulk_pull_compact_flag = 2;
 	static uint8_t constexpr frontier_req_only_confirmed = 1;
 	bool frontier_req_is_only_confirmed_present () const;
+	static uint8_t constexpr frontier_req_end_present_flag = 2;
+	bool frontier_req_is_end_present () const;
 	static uint8_t constexpr node_id_handshake_query_flag = 0;
 	static uint8_t constexpr node_id_handshake_response_flag = 1;
 	bool node_id_handshake_is_query () const;
@@ -362,7 +366,10 @@ public:
 	scendere::account start;
 	uint32_t age;
 	uint32_t count;
+	/** Exclusive end of the requested account range, only sent when the end_present flag is set */
+	scendere::account end{ 0 };
 	static std::size_t constexpr size = sizeof (start) + sizeof (age) + sizeof (count);
+	static std::size_t constexpr extended_parameters_size = sizeof (end);
 };
 
 enum class telemetry_maker : uint8_t
@@ -450,7 +457,15 @@ public:
 	count_t count{ 0 };
 	bool is_count_present () const;
 	void set_count_present (bool);
+	/** Ascending pulls walk successors forward from the start block (exclusive) or from the open block of the start account */
+	bool is_ascending () const;
+	void set_ascending (bool);
+	/** Asks for state blocks in the compact chain encoding, peers without support ignore the flag and send regular blocks */
+	bool is_compact () const;
+	void set_compact (bool);
 	static std::size_t constexpr count_present_flag = scendere::message_header::bulk_pull_count_present_flag;
+	static std::size_t constexpr ascending_flag = scendere::message_header::bulk_pull_ascending_flag;
+	static std::size_t constexpr compact_flag = scendere::message_header::bulk_pull_compact_flag;
 	static std::size_t constexpr extended_parameters_size = 8;
 	static std::size_t constexpr size = sizeof (start) + sizeof (end);
 };
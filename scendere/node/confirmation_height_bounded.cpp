@@ -2,6 +2,7 @@
 #include <scendere/lib/stats.hpp>
 #include <scendere/node/confirmation_height_bounded.hpp>
 #include <scendere/node/logging.hpp>
+#include <scendere/node/write_coordinator.hpp>
 #include <scendere/node/write_database_queue.hpp>
 #include <scendere/secure/ledger.hpp>
 
@@ -10,9 +11,10 @@
 
 #include <numeric>
 
-scendere::confirmation_height_bounded::confirmation_height_bounded (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, std::atomic<bool> & stopped_a, uint64_t & batch_write_size_a, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const & notify_observers_callback_a, std::function<void (scendere::block_hash const &)> const & notify_block_already_cemented_observers_callback_a, std::function<uint64_t ()> const & awaiting_processing_size_callback_a) :
+scendere::confirmation_height_bounded::confirmation_height_bounded (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, scendere::write_coordinator & write_coordinator_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, std::atomic<bool> & stopped_a, uint64_t & batch_write_size_a, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const & notify_observers_callback_a, std::function<void (scendere::block_hash const &)> const & notify_block_already_cemented_observers_callback_a, std::function<uint64_t ()> const & awaiting_processing_size_callback_a) :
 	ledger (ledger_a),
 	write_database_queue (write_database_queue_a),
+	write_coordinator (write_coordinator_a),
 	batch_separate_pending_min_time (batch_separate_pending_min_time_a),
 	logging (logging_a),
 	logger (logger_a),
@@ -370,180 +372,177 @@ void scendere::confirmation_height_bounded::cement_blocks (scendere::write_guard
 	auto const minimum_batch_write_size = 16384u;
 	scendere::timer<> cemented_batch_timer;
 	auto error = false;
+	// Each batch is committed by the write coordinator together with the writes of the other writers in its round, the batch stops itself
+	// at the size limit or the deadline of this writer. Remaining pending writes go into the next batch.
+	while (!error && !pending_writes.empty ())
 	{
-		// This only writes to the confirmation_height table and is the only place to do so in a single process
-		auto transaction (ledger.store.tx_begin_write ({}, { scendere::tables::confirmation_height }));
-		cemented_batch_timer.start ();
-		// Cement all pending entries, each entry is specific to an account and contains the least amount
-		// of blocks to retain consistent cementing across all account chains to genesis.
-		while (!error && !pending_writes.empty ())
+		if (!scoped_write_guard_a.is_owned ())
 		{
-			auto const & pending = pending_writes.front ();
-			auto const & account = pending.account;
+			scoped_write_guard_a = write_database_queue.wait (scendere::writer::confirmation_height);
+		}
+		cemented_batch_timer.restart ();
+		write_coordinator.submit (
+		scendere::writer::confirmation_height, { scendere::tables::confirmation_height }, [this, &cemented_blocks, &error] (scendere::write_transaction const & transaction_a, std::chrono::steady_clock::time_point deadline_a) {
+			error = cement_batch (transaction_a, deadline_a, cemented_blocks);
+		},
+		std::chrono::milliseconds (maximum_batch_write_time))
+		.wait ();
+		auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
+		if (logging.timing_logging () && time_spent_cementing > 50)
+		{
+			logger.always_log (boost::str (boost::format ("Cemented %1% blocks in %2% %3% (bounded processor)") % cemented_blocks.size () % time_spent_cementing % cemented_batch_timer.unit ()));
+		}
+
+		// Update the maximum amount of blocks to write next time based on the time it took to cement this batch.
+		if (time_spent_cementing > maximum_batch_write_time)
+		{
+			// Reduce (unless we have hit a floor)
+			batch_write_size = std::max<uint64_t> (minimum_batch_write_size, batch_write_size - amount_to_change);
+		}
+		else if (time_spent_cementing < maximum_batch_write_time_increase_cutoff && !pending_writes.empty ())
+		{
+			// Increase amount of blocks written for next batch if the time for writing this one is sufficiently lower than the max time to warrant changing
+			batch_write_size += amount_to_change;
+		}
+
+		scoped_write_guard_a.release ();
+		if (!cemented_blocks.empty ())
+		{
+			notify_observers_callback (cemented_blocks);
+			cemented_blocks.clear ();
+		}
+	}
 
-			auto write_confirmation_height = [&account, &ledger = ledger, &transaction] (uint64_t num_blocks_cemented, uint64_t confirmation_height, scendere::block_hash const & confirmed_frontier) {
+	// Bail if there was an error. This indicates that there was a fatal issue with the ledger
+	// (the blocks probably got rolled back when they shouldn't have).
+	release_assert (!error);
+
+	debug_assert (pending_writes.empty ());
+	debug_assert (pending_writes_size == 0);
+	timer.restart ();
+}
+
+bool scendere::confirmation_height_bounded::cement_batch (scendere::write_transaction const & transaction, std::chrono::steady_clock::time_point deadline_a, std::vector<std::shared_ptr<scendere::block>> & cemented_blocks)
+{
+	auto error = false;
+	// Flush the callbacks once the batch is full or out of time as we write in batches to not hold the write db transaction for too long.
+	// Include a tolerance to save having to potentially wait on the block processor if the number of blocks to cement is only a bit higher than the max.
+	auto batch_full = [this, &cemented_blocks, deadline_a] () {
+		return cemented_blocks.size () > batch_write_size + (batch_write_size / 10) || std::chrono::steady_clock::now () >= deadline_a;
+	};
+	// Cement all pending entries, each entry is specific to an account and contains the least amount
+	// of blocks to retain consistent cementing across all account chains to genesis.
+	while (!error && !pending_writes.empty ())
+	{
+		auto const & pending = pending_writes.front ();
+		auto const & account = pending.account;
+
+		auto write_confirmation_height = [&account, &ledger = ledger, &transaction] (uint64_t num_blocks_cemented, uint64_t confirmation_height, scendere::block_hash const & confirmed_frontier) {
 #ifndef NDEBUG
-				// Extra debug checks
-				scendere::confirmation_height_info confirmation_height_info;
-				ledger.store.confirmation_height.get (transaction, account, confirmation_height_info);
-				auto block (ledger.store.block.get (transaction, confirmed_frontier));
-				debug_assert (block != nullptr);
-				debug_assert (block->sideband ().height == confirmation_height_info.height + num_blocks_cemented);
+			// Extra debug checks
+			scendere::confirmation_height_info confirmation_height_info;
+			ledger.store.confirmation_height.get (transaction, account, confirmation_height_info);
+			auto block (ledger.store.block.get (transaction, confirmed_frontier));
+			debug_assert (block != nullptr);
+			debug_assert (block->sideband ().height == confirmation_height_info.height + num_blocks_cemented);
 #endif
-				ledger.store.confirmation_height.put (transaction, account, scendere::confirmation_height_info{ confirmation_height, confirmed_frontier });
-				ledger.cache.cemented_count += num_blocks_cemented;
-				ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed, scendere::stat::dir::in, num_blocks_cemented);
-				ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed_bounded, scendere::stat::dir::in, num_blocks_cemented);
-			};
+			ledger.store.confirmation_height.put (transaction, account, scendere::confirmation_height_info{ confirmation_height, confirmed_frontier });
+			ledger.cache.cemented_count += num_blocks_cemented;
+			ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed, scendere::stat::dir::in, num_blocks_cemented);
+			ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed_bounded, scendere::stat::dir::in, num_blocks_cemented);
+		};
 
-			scendere::confirmation_height_info confirmation_height_info;
-			ledger.store.confirmation_height.get (transaction, pending.account, confirmation_height_info);
+		scendere::confirmation_height_info confirmation_height_info;
+		ledger.store.confirmation_height.get (transaction, pending.account, confirmation_height_info);
 
-			// Some blocks need to be cemented at least
-			if (pending.top_height > confirmation_height_info.height)
+		// Some blocks need to be cemented at least
+		if (pending.top_height > confirmation_height_info.height)
+		{
+			// The highest hash which will be cemented
+			scendere::block_hash new_cemented_frontier;
+			uint64_t num_blocks_confirmed = 0;
+			uint64_t start_height = 0;
+			if (pending.bottom_height > confirmation_height_info.height)
 			{
-				// The highest hash which will be cemented
-				scendere::block_hash new_cemented_frontier;
-				uint64_t num_blocks_confirmed = 0;
-				uint64_t start_height = 0;
-				if (pending.bottom_height > confirmation_height_info.height)
-				{
-					new_cemented_frontier = pending.bottom_hash;
-					// If we are higher than the cemented frontier, we should be exactly 1 block above
-					debug_assert (pending.bottom_height == confirmation_height_info.height + 1);
-					num_blocks_confirmed = pending.top_height - pending.bottom_height + 1;
-					start_height = pending.bottom_height;
-				}
-				else
+				new_cemented_frontier = pending.bottom_hash;
+				// If we are higher than the cemented frontier, we should be exactly 1 block above
+				debug_assert (pending.bottom_height == confirmation_height_info.height + 1);
+				num_blocks_confirmed = pending.top_height - pending.bottom_height + 1;
+				start_height = pending.bottom_height;
+			}
+			else
+			{
+				// Also resumes an account whose cementing was split over several batches
+				auto block = ledger.store.block.get (transaction, confirmation_height_info.frontier);
+				new_cemented_frontier = block->sideband ().successor;
+				num_blocks_confirmed = pending.top_height - confirmation_height_info.height;
+				start_height = confirmation_height_info.height + 1;
+			}
+
+			auto block = ledger.store.block.get (transaction, new_cemented_frontier);
+
+			// Cementing starts from the bottom of the chain and works upwards. This is because chains can have effectively
+			// an infinite number of send/change blocks in a row. We don't want to hold the write transaction open for too long.
+			for (auto num_blocks_iterated = 0; num_blocks_confirmed - num_blocks_iterated != 0; ++num_blocks_iterated)
+			{
+				if (!block)
 				{
-					auto block = ledger.store.block.get (transaction, confirmation_height_info.frontier);
-					new_cemented_frontier = block->sideband ().successor;
-					num_blocks_confirmed = pending.top_height - confirmation_height_info.height;
-					start_height = confirmation_height_info.height + 1;
+					auto error_str = (boost::format ("Failed to write confirmation height for block %1% (bounded processor)") % new_cemented_frontier.to_string ()).str ();
+					logger.always_log (error_str);
+					std::cerr << error_str << std::endl;
+					// Undo any blocks about to be cemented from this account for this pending write.
+					cemented_blocks.erase (cemented_blocks.end () - num_blocks_iterated, cemented_blocks.end ());
+					error = true;
+					break;
 				}
 
-				auto total_blocks_cemented = 0;
-				auto block = ledger.store.block.get (transaction, new_cemented_frontier);
+				auto last_iteration = (num_blocks_confirmed - num_blocks_iterated) == 1;
+
+				cemented_blocks.emplace_back (block);
 
-				// Cementing starts from the bottom of the chain and works upwards. This is because chains can have effectively
-				// an infinite number of send/change blocks in a row. We don't want to hold the write transaction open for too long.
-				for (auto num_blocks_iterated = 0; num_blocks_confirmed - num_blocks_iterated != 0; ++num_blocks_iterated)
+				if (!last_iteration && batch_full ())
 				{
-					if (!block)
-					{
-						auto error_str = (boost::format ("Failed to write confirmation height for block %1% (bounded processor)") % new_cemented_frontier.to_string ()).str ();
-						logger.always_log (error_str);
-						std::cerr << error_str << std::endl;
-						// Undo any blocks about to be cemented from this account for this pending write.
-						cemented_blocks.erase (cemented_blocks.end () - num_blocks_iterated, cemented_blocks.end ());
-						error = true;
-						break;
-					}
-
-					auto last_iteration = (num_blocks_confirmed - num_blocks_iterated) == 1;
-
-					cemented_blocks.emplace_back (block);
-
-					// Flush these callbacks and continue as we write in batches (ideally maximum 250ms) to not hold write db transaction for too long.
-					// Include a tolerance to save having to potentially wait on the block processor if the number of blocks to cement is only a bit higher than the max.
-					if (cemented_blocks.size () > batch_write_size + (batch_write_size / 10))
-					{
-						auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
-						auto num_blocks_cemented = num_blocks_iterated - total_blocks_cemented + 1;
-						total_blocks_cemented += num_blocks_cemented;
-						write_confirmation_height (num_blocks_cemented, start_height + total_blocks_cemented - 1, new_cemented_frontier);
-						transaction.commit ();
-						if (logging.timing_logging ())
-						{
-							logger.always_log (boost::str (boost::format ("Cemented %1% blocks in %2% %3% (bounded processor)") % cemented_blocks.size () % time_spent_cementing % cemented_batch_timer.unit ()));
-						}
-
-						// Update the maximum amount of blocks to write next time based on the time it took to cement this batch.
-						if (time_spent_cementing > maximum_batch_write_time)
-						{
-							// Reduce (unless we have hit a floor)
-							batch_write_size = std::max<uint64_t> (minimum_batch_write_size, batch_write_size - amount_to_change);
-						}
-						else if (time_spent_cementing < maximum_batch_write_time_increase_cutoff)
-						{
-							// Increase amount of blocks written for next batch if the time for writing this one is sufficiently lower than the max time to warrant changing
-							batch_write_size += amount_to_change;
-						}
-
-						scoped_write_guard_a.release ();
-						notify_observers_callback (cemented_blocks);
-						cemented_blocks.clear ();
-
-						// Only aquire transaction if there are blocks left
-						if (!(last_iteration && pending_writes.size () == 1))
-						{
-							scoped_write_guard_a = write_database_queue.wait (scendere::writer::confirmation_height);
-							transaction.renew ();
-						}
-						cemented_batch_timer.restart ();
-					}
-
-					// Get the next block in the chain until we have reached the final desired one
-					if (!last_iteration)
-					{
-						new_cemented_frontier = block->sideband ().successor;
-						block = ledger.store.block.get (transaction, new_cemented_frontier);
-					}
-					else
-					{
-						// Confirm it is indeed the last one
-						debug_assert (new_cemented_frontier == pending.top_hash);
-					}
+					// The rest of this account is cemented by the next batch, starting from the height written here
+					write_confirmation_height (num_blocks_iterated + 1, start_height + num_blocks_iterated, new_cemented_frontier);
+					return error;
 				}
 
-				if (error)
+				// Get the next block in the chain until we have reached the final desired one
+				if (!last_iteration)
 				{
-					// There was an error writing a block, do not process any more
-					break;
+					new_cemented_frontier = block->sideband ().successor;
+					block = ledger.store.block.get (transaction, new_cemented_frontier);
 				}
-
-				auto num_blocks_cemented = num_blocks_confirmed - total_blocks_cemented;
-				if (num_blocks_cemented > 0)
+				else
 				{
-					write_confirmation_height (num_blocks_cemented, pending.top_height, new_cemented_frontier);
+					// Confirm it is indeed the last one
+					debug_assert (new_cemented_frontier == pending.top_hash);
 				}
 			}
 
-			auto it = accounts_confirmed_info.find (pending.account);
-			if (it != accounts_confirmed_info.cend () && it->second.confirmed_height == pending.top_height)
+			if (error)
 			{
-				accounts_confirmed_info.erase (pending.account);
-				--accounts_confirmed_info_size;
+				// There was an error writing a block, do not process any more
+				break;
 			}
-			pending_writes.pop_front ();
-			--pending_writes_size;
-		}
-	}
-	auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
-	if (logging.timing_logging () && time_spent_cementing > 50)
-	{
-		logger.always_log (boost::str (boost::format ("Cemented %1% blocks in %2% %3% (bounded processor)") % cemented_blocks.size () % time_spent_cementing % cemented_batch_timer.unit ()));
-	}
 
-	// Scope guard could have been released earlier (0 cemented_blocks would indicate that)
-	if (scoped_write_guard_a.is_owned () && !cemented_blocks.empty ())
-	{
-		scoped_write_guard_a.release ();
-		notify_observers_callback (cemented_blocks);
-	}
+			write_confirmation_height (num_blocks_confirmed, pending.top_height, new_cemented_frontier);
+		}
 
-	// Bail if there was an error. This indicates that there was a fatal issue with the ledger
-	// (the blocks probably got rolled back when they shouldn't have).
-	release_assert (!error);
-	if (time_spent_cementing > maximum_batch_write_time)
-	{
-		// Reduce (unless we have hit a floor)
-		batch_write_size = std::max<uint64_t> (minimum_batch_write_size, batch_write_size - amount_to_change);
+		auto it = accounts_confirmed_info.find (pending.account);
+		if (it != accounts_confirmed_info.cend () && it->second.confirmed_height == pending.top_height)
+		{
+			accounts_confirmed_info.erase (pending.account);
+			--accounts_confirmed_info_size;
+		}
+		pending_writes.pop_front ();
+		--pending_writes_size;
+		if (batch_full ())
+		{
+			break;
+		}
 	}
-
-	debug_assert (pending_writes.empty ());
-	debug_assert (pending_writes_size == 0);
-	timer.restart ();
+	return error;
 }
 
 bool scendere::confirmation_height_bounded::pending_empty () const
@@ -13,13 +13,14 @@ class ledger;
 class read_transaction;
 class logging;
 class logger_mt;
+class write_coordinator;
 class write_database_queue;
 class write_guard;
 
 class confirmation_height_bounded final
 {
 public:
-	confirmation_height_bounded (scendere::ledger &, scendere::write_database_queue &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, std::atomic<bool> &, uint64_t &, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const &, std::function<void (scendere::block_hash const &)> const &, std::function<uint64_t ()> const &);
+	confirmation_height_bounded (scendere::ledger &, scendere::write_database_queue &, scendere::write_coordinator &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, std::atomic<bool> &, uint64_t &, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const &, std::function<void (scendere::block_hash const &)> const &, std::function<uint64_t ()> const &);
 	bool pending_empty () const;
 	void clear_process_vars ();
 	void process (std::shared_ptr<scendere::block> original_block);
@@ -116,10 +117,13 @@ private:
 	top_and_next_hash get_next_block (boost::optional<top_and_next_hash> const &, boost::circular_buffer_space_optimized<scendere::block_hash> const &, boost::circular_buffer_space_optimized<receive_source_pair> const & receive_source_pairs, boost::optional<receive_chain_details> &, scendere::block const & original_block);
 	scendere::block_hash get_least_unconfirmed_hash_from_top_level (scendere::transaction const &, scendere::block_hash const &, scendere::account const &, scendere::confirmation_height_info const &, uint64_t &);
 	void prepare_iterated_blocks_for_cementing (preparation_data &);
+	/** Cements pending writes until the batch is full or the deadline passes, returns true if a block to cement is missing */
+	bool cement_batch (scendere::write_transaction const &, std::chrono::steady_clock::time_point, std::vector<std::shared_ptr<scendere::block>> &);
 	bool iterate (scendere::read_transaction const &, uint64_t, scendere::block_hash const &, boost::circular_buffer_space_optimized<scendere::block_hash> &, scendere::block_hash &, scendere::block_hash const &, boost::circular_buffer_space_optimized<receive_source_pair> &, scendere::account const &);
 
 	scendere::ledger & ledger;
 	scendere::write_database_queue & write_database_queue;
+	scendere::write_coordinator & write_coordinator;
 	std::chrono::milliseconds batch_separate_pending_min_time;
 	scendere::logging const & logging;
 	scendere::logger_mt & logger;
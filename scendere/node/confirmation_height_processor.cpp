@@ -11,12 +11,12 @@
 
 #include <numeric>
 
-scendere::confirmation_height_processor::confirmation_height_processor (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, boost::latch & latch, confirmation_height_mode mode_a) :
+scendere::confirmation_height_processor::confirmation_height_processor (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, scendere::write_coordinator & write_coordinator_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, boost::latch & latch, confirmation_height_mode mode_a) :
 	ledger (ledger_a),
 	write_database_queue (write_database_queue_a),
 	// clang-format off
-unbounded_processor (ledger_a, write_database_queue_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
-bounded_processor (ledger_a, write_database_queue_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
+unbounded_processor (ledger_a, write_database_queue_a, write_coordinator_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
+bounded_processor (ledger_a, write_database_queue_a, write_coordinator_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
 	// clang-format on
 	thread ([this, &latch, mode_a] () {
 		scendere::thread_role::set (scendere::thread_role::name::confirmation_height_processing);
@@ -27,12 +27,13 @@ namespace scendere
 {
 class ledger;
 class logger_mt;
+class write_coordinator;
 class write_database_queue;
 
 class confirmation_height_processor final
 {
 public:
-	confirmation_height_processor (scendere::ledger &, scendere::write_database_queue &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic);
+	confirmation_height_processor (scendere::ledger &, scendere::write_database_queue &, scendere::write_coordinator &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic);
 	~confirmation_height_processor ();
 	void pause ();
 	void unpause ();
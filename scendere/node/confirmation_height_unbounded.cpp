@@ -1,6 +1,7 @@
 #include <scendere/lib/stats.hpp>
 #include <scendere/node/confirmation_height_unbounded.hpp>
 #include <scendere/node/logging.hpp>
+#include <scendere/node/write_coordinator.hpp>
 #include <scendere/node/write_database_queue.hpp>
 #include <scendere/secure/ledger.hpp>
 
@@ -8,9 +9,10 @@
 
 #include <numeric>
 
-scendere::confirmation_height_unbounded::confirmation_height_unbounded (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, std::atomic<bool> & stopped_a, uint64_t & batch_write_size_a, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const & notify_observers_callback_a, std::function<void (scendere::block_hash const &)> const & notify_block_already_cemented_observers_callback_a, std::function<uint64_t ()> const & awaiting_processing_size_callback_a) :
+scendere::confirmation_height_unbounded::confirmation_height_unbounded (scendere::ledger & ledger_a, scendere::write_database_queue & write_database_queue_a, scendere::write_coordinator & write_coordinator_a, std::chrono::milliseconds batch_separate_pending_min_time_a, scendere::logging const & logging_a, scendere::logger_mt & logger_a, std::atomic<bool> & stopped_a, uint64_t & batch_write_size_a, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const & notify_observers_callback_a, std::function<void (scendere::block_hash const &)> const & notify_block_already_cemented_observers_callback_a, std::function<uint64_t ()> const & awaiting_processing_size_callback_a) :
 	ledger (ledger_a),
 	write_database_queue (write_database_queue_a),
+	write_coordinator (write_coordinator_a),
 	batch_separate_pending_min_time (batch_separate_pending_min_time_a),
 	logging (logging_a),
 	logger (logger_a),
@@ -366,70 +368,35 @@ void scendere::confirmation_height_unbounded::prepare_iterated_blocks_for_cement
  */
 void scendere::confirmation_height_unbounded::cement_blocks (scendere::write_guard & scoped_write_guard_a)
 {
+	auto const maximum_batch_write_time = 250; // milliseconds
 	scendere::timer<std::chrono::milliseconds> cemented_batch_timer;
 	std::vector<std::shared_ptr<scendere::block>> cemented_blocks;
 	auto error = false;
+	// Pending writes left over once the deadline of this writer passes are cemented by the next write coordinator round
+	while (!error && !pending_writes.empty ())
 	{
-		auto transaction (ledger.store.tx_begin_write ({}, { scendere::tables::confirmation_height }));
-		cemented_batch_timer.start ();
-		while (!pending_writes.empty ())
+		if (!scoped_write_guard_a.is_owned ())
 		{
-			auto & pending = pending_writes.front ();
-			scendere::confirmation_height_info confirmation_height_info;
-			ledger.store.confirmation_height.get (transaction, pending.account, confirmation_height_info);
-			auto confirmation_height = confirmation_height_info.height;
-			if (pending.height > confirmation_height)
-			{
-				auto block = ledger.store.block.get (transaction, pending.hash);
-				debug_assert (ledger.pruning || block != nullptr);
-				debug_assert (ledger.pruning || block->sideband ().height == pending.height);
-
-				if (!block)
-				{
-					if (ledger.pruning && ledger.store.pruned.exists (transaction, pending.hash))
-					{
-						pending_writes.erase (pending_writes.begin ());
-						--pending_writes_size;
-						continue;
-					}
-					else
-					{
-						auto error_str = (boost::format ("Failed to write confirmation height for block %1% (unbounded processor)") % pending.hash.to_string ()).str ();
-						logger.always_log (error_str);
-						std::cerr << error_str << std::endl;
-						error = true;
-						break;
-					}
-				}
-				ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed, scendere::stat::dir::in, pending.height - confirmation_height);
-				ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed_unbounded, scendere::stat::dir::in, pending.height - confirmation_height);
-				debug_assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
-				confirmation_height = pending.height;
-				ledger.cache.cemented_count += pending.num_blocks_confirmed;
-				ledger.store.confirmation_height.put (transaction, pending.account, { confirmation_height, pending.hash });
-
-				// Reverse it so that the callbacks start from the lowest newly cemented block and move upwards
-				std::reverse (pending.block_callback_data.begin (), pending.block_callback_data.end ());
-
-				scendere::lock_guard<scendere::mutex> guard (block_cache_mutex);
-				std::transform (pending.block_callback_data.begin (), pending.block_callback_data.end (), std::back_inserter (cemented_blocks), [&block_cache = block_cache] (auto const & hash_a) {
-					debug_assert (block_cache.count (hash_a) == 1);
-					return block_cache.at (hash_a);
-				});
-			}
-			pending_writes.erase (pending_writes.begin ());
-			--pending_writes_size;
+			scoped_write_guard_a = write_database_queue.wait (scendere::writer::confirmation_height);
+		}
+		cemented_batch_timer.restart ();
+		write_coordinator.submit (
+		scendere::writer::confirmation_height, { scendere::tables::confirmation_height }, [this, &cemented_blocks, &error] (scendere::write_transaction const & transaction_a, std::chrono::steady_clock::time_point deadline_a) {
+			error = cement_batch (transaction_a, deadline_a, cemented_blocks);
+		},
+		std::chrono::milliseconds (maximum_batch_write_time))
+		.wait ();
+
+		auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
+		if (logging.timing_logging () && time_spent_cementing > 50)
+		{
+			logger.always_log (boost::str (boost::format ("Cemented %1% blocks in %2% %3% (unbounded processor)") % cemented_blocks.size () % time_spent_cementing % cemented_batch_timer.unit ()));
 		}
-	}
 
-	auto time_spent_cementing = cemented_batch_timer.since_start ().count ();
-	if (logging.timing_logging () && time_spent_cementing > 50)
-	{
-		logger.always_log (boost::str (boost::format ("Cemented %1% blocks in %2% %3% (unbounded processor)") % cemented_blocks.size () % time_spent_cementing % cemented_batch_timer.unit ()));
+		scoped_write_guard_a.release ();
+		notify_observers_callback (cemented_blocks);
+		cemented_blocks.clear ();
 	}
-
-	scoped_write_guard_a.release ();
-	notify_observers_callback (cemented_blocks);
 	release_assert (!error);
 
 	debug_assert (pending_writes.empty ());
@@ -437,6 +404,60 @@ void scendere::confirmation_height_unbounded::cement_blocks (scendere::write_gua
 	timer.restart ();
 }
 
+bool scendere::confirmation_height_unbounded::cement_batch (scendere::write_transaction const & transaction, std::chrono::steady_clock::time_point deadline_a, std::vector<std::shared_ptr<scendere::block>> & cemented_blocks)
+{
+	auto error = false;
+	while (!pending_writes.empty () && std::chrono::steady_clock::now () < deadline_a)
+	{
+		auto & pending = pending_writes.front ();
+		scendere::confirmation_height_info confirmation_height_info;
+		ledger.store.confirmation_height.get (transaction, pending.account, confirmation_height_info);
+		auto confirmation_height = confirmation_height_info.height;
+		if (pending.height > confirmation_height)
+		{
+			auto block = ledger.store.block.get (transaction, pending.hash);
+			debug_assert (ledger.pruning || block != nullptr);
+			debug_assert (ledger.pruning || block->sideband ().height == pending.height);
+
+			if (!block)
+			{
+				if (ledger.pruning && ledger.store.pruned.exists (transaction, pending.hash))
+				{
+					pending_writes.erase (pending_writes.begin ());
+					--pending_writes_size;
+					continue;
+				}
+				else
+				{
+					auto error_str = (boost::format ("Failed to write confirmation height for block %1% (unbounded processor)") % pending.hash.to_string ()).str ();
+					logger.always_log (error_str);
+					std::cerr << error_str << std::endl;
+					error = true;
+					break;
+				}
+			}
+			ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed, scendere::stat::dir::in, pending.height - confirmation_height);
+			ledger.stats.add (scendere::stat::type::confirmation_height, scendere::stat::detail::blocks_confirmed_unbounded, scendere::stat::dir::in, pending.height - confirmation_height);
+			debug_assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
+			confirmation_height = pending.height;
+			ledger.cache.cemented_count += pending.num_blocks_confirmed;
+			ledger.store.confirmation_height.put (transaction, pending.account, { confirmation_height, pending.hash });
+
+			// Reverse it so that the callbacks start from the lowest newly cemented block and move upwards
+			std::reverse (pending.block_callback_data.begin (), pending.block_callback_data.end ());
+
+			scendere::lock_guard<scendere::mutex> guard (block_cache_mutex);
+			std::transform (pending.block_callback_data.begin (), pending.block_callback_data.end (), std::back_inserter (cemented_blocks), [&block_cache = block_cache] (auto const & hash_a) {
+				debug_assert (block_cache.count (hash_a) == 1);
+				return block_cache.at (hash_a);
+			});
+		}
+		pending_writes.erase (pending_writes.begin ());
+		--pending_writes_size;
+	}
+	return error;
+}
+
 std::shared_ptr<scendere::block> scendere::confirmation_height_unbounded::get_block_and_sideband (scendere::block_hash const & hash_a, scendere::transaction const & transaction_a)
 {
 	scendere::lock_guard<scendere::mutex> guard (block_cache_mutex);
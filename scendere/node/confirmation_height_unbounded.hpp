@@ -14,13 +14,14 @@ class ledger;
 class read_transaction;
 class logging;
 class logger_mt;
+class write_coordinator;
 class write_database_queue;
 class write_guard;
 
 class confirmation_height_unbounded final
 {
 public:
-	confirmation_height_unbounded (scendere::ledger &, scendere::write_database_queue &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, std::atomic<bool> &, uint64_t &, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const &, std::function<void (scendere::block_hash const &)> const &, std::function<uint64_t ()> const &);
+	confirmation_height_unbounded (scendere::ledger &, scendere::write_database_queue &, scendere::write_coordinator &, std::chrono::milliseconds, scendere::logging const &, scendere::logger_mt &, std::atomic<bool> &, uint64_t &, std::function<void (std::vector<std::shared_ptr<scendere::block>> const &)> const &, std::function<void (scendere::block_hash const &)> const &, std::function<uint64_t ()> const &);
 	bool pending_empty () const;
 	void clear_process_vars ();
 	void process (std::shared_ptr<scendere::block> original_block);
@@ -94,9 +95,12 @@ private:
 
 	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, std::shared_ptr<scendere::block> const &, scendere::block_hash const &, scendere::account const &, scendere::read_transaction const &, std::vector<receive_source_pair> &, std::vector<scendere::block_hash> &, std::vector<scendere::block_hash> &, std::shared_ptr<scendere::block> original_block);
 	void prepare_iterated_blocks_for_cementing (preparation_data &);
+	/** Cements pending writes until the deadline passes, returns true if a block to cement is missing */
+	bool cement_batch (scendere::write_transaction const &, std::chrono::steady_clock::time_point, std::vector<std::shared_ptr<scendere::block>> &);
 
 	scendere::ledger & ledger;
 	scendere::write_database_queue & write_database_queue;
+	scendere::write_coordinator & write_coordinator;
 	std::chrono::milliseconds batch_separate_pending_min_time;
 	scendere::logger_mt & logger;
 	std::atomic<bool> & stopped;
@@ -1,3 +1,4 @@
+#include <scendere/lib/asio.hpp>
 #include <scendere/lib/config.hpp>
 #include <scendere/lib/json_error_response.hpp>
 #include <scendere/lib/timer.hpp>
@@ -269,6 +270,22 @@ scendere::account_info scendere::json_handler::account_info_impl (scendere::tran
 	return result;
 }
 
+std::vector<std::shared_ptr<scendere::block>> scendere::json_handler::blocks_impl (scendere::transaction const & transaction_a, std::string const & key_a)
+{
+	std::vector<scendere::block_hash> hashes_l;
+	for (auto & hashes : request.get_child (key_a))
+	{
+		// Undecodable hashes are looked up as zero and reported by the caller
+		scendere::block_hash hash;
+		if (hash.decode_hex (hashes.second.data ()))
+		{
+			hash.clear ();
+		}
+		hashes_l.push_back (hash);
+	}
+	return node.store.block.get_many (transaction_a, hashes_l);
+}
+
 scendere::amount scendere::json_handler::amount_impl ()
 {
 	scendere::amount result (0);
@@ -537,7 +554,7 @@ void scendere::json_handler::account_block_count ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -614,7 +631,7 @@ void scendere::json_handler::account_info ()
 		bool const pending = request.get<bool> ("pending", false);
 		bool const receivable = request.get<bool> ("receivable", pending);
 		bool const include_confirmed = request.get<bool> ("include_confirmed", false);
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		auto info (account_info_impl (transaction, account));
 		scendere::confirmation_height_info confirmation_height_info;
 		node.store.confirmation_height.get (transaction, account, confirmation_height_info);
@@ -801,7 +818,7 @@ void scendere::json_handler::account_representative ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -891,17 +908,28 @@ void scendere::json_handler::account_weight ()
 void scendere::json_handler::accounts_balances ()
 {
 	boost::property_tree::ptree balances;
+	std::vector<scendere::account> accounts_l;
 	for (auto & accounts : request.get_child ("accounts"))
 	{
 		auto account (account_impl (accounts.second.data ()));
 		if (!ec)
+		{
+			accounts_l.push_back (account);
+		}
+	}
+	if (!ec)
+	{
+		auto transaction (node.store.tx_begin_read ());
+		auto infos (node.store.account.get_many (transaction, accounts_l));
+		for (auto i (0); i < accounts_l.size (); ++i)
 		{
 			boost::property_tree::ptree entry;
-			auto balance (node.balance_pending (account, false));
-			entry.put ("balance", balance.first.convert_to<std::string> ());
-			entry.put ("pending", balance.second.convert_to<std::string> ());
-			entry.put ("receivable", balance.second.convert_to<std::string> ());
-			balances.push_back (std::make_pair (account.to_account (), entry));
+			auto balance (infos[i] ? infos[i]->balance.number () : scendere::uint128_t (0));
+			auto receivable (node.ledger.account_receivable (transaction, accounts_l[i], false));
+			entry.put ("balance", balance.convert_to<std::string> ());
+			entry.put ("pending", receivable.convert_to<std::string> ());
+			entry.put ("receivable", receivable.convert_to<std::string> ());
+			balances.push_back (std::make_pair (accounts_l[i].to_account (), entry));
 		}
 	}
 	response_l.add_child ("balances", balances);
@@ -956,16 +984,24 @@ void scendere::json_handler::accounts_create ()
 void scendere::json_handler::accounts_frontiers ()
 {
 	boost::property_tree::ptree frontiers;
-	auto transaction (node.store.tx_begin_read ());
+	std::vector<scendere::account> accounts_l;
 	for (auto & accounts : request.get_child ("accounts"))
 	{
 		auto account (account_impl (accounts.second.data ()));
 		if (!ec)
 		{
-			auto latest (node.ledger.latest (transaction, account));
-			if (!latest.is_zero ())
+			accounts_l.push_back (account);
+		}
+	}
+	if (!ec)
+	{
+		auto transaction (node.store.tx_begin_read ());
+		auto infos (node.store.account.get_many (transaction, accounts_l));
+		for (auto i (0); i < accounts_l.size (); ++i)
+		{
+			if (infos[i])
 			{
-				frontiers.put (account.to_account (), latest.to_string ());
+				frontiers.put (accounts_l[i].to_account (), infos[i]->head.to_string ());
 			}
 		}
 	}
@@ -996,36 +1032,39 @@ void scendere::json_handler::accounts_receivable ()
 		if (!ec)
 		{
 			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending.begin (transaction, scendere::pending_key (account, 0))), n (node.store.pending.end ()); i != n && scendere::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			if (simple)
 			{
-				scendere::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+				for (auto i (node.store.pending.begin (transaction, scendere::pending_key (account, 0))), n (node.store.pending.end ()); i != n && scendere::pending_key (i->first).account == account && peers_l.size () < count; ++i)
 				{
-					if (simple)
+					scendere::pending_key const & key (i->first);
+					if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 					{
 						boost::property_tree::ptree entry;
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
-					else
+				}
+			}
+			else
+			{
+				// With the receivable amount index the largest entries come first and those below the threshold are never read
+				node.ledger.receivable_for_each (transaction, account, threshold.number (), [&] (scendere::pending_key const & key, scendere::pending_info const & info) {
+					if (peers_l.size () < count && block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 					{
-						scendere::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
+						if (source)
 						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							boost::property_tree::ptree pending_tree;
+							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+							pending_tree.put ("source", info.source.to_account ());
+							peers_l.add_child (key.hash.to_string (), pending_tree);
+						}
+						else
+						{
+							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 						}
 					}
-				}
+					return peers_l.size () < count;
+				});
 			}
 			if (sorting && !simple)
 			{
@@ -1095,7 +1134,7 @@ void scendere::json_handler::block_info ()
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		auto block (node.store.block.get (transaction, hash));
 		if (block != nullptr)
 		{
@@ -1196,15 +1235,17 @@ void scendere::json_handler::blocks ()
 	bool const json_block_l = request.get<bool> ("json_block", false);
 	boost::property_tree::ptree blocks;
 	auto transaction (node.store.tx_begin_read ());
+	auto blocks_l (blocks_impl (transaction));
+	auto index (0);
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
+		auto block (blocks_l[index++]);
 		if (!ec)
 		{
 			std::string hash_text = hashes.second.data ();
 			scendere::block_hash hash;
 			if (!hash.decode_hex (hash_text))
 			{
-				auto block (node.store.block.get (transaction, hash));
 				if (block != nullptr)
 				{
 					if (json_block_l)
@@ -1247,15 +1288,17 @@ void scendere::json_handler::blocks_info ()
 	boost::property_tree::ptree blocks;
 	boost::property_tree::ptree blocks_not_found;
 	auto transaction (node.store.tx_begin_read ());
+	auto blocks_l (blocks_impl (transaction));
+	auto index (0);
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
+		auto block (blocks_l[index++]);
 		if (!ec)
 		{
 			std::string hash_text = hashes.second.data ();
 			scendere::block_hash hash;
 			if (!hash.decode_hex (hash_text))
 			{
-				auto block (node.store.block.get (transaction, hash));
 				if (block != nullptr)
 				{
 					boost::property_tree::ptree entry;
@@ -1383,7 +1426,7 @@ void scendere::json_handler::block_account ()
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (node.store.tx_begin_read_cached ());
 		if (node.store.block.exists (transaction, hash))
 		{
 			auto account (node.ledger.account (transaction, hash));
@@ -1861,8 +1904,23 @@ void scendere::json_handler::bootstrap_status ()
 		connections.put ("idle", std::to_string (node.bootstrap_initiator.connections->idle.size ()));
 		connections.put ("target_connections", std::to_string (node.bootstrap_initiator.connections->target_connections (node.bootstrap_initiator.connections->pulls.size (), attempts_count)));
 		connections.put ("pulls", std::to_string (node.bootstrap_initiator.connections->pulls.size ()));
+		connections.put ("ingest_target", std::to_string (node.bootstrap_initiator.connections->ingest_target_m.load ()));
+		connections.put ("ingest_rate", std::to_string (static_cast<uint64_t> (node.bootstrap_initiator.connections->ingest_rate.load ())));
 	}
 	response_l.add_child ("connections", connections);
+	boost::property_tree::ptree peers;
+	for (auto const & score : node.bootstrap_initiator.connections->scores.list ())
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("endpoint", boost::str (boost::format ("%1%") % score.endpoint));
+		entry.put ("score", std::to_string (score.score ()));
+		entry.put ("block_rate", std::to_string (score.block_rate));
+		entry.put ("latency_ms", std::to_string (static_cast<uint64_t> (score.latency_ms)));
+		entry.put ("failures", std::to_string (score.failures));
+		entry.put ("idle_seconds", std::to_string (std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - score.last_update).count ()));
+		peers.push_back (std::make_pair ("", entry));
+	}
+	response_l.add_child ("peers", peers);
 	boost::property_tree::ptree attempts;
 	{
 		scendere::lock_guard<scendere::mutex> attempts_lock (node.bootstrap_initiator.attempts.bootstrap_attempts_mutex);
@@ -1895,6 +1953,18 @@ void scendere::json_handler::chain (bool successors)
 	{
 		boost::property_tree::ptree blocks;
 		auto transaction (node.store.tx_begin_read ());
+		if (offset > 0 && node.ledger.account_heights)
+		{
+			// Skipped blocks are looked up by height instead of being walked
+			auto block_l (node.store.block.get (transaction, hash));
+			if (block_l != nullptr)
+			{
+				auto height (block_l->sideband ().height);
+				auto target (successors ? (std::numeric_limits<uint64_t>::max () - height >= offset ? height + offset : 0) : (height > offset ? height - offset : 0));
+				hash = node.ledger.block_at_height (transaction, node.store.block.account_calculated (*block_l), target);
+				offset = 0;
+			}
+		}
 		while (!hash.is_zero () && blocks.size () < count)
 		{
 			auto block_l (node.store.block.get (transaction, hash));
@@ -2170,17 +2240,33 @@ void scendere::json_handler::delegators ()
 	{
 		auto transaction (node.store.tx_begin_read ());
 		boost::property_tree::ptree delegators;
-		for (auto i (node.store.account.begin (transaction, start_account.number () + 1)), n (node.store.account.end ()); i != n && delegators.size () < count; ++i)
+		auto add_delegator = [&delegators, &threshold] (scendere::account const & delegator_a, scendere::account_info const & info_a) {
+			if (info_a.balance.number () >= threshold.number ())
+			{
+				std::string balance;
+				scendere::uint128_union (info_a.balance).encode_dec (balance);
+				delegators.put (delegator_a.to_account (), balance);
+			}
+		};
+		if (node.ledger.delegators)
 		{
-			scendere::account_info const & info (i->second);
-			if (info.representative == representative)
+			for (auto i (node.store.delegator.begin (transaction, representative, start_account.number () + 1)), n (node.store.delegator.end ()); i != n && i->first.representative == representative && delegators.size () < count; ++i)
 			{
-				if (info.balance.number () >= threshold.number ())
+				scendere::account_info info;
+				if (!node.store.account.get (transaction, i->first.account, info))
 				{
-					std::string balance;
-					scendere::uint128_union (info.balance).encode_dec (balance);
-					scendere::account const & delegator (i->first);
-					delegators.put (delegator.to_account (), balance);
+					add_delegator (i->first.account, info);
+				}
+			}
+		}
+		else
+		{
+			for (auto i (node.store.account.begin (transaction, start_account.number () + 1)), n (node.store.account.end ()); i != n && delegators.size () < count; ++i)
+			{
+				scendere::account_info const & info (i->second);
+				if (info.representative == representative)
+				{
+					add_delegator (i->first, info);
 				}
 			}
 		}
@@ -2196,14 +2282,25 @@ void scendere::json_handler::delegators_count ()
 	{
 		uint64_t count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.account.begin (transaction)), n (node.store.account.end ()); i != n; ++i)
+		if (node.ledger.delegators)
 		{
-			scendere::account_info const & info (i->second);
-			if (info.representative == account)
+			// Starts after the zero account, which is never a delegator but marks the index as complete
+			for (auto i (node.store.delegator.begin (transaction, account, 1)), n (node.store.delegator.end ()); i != n && i->first.representative == account; ++i)
 			{
 				++count;
 			}
 		}
+		else
+		{
+			for (auto i (node.store.account.begin (transaction)), n (node.store.account.end ()); i != n; ++i)
+			{
+				scendere::account_info const & info (i->second);
+				if (info.representative == account)
+				{
+					++count;
+				}
+			}
+		}
 		response_l.put ("count", std::to_string (count));
 	}
 	response_errors ();
@@ -2596,6 +2693,15 @@ void scendere::json_handler::account_history ()
 		bool output_raw (request.get_optional<bool> ("raw") == true);
 		response_l.put ("account", account.to_account ());
 		auto block (node.store.block.get (transaction, hash));
+		if (offset > 0 && block != nullptr && node.ledger.account_heights)
+		{
+			// Skipped blocks are looked up by height instead of being walked
+			auto height (block->sideband ().height);
+			auto target (reverse ? (std::numeric_limits<uint64_t>::max () - height >= offset ? height + offset : 0) : (height > offset ? height - offset : 0));
+			hash = node.ledger.block_at_height (transaction, account, target);
+			block = node.store.block.get (transaction, hash);
+			offset = 0;
+		}
 		while (block != nullptr && count > 0)
 		{
 			if (offset > 0)
@@ -3004,7 +3110,8 @@ void scendere::json_handler::receivable ()
 	bool const include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
 	bool const sorting = request.get<bool> ("sorting", false);
 	auto simple (threshold.is_zero () && !source && !min_version && !sorting); // if simple, response is a list of hashes
-	bool const should_sort = sorting && !simple;
+	// Entries from the receivable amount index are already in descending amount order
+	bool const should_sort = sorting && !simple && !node.ledger.pending_amounts;
 	if (!ec)
 	{
 		auto offset_counter = offset;
@@ -3013,64 +3120,69 @@ void scendere::json_handler::receivable ()
 		// The ptree container is used if there are any children nodes (e.g source/min_version) otherwise the amount container is used.
 		std::vector<std::pair<std::string, boost::property_tree::ptree>> hash_ptree_pairs;
 		std::vector<std::pair<std::string, scendere::uint128_t>> hash_amount_pairs;
-		for (auto i (node.store.pending.begin (transaction, scendere::pending_key (account, 0))), n (node.store.pending.end ()); i != n && scendere::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
-		{
-			scendere::pending_key const & key (i->first);
+		auto visit = [&] (scendere::pending_key const & key, scendere::pending_info const & info) {
 			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 			{
 				if (!should_sort && offset_counter > 0)
 				{
 					--offset_counter;
-					continue;
 				}
-
-				if (simple)
+				else if (simple)
 				{
 					boost::property_tree::ptree entry;
 					entry.put ("", key.hash.to_string ());
 					peers_l.push_back (std::make_pair ("", entry));
 				}
-				else
+				else if (info.amount.number () >= threshold.number ())
 				{
-					scendere::pending_info const & info (i->second);
-					if (info.amount.number () >= threshold.number ())
+					if (source || min_version)
 					{
-						if (source || min_version)
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						if (source)
 						{
-							boost::property_tree::ptree pending_tree;
-							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-							if (source)
-							{
-								pending_tree.put ("source", info.source.to_account ());
-							}
-							if (min_version)
-							{
-								pending_tree.put ("min_version", epoch_as_string (info.epoch));
-							}
+							pending_tree.put ("source", info.source.to_account ());
+						}
+						if (min_version)
+						{
+							pending_tree.put ("min_version", epoch_as_string (info.epoch));
+						}
 
-							if (should_sort)
-							{
-								hash_ptree_pairs.emplace_back (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
+						if (should_sort)
+						{
+							hash_ptree_pairs.emplace_back (key.hash.to_string (), pending_tree);
 						}
 						else
 						{
-							if (should_sort)
-							{
-								hash_amount_pairs.emplace_back (key.hash.to_string (), info.amount.number ());
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							peers_l.add_child (key.hash.to_string (), pending_tree);
+						}
+					}
+					else
+					{
+						if (should_sort)
+						{
+							hash_amount_pairs.emplace_back (key.hash.to_string (), info.amount.number ());
+						}
+						else
+						{
+							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 						}
 					}
 				}
 			}
+			return should_sort || peers_l.size () < count;
+		};
+		if (simple)
+		{
+			for (auto i (node.store.pending.begin (transaction, scendere::pending_key (account, 0))), n (node.store.pending.end ()); i != n && scendere::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			{
+				visit (i->first, i->second);
+			}
+		}
+		else if (count > 0 || should_sort)
+		{
+			// Without the index the offset counts every entry in block hash order, including those below the threshold
+			node.ledger.receivable_for_each (transaction, account, node.ledger.pending_amounts ? threshold.number () : 0, visit);
 		}
 		if (should_sort)
 		{
@@ -3891,6 +4003,10 @@ void scendere::json_handler::stats ()
 	{
 		node.store.serialize_memory_stats (response_l);
 	}
+	else if (type == "store")
+	{
+		node.store.latency.serialize (response_l);
+	}
 	else
 	{
 		ec = scendere::error_rpc::invalid_missing_type;
@@ -3912,6 +4028,7 @@ void scendere::json_handler::stats ()
 void scendere::json_handler::stats_clear ()
 {
 	node.stats.clear ();
+	node.store.latency.clear ();
 	response_l.put ("success", "");
 	std::stringstream ostream;
 	boost::property_tree::write_json (ostream, response_l);
@@ -4287,6 +4404,7 @@ void scendere::json_handler::version ()
 	response_l.put ("network", node.network_params.network.get_current_network_as_string ());
 	response_l.put ("network_identifier", node.network_params.ledger.genesis->hash ().to_string ());
 	response_l.put ("build_info", BUILD_INFO);
+	response_l.put ("networking_backend", scendere::asio_backend ());
 	response_errors ();
 }
 
@@ -4769,43 +4887,45 @@ void scendere::json_handler::wallet_receivable ()
 		{
 			scendere::account const & account (i->first);
 			boost::property_tree::ptree peers_l;
-			for (auto ii (node.store.pending.begin (block_transaction, scendere::pending_key (account, 0))), nn (node.store.pending.end ()); ii != nn && scendere::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
+			if (threshold.is_zero () && !source)
 			{
-				scendere::pending_key key (ii->first);
-				if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
+				for (auto ii (node.store.pending.begin (block_transaction, scendere::pending_key (account, 0))), nn (node.store.pending.end ()); ii != nn && scendere::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
 				{
-					if (threshold.is_zero () && !source)
+					scendere::pending_key key (ii->first);
+					if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
 					{
 						boost::property_tree::ptree entry;
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
-					else
+				}
+			}
+			else
+			{
+				node.ledger.receivable_for_each (block_transaction, account, threshold.number (), [&] (scendere::pending_key const & key, scendere::pending_info const & info) {
+					if (peers_l.size () < count && block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
 					{
-						scendere::pending_info info (ii->second);
-						if (info.amount.number () >= threshold.number ())
+						if (source || min_version)
 						{
-							if (source || min_version)
+							boost::property_tree::ptree pending_tree;
+							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+							if (source)
 							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								if (source)
-								{
-									pending_tree.put ("source", info.source.to_account ());
-								}
-								if (min_version)
-								{
-									pending_tree.put ("min_version", epoch_as_string (info.epoch));
-								}
-								peers_l.add_child (key.hash.to_string (), pending_tree);
+								pending_tree.put ("source", info.source.to_account ());
 							}
-							else
+							if (min_version)
 							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
+								pending_tree.put ("min_version", epoch_as_string (info.epoch));
 							}
+							peers_l.add_child (key.hash.to_string (), pending_tree);
+						}
+						else
+						{
+							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 						}
 					}
-				}
+					return peers_l.size () < count;
+				});
 			}
 			if (!peers_l.empty ())
 			{
@@ -160,6 +160,8 @@ public:
 	scendere::amount amount_impl ();
 	std::shared_ptr<scendere::block> block_impl (bool = true);
 	scendere::block_hash hash_impl (std::string = "hash");
+	/** Blocks for each entry of a list of hashes in one batch, null for hashes not found or not decodable */
+	std::vector<std::shared_ptr<scendere::block>> blocks_impl (scendere::transaction const &, std::string const & = "hashes");
 	scendere::amount threshold_optional_impl ();
 	uint64_t work_optional_impl ();
 	uint64_t count_impl ();
@@ -52,6 +52,15 @@ void scendere::ledger_walker::walk_backward (scendere::block_hash const & start_
 	clear_queue ();
 }
 
+void scendere::ledger_walker::walk_backward (scendere::account const & account_a, std::uint64_t height_a, should_visit_callback const & should_visit_callback_a, visitor_callback const & visitor_callback_a)
+{
+	auto const start_block_hash = ledger.block_at_height (ledger.store.tx_begin_read (), account_a, height_a);
+	if (!start_block_hash.is_zero ())
+	{
+		walk_backward (start_block_hash, should_visit_callback_a, visitor_callback_a);
+	}
+}
+
 void scendere::ledger_walker::walk (scendere::block_hash const & end_block_hash_a, should_visit_callback const & should_visit_callback_a, visitor_callback const & visitor_callback_a)
 {
 	std::uint64_t last_walked_block_order_index = 0;
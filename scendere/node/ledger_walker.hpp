@@ -6,6 +6,7 @@
 #include <scendere/lib/numbers.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -32,6 +33,9 @@ public:
 	/** Start traversing (in a backwards direction -- towards genesis) from \p start_block_hash_a until \p should_visit_callback_a returns false, calling \p visitor_callback_a at each block. Prefer 'walk' instead, if possible. */
 	void walk_backward (scendere::block_hash const & start_block_hash_a, should_visit_callback const & should_visit_callback_a, visitor_callback const & visitor_callback_a);
 
+	/** Same as walk_backward, starting from the block at \p height_a in the chain of \p account_a. Does nothing if there is no such block. */
+	void walk_backward (scendere::account const & account_a, std::uint64_t height_a, should_visit_callback const & should_visit_callback_a, visitor_callback const & visitor_callback_a);
+
 	/** Start traversing (in a forward direction -- towards end_block_hash_a) from first block (genesis onwards) where \p should_visit_a returns true until \p end_block_hash_a, calling \p visitor_callback at each block. Prefer this one, instead of 'walk_backwards', if possible. */
 	void walk (scendere::block_hash const & end_block_hash_a, should_visit_callback const & should_visit_callback_a, visitor_callback const & visitor_callback_a);
 
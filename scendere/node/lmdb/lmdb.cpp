@@ -12,6 +12,61 @@
 #include <boost/polymorphic_cast.hpp>
 
 #include <queue>
+#include <thread>
+
+namespace
+{
+/** Entries of one table read ahead of the writer in key order, keys and values are packed in a single buffer */
+class append_batch final
+{
+public:
+	static std::size_t constexpr max_bytes = 4 * 1024 * 1024;
+	std::vector<uint8_t> buffer;
+	std::vector<std::pair<std::size_t, std::size_t>> sizes;
+};
+
+/** Bounded queue of batches between the reader of a table and the writer */
+class append_queue final
+{
+public:
+	void push (append_batch && batch_a)
+	{
+		scendere::unique_lock<scendere::mutex> lock (mutex);
+		condition.wait (lock, [this] () { return batches.size () < max_batches; });
+		batches.push_back (std::move (batch_a));
+		condition.notify_all ();
+	}
+
+	void close ()
+	{
+		scendere::lock_guard<scendere::mutex> guard (mutex);
+		closed = true;
+		condition.notify_all ();
+	}
+
+	/** Returns false once the reader is done and every batch has been taken */
+	bool pop (append_batch & batch_a)
+	{
+		scendere::unique_lock<scendere::mutex> lock (mutex);
+		condition.wait (lock, [this] () { return closed || !batches.empty (); });
+		auto result (!batches.empty ());
+		if (result)
+		{
+			batch_a = std::move (batches.front ());
+			batches.pop_front ();
+			condition.notify_all ();
+		}
+		return result;
+	}
+
+private:
+	static std::size_t constexpr max_batches = 4;
+	scendere::mutex mutex;
+	scendere::condition_variable condition;
+	std::deque<append_batch> batches;
+	bool closed{ false };
+};
+}
 
 namespace scendere
 {
@@ -54,7 +109,10 @@ scendere::mdb_store::mdb_store (scendere::logger_mt & logger_a, boost::filesyste
 		peer_store_partial,
 		confirmation_height_store_partial,
 		final_vote_store_partial,
-		version_store_partial
+		version_store_partial,
+		account_height_store_partial,
+		delegator_store_partial,
+		pending_amount_store_partial
 	},
 	// clang-format on
 	block_store_partial{ *this },
@@ -68,6 +126,9 @@ scendere::mdb_store::mdb_store (scendere::logger_mt & logger_a, boost::filesyste
 	final_vote_store_partial{ *this },
 	unchecked_mdb_store{ *this },
 	version_store_partial{ *this },
+	account_height_store_partial{ *this },
+	delegator_store_partial{ *this },
+	pending_amount_store_partial{ *this },
 	logger (logger_a),
 	env (error, path_a, scendere::mdb_env::options::make ().set_config (lmdb_config_a).set_use_no_mem_init (true)),
 	mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
@@ -189,11 +250,23 @@ scendere::read_transaction scendere::mdb_store::tx_begin_read () const
 	return env.tx_begin_read (create_txn_callbacks ());
 }
 
+scendere::read_transaction scendere::mdb_store::tx_begin_read_cached () const
+{
+	return env.tx_begin_read_cached (create_txn_callbacks ());
+}
+
 std::string scendere::mdb_store::vendor_get () const
 {
 	return boost::str (boost::format ("LMDB %1%.%2%.%3%") % MDB_VERSION_MAJOR % MDB_VERSION_MINOR % MDB_VERSION_PATCH);
 }
 
+uint64_t scendere::mdb_store::write_sequence () const
+{
+	MDB_envinfo info;
+	mdb_env_info (env.environment, &info);
+	return info.me_last_txnid;
+}
+
 scendere::mdb_txn_callbacks scendere::mdb_store::create_txn_callbacks () const
 {
 	scendere::mdb_txn_callbacks mdb_txn_callbacks;
@@ -223,6 +296,9 @@ void scendere::mdb_store::open_databases (bool & error_a, scendere::transaction
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_v0_handle) != 0;
 	pending_handle = pending_v0_handle;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "final_votes", flags, &final_votes_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_heights", flags, &account_heights_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "delegators", flags, &delegators_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_amounts", flags, &pending_amounts_handle) != 0;
 
 	auto version_l = version.get (transaction_a);
 	if (version_l < 19)
@@ -307,6 +383,19 @@ bool scendere::mdb_store::do_upgrades (scendere::write_transaction & transaction
 			upgrade_v20_to_v21 (transaction_a);
 			[[fallthrough]];
 		case 21:
+			upgrade_v21_to_v22 (transaction_a);
+			[[fallthrough]];
+		case 22:
+			upgrade_v22_to_v23 (transaction_a);
+			[[fallthrough]];
+		case 23:
+			upgrade_v23_to_v24 (transaction_a);
+			[[fallthrough]];
+		case 24:
+			upgrade_v24_to_v25 (transaction_a);
+			needs_vacuuming = true;
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -780,6 +869,69 @@ void scendere::mdb_store::upgrade_v20_to_v21 (scendere::write_transaction const
 	logger.always_log ("Finished creating new final_vote table");
 }
 
+void scendere::mdb_store::upgrade_v21_to_v22 (scendere::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v21 to v22 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "account_heights", MDB_CREATE, &account_heights_handle);
+	version.put (transaction_a, 22);
+	logger.always_log ("Finished creating new account_heights table");
+}
+
+void scendere::mdb_store::upgrade_v22_to_v23 (scendere::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v22 to v23 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "delegators", MDB_CREATE, &delegators_handle);
+	version.put (transaction_a, 23);
+	logger.always_log ("Finished creating new delegators table");
+}
+
+void scendere::mdb_store::upgrade_v23_to_v24 (scendere::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v23 to v24 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "pending_amounts", MDB_CREATE, &pending_amounts_handle);
+	version.put (transaction_a, 24);
+	logger.always_log ("Finished creating new pending_amounts table");
+}
+
+void scendere::mdb_store::upgrade_v24_to_v25 (scendere::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v24 to v25 database upgrade...");
+	auto count_pre (count (transaction_a, blocks_handle));
+	uint64_t bytes_before (0);
+	uint64_t bytes_after (0);
+	auto num (0u);
+	for (scendere::mdb_iterator<scendere::block_hash, scendere::block_w_sideband> i (transaction_a, blocks_handle), n{}; i != n; ++i, ++num)
+	{
+		auto size (i->second.size ());
+		auto data (scendere::block_entry_compact (reinterpret_cast<uint8_t const *> (i->second.data ()), size));
+		bytes_before += size;
+		if (!data.empty ())
+		{
+			bytes_after += data.size ();
+			scendere::mdb_val value{ data.size (), (void *)data.data () };
+			auto s = mdb_cursor_put (i.cursor, i->first, value, MDB_CURRENT);
+			release_assert_success (*this, s);
+		}
+		else
+		{
+			bytes_after += size;
+		}
+
+		// Every so often output to the log to indicate progress
+		constexpr auto output_cutoff = 1000000;
+		if (num > 0 && num % output_cutoff == 0)
+		{
+			logger.always_log (boost::str (boost::format ("Database block encoding upgrade %1% million blocks upgraded (out of %2%)") % (num / output_cutoff) % count_pre));
+		}
+	}
+
+	auto count_post (count (transaction_a, blocks_handle));
+	release_assert (count_pre == count_post);
+
+	version.put (transaction_a, 25);
+	logger.always_log (boost::str (boost::format ("Finished compacting %1% blocks, block data reduced from %2% to %3% bytes") % count_post % bytes_before % bytes_after));
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void scendere::mdb_store::create_backup_file (scendere::mdb_env & env_a, boost::filesystem::path const & filepath_a, scendere::logger_mt & logger_a)
 {
@@ -827,6 +979,23 @@ int scendere::mdb_store::get (scendere::transaction const & transaction_a, table
 	return mdb_get (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a);
 }
 
+std::vector<int> scendere::mdb_store::get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::mdb_val> const & keys_a, std::vector<scendere::mdb_val> & values_a) const
+{
+	std::vector<int> result (keys_a.size (), MDB_NOTFOUND);
+	values_a.resize (keys_a.size ());
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert (success (status));
+	// Walking the keys in order with one cursor lets LMDB reuse the pages of the previous lookup instead of descending from the root each time
+	for (auto index : key_order (keys_a))
+	{
+		scendere::mdb_val key (keys_a[index].size (), keys_a[index].data ());
+		result[index] = mdb_cursor_get (cursor, &key.value, &values_a[index].value, MDB_SET_KEY);
+	}
+	mdb_cursor_close (cursor);
+	return result;
+}
+
 int scendere::mdb_store::put (scendere::write_transaction const & transaction_a, tables table_a, scendere::mdb_val const & key_a, scendere::mdb_val const & value_a) const
 {
 	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
@@ -886,6 +1055,12 @@ MDB_dbi scendere::mdb_store::table_to_dbi (tables table_a) const
 			return confirmation_height_handle;
 		case tables::final_votes:
 			return final_votes_handle;
+		case tables::account_heights:
+			return account_heights_handle;
+		case tables::delegators:
+			return delegators_handle;
+		case tables::pending_amounts:
+			return pending_amounts_handle;
 		default:
 			release_assert (false);
 			return peers_handle;
@@ -914,57 +1089,178 @@ std::string scendere::mdb_store::error_string (int status) const
 
 bool scendere::mdb_store::copy_db (boost::filesystem::path const & destination_file)
 {
-	return !mdb_env_copy2 (env.environment, destination_file.string ().c_str (), MDB_CP_COMPACT);
-}
+	/*
+	 * Every table is streamed in key order into a fresh environment with MDB_APPEND, which fills each page before starting the next one
+	 * instead of splitting pages as ordinary puts do. Tables are read in parallel, each by its own thread and read transaction, while a
+	 * single writer appends them one after the other.
+	 */
+	MDB_envinfo info;
+	mdb_env_info (env.environment, &info);
+	scendere::lmdb_config config;
+	config.map_size = info.me_mapsize;
+	// Nothing uses the copy until it is complete, it is synced once at the end
+	config.sync = scendere::lmdb_config::sync_strategy::nosync_unsafe;
+	auto error (false);
+	scendere::mdb_env destination (error, destination_file, scendere::mdb_env::options::make ().set_config (config).set_use_no_mem_init (true));
+	if (error)
+	{
+		return false;
+	}
 
-void scendere::mdb_store::rebuild_db (scendere::write_transaction const & transaction_a)
-{
-	// Tables with uint256_union key
-	std::vector<MDB_dbi> tables = { accounts_handle, blocks_handle, pruned_handle, confirmation_height_handle };
-	for (auto const & table : tables)
+	class table final
 	{
-		MDB_dbi temp;
-		mdb_dbi_open (env.tx (transaction_a), "temp_table", MDB_CREATE, &temp);
-		// Copy all values to temporary table
-		for (auto i (scendere::store_iterator<scendere::uint256_union, scendere::mdb_val> (std::make_unique<scendere::mdb_iterator<scendere::uint256_union, scendere::mdb_val>> (transaction_a, table))), n (scendere::store_iterator<scendere::uint256_union, scendere::mdb_val> (nullptr)); i != n; ++i)
+	public:
+		std::string name;
+		MDB_dbi source;
+		MDB_dbi destination;
+		unsigned flags;
+		append_queue queue;
+		uint64_t entries{ 0 };
+		uint64_t bytes{ 0 };
+	};
+	std::deque<table> tables_l;
+	{
+		// Tables are named by the keys of the main database. Handles opened in a committed transaction are shared with the environment
+		MDB_txn * source_txn;
+		release_assert (success (mdb_txn_begin (env.environment, nullptr, MDB_RDONLY, &source_txn)));
+		MDB_dbi main;
+		release_assert (success (mdb_dbi_open (source_txn, nullptr, 0, &main)));
+		MDB_cursor * cursor;
+		release_assert (success (mdb_cursor_open (source_txn, main, &cursor)));
+		MDB_val key;
+		MDB_val value;
+		for (auto status (mdb_cursor_get (cursor, &key, &value, MDB_FIRST)); success (status); status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
 		{
-			auto s = mdb_put (env.tx (transaction_a), temp, scendere::mdb_val (i->first), i->second, MDB_APPEND);
-			release_assert_success (*this, s);
+			tables_l.emplace_back ();
+			tables_l.back ().name.assign (static_cast<char const *> (key.mv_data), key.mv_size);
 		}
-		release_assert (count (transaction_a, table) == count (transaction_a, temp));
-		// Clear existing table
-		mdb_drop (env.tx (transaction_a), table, 0);
-		// Put values from copy
-		for (auto i (scendere::store_iterator<scendere::uint256_union, scendere::mdb_val> (std::make_unique<scendere::mdb_iterator<scendere::uint256_union, scendere::mdb_val>> (transaction_a, temp))), n (scendere::store_iterator<scendere::uint256_union, scendere::mdb_val> (nullptr)); i != n; ++i)
+		mdb_cursor_close (cursor);
+		MDB_txn * destination_txn;
+		release_assert (success (mdb_txn_begin (destination.environment, nullptr, 0, &destination_txn)));
+		for (auto & table_l : tables_l)
 		{
-			auto s = mdb_put (env.tx (transaction_a), table, scendere::mdb_val (i->first), i->second, MDB_APPEND);
-			release_assert_success (*this, s);
+			release_assert (success (mdb_dbi_open (source_txn, table_l.name.c_str (), 0, &table_l.source)));
+			release_assert (success (mdb_dbi_flags (source_txn, table_l.source, &table_l.flags)));
+			release_assert (success (mdb_dbi_open (destination_txn, table_l.name.c_str (), table_l.flags | MDB_CREATE, &table_l.destination)));
 		}
-		release_assert (count (transaction_a, table) == count (transaction_a, temp));
-		// Remove temporary table
-		mdb_drop (env.tx (transaction_a), temp, 1);
+		release_assert (success (mdb_txn_commit (destination_txn)));
+		release_assert (success (mdb_txn_commit (source_txn)));
+	}
+
+	std::vector<std::thread> readers;
+	for (auto & table_l : tables_l)
+	{
+		readers.emplace_back ([this, &table_l] () {
+			scendere::thread_role::set (scendere::thread_role::name::db_parallel_traversal);
+			auto transaction (tx_begin_read ());
+			MDB_cursor * cursor;
+			release_assert (success (mdb_cursor_open (env.tx (transaction), table_l.source, &cursor)));
+			append_batch batch;
+			MDB_val key;
+			MDB_val value;
+			for (auto status (mdb_cursor_get (cursor, &key, &value, MDB_FIRST)); success (status); status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+			{
+				auto key_data (static_cast<uint8_t const *> (key.mv_data));
+				auto value_data (static_cast<uint8_t const *> (value.mv_data));
+				batch.buffer.insert (batch.buffer.end (), key_data, key_data + key.mv_size);
+				batch.buffer.insert (batch.buffer.end (), value_data, value_data + value.mv_size);
+				batch.sizes.emplace_back (key.mv_size, value.mv_size);
+				if (batch.buffer.size () >= append_batch::max_bytes)
+				{
+					table_l.queue.push (std::move (batch));
+					batch = append_batch{};
+				}
+			}
+			mdb_cursor_close (cursor);
+			if (!batch.sizes.empty ())
+			{
+				table_l.queue.push (std::move (batch));
+			}
+			table_l.queue.close ();
+		});
 	}
-	// Pending table
+
+	auto start (std::chrono::steady_clock::now ());
+	for (auto & table_l : tables_l)
 	{
-		MDB_dbi temp;
-		mdb_dbi_open (env.tx (transaction_a), "temp_table", MDB_CREATE, &temp);
-		// Copy all values to temporary table
-		for (auto i (scendere::store_iterator<scendere::pending_key, scendere::pending_info> (std::make_unique<scendere::mdb_iterator<scendere::pending_key, scendere::pending_info>> (transaction_a, pending_handle))), n (scendere::store_iterator<scendere::pending_key, scendere::pending_info> (nullptr)); i != n; ++i)
+		auto table_start (std::chrono::steady_clock::now ());
+		auto append_flag (table_l.flags & MDB_DUPSORT ? MDB_APPENDDUP : MDB_APPEND);
+		append_batch batch;
+		while (table_l.queue.pop (batch))
 		{
-			auto s = mdb_put (env.tx (transaction_a), temp, scendere::mdb_val (i->first), scendere::mdb_val (i->second), MDB_APPEND);
-			release_assert_success (*this, s);
+			// One write transaction per batch keeps the number of dirty pages bounded
+			MDB_txn * destination_txn;
+			release_assert (success (mdb_txn_begin (destination.environment, nullptr, 0, &destination_txn)));
+			auto data (batch.buffer.data ());
+			for (auto const & [key_size, value_size] : batch.sizes)
+			{
+				MDB_val key{ key_size, data };
+				MDB_val value{ value_size, data + key_size };
+				auto status (mdb_put (destination_txn, table_l.destination, &key, &value, append_flag));
+				error |= !success (status);
+				data += key_size + value_size;
+			}
+			table_l.entries += batch.sizes.size ();
+			table_l.bytes += batch.buffer.size ();
+			error |= !success (mdb_txn_commit (destination_txn));
 		}
-		release_assert (count (transaction_a, pending_handle) == count (transaction_a, temp));
-		mdb_drop (env.tx (transaction_a), pending_handle, 0);
-		// Put values from copy
-		for (auto i (scendere::store_iterator<scendere::pending_key, scendere::pending_info> (std::make_unique<scendere::mdb_iterator<scendere::pending_key, scendere::pending_info>> (transaction_a, temp))), n (scendere::store_iterator<scendere::pending_key, scendere::pending_info> (nullptr)); i != n; ++i)
+
+		MDB_stat source_stat;
+		MDB_stat destination_stat;
 		{
-			auto s = mdb_put (env.tx (transaction_a), pending_handle, scendere::mdb_val (i->first), scendere::mdb_val (i->second), MDB_APPEND);
-			release_assert_success (*this, s);
+			auto transaction (tx_begin_read ());
+			mdb_stat (env.tx (transaction), table_l.source, &source_stat);
+		}
+		{
+			MDB_txn * destination_txn;
+			release_assert (success (mdb_txn_begin (destination.environment, nullptr, MDB_RDONLY, &destination_txn)));
+			mdb_stat (destination_txn, table_l.destination, &destination_stat);
+			mdb_txn_abort (destination_txn);
 		}
-		release_assert (count (transaction_a, pending_handle) == count (transaction_a, temp));
-		mdb_drop (env.tx (transaction_a), temp, 1);
+		error |= source_stat.ms_entries != table_l.entries || destination_stat.ms_entries != table_l.entries;
+		auto seconds (std::max (std::chrono::duration<double> (std::chrono::steady_clock::now () - table_start).count (), 0.001));
+		auto leaf_bytes (static_cast<double> (destination_stat.ms_leaf_pages) * destination_stat.ms_psize);
+		logger.always_log (boost::str (boost::format ("Copied table %1%: %2% entries, %3$.1f MB/s, %4% leaf pages %5$.1f%% full (were %6%)") % table_l.name % table_l.entries % (table_l.bytes / seconds / (1024 * 1024)) % destination_stat.ms_leaf_pages % (leaf_bytes > 0 ? 100.0 * table_l.bytes / leaf_bytes : 0.0) % source_stat.ms_leaf_pages));
+	}
+	for (auto & reader : readers)
+	{
+		reader.join ();
 	}
+	error |= !success (mdb_env_sync (destination.environment, 1));
+	logger.always_log (boost::str (boost::format ("Database copy %1% in %2% seconds") % (error ? "failed" : "completed") % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - start).count ()));
+	return !error;
+}
+
+void scendere::mdb_store::table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const
+{
+	parallel_traversal<scendere::uint256_t> (
+	[this, table_a, &sink_make_a] (scendere::uint256_t const & start, scendere::uint256_t const & end, bool const is_last) {
+		// Each range has its own cursor positioned on the first key at or after the start of the range
+		auto transaction (tx_begin_read ());
+		auto & sink (sink_make_a ());
+		scendere::uint256_union start_l (start);
+		scendere::uint256_union const end_l (end);
+		MDB_cursor * cursor;
+		auto status (mdb_cursor_open (env.tx (transaction), table_to_dbi (table_a), &cursor));
+		release_assert (success (status));
+		scendere::mdb_val key (start_l);
+		scendere::mdb_val value;
+		for (status = mdb_cursor_get (cursor, &key.value, &value.value, MDB_SET_RANGE); success (status); status = mdb_cursor_get (cursor, &key.value, &value.value, MDB_NEXT))
+		{
+			if (!is_last && std::memcmp (key.data (), end_l.bytes.data (), std::min (key.size (), sizeof (end_l))) >= 0)
+			{
+				break;
+			}
+			sink.put (key.data (), key.size (), value.data (), value.size ());
+		}
+		release_assert (success (status) || not_found (status));
+		mdb_cursor_close (cursor);
+	});
+}
+
+void scendere::mdb_store::rebuild_db (scendere::write_transaction const &)
+{
+	// The copy made by copy_db appends every table in key order into a fresh environment, rewriting tables in place first only grows the source
 }
 
 bool scendere::mdb_store::init_error () const
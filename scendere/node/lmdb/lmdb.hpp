@@ -8,13 +8,16 @@
 #include <scendere/node/lmdb/lmdb_iterator.hpp>
 #include <scendere/node/lmdb/lmdb_txn.hpp>
 #include <scendere/secure/common.hpp>
+#include <scendere/secure/store/account_height_store_partial.hpp>
 #include <scendere/secure/store/account_store_partial.hpp>
 #include <scendere/secure/store/block_store_partial.hpp>
 #include <scendere/secure/store/confirmation_height_store_partial.hpp>
+#include <scendere/secure/store/delegator_store_partial.hpp>
 #include <scendere/secure/store/final_vote_store_partial.hpp>
 #include <scendere/secure/store/frontier_store_partial.hpp>
 #include <scendere/secure/store/online_weight_partial.hpp>
 #include <scendere/secure/store/peer_store_partial.hpp>
+#include <scendere/secure/store/pending_amount_store_partial.hpp>
 #include <scendere/secure/store/pending_store_partial.hpp>
 #include <scendere/secure/store/pruned_store_partial.hpp>
 #include <scendere/secure/store/unchecked_store_partial.hpp>
@@ -64,6 +67,9 @@ private:
 	scendere::confirmation_height_store_partial<MDB_val, mdb_store> confirmation_height_store_partial;
 	scendere::final_vote_store_partial<MDB_val, mdb_store> final_vote_store_partial;
 	scendere::version_store_partial<MDB_val, mdb_store> version_store_partial;
+	scendere::account_height_store_partial<MDB_val, mdb_store> account_height_store_partial;
+	scendere::delegator_store_partial<MDB_val, mdb_store> delegator_store_partial;
+	scendere::pending_amount_store_partial<MDB_val, mdb_store> pending_amount_store_partial;
 
 	friend class scendere::unchecked_mdb_store;
 
@@ -71,8 +77,10 @@ public:
 	mdb_store (scendere::logger_mt &, boost::filesystem::path const &, scendere::ledger_constants & constants, scendere::txn_tracking_config const & txn_tracking_config_a = scendere::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), scendere::lmdb_config const & lmdb_config_a = scendere::lmdb_config{}, bool backup_before_upgrade = false);
 	scendere::write_transaction tx_begin_write (std::vector<scendere::tables> const & tables_requiring_lock = {}, std::vector<scendere::tables> const & tables_no_lock = {}) override;
 	scendere::read_transaction tx_begin_read () const override;
+	scendere::read_transaction tx_begin_read_cached () const override;
 
 	std::string vendor_get () const override;
+	uint64_t write_sequence () const override;
 
 	void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds) override;
 
@@ -82,6 +90,8 @@ public:
 
 	unsigned max_block_write_batch_num () const override;
 
+	uint64_t count (scendere::transaction const & transaction_a, tables table_a) const override;
+
 private:
 	scendere::logger_mt & logger;
 	bool error{ false };
@@ -227,14 +237,34 @@ public:
 	 */
 	MDB_dbi final_votes_handle{ 0 };
 
+	/**
+	 * Optional index of the blocks of each account by height
+	 * scendere::account, uint64_t (big endian) -> scendere::block_hash
+	 */
+	MDB_dbi account_heights_handle{ 0 };
+
+	/**
+	 * Optional index of the accounts delegating to each representative
+	 * scendere::account (representative), scendere::account -> nullptr
+	 */
+	MDB_dbi delegators_handle{ 0 };
+
+	/**
+	 * Optional index of the pending entries of each account by descending amount
+	 * scendere::account, scendere::amount (inverted), scendere::block_hash -> nullptr
+	 */
+	MDB_dbi pending_amounts_handle{ 0 };
+
 	bool exists (scendere::transaction const & transaction_a, tables table_a, scendere::mdb_val const & key_a) const;
 
 	int get (scendere::transaction const & transaction_a, tables table_a, scendere::mdb_val const & key_a, scendere::mdb_val & value_a) const;
+	std::vector<int> get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::mdb_val> const & keys_a, std::vector<scendere::mdb_val> & values_a) const;
 	int put (scendere::write_transaction const & transaction_a, tables table_a, scendere::mdb_val const & key_a, scendere::mdb_val const & value_a) const;
 	int del (scendere::write_transaction const & transaction_a, tables table_a, scendere::mdb_val const & key_a) const;
 
 	bool copy_db (boost::filesystem::path const & destination_file) override;
 	void rebuild_db (scendere::write_transaction const & transaction_a) override;
+	void table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const override;
 
 	template <typename Key, typename Value>
 	scendere::store_iterator<Key, Value> make_iterator (scendere::transaction const & transaction_a, tables table_a, bool const direction_asc) const
@@ -269,6 +299,10 @@ private:
 	void upgrade_v18_to_v19 (scendere::write_transaction const &);
 	void upgrade_v19_to_v20 (scendere::write_transaction const &);
 	void upgrade_v20_to_v21 (scendere::write_transaction const &);
+	void upgrade_v21_to_v22 (scendere::write_transaction const &);
+	void upgrade_v22_to_v23 (scendere::write_transaction const &);
+	void upgrade_v23_to_v24 (scendere::write_transaction const &);
+	void upgrade_v24_to_v25 (scendere::write_transaction const &);
 
 	std::shared_ptr<scendere::block> block_get_v18 (scendere::transaction const & transaction_a, scendere::block_hash const & hash_a) const;
 	scendere::mdb_val block_raw_get_v18 (scendere::transaction const & transaction_a, scendere::block_hash const & hash_a, scendere::block_type & type_a) const;
@@ -290,8 +324,6 @@ private:
 	scendere::mdb_txn_callbacks create_txn_callbacks () const;
 	bool txn_tracking_enabled;
 
-	uint64_t count (scendere::transaction const & transaction_a, tables table_a) const override;
-
 	bool vacuum_after_upgrade (boost::filesystem::path const & path_a, scendere::lmdb_config const & lmdb_config_a);
 
 	class upgrade_counters
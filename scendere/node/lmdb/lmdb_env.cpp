@@ -1,8 +1,53 @@
+#include <scendere/lib/threading.hpp>
 #include <scendere/node/lmdb/lmdb_env.hpp>
 
 #include <boost/filesystem/operations.hpp>
 
-scendere::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path_a, scendere::mdb_env::options options_a)
+#include <algorithm>
+
+namespace
+{
+/** Cached read transactions of the current thread, closed when the thread exits */
+class thread_cached_reads final
+{
+public:
+	~thread_cached_reads ()
+	{
+		for (auto & [env, entry] : entries)
+		{
+			scendere::lock_guard<scendere::mutex> guard (entry->mutex);
+			debug_assert (!entry->in_use);
+			if (!entry->closed)
+			{
+				entry->close ();
+			}
+			entry->exited = true;
+		}
+	}
+	std::vector<std::pair<uint64_t, std::shared_ptr<scendere::mdb_cached_read>>> entries;
+};
+
+thread_local thread_cached_reads cached_reads;
+}
+
+void scendere::mdb_cached_read::close ()
+{
+	if (txn != nullptr)
+	{
+		if (!active)
+		{
+			// Read transactions are closed by committing, which requires them to be active
+			txn->renew ();
+		}
+		txn.reset ();
+		active = false;
+	}
+}
+
+std::atomic<uint64_t> scendere::mdb_env::next_id{ 0 };
+
+scendere::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path_a, scendere::mdb_env::options options_a) :
+	id (next_id++)
 {
 	init (error_a, path_a, options_a);
 }
@@ -10,6 +55,7 @@ scendere::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path
 void scendere::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a, scendere::mdb_env::options options_a)
 {
 	boost::system::error_code error_mkdir, error_chmod;
+	cached_staleness = options_a.config.read_transaction_staleness;
 	if (path_a.has_parent_path ())
 	{
 		boost::filesystem::create_directories (path_a.parent_path (), error_mkdir);
@@ -80,6 +126,7 @@ void scendere::mdb_env::init (bool & error_a, boost::filesystem::path const & pa
 
 scendere::mdb_env::~mdb_env ()
 {
+	clear_cached ();
 	if (environment != nullptr)
 	{
 		// Make sure the commits are flushed. This is a no-op unless MDB_NOSYNC is used.
@@ -103,6 +150,134 @@ scendere::write_transaction scendere::mdb_env::tx_begin_write (mdb_txn_callbacks
 	return scendere::write_transaction{ std::make_unique<scendere::write_mdb_txn> (*this, mdb_txn_callbacks) };
 }
 
+scendere::mdb_cached_read & scendere::mdb_env::cached_entry () const
+{
+	auto & entries (cached_reads.entries);
+	auto existing (std::find_if (entries.begin (), entries.end (), [this] (auto const & item_a) { return item_a.first == id; }));
+	if (existing != entries.end ())
+	{
+		return *existing->second;
+	}
+	// Entries of closed environments are only referenced from here
+	entries.erase (std::remove_if (entries.begin (), entries.end (), [] (auto const & item_a) {
+		scendere::lock_guard<scendere::mutex> guard (item_a.second->mutex);
+		return item_a.second->closed;
+	}),
+	entries.end ());
+	auto entry (std::make_shared<scendere::mdb_cached_read> ());
+	entries.emplace_back (id, entry);
+	scendere::lock_guard<scendere::mutex> guard (cached_mutex);
+	cached.erase (std::remove_if (cached.begin (), cached.end (), [] (auto const & item_a) { return item_a->exited.load (); }), cached.end ());
+	cached.push_back (entry);
+	if (cached_staleness.count () > 0 && !sweeper.joinable ())
+	{
+		sweeper = std::thread ([this] () { run_sweeper (); });
+	}
+	return *entry;
+}
+
+scendere::read_transaction scendere::mdb_env::tx_begin_read_cached (mdb_txn_callbacks mdb_txn_callbacks) const
+{
+	auto & entry (cached_entry ());
+	// Only the owning thread changes in_use, the sweeper skips entries in use
+	if (entry.in_use)
+	{
+		return tx_begin_read (mdb_txn_callbacks);
+	}
+	auto now (std::chrono::steady_clock::now ());
+	scendere::lock_guard<scendere::mutex> guard (entry.mutex);
+	entry.in_use = true;
+	if (entry.txn == nullptr)
+	{
+		entry.txn = std::make_unique<scendere::read_mdb_txn> (*this, mdb_txn_callbacks);
+		entry.active = true;
+		entry.renewed = now;
+	}
+	else if (!entry.active || now - entry.renewed >= cached_staleness)
+	{
+		if (entry.active)
+		{
+			entry.txn->reset ();
+		}
+		entry.txn->renew ();
+		entry.active = true;
+		entry.renewed = now;
+	}
+	return scendere::read_transaction{ std::make_unique<scendere::cached_read_mdb_txn> (*this, entry) };
+}
+
+void scendere::mdb_env::release_cached (scendere::mdb_cached_read & entry_a) const
+{
+	scendere::lock_guard<scendere::mutex> guard (entry_a.mutex);
+	if (entry_a.active && std::chrono::steady_clock::now () - entry_a.renewed >= cached_staleness)
+	{
+		entry_a.txn->reset ();
+		entry_a.active = false;
+	}
+	entry_a.in_use = false;
+}
+
+std::size_t scendere::mdb_env::cached_open () const
+{
+	scendere::lock_guard<scendere::mutex> guard (cached_mutex);
+	return std::count_if (cached.begin (), cached.end (), [] (auto const & entry_a) {
+		scendere::lock_guard<scendere::mutex> guard (entry_a->mutex);
+		return entry_a->txn != nullptr;
+	});
+}
+
+void scendere::mdb_env::run_sweeper () const
+{
+	scendere::thread_role::set (scendere::thread_role::name::db_read_sweeper);
+	scendere::unique_lock<scendere::mutex> lock (cached_mutex);
+	while (!sweeper_stopped)
+	{
+		cached_condition.wait_for (lock, cached_staleness);
+		cached.erase (std::remove_if (cached.begin (), cached.end (), [] (auto const & entry_a) { return entry_a->exited.load (); }), cached.end ());
+		auto entries (cached);
+		lock.unlock ();
+		// Release snapshots of threads which stopped reading so they do not pin pages, MDB_NOTLS allows resetting them from this thread
+		auto now (std::chrono::steady_clock::now ());
+		for (auto const & entry : entries)
+		{
+			scendere::lock_guard<scendere::mutex> guard (entry->mutex);
+			if (!entry->in_use && entry->active && now - entry->renewed >= cached_staleness)
+			{
+				entry->txn->reset ();
+				entry->active = false;
+			}
+		}
+		lock.lock ();
+	}
+}
+
+void scendere::mdb_env::clear_cached ()
+{
+	{
+		scendere::lock_guard<scendere::mutex> guard (cached_mutex);
+		sweeper_stopped = true;
+	}
+	cached_condition.notify_all ();
+	if (sweeper.joinable ())
+	{
+		sweeper.join ();
+	}
+	scendere::lock_guard<scendere::mutex> guard (cached_mutex);
+	for (auto const & entry : cached)
+	{
+		scendere::lock_guard<scendere::mutex> entry_guard (entry->mutex);
+		debug_assert (!entry->in_use);
+		if (entry->txn != nullptr)
+		{
+			// The owner of the tracking callbacks may already be gone
+			entry->txn->txn_callbacks = scendere::mdb_txn_callbacks{};
+			entry->close ();
+		}
+		entry->closed = true;
+	}
+	cached.clear ();
+}
+
 MDB_txn * scendere::mdb_env::tx (scendere::transaction const & transaction_a) const
 {
 	return static_cast<MDB_txn *> (transaction_a.get_handle ());
@@ -4,8 +4,34 @@
 #include <scendere/node/lmdb/lmdb_txn.hpp>
 #include <scendere/secure/store.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace scendere
 {
+/**
+ * Read transaction kept by one thread between reads, reset and renewed rather than begun and closed each time.
+ * Only the owning thread uses the transaction, the mutex guards it against the sweeper, the owning thread exiting and the environment closing.
+ */
+class mdb_cached_read final
+{
+public:
+	/** Closes the transaction, it has to be active to be committed */
+	void close ();
+	scendere::mutex mutex;
+	std::unique_ptr<scendere::read_mdb_txn> txn;
+	std::chrono::steady_clock::time_point renewed;
+	bool active{ false };
+	bool in_use{ false };
+	/** The owning thread exited, the environment drops the entry from its registry */
+	std::atomic<bool> exited{ false };
+	/** The environment was closed, the owning thread drops the entry */
+	bool closed{ false };
+};
+
 /**
  * RAII wrapper for MDB_env
  */
@@ -60,7 +86,31 @@ public:
 	operator MDB_env * () const;
 	scendere::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
 	scendere::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
+	/**
+	 * Read transaction reused by the calling thread, kept in thread local storage and closed when the thread exits. Its snapshot is kept
+	 * for up to the configured read_transaction_staleness after it was last renewed, a zero staleness renews it for every call.
+	 * A background thread releases idle snapshots older than the staleness so they do not pin pages.
+	 * Nested calls on a thread get a regular read transaction.
+	 */
+	scendere::read_transaction tx_begin_read_cached (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
+	void release_cached (scendere::mdb_cached_read &) const;
+	/** Number of cached read transactions which are open, for tests */
+	std::size_t cached_open () const;
 	MDB_txn * tx (scendere::transaction const & transaction_a) const;
 	MDB_env * environment;
+
+private:
+	scendere::mdb_cached_read & cached_entry () const;
+	void run_sweeper () const;
+	void clear_cached ();
+	/** Identifies the environment in thread local storage, addresses may be reused once an environment is destroyed */
+	uint64_t const id;
+	std::chrono::milliseconds cached_staleness{ 0 };
+	mutable scendere::mutex cached_mutex;
+	mutable scendere::condition_variable cached_condition;
+	mutable std::vector<std::shared_ptr<scendere::mdb_cached_read>> cached;
+	mutable std::thread sweeper;
+	mutable bool sweeper_stopped{ false };
+	static std::atomic<uint64_t> next_id;
 };
 }
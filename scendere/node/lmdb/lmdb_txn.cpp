@@ -78,6 +78,35 @@ void scendere::read_mdb_txn::renew ()
 	txn_callbacks.txn_start (this);
 }
 
+scendere::cached_read_mdb_txn::cached_read_mdb_txn (scendere::mdb_env const & env_a, scendere::mdb_cached_read & cached_a) :
+	env (env_a),
+	cached (cached_a)
+{
+}
+
+scendere::cached_read_mdb_txn::~cached_read_mdb_txn ()
+{
+	env.release_cached (cached);
+}
+
+void scendere::cached_read_mdb_txn::reset ()
+{
+	cached.txn->reset ();
+	cached.active = false;
+}
+
+void scendere::cached_read_mdb_txn::renew ()
+{
+	cached.txn->renew ();
+	cached.active = true;
+	cached.renewed = std::chrono::steady_clock::now ();
+}
+
+void * scendere::cached_read_mdb_txn::get_handle () const
+{
+	return cached.txn->get_handle ();
+}
+
 void * scendere::read_mdb_txn::get_handle () const
 {
 	return handle;
@@ -15,6 +15,7 @@ namespace scendere
 {
 class transaction_impl;
 class logger_mt;
+class mdb_cached_read;
 class mdb_env;
 
 class mdb_txn_callbacks
@@ -36,6 +37,19 @@ public:
 	mdb_txn_callbacks txn_callbacks;
 };
 
+/** Handle to a thread's cached read transaction which hands it back to the environment when destroyed */
+class cached_read_mdb_txn final : public read_transaction_impl
+{
+public:
+	cached_read_mdb_txn (scendere::mdb_env const &, scendere::mdb_cached_read &);
+	~cached_read_mdb_txn ();
+	void reset () override;
+	void renew () override;
+	void * get_handle () const override;
+	scendere::mdb_env const & env;
+	scendere::mdb_cached_read & cached;
+};
+
 class write_mdb_txn final : public write_transaction_impl
 {
 public:
@@ -0,0 +1,443 @@
+#include <scendere/node/memory/memory.hpp>
+#include <scendere/node/memory/memory_txn.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+namespace scendere
+{
+template <>
+void * memory_val::data () const
+{
+	return value.data;
+}
+
+template <>
+std::size_t memory_val::size () const
+{
+	return value.size;
+}
+
+template <>
+memory_val::db_val (std::size_t size_a, void * data_a) :
+	value ({ size_a, data_a })
+{
+}
+
+template <>
+void memory_val::convert_buffer_to_value ()
+{
+	value = { buffer->size (), const_cast<uint8_t *> (buffer->data ()) };
+}
+}
+
+scendere::memory_store::memory_store (scendere::ledger_constants & constants) :
+	// clang-format off
+	store_partial{
+		constants,
+		block_store_partial,
+		frontier_store_partial,
+		account_store_partial,
+		pending_store_partial,
+		unchecked_store_partial,
+		online_weight_store_partial,
+		pruned_store_partial,
+		peer_store_partial,
+		confirmation_height_store_partial,
+		final_vote_store_partial,
+		version_store_partial,
+		account_height_store_partial,
+		delegator_store_partial,
+		pending_amount_store_partial
+	},
+	// clang-format on
+	block_store_partial{ *this },
+	frontier_store_partial{ *this },
+	account_store_partial{ *this },
+	pending_store_partial{ *this },
+	unchecked_store_partial{ *this },
+	online_weight_store_partial{ *this },
+	pruned_store_partial{ *this },
+	peer_store_partial{ *this },
+	confirmation_height_store_partial{ *this },
+	final_vote_store_partial{ *this },
+	version_store_partial{ *this },
+	account_height_store_partial{ *this },
+	delegator_store_partial{ *this },
+	pending_amount_store_partial{ *this }
+{
+	for (auto table : all_tables ())
+	{
+		tables_m.emplace (std::piecewise_construct, std::forward_as_tuple (table), std::forward_as_tuple ());
+	}
+	auto transaction (tx_begin_write ());
+	version.put (transaction, version_number);
+}
+
+scendere::write_transaction scendere::memory_store::tx_begin_write (std::vector<scendere::tables> const &, std::vector<scendere::tables> const &)
+{
+	return scendere::write_transaction{ std::make_unique<scendere::write_memory_txn> (*this) };
+}
+
+scendere::read_transaction scendere::memory_store::tx_begin_read () const
+{
+	return scendere::read_transaction{ std::make_unique<scendere::read_memory_txn> (*this) };
+}
+
+std::string scendere::memory_store::vendor_get () const
+{
+	return "Memory";
+}
+
+uint64_t scendere::memory_store::write_sequence () const
+{
+	// Nothing outlives the process
+	return 0;
+}
+
+auto scendere::memory_store::visible (std::vector<revision> const & revisions_a, uint64_t sequence_a) -> revision const *
+{
+	auto existing (std::find_if (revisions_a.rbegin (), revisions_a.rend (), [sequence_a] (revision const & revision_a) { return revision_a.sequence <= sequence_a; }));
+	return (existing != revisions_a.rend () && !existing->erased) ? &*existing : nullptr;
+}
+
+uint64_t scendere::memory_store::sequence (scendere::transaction const & transaction_a) const
+{
+	return *static_cast<uint64_t const *> (transaction_a.get_handle ());
+}
+
+auto scendere::memory_store::table_get (tables table_a) const -> table &
+{
+	return tables_m.at (table_a);
+}
+
+bool scendere::memory_store::exists (scendere::transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a) const
+{
+	scendere::memory_val value;
+	return success (get (transaction_a, table_a, key_a, value));
+}
+
+int scendere::memory_store::get (scendere::transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a, scendere::memory_val & value_a) const
+{
+	auto sequence_l (sequence (transaction_a));
+	auto & table_l (table_get (table_a));
+	auto data (static_cast<uint8_t const *> (key_a.data ()));
+	auto result (status_not_found);
+	scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+	auto existing (table_l.entries.find (std::vector<uint8_t> (data, data + key_a.size ())));
+	if (existing != table_l.entries.end ())
+	{
+		if (auto revision_l = visible (existing->second, sequence_l))
+		{
+			value_a.buffer = std::make_shared<std::vector<uint8_t>> (revision_l->value);
+			value_a.convert_buffer_to_value ();
+			result = status_success;
+		}
+	}
+	return result;
+}
+
+std::vector<int> scendere::memory_store::get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::memory_val> const & keys_a, std::vector<scendere::memory_val> & values_a) const
+{
+	auto sequence_l (sequence (transaction_a));
+	auto & table_l (table_get (table_a));
+	std::vector<int> result (keys_a.size (), status_not_found);
+	values_a.resize (keys_a.size ());
+	// One lock for the whole batch
+	scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+	for (auto i (0); i < keys_a.size (); ++i)
+	{
+		auto data (static_cast<uint8_t const *> (keys_a[i].data ()));
+		auto existing (table_l.entries.find (std::vector<uint8_t> (data, data + keys_a[i].size ())));
+		if (existing != table_l.entries.end ())
+		{
+			if (auto revision_l = visible (existing->second, sequence_l))
+			{
+				values_a[i].buffer = std::make_shared<std::vector<uint8_t>> (revision_l->value);
+				values_a[i].convert_buffer_to_value ();
+				result[i] = status_success;
+			}
+		}
+	}
+	return result;
+}
+
+int scendere::memory_store::put (scendere::write_transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a, scendere::memory_val const & value_a)
+{
+	auto data (static_cast<uint8_t const *> (value_a.data ()));
+	write (transaction_a, table_a, key_a, false, std::vector<uint8_t> (data, data + value_a.size ()));
+	return status_success;
+}
+
+int scendere::memory_store::del (scendere::write_transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a)
+{
+	auto result (status_not_found);
+	if (exists (transaction_a, table_a, key_a))
+	{
+		write (transaction_a, table_a, key_a, true, {});
+		result = status_success;
+	}
+	return result;
+}
+
+void scendere::memory_store::write (scendere::write_transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a, bool erased_a, std::vector<uint8_t> value_a)
+{
+	auto sequence_l (sequence (transaction_a));
+	auto & table_l (table_get (table_a));
+	auto data (static_cast<uint8_t const *> (key_a.data ()));
+	std::vector<uint8_t> key (data, data + key_a.size ());
+	auto prunable (erased_a);
+	{
+		scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+		auto & revisions (table_l.entries[key]);
+		// Rewriting a key in the same transaction replaces the revision it wrote
+		if (!revisions.empty () && revisions.back ().sequence == sequence_l)
+		{
+			revisions.back () = { sequence_l, erased_a, std::move (value_a) };
+		}
+		else
+		{
+			revisions.push_back ({ sequence_l, erased_a, std::move (value_a) });
+		}
+		prunable = prunable || revisions.size () > 1;
+	}
+	if (prunable)
+	{
+		garbage.push_back ({ sequence_l, table_a, std::move (key) });
+	}
+}
+
+bool scendere::memory_store::seek (scendere::transaction const & transaction_a, tables table_a, std::vector<uint8_t> const * key_a, bool exclusive_a, bool direction_asc, entry & result_a) const
+{
+	auto sequence_l (sequence (transaction_a));
+	auto & table_l (table_get (table_a));
+	auto result (false);
+	scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+	auto & entries (table_l.entries);
+	if (direction_asc)
+	{
+		auto i (entries.begin ());
+		if (key_a != nullptr)
+		{
+			i = exclusive_a ? entries.upper_bound (*key_a) : entries.lower_bound (*key_a);
+		}
+		for (auto n (entries.end ()); i != n && !result; ++i)
+		{
+			if (auto revision_l = visible (i->second, sequence_l))
+			{
+				result_a = { i->first, revision_l->value };
+				result = true;
+			}
+		}
+	}
+	else
+	{
+		auto i (entries.end ());
+		if (key_a != nullptr)
+		{
+			i = exclusive_a ? entries.lower_bound (*key_a) : entries.upper_bound (*key_a);
+		}
+		for (auto n (entries.begin ()); i != n && !result;)
+		{
+			--i;
+			if (auto revision_l = visible (i->second, sequence_l))
+			{
+				result_a = { i->first, revision_l->value };
+				result = true;
+			}
+		}
+	}
+	return result;
+}
+
+uint64_t scendere::memory_store::count (scendere::transaction const & transaction_a, tables table_a) const
+{
+	auto sequence_l (sequence (transaction_a));
+	auto & table_l (table_get (table_a));
+	uint64_t result (0);
+	scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+	for (auto const & [key, revisions] : table_l.entries)
+	{
+		if (visible (revisions, sequence_l) != nullptr)
+		{
+			++result;
+		}
+	}
+	return result;
+}
+
+int scendere::memory_store::drop (scendere::write_transaction const & transaction_a, tables table_a)
+{
+	std::vector<std::vector<uint8_t>> keys;
+	{
+		auto sequence_l (sequence (transaction_a));
+		auto & table_l (table_get (table_a));
+		scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+		for (auto const & [key, revisions] : table_l.entries)
+		{
+			if (visible (revisions, sequence_l) != nullptr)
+			{
+				keys.push_back (key);
+			}
+		}
+	}
+	for (auto & key : keys)
+	{
+		write (transaction_a, table_a, scendere::memory_val (key.size (), key.data ()), true, {});
+	}
+	return status_success;
+}
+
+uint64_t scendere::memory_store::snapshot_acquire () const
+{
+	scendere::lock_guard<scendere::mutex> guard (snapshots_mutex);
+	snapshots.insert (committed);
+	return committed;
+}
+
+void scendere::memory_store::snapshot_release (uint64_t sequence_a) const
+{
+	scendere::lock_guard<scendere::mutex> guard (snapshots_mutex);
+	auto existing (snapshots.find (sequence_a));
+	debug_assert (existing != snapshots.end ());
+	snapshots.erase (existing);
+}
+
+uint64_t scendere::memory_store::write_begin ()
+{
+	debug_assert (!write_mutex.try_lock ());
+	scendere::lock_guard<scendere::mutex> guard (snapshots_mutex);
+	return committed + 1;
+}
+
+void scendere::memory_store::write_commit (uint64_t sequence_a)
+{
+	debug_assert (!write_mutex.try_lock ());
+	{
+		scendere::lock_guard<scendere::mutex> guard (snapshots_mutex);
+		debug_assert (sequence_a == committed + 1);
+		committed = sequence_a;
+	}
+	prune ();
+}
+
+void scendere::memory_store::prune ()
+{
+	uint64_t oldest;
+	{
+		scendere::lock_guard<scendere::mutex> guard (snapshots_mutex);
+		oldest = snapshots.empty () ? committed : *snapshots.begin ();
+	}
+	while (!garbage.empty () && garbage.front ().sequence <= oldest)
+	{
+		auto const & garbage_l (garbage.front ());
+		auto & table_l (table_get (garbage_l.table));
+		scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+		auto existing (table_l.entries.find (garbage_l.key));
+		if (existing != table_l.entries.end ())
+		{
+			auto & revisions (existing->second);
+			// Every snapshot sees the newest revision at or below the oldest one, anything before it is unreachable
+			auto newest (std::find_if (revisions.rbegin (), revisions.rend (), [oldest] (revision const & revision_a) { return revision_a.sequence <= oldest; }));
+			if (newest != revisions.rend ())
+			{
+				revisions.erase (revisions.begin (), std::prev (newest.base ()));
+			}
+			if (revisions.size () == 1 && revisions.front ().erased && revisions.front ().sequence <= oldest)
+			{
+				table_l.entries.erase (existing);
+			}
+		}
+		garbage.pop_front ();
+	}
+}
+
+void scendere::memory_store::serialize_memory_stats (boost::property_tree::ptree & json)
+{
+	std::size_t entries (0);
+	std::size_t revisions (0);
+	for (auto & [name, table_l] : tables_m)
+	{
+		scendere::lock_guard<scendere::mutex> guard (table_l.mutex);
+		entries += table_l.entries.size ();
+		for (auto const & [key, revisions_l] : table_l.entries)
+		{
+			revisions += revisions_l.size ();
+		}
+	}
+	json.put ("entries", entries);
+	json.put ("revisions", revisions);
+}
+
+bool scendere::memory_store::copy_db (boost::filesystem::path const &)
+{
+	// Nothing on disk to copy
+	return false;
+}
+
+void scendere::memory_store::rebuild_db (scendere::write_transaction const &)
+{
+	// Tables are never fragmented, unreachable revisions are pruned on commit
+}
+
+void scendere::memory_store::table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const
+{
+	// Nothing to gain from splitting an in-memory table, it is read as a single range
+	auto transaction (tx_begin_read ());
+	auto & sink (sink_make_a ());
+	entry entry_l;
+	for (auto found (seek (transaction, table_a, nullptr, false, true, entry_l)); found;)
+	{
+		sink.put (entry_l.first.data (), entry_l.first.size (), entry_l.second.data (), entry_l.second.size ());
+		auto key (std::move (entry_l.first));
+		found = seek (transaction, table_a, &key, true, true, entry_l);
+	}
+}
+
+unsigned scendere::memory_store::max_block_write_batch_num () const
+{
+	return std::numeric_limits<unsigned>::max ();
+}
+
+bool scendere::memory_store::init_error () const
+{
+	return false;
+}
+
+bool scendere::memory_store::not_found (int status) const
+{
+	return status == status_not_found;
+}
+
+bool scendere::memory_store::success (int status) const
+{
+	return status == status_success;
+}
+
+int scendere::memory_store::status_code_not_found () const
+{
+	return status_not_found;
+}
+
+std::string scendere::memory_store::error_string (int status) const
+{
+	std::string result ("Unknown error");
+	if (success (status))
+	{
+		result = "Success";
+	}
+	else if (not_found (status))
+	{
+		result = "Not found";
+	}
+	return result;
+}
+
+std::vector<scendere::tables> scendere::memory_store::all_tables () const
+{
+	return std::vector<scendere::tables>{ tables::account_heights, tables::accounts, tables::blocks, tables::confirmation_height, tables::delegators, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pending_amounts, tables::pruned, tables::unchecked, tables::vote };
+}
+
+// Explicitly instantiate
+template class scendere::store_partial<scendere::memory_slice, scendere::memory_store>;
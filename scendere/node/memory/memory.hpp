@@ -0,0 +1,297 @@
+#pragma once
+
+#include <scendere/lib/locks.hpp>
+#include <scendere/lib/numbers.hpp>
+#include <scendere/secure/common.hpp>
+#include <scendere/secure/store/account_height_store_partial.hpp>
+#include <scendere/secure/store/account_store_partial.hpp>
+#include <scendere/secure/store/block_store_partial.hpp>
+#include <scendere/secure/store/confirmation_height_store_partial.hpp>
+#include <scendere/secure/store/delegator_store_partial.hpp>
+#include <scendere/secure/store/final_vote_store_partial.hpp>
+#include <scendere/secure/store/frontier_store_partial.hpp>
+#include <scendere/secure/store/online_weight_partial.hpp>
+#include <scendere/secure/store/peer_store_partial.hpp>
+#include <scendere/secure/store/pending_amount_store_partial.hpp>
+#include <scendere/secure/store/pending_store_partial.hpp>
+#include <scendere/secure/store/pruned_store_partial.hpp>
+#include <scendere/secure/store/unchecked_store_partial.hpp>
+#include <scendere/secure/store/version_store_partial.hpp>
+#include <scendere/secure/store_partial.hpp>
+
+#include <boost/polymorphic_cast.hpp>
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace scendere
+{
+/** Value type of the in-memory store, points into a buffer owned by the db_val */
+class memory_slice final
+{
+public:
+	std::size_t size{ 0 };
+	void * data{ nullptr };
+};
+
+using memory_val = db_val<memory_slice>;
+
+template <>
+void * memory_val::data () const;
+template <>
+std::size_t memory_val::size () const;
+template <>
+memory_val::db_val (std::size_t size_a, void * data_a);
+template <>
+void memory_val::convert_buffer_to_value ();
+
+template <typename T, typename U>
+class memory_iterator;
+
+/**
+ * In-memory implementation of the block store, nothing is persisted. Meant for benchmarks and ephemeral test nodes.
+ * Tables are ordered maps holding a short list of revisions per key. A write transaction stamps its writes with the next sequence number,
+ * they become visible to new read transactions when it commits. Read transactions see the revisions committed when they started.
+ * Versions which no transaction can see any more are pruned on later commits. Only one write transaction is open at a time, as with LMDB.
+ */
+class memory_store : public store_partial<memory_slice, memory_store>
+{
+private:
+	scendere::block_store_partial<memory_slice, memory_store> block_store_partial;
+	scendere::frontier_store_partial<memory_slice, memory_store> frontier_store_partial;
+	scendere::account_store_partial<memory_slice, memory_store> account_store_partial;
+	scendere::pending_store_partial<memory_slice, memory_store> pending_store_partial;
+	scendere::unchecked_store_partial<memory_slice, memory_store> unchecked_store_partial;
+	scendere::online_weight_store_partial<memory_slice, memory_store> online_weight_store_partial;
+	scendere::pruned_store_partial<memory_slice, memory_store> pruned_store_partial;
+	scendere::peer_store_partial<memory_slice, memory_store> peer_store_partial;
+	scendere::confirmation_height_store_partial<memory_slice, memory_store> confirmation_height_store_partial;
+	scendere::final_vote_store_partial<memory_slice, memory_store> final_vote_store_partial;
+	scendere::version_store_partial<memory_slice, memory_store> version_store_partial;
+	scendere::account_height_store_partial<memory_slice, memory_store> account_height_store_partial;
+	scendere::delegator_store_partial<memory_slice, memory_store> delegator_store_partial;
+	scendere::pending_amount_store_partial<memory_slice, memory_store> pending_amount_store_partial;
+
+public:
+	using entry = std::pair<std::vector<uint8_t>, std::vector<uint8_t>>;
+
+	explicit memory_store (scendere::ledger_constants & constants);
+
+	scendere::write_transaction tx_begin_write (std::vector<scendere::tables> const & tables_requiring_lock = {}, std::vector<scendere::tables> const & tables_no_lock = {}) override;
+	scendere::read_transaction tx_begin_read () const override;
+
+	std::string vendor_get () const override;
+	uint64_t write_sequence () const override;
+
+	uint64_t count (scendere::transaction const & transaction_a, tables table_a) const override;
+
+	bool exists (scendere::transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a) const;
+	int get (scendere::transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a, scendere::memory_val & value_a) const;
+	std::vector<int> get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::memory_val> const & keys_a, std::vector<scendere::memory_val> & values_a) const;
+	int put (scendere::write_transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a, scendere::memory_val const & value_a);
+	int del (scendere::write_transaction const & transaction_a, tables table_a, scendere::memory_val const & key_a);
+
+	/**
+	 * Finds the first entry visible to transaction_a starting from key_a, or from the first or last key if key_a is null.
+	 * key_a itself is skipped when exclusive_a is set. Returns false if there is no such entry
+	 */
+	bool seek (scendere::transaction const & transaction_a, tables table_a, std::vector<uint8_t> const * key_a, bool exclusive_a, bool direction_asc, entry & result_a) const;
+
+	void serialize_memory_stats (boost::property_tree::ptree &) override;
+
+	bool copy_db (boost::filesystem::path const & destination) override;
+	void rebuild_db (scendere::write_transaction const & transaction_a) override;
+	void table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const override;
+
+	unsigned max_block_write_batch_num () const override;
+
+	template <typename Key, typename Value>
+	scendere::store_iterator<Key, Value> make_iterator (scendere::transaction const & transaction_a, tables table_a, bool const direction_asc) const
+	{
+		return scendere::store_iterator<Key, Value> (std::make_unique<scendere::memory_iterator<Key, Value>> (*this, transaction_a, table_a, nullptr, direction_asc));
+	}
+
+	template <typename Key, typename Value>
+	scendere::store_iterator<Key, Value> make_iterator (scendere::transaction const & transaction_a, tables table_a, scendere::memory_val const & key) const
+	{
+		return scendere::store_iterator<Key, Value> (std::make_unique<scendere::memory_iterator<Key, Value>> (*this, transaction_a, table_a, &key, true));
+	}
+
+	bool init_error () const override;
+
+	std::string error_string (int status) const override;
+
+private:
+	class revision final
+	{
+	public:
+		uint64_t sequence;
+		bool erased;
+		std::vector<uint8_t> value;
+	};
+
+	class table final
+	{
+	public:
+		scendere::mutex mutex;
+		/** Revisions of each key by ascending sequence number */
+		std::map<std::vector<uint8_t>, std::vector<revision>> entries;
+	};
+
+	class garbage_entry final
+	{
+	public:
+		uint64_t sequence;
+		scendere::tables table;
+		std::vector<uint8_t> key;
+	};
+
+	static int constexpr status_success{ 0 };
+	static int constexpr status_not_found{ 1 };
+
+	/** Returns the revision of a key seen at sequence_a, null if it does not exist or is erased at that point */
+	static revision const * visible (std::vector<revision> const &, uint64_t sequence_a);
+	uint64_t sequence (scendere::transaction const &) const;
+	table & table_get (tables) const;
+	void write (scendere::write_transaction const &, tables, scendere::memory_val const & key_a, bool erased_a, std::vector<uint8_t> value_a);
+	std::vector<scendere::tables> all_tables () const;
+
+	/** Hooks for the transactions, read snapshots are counted so pruning keeps every revision they can see */
+	uint64_t snapshot_acquire () const;
+	void snapshot_release (uint64_t) const;
+	uint64_t write_begin ();
+	void write_commit (uint64_t);
+	void prune ();
+
+	bool not_found (int status) const override;
+	bool success (int status) const override;
+	int status_code_not_found () const override;
+	int drop (scendere::write_transaction const &, tables) override;
+
+	mutable std::unordered_map<scendere::tables, table> tables_m;
+	/** Held by the open write transaction */
+	scendere::mutex write_mutex;
+	/** Keys with revisions which can be pruned once every snapshot is at or past their sequence, in sequence order. Guarded by write_mutex */
+	std::deque<garbage_entry> garbage;
+	mutable scendere::mutex snapshots_mutex;
+	mutable std::multiset<uint64_t> snapshots;
+	uint64_t committed{ 0 };
+
+	friend class read_memory_txn;
+	friend class write_memory_txn;
+};
+
+/** Iterates a snapshot of a memory_store table, entries are copied out so the table can change while iterating */
+template <typename T, typename U>
+class memory_iterator : public store_iterator_impl<T, U>
+{
+public:
+	memory_iterator (scendere::memory_store const & store_a, scendere::transaction const & transaction_a, scendere::tables table_a, scendere::memory_val const * val_a, bool const direction_asc) :
+		store (store_a),
+		transaction (transaction_a),
+		table (table_a)
+	{
+		if (val_a != nullptr)
+		{
+			auto data (static_cast<uint8_t const *> (val_a->data ()));
+			std::vector<uint8_t> key (data, data + val_a->size ());
+			seek (&key, false, true);
+		}
+		else
+		{
+			seek (nullptr, false, direction_asc);
+		}
+	}
+
+	memory_iterator (scendere::memory_iterator<T, U> const &) = delete;
+
+	scendere::store_iterator_impl<T, U> & operator++ () override
+	{
+		if (!is_end_sentinal ())
+		{
+			auto key (*current.first.buffer);
+			seek (&key, true, true);
+		}
+		return *this;
+	}
+
+	scendere::store_iterator_impl<T, U> & operator-- () override
+	{
+		if (!is_end_sentinal ())
+		{
+			auto key (*current.first.buffer);
+			seek (&key, true, false);
+		}
+		return *this;
+	}
+
+	bool operator== (scendere::store_iterator_impl<T, U> const & base_a) const override
+	{
+		auto const other_a (boost::polymorphic_downcast<scendere::memory_iterator<T, U> const *> (&base_a));
+		auto result (current.first.size () == other_a->current.first.size () && (current.first.size () == 0 || std::memcmp (current.first.data (), other_a->current.first.data (), current.first.size ()) == 0));
+		debug_assert (!result || (current.second.size () == other_a->current.second.size ()));
+		return result;
+	}
+
+	bool is_end_sentinal () const override
+	{
+		return current.first.size () == 0;
+	}
+
+	void fill (std::pair<T, U> & value_a) const override
+	{
+		if (current.first.size () != 0)
+		{
+			value_a.first = static_cast<T> (current.first);
+		}
+		else
+		{
+			value_a.first = T ();
+		}
+		if (current.second.size () != 0)
+		{
+			value_a.second = static_cast<U> (current.second);
+		}
+		else
+		{
+			value_a.second = U ();
+		}
+	}
+
+	void clear ()
+	{
+		current.first = scendere::memory_val{};
+		current.second = scendere::memory_val{};
+		debug_assert (is_end_sentinal ());
+	}
+
+	std::pair<scendere::memory_val, scendere::memory_val> current;
+
+private:
+	void seek (std::vector<uint8_t> const * key_a, bool exclusive_a, bool direction_asc)
+	{
+		scendere::memory_store::entry entry;
+		if (store.seek (transaction, table, key_a, exclusive_a, direction_asc, entry) && entry.first.size () == sizeof (T))
+		{
+			current.first.buffer = std::make_shared<std::vector<uint8_t>> (std::move (entry.first));
+			current.first.convert_buffer_to_value ();
+			current.second.buffer = std::make_shared<std::vector<uint8_t>> (std::move (entry.second));
+			current.second.convert_buffer_to_value ();
+		}
+		else
+		{
+			clear ();
+		}
+	}
+
+	scendere::memory_store const & store;
+	scendere::transaction const & transaction;
+	scendere::tables const table;
+};
+
+extern template class store_partial<memory_slice, memory_store>;
+}
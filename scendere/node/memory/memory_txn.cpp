@@ -0,0 +1,76 @@
+#include <scendere/node/memory/memory.hpp>
+#include <scendere/node/memory/memory_txn.hpp>
+
+scendere::read_memory_txn::read_memory_txn (scendere::memory_store const & store_a) :
+	store (store_a),
+	sequence (store_a.snapshot_acquire ())
+{
+}
+
+scendere::read_memory_txn::~read_memory_txn ()
+{
+	reset ();
+}
+
+void scendere::read_memory_txn::reset ()
+{
+	if (active)
+	{
+		store.snapshot_release (sequence);
+		active = false;
+	}
+}
+
+void scendere::read_memory_txn::renew ()
+{
+	debug_assert (!active);
+	sequence = store.snapshot_acquire ();
+	active = true;
+}
+
+void * scendere::read_memory_txn::get_handle () const
+{
+	return (void *)&sequence;
+}
+
+scendere::write_memory_txn::write_memory_txn (scendere::memory_store & store_a) :
+	store (store_a)
+{
+	store.write_mutex.lock ();
+	sequence = store.write_begin ();
+}
+
+scendere::write_memory_txn::~write_memory_txn ()
+{
+	commit ();
+}
+
+void scendere::write_memory_txn::commit ()
+{
+	if (active)
+	{
+		store.write_commit (sequence);
+		active = false;
+		// Other writers may proceed until this transaction is renewed
+		store.write_mutex.unlock ();
+	}
+}
+
+void scendere::write_memory_txn::renew ()
+{
+	debug_assert (!active);
+	store.write_mutex.lock ();
+	sequence = store.write_begin ();
+	active = true;
+}
+
+void * scendere::write_memory_txn::get_handle () const
+{
+	return (void *)&sequence;
+}
+
+bool scendere::write_memory_txn::contains (scendere::tables) const
+{
+	// Writes are serialized by the store so every table is available
+	return true;
+}
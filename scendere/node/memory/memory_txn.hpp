@@ -0,0 +1,39 @@
+#pragma once
+
+#include <scendere/secure/store.hpp>
+
+namespace scendere
+{
+class memory_store;
+
+class read_memory_txn final : public read_transaction_impl
+{
+public:
+	explicit read_memory_txn (scendere::memory_store const &);
+	~read_memory_txn ();
+	void reset () override;
+	void renew () override;
+	void * get_handle () const override;
+
+private:
+	scendere::memory_store const & store;
+	uint64_t sequence;
+	bool active{ true };
+};
+
+class write_memory_txn final : public write_transaction_impl
+{
+public:
+	explicit write_memory_txn (scendere::memory_store &);
+	~write_memory_txn ();
+	void commit () override;
+	void renew () override;
+	void * get_handle () const override;
+	bool contains (scendere::tables table_a) const override;
+
+private:
+	scendere::memory_store & store;
+	uint64_t sequence;
+	bool active{ true };
+};
+}
@@ -29,7 +29,7 @@ scendere::network::network (scendere::node & node_a, uint16_t port_a) :
 	limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit),
 	tcp_message_manager (node_a.config.tcp_incoming_connections_max),
 	node (node_a),
-	publish_filter (256 * 1024),
+	publish_filter (256 * 1024, 4),
 	udp_channels (node_a, port_a, inbound),
 	tcp_channels (node_a, inbound),
 	port (port_a),
@@ -210,37 +210,59 @@ void scendere::network::flood_keepalive_self (float const scale_a)
 void scendere::network::flood_block (std::shared_ptr<scendere::block> const & block_a, scendere::buffer_drop_policy const drop_policy_a)
 {
 	scendere::publish message (node.network_params.network, block_a);
-	flood_message (message, drop_policy_a);
+	auto hash (block_a->hash ());
+	for (auto & i : list (fanout ()))
+	{
+		if (!i->send (message, nullptr, drop_policy_a))
+		{
+			i->set_known (hash);
+		}
+	}
 }
 
 void scendere::network::flood_block_initial (std::shared_ptr<scendere::block> const & block_a)
 {
 	scendere::publish message (node.network_params.network, block_a);
+	auto hash (block_a->hash ());
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop);
+		if (!i.channel->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop))
+		{
+			i.channel->set_known (hash);
+		}
 	}
 	for (auto & i : list_non_pr (fanout (1.0)))
 	{
-		i->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop);
+		if (!i->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop))
+		{
+			i->set_known (hash);
+		}
 	}
 }
 
 void scendere::network::flood_vote (std::shared_ptr<scendere::vote> const & vote_a, float scale)
 {
 	scendere::confirm_ack message{ node.network_params.network, vote_a };
+	auto hash (vote_a->full_hash ());
 	for (auto & i : list (fanout (scale)))
 	{
-		i->send (message, nullptr);
+		if (!i->send (message, nullptr))
+		{
+			i->set_known (hash);
+		}
 	}
 }
 
 void scendere::network::flood_vote_pr (std::shared_ptr<scendere::vote> const & vote_a)
 {
 	scendere::confirm_ack message{ node.network_params.network, vote_a };
+	auto hash (vote_a->full_hash ());
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop);
+		if (!i.channel->send (message, nullptr, scendere::buffer_drop_policy::no_limiter_drop))
+		{
+			i.channel->set_known (hash);
+		}
 	}
 }
 
@@ -268,6 +290,18 @@ void scendere::network::flood_block_many (std::deque<std::shared_ptr<scendere::b
 	}
 }
 
+void scendere::network::relay_block (std::shared_ptr<scendere::block> const & block_a)
+{
+	scendere::publish message (node.network_params.network, block_a);
+	relay_message (message, block_a->hash (), 1.0f);
+}
+
+void scendere::network::relay_vote (std::shared_ptr<scendere::vote> const & vote_a, float scale)
+{
+	scendere::confirm_ack message{ node.network_params.network, vote_a };
+	relay_message (message, vote_a->full_hash (), scale);
+}
+
 void scendere::network::send_confirm_req (std::shared_ptr<scendere::transport::channel> const & channel_a, std::pair<scendere::block_hash, scendere::block_hash> const & hash_root_a)
 {
 	// Confirmation request with hash + root
@@ -438,6 +472,7 @@ public:
 			node.logger.try_log (boost::str (boost::format ("Publish message from %1% for %2%") % channel->to_string () % message_a.block->hash ().to_string ()));
 		}
 		node.stats.inc (scendere::stat::type::message, scendere::stat::detail::publish, scendere::stat::dir::in);
+		channel->set_known (message_a.block->hash ());
 		if (!node.block_processor.full ())
 		{
 			node.process_active (message_a.block);
@@ -484,6 +519,7 @@ public:
 		node.stats.inc (scendere::stat::type::message, scendere::stat::detail::confirm_ack, scendere::stat::dir::in);
 		if (!message_a.vote->account.is_zero ())
 		{
+			channel->set_known (message_a.vote->full_hash ());
 			if (message_a.header.block_type () != scendere::block_type::not_a_block)
 			{
 				for (auto & vote_block : message_a.vote->blocks)
@@ -650,6 +686,31 @@ std::size_t scendere::network::fanout (float scale) const
 	return static_cast<std::size_t> (std::ceil (scale * size_sqrt ()));
 }
 
+void scendere::network::relay_message (scendere::message & message_a, scendere::block_hash const & hash_a, float scale_a)
+{
+	// Sample twice the fanout so peers which already have the item can be skipped without listing every channel
+	auto remaining (fanout (scale_a));
+	for (auto const & i : random_set (remaining * 2, 0, true))
+	{
+		if (remaining == 0)
+		{
+			break;
+		}
+		if (!i->is_known (hash_a))
+		{
+			if (!i->send (message_a, nullptr, scendere::buffer_drop_policy::limiter))
+			{
+				i->set_known (hash_a);
+			}
+			--remaining;
+		}
+		else
+		{
+			node.stats.inc (scendere::stat::type::filter, scendere::stat::detail::flood_known_by_peer, scendere::stat::dir::out);
+		}
+	}
+}
+
 std::unordered_set<std::shared_ptr<scendere::transport::channel>> scendere::network::random_set (std::size_t count_a, uint8_t min_version_a, bool include_temporary_channels_a) const
 {
 	std::unordered_set<std::shared_ptr<scendere::transport::channel>> result (tcp_channels.random_set (count_a, min_version_a, include_temporary_channels_a));
@@ -133,6 +133,10 @@ public:
 	// Flood block to a random selection of peers
 	void flood_block (std::shared_ptr<scendere::block> const &, scendere::buffer_drop_policy const = scendere::buffer_drop_policy::limiter);
 	void flood_block_many (std::deque<std::shared_ptr<scendere::block>>, std::function<void ()> = nullptr, unsigned = broadcast_interval_ms);
+	// Relay a block received from the network to a random selection of peers not already known to have it
+	void relay_block (std::shared_ptr<scendere::block> const &);
+	// Relay a vote received from the network to a random selection of peers not already known to have it
+	void relay_vote (std::shared_ptr<scendere::vote> const &, float scale);
 	void merge_peers (std::array<scendere::endpoint, 8> const &);
 	void merge_peer (scendere::endpoint const &);
 	void send_keepalive (std::shared_ptr<scendere::transport::channel> const &);
@@ -152,6 +156,8 @@ public:
 	std::deque<std::shared_ptr<scendere::transport::channel>> list_non_pr (std::size_t);
 	// Desired fanout for a given scale
 	std::size_t fanout (float scale = 1.0f) const;
+	// Send to fanout peers not already known to have \p hash_a, backfilling with other peers
+	void relay_message (scendere::message &, scendere::block_hash const & hash_a, float scale);
 	void random_fill (std::array<scendere::endpoint, 8> &) const;
 	void fill_keepalive_self (std::array<scendere::endpoint, 8> &) const;
 	// Note: The minimum protocol version is used after the random selection, so number of peers can be less than expected.
@@ -3,6 +3,7 @@
 #include <scendere/lib/utility.hpp>
 #include <scendere/node/common.hpp>
 #include <scendere/node/daemonconfig.hpp>
+#include <scendere/node/memory/memory.hpp>
 #include <scendere/node/node.hpp>
 #include <scendere/node/rocksdb/rocksdb.hpp>
 #include <scendere/node/telemetry.hpp>
@@ -32,6 +33,40 @@ extern unsigned char scendere_bootstrap_weights_beta[];
 extern std::size_t scendere_bootstrap_weights_beta_size;
 }
 
+namespace
+{
+/**
+ * Builds an enabled ledger index which is incomplete, or drops a disabled one since it is not maintained and would go stale.
+ * Read only and inactive nodes leave the index as it is, it can be rebuilt explicitly from the command line.
+ * Returns whether the ledger maintains the index, which requires it to be complete
+ */
+template <typename Index>
+bool index_startup (scendere::node & node_a, bool enabled_a, std::string const & name_a, Index & index_a, scendere::tables table_a, std::function<bool (scendere::transaction const &)> const & complete_a, std::function<uint64_t ()> const & build_a)
+{
+	auto result (false);
+	if (!node_a.flags.read_only && !node_a.flags.inactive_node)
+	{
+		if (enabled_a && !complete_a (node_a.store.tx_begin_read ()))
+		{
+			node_a.logger.always_log (boost::str (boost::format ("Building %1%, this may take a while...") % name_a));
+			auto indexed (build_a ());
+			node_a.logger.always_log (boost::str (boost::format ("Finished building %1% with %2% entries") % name_a % indexed));
+		}
+		else if (!enabled_a && index_a.begin (node_a.store.tx_begin_read ()) != index_a.end ())
+		{
+			node_a.logger.always_log (boost::str (boost::format ("Dropping %1%") % name_a));
+			index_a.clear (node_a.store.tx_begin_write ({ table_a }));
+		}
+		result = enabled_a;
+	}
+	else
+	{
+		result = complete_a (node_a.store.tx_begin_read ());
+	}
+	return result;
+}
+}
+
 void scendere::node::keepalive (std::string const & address_a, uint16_t port_a)
 {
 	auto node_l (shared_from_this ());
@@ -91,13 +126,14 @@ scendere::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::pat
 	work (work_a),
 	distributed_work (*this),
 	logger (config_a.logging.min_time_between_log_output),
-	store_impl (scendere::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade)),
+	store_impl (flags.memory_store ? std::make_unique<scendere::memory_store> (network_params.ledger) : scendere::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade)),
 	store (*store_impl),
+	write_coordinator (store, stats),
 	unchecked{ store, flags.disable_block_processor_unchecked_deletion },
 	wallets_store_impl (std::make_unique<scendere::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
 	gap_cache (*this),
-	ledger (store, stats, network_params.ledger, flags_a.generate_cache),
+	ledger (store, stats, network_params.ledger, flags_a.generate_cache, flags_a.read_only || flags_a.inactive_node ? boost::filesystem::path{} : application_path_a / "ledger_cache.snapshot"),
 	checker (config.signature_checker_threads),
 	// empty `config.peering_port` means the user made no port choice at all;
 	// otherwise, any value is considered, with `0` having the special meaning of 'let the OS pick a port instead'
@@ -122,7 +158,7 @@ scendere::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::pat
 	online_reps (ledger, config),
 	history{ config.network_params.voting },
 	vote_uniquer (block_uniquer),
-	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
+	confirmation_height_processor (ledger, write_database_queue, write_coordinator, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
 	active (*this, confirmation_height_processor),
 	scheduler{ *this },
 	aggregator (config, stats, active.generator, active.final_generator, history, ledger, wallets, active),
@@ -133,6 +169,9 @@ scendere::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::pat
 	unchecked.satisfied = [this] (scendere::unchecked_info const & info) {
 		this->block_processor.add (info);
 	};
+	unchecked.write = [this] (std::function<void (scendere::write_transaction const &)> const & action_a) {
+		this->write_coordinator.submit (scendere::writer::unchecked, { tables::unchecked }, action_a).wait ();
+	};
 	if (!init_error ())
 	{
 		telemetry->start ();
@@ -441,6 +480,27 @@ scendere::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::pat
 				std::exit (1);
 			}
 		}
+
+		ledger.account_heights = index_startup (*this, config.enable_account_height_index, "account height index", store.account_height, tables::account_heights, [this] (scendere::transaction const & transaction_a) { return ledger.account_heights_complete (transaction_a); }, [this] () { return ledger.account_heights_build (); });
+		ledger.delegators = index_startup (*this, config.enable_delegator_index, "delegator index", store.delegator, tables::delegators, [this] (scendere::transaction const & transaction_a) { return ledger.delegators_complete (transaction_a); }, [this] () { return ledger.delegators_build (); });
+		ledger.pending_amounts = index_startup (*this, config.enable_receivable_amount_index, "receivable amount index", store.pending_amount, tables::pending_amounts, [this] (scendere::transaction const & transaction_a) { return ledger.pending_amounts_complete (transaction_a); }, [this] () { return ledger.pending_amounts_build (); });
+
+		if (!flags.read_only && !bootstrap_initiator.checkpoint.empty ())
+		{
+			// Checkpoint frontiers inserted before a restart which were not cemented yet
+			auto uncemented (bootstrap_initiator.checkpoint.uncemented (store.tx_begin_read (), ledger));
+			for (auto const & block : uncemented)
+			{
+				confirmation_height_processor.add (block);
+			}
+			logger.always_log (boost::str (boost::format ("%1% bootstrap checkpoint frontiers already in the ledger queued for cementing") % uncemented.size ()));
+		}
+
+		// Enabled once the startup work above is done so the figures reflect normal operation
+		if (config.diagnostics_config.store_latency.enable)
+		{
+			store.latency.enable (config.diagnostics_config.store_latency.sample_interval);
+		}
 	}
 	node_initialized_latch.count_down ();
 }
@@ -537,6 +597,10 @@ std::unique_ptr<scendere::container_info_component> scendere::collect_container_
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	if (node.store.latency.enabled ())
+	{
+		composite->add_component (collect_container_info (node.store.latency, "store_latency"));
+	}
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (node.bootstrap, "bootstrap"));
@@ -551,6 +615,7 @@ std::unique_ptr<scendere::container_info_component> scendere::collect_container_
 	composite->add_component (collect_container_info (node.vote_processor, "vote_processor"));
 	composite->add_component (collect_container_info (node.rep_crawler, "rep_crawler"));
 	composite->add_component (collect_container_info (node.block_processor, "block_processor"));
+	composite->add_component (collect_container_info (node.write_coordinator, "write_coordinator"));
 	composite->add_component (collect_container_info (node.block_arrival, "block_arrival"));
 	composite->add_component (collect_container_info (node.online_reps, "online_reps"));
 	composite->add_component (collect_container_info (node.history, "history"));
@@ -571,7 +636,7 @@ void scendere::node::process_active (std::shared_ptr<scendere::block> const & in
 
 scendere::process_return scendere::node::process (scendere::block & block_a)
 {
-	auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto const transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_amounts }));
 	auto result (ledger.process (transaction, block_a));
 	return result;
 }
@@ -586,7 +651,7 @@ scendere::process_return scendere::node::process_local (std::shared_ptr<scendere
 	block_processor.wait_write ();
 	// Process block
 	block_post_events post_events ([&store = store] { return store.tx_begin_read (); });
-	auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto const transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending, tables::pending_amounts }));
 	return block_processor.process_one (transaction, post_events, info, false, scendere::block_origin::local);
 }
 
@@ -628,6 +693,13 @@ void scendere::node::start ()
 	}
 	ongoing_rep_calculation ();
 	ongoing_peer_store ();
+	if (!flags.read_only && !flags.inactive_node)
+	{
+		auto this_l (shared ());
+		workers.add_timed_task (std::chrono::steady_clock::now () + config.ledger_cache_snapshot_interval, [this_l] () {
+			this_l->ongoing_ledger_cache_snapshot ();
+		});
+	}
 	ongoing_online_weight_calculation_queue ();
 	bool tcp_enabled (false);
 	if (config.tcp_incoming_connections_max > 0 && !(flags.disable_bootstrap_listener && flags.disable_tcp_realtime))
@@ -699,6 +771,7 @@ void scendere::node::stop ()
 		port_mapping.stop ();
 		checker.stop ();
 		wallets.stop ();
+		write_coordinator.stop ();
 		stats.stop ();
 		auto epoch_upgrade = epoch_upgrading.lock ();
 		if (epoch_upgrade->valid ())
@@ -706,6 +779,12 @@ void scendere::node::stop ()
 			epoch_upgrade->wait ();
 		}
 		workers.stop ();
+		// Command line tools run inactive nodes which do not generate the cache and may write the ledger without updating it
+		if (!flags.read_only && !flags.inactive_node)
+		{
+			// Every ledger writer has stopped, the snapshot matches the store as it is closed
+			ledger.cache_snapshot_write (application_path / "ledger_cache.snapshot");
+		}
 		// work pool is not stopped on purpose due to testing setup
 	}
 }
@@ -723,26 +802,26 @@ void scendere::node::keepalive_preconfigured (std::vector<std::string> const & p
 
 scendere::block_hash scendere::node::latest (scendere::account const & account_a)
 {
-	auto const transaction (store.tx_begin_read ());
+	auto const transaction (store.tx_begin_read_cached ());
 	return ledger.latest (transaction, account_a);
 }
 
 scendere::uint128_t scendere::node::balance (scendere::account const & account_a)
 {
-	auto const transaction (store.tx_begin_read ());
+	auto const transaction (store.tx_begin_read_cached ());
 	return ledger.account_balance (transaction, account_a);
 }
 
 std::shared_ptr<scendere::block> scendere::node::block (scendere::block_hash const & hash_a)
 {
-	auto const transaction (store.tx_begin_read ());
+	auto const transaction (store.tx_begin_read_cached ());
 	return store.block.get (transaction, hash_a);
 }
 
 std::pair<scendere::uint128_t, scendere::uint128_t> scendere::node::balance_pending (scendere::account const & account_a, bool only_confirmed_a)
 {
 	std::pair<scendere::uint128_t, scendere::uint128_t> result;
-	auto const transaction (store.tx_begin_read ());
+	auto const transaction (store.tx_begin_read_cached ());
 	result.first = ledger.account_balance (transaction, account_a, only_confirmed_a);
 	result.second = ledger.account_receivable (transaction, account_a, only_confirmed_a);
 	return result;
@@ -755,7 +834,7 @@ scendere::uint128_t scendere::node::weight (scendere::account const & account_a)
 
 scendere::block_hash scendere::node::rep_block (scendere::account const & account_a)
 {
-	auto const transaction (store.tx_begin_read ());
+	auto const transaction (store.tx_begin_read_cached ());
 	scendere::account_info info;
 	scendere::block_hash result (0);
 	if (!store.account.get (transaction, account_a, info))
@@ -881,6 +960,18 @@ void scendere::node::ongoing_peer_store ()
 	});
 }
 
+void scendere::node::ongoing_ledger_cache_snapshot ()
+{
+	ledger.cache_snapshot_write (application_path / "ledger_cache.snapshot");
+	std::weak_ptr<scendere::node> node_w (shared_from_this ());
+	workers.add_timed_task (std::chrono::steady_clock::now () + config.ledger_cache_snapshot_interval, [node_w] () {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->ongoing_ledger_cache_snapshot ();
+		}
+	});
+}
+
 void scendere::node::backup_wallet ()
 {
 	auto transaction (wallets.tx_begin_read ());
@@ -1071,7 +1162,7 @@ void scendere::node::ledger_pruning (uint64_t const batch_size_a, bool bootstrap
 		if (!pruning_targets.empty () && !stopped)
 		{
 			auto scoped_write_guard = write_database_queue.wait (scendere::writer::pruning);
-			auto write_transaction (store.tx_begin_write ({ tables::blocks, tables::pruned }));
+			auto write_transaction (store.tx_begin_write ({ tables::account_heights, tables::blocks, tables::pruned }));
 			while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
 			{
 				auto const & pruning_hash (pruning_targets.front ());
@@ -25,6 +25,7 @@
 #include <scendere/node/unchecked_map.hpp>
 #include <scendere/node/vote_processor.hpp>
 #include <scendere/node/wallet.hpp>
+#include <scendere/node/write_coordinator.hpp>
 #include <scendere/node/write_database_queue.hpp>
 #include <scendere/secure/ledger.hpp>
 #include <scendere/secure/utility.hpp>
@@ -119,6 +120,7 @@ public:
 	void ongoing_rep_calculation ();
 	void ongoing_bootstrap ();
 	void ongoing_peer_store ();
+	void ongoing_ledger_cache_snapshot ();
 	void ongoing_unchecked_cleanup ();
 	void ongoing_backlog_population ();
 	void backup_wallet ();
@@ -167,6 +169,7 @@ public:
 	scendere::logger_mt logger;
 	std::unique_ptr<scendere::store> store_impl;
 	scendere::store & store;
+	scendere::write_coordinator write_coordinator;
 	scendere::unchecked_map unchecked;
 	std::unique_ptr<scendere::wallets_store> wallets_store_impl;
 	scendere::wallets_store & wallets_store;
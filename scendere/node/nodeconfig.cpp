@@ -92,6 +92,9 @@ scendere::error scendere::node_config::serialize_toml (scendere::tomlconfig & to
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("signature_checker_threads", signature_checker_threads, "Number of additional threads dedicated to signature verification. Defaults to number of CPU threads / 2.\ntype:uint64");
 	toml.put ("enable_voting", enable_voting, "Enable or disable voting. Enabling this option requires additional system resources, namely increased CPU, bandwidth and disk usage.\ntype:bool");
+	toml.put ("enable_account_height_index", enable_account_height_index, "Maintain an index of blocks by account and height, which lets account_history and chain skip to an offset directly. Building it for an existing ledger takes a while at the next start, disabling it drops the index.\ntype:bool");
+	toml.put ("enable_delegator_index", enable_delegator_index, "Maintain an index of accounts by representative, which lets delegators and delegators_count avoid scanning every account. Building it for an existing ledger takes a while at the next start, disabling it drops the index.\ntype:bool");
+	toml.put ("enable_receivable_amount_index", enable_receivable_amount_index, "Maintain an index of receivable blocks by amount for each account, which lets receivable queries with a threshold return the largest entries and wallet searches skip amounts below receive_minimum without reading them. Building it for an existing ledger takes a while at the next start, disabling it drops the index.\ntype:bool");
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 4.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
 	toml.put ("bootstrap_initiator_threads", bootstrap_initiator_threads, "Number of threads dedicated to concurrent bootstrap attempts. Defaults to 1.\nWarning: a larger amount of attempts may use additional system memory and disk IO.\ntype:uint64");
@@ -334,6 +337,9 @@ scendere::error scendere::node_config::deserialize_toml (scendere::tomlconfig &
 		toml.get<unsigned> ("bootstrap_initiator_threads", bootstrap_initiator_threads);
 		toml.get<uint32_t> ("bootstrap_frontier_request_count", bootstrap_frontier_request_count);
 		toml.get<bool> ("enable_voting", enable_voting);
+		toml.get<bool> ("enable_account_height_index", enable_account_height_index);
+		toml.get<bool> ("enable_delegator_index", enable_delegator_index);
+		toml.get<bool> ("enable_receivable_amount_index", enable_receivable_amount_index);
 		toml.get<bool> ("allow_local_peers", allow_local_peers);
 		toml.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
 
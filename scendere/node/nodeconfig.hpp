@@ -62,6 +62,12 @@ public:
 	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
 	unsigned signature_checker_threads{ std::thread::hardware_concurrency () / 2 };
 	bool enable_voting{ false };
+	/** Index blocks by account and height so history can be paged from any height */
+	bool enable_account_height_index{ false };
+	/** Index accounts by representative so delegators can be listed without scanning all accounts */
+	bool enable_delegator_index{ false };
+	/** Index receivable entries by amount so threshold queries and searches skip small amounts */
+	bool enable_receivable_amount_index{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
 	unsigned bootstrap_initiator_threads{ 1 };
@@ -89,6 +95,8 @@ public:
 	static std::chrono::seconds constexpr keepalive_period = std::chrono::seconds (60);
 	static std::chrono::seconds constexpr keepalive_cutoff = keepalive_period * 5;
 	static std::chrono::minutes constexpr wallet_backup_interval = std::chrono::minutes (5);
+	/** How often the ledger cache is saved so a restart after a crash can skip rebuilding it, it is also saved on shutdown */
+	static std::chrono::minutes constexpr ledger_cache_snapshot_interval = std::chrono::minutes (5);
 	/** Default outbound traffic shaping is 10MB/s */
 	std::size_t bandwidth_limit{ 10 * 1024 * 1024 };
 	/** By default, allow bursts of 15MB/s (not sustainable) */
@@ -141,8 +149,14 @@ public:
 	bool force_use_write_database_queue{ false }; // For testing only. RocksDB does not use the database queue, but some tests rely on it being used.
 	bool disable_search_pending{ false }; // For testing only
 	bool enable_pruning{ false };
+	bool enable_ascending_bootstrap{ false };
+	bool enable_compact_bulk_pull{ false };
 	bool fast_bootstrap{ false };
+	/** Path of a trusted checkpoint of confirmed account frontiers, blocks up to them are cemented without elections */
+	std::string bootstrap_checkpoint;
 	bool read_only{ false };
+	/** Keep the ledger in memory instead of the configured database, it is lost when the node stops */
+	bool memory_store{ false };
 	bool disable_connection_cleanup{ false };
 	scendere::confirmation_height_mode confirmation_height_processor_mode{ scendere::confirmation_height_mode::automatic };
 	scendere::generate_cache generate_cache;
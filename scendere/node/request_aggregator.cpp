@@ -168,15 +168,30 @@ void scendere::request_aggregator::erase_duplicates (std::vector<std::pair<scend
 
 std::pair<std::vector<std::shared_ptr<scendere::block>>, std::vector<std::shared_ptr<scendere::block>>> scendere::request_aggregator::aggregate (std::vector<std::pair<scendere::block_hash, scendere::root>> const & requests_a, std::shared_ptr<scendere::transport::channel> & channel_a) const
 {
-	auto transaction (ledger.store.tx_begin_read ());
+	auto transaction (ledger.store.tx_begin_read_cached ());
 	std::size_t cached_hashes = 0;
 	std::vector<std::shared_ptr<scendere::block>> to_generate;
 	std::vector<std::shared_ptr<scendere::block>> to_generate_final;
 	std::vector<std::shared_ptr<scendere::vote>> cached_votes;
+	// Blocks of the requests which are not answered from the vote cache are read from the ledger in one batch
+	std::vector<std::vector<std::shared_ptr<scendere::vote>>> found_votes;
+	found_votes.reserve (requests_a.size ());
+	std::vector<scendere::block_hash> ledger_hashes;
 	for (auto const & [hash, root] : requests_a)
 	{
+		found_votes.push_back (local_votes.votes (root, hash));
+		if (found_votes.back ().empty ())
+		{
+			ledger_hashes.push_back (hash);
+		}
+	}
+	auto ledger_blocks (ledger.store.block.get_many (transaction, ledger_hashes));
+	auto ledger_block (ledger_blocks.begin ());
+	for (auto i (0); i < requests_a.size (); ++i)
+	{
+		auto const & [hash, root] = requests_a[i];
 		// 1. Votes in cache
-		auto find_votes (local_votes.votes (root, hash));
+		auto const & find_votes (found_votes[i]);
 		if (!find_votes.empty ())
 		{
 			++cached_hashes;
@@ -187,6 +202,7 @@ std::pair<std::vector<std::shared_ptr<scendere::block>>, std::vector<std::shared
 			bool generate_vote (true);
 			bool generate_final_vote (false);
 			std::shared_ptr<scendere::block> block;
+			auto ledger_block_l (*ledger_block++);
 
 			//2. Final votes
 			auto final_vote_hashes (ledger.store.final_vote.get (transaction, root));
@@ -212,7 +228,7 @@ std::pair<std::vector<std::shared_ptr<scendere::block>>, std::vector<std::shared
 			// 4. Ledger by hash
 			if (block == nullptr)
 			{
-				block = ledger.store.block.get (transaction, hash);
+				block = ledger_block_l;
 				// Confirmation status. Generate final votes for confirmed
 				if (block != nullptr)
 				{
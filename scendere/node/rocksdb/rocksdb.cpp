@@ -5,6 +5,7 @@
 #include <scendere/node/rocksdb/rocksdb_txn.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -15,6 +16,7 @@
 #include <rocksdb/utilities/backupable_db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/write_batch.h>
 
 namespace
 {
@@ -77,7 +79,10 @@ scendere::rocksdb_store::rocksdb_store (scendere::logger_mt & logger_a, boost::f
 		peer_store_partial,
 		confirmation_height_store_partial,
 		final_vote_store_partial,
-		version_rocksdb_store
+		version_rocksdb_store,
+		account_height_store_partial,
+		delegator_store_partial,
+		pending_amount_store_partial
 	},
 	// clang-format on
 	block_store_partial{ *this },
@@ -91,7 +96,11 @@ scendere::rocksdb_store::rocksdb_store (scendere::logger_mt & logger_a, boost::f
 	confirmation_height_store_partial{ *this },
 	final_vote_store_partial{ *this },
 	version_rocksdb_store{ *this },
+	account_height_store_partial{ *this },
+	delegator_store_partial{ *this },
+	pending_amount_store_partial{ *this },
 	logger{ logger_a },
+	path{ path_a },
 	constants{ constants },
 	rocksdb_config{ rocksdb_config_a },
 	max_block_write_batch_num_m{ scendere::narrow_cast<unsigned> (blocks_memtable_size_bytes () / (2 * (sizeof (scendere::block_type) + scendere::state_block::size + scendere::block_sideband::size (scendere::block_type::state)))) },
@@ -128,7 +137,10 @@ std::unordered_map<char const *, scendere::tables> scendere::rocksdb_store::crea
 		{ "peers", tables::peers },
 		{ "confirmation_height", tables::confirmation_height },
 		{ "pruned", tables::pruned },
-		{ "final_votes", tables::final_votes } };
+		{ "final_votes", tables::final_votes },
+		{ "account_heights", tables::account_heights },
+		{ "delegators", tables::delegators },
+		{ "pending_amounts", tables::pending_amounts } };
 
 	debug_assert (map.size () == all_tables ().size () + 1);
 	return map;
@@ -174,7 +186,66 @@ void scendere::rocksdb_store::open (bool & error_a, boost::filesystem::path cons
 			error_a = true;
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
 		}
+		else if (version_l < 25)
+		{
+			if (!open_read_only_a)
+			{
+				upgrade_v24_to_v25 ();
+			}
+			else
+			{
+				// Blocks are still in the fixed layout, which cannot be decoded without the upgrade. Raw access as block iterators decode entries
+				std::unique_ptr<rocksdb::Iterator> blocks (db->NewIterator (rocksdb::ReadOptions{}, table_to_column_family (tables::blocks)));
+				blocks->SeekToFirst ();
+				if (blocks->Valid ())
+				{
+					error_a = true;
+					logger.always_log (boost::str (boost::format ("The ledger (version %1%) must be upgraded by starting the node before it can be opened read only") % version_l));
+				}
+			}
+		}
+	}
+}
+
+void scendere::rocksdb_store::upgrade_v24_to_v25 ()
+{
+	logger.always_log ("Preparing v24 to v25 database upgrade...");
+	auto blocks_handle (table_to_column_family (tables::blocks));
+	uint64_t count_l (0);
+	uint64_t bytes_before (0);
+	uint64_t bytes_after (0);
+	rocksdb::WriteBatch batch;
+	auto write_batch = [this, &batch] () {
+		auto status (db->Write (rocksdb::WriteOptions{}, &batch));
+		release_assert (status.ok ());
+		batch.Clear ();
+	};
+	// Entries already in the compact layout are skipped, so an interrupted upgrade resumes where it stopped
+	std::unique_ptr<rocksdb::Iterator> iterator (db->NewIterator (rocksdb::ReadOptions{}, blocks_handle));
+	for (iterator->SeekToFirst (); iterator->Valid (); iterator->Next (), ++count_l)
+	{
+		auto value (iterator->value ());
+		auto data (scendere::block_entry_compact (reinterpret_cast<uint8_t const *> (value.data ()), value.size ()));
+		bytes_before += value.size ();
+		bytes_after += data.empty () ? value.size () : data.size ();
+		if (!data.empty ())
+		{
+			batch.Put (blocks_handle, iterator->key (), rocksdb::Slice (reinterpret_cast<char const *> (data.data ()), data.size ()));
+			if (batch.Count () >= max_block_write_batch_num ())
+			{
+				write_batch ();
+			}
+		}
+	}
+	release_assert (iterator->status ().ok ());
+	write_batch ();
+	// An empty store is left alone, initializing it writes the current version
+	if (count_l > 0)
+	{
+		auto transaction (tx_begin_write ({ tables::meta }));
+		version.put (transaction, 25);
 	}
+	logger.always_log (boost::str (boost::format ("Finished compacting %1% blocks, block data reduced from %2% to %3% bytes") % count_l % bytes_before % bytes_after));
 }
 
 void scendere::rocksdb_store::generate_tombstone_map ()
@@ -183,6 +254,7 @@ void scendere::rocksdb_store::generate_tombstone_map ()
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (scendere::tables::blocks), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (scendere::tables::accounts), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (scendere::tables::pending), std::forward_as_tuple (0, 25000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (scendere::tables::pending_amounts), std::forward_as_tuple (0, 25000));
 }
 
 rocksdb::ColumnFamilyOptions scendere::rocksdb_store::get_common_cf_options (std::shared_ptr<rocksdb::TableFactory> const & table_factory_a, unsigned long long memtable_size_bytes_a) const
@@ -299,6 +371,28 @@ rocksdb::ColumnFamilyOptions scendere::rocksdb_store::get_cf_options (std::strin
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
+	else if (cf_name_a == "account_heights")
+	{
+		// Written with every block and rarely deleted, looked up by account and height
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "delegators")
+	{
+		// One entry per account, rewritten only when the representative changes and read over representative ranges
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "pending_amounts")
+	{
+		// Written and deleted along with pending
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+
+		// Same compaction settings as pending as it has as many deletions
+		cf_options.level0_file_num_compaction_trigger = 2;
+		cf_options.max_bytes_for_level_base = memtable_size_bytes * 2;
+	}
 	else if (cf_name_a == rocksdb::kDefaultColumnFamilyName)
 	{
 		// Do nothing.
@@ -352,6 +446,11 @@ std::string scendere::rocksdb_store::vendor_get () const
 	return boost::str (boost::format ("RocksDB %1%.%2%.%3%") % ROCKSDB_MAJOR % ROCKSDB_MINOR % ROCKSDB_PATCH);
 }
 
+uint64_t scendere::rocksdb_store::write_sequence () const
+{
+	return db->GetLatestSequenceNumber ();
+}
+
 rocksdb::ColumnFamilyHandle * scendere::rocksdb_store::table_to_column_family (tables table_a) const
 {
 	auto & handles_l = handles;
@@ -389,6 +488,12 @@ rocksdb::ColumnFamilyHandle * scendere::rocksdb_store::table_to_column_family (t
 			return get_handle ("confirmation_height");
 		case tables::final_votes:
 			return get_handle ("final_votes");
+		case tables::account_heights:
+			return get_handle ("account_heights");
+		case tables::delegators:
+			return get_handle ("delegators");
+		case tables::pending_amounts:
+			return get_handle ("pending_amounts");
 		default:
 			release_assert (false);
 			return get_handle ("");
@@ -481,6 +586,43 @@ int scendere::rocksdb_store::get (scendere::transaction const & transaction_a, t
 	return status.code ();
 }
 
+std::vector<int> scendere::rocksdb_store::get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::rocksdb_val> const & keys_a, std::vector<scendere::rocksdb_val> & values_a) const
+{
+	auto order (key_order (keys_a));
+	std::vector<rocksdb::Slice> keys;
+	keys.reserve (order.size ());
+	for (auto index : order)
+	{
+		keys.push_back (keys_a[index]);
+	}
+	std::vector<rocksdb::PinnableSlice> slices (keys.size ());
+	std::vector<rocksdb::Status> statuses (keys.size ());
+	auto handle = table_to_column_family (table_a);
+	// Keys are passed sorted so MultiGet can skip the sort, every key is read from the same snapshot
+	if (is_read (transaction_a))
+	{
+		db->MultiGet (snapshot_options (transaction_a), handle, keys.size (), keys.data (), slices.data (), statuses.data (), true);
+	}
+	else
+	{
+		tx (transaction_a)->MultiGet (rocksdb::ReadOptions{}, handle, keys.size (), keys.data (), slices.data (), statuses.data (), true);
+	}
+	std::vector<int> result (keys_a.size ());
+	values_a.resize (keys_a.size ());
+	for (auto i (0); i < order.size (); ++i)
+	{
+		auto index (order[i]);
+		if (statuses[i].ok ())
+		{
+			values_a[index].buffer = std::make_shared<std::vector<uint8_t>> (slices[i].size ());
+			std::memcpy (values_a[index].buffer->data (), slices[i].data (), slices[i].size ());
+			values_a[index].convert_buffer_to_value ();
+		}
+		result[index] = statuses[i].code ();
+	}
+	return result;
+}
+
 int scendere::rocksdb_store::put (scendere::write_transaction const & transaction_a, tables table_a, scendere::rocksdb_val const & key_a, scendere::rocksdb_val const & value_a)
 {
 	debug_assert (transaction_a.contains (table_a));
@@ -536,6 +678,11 @@ uint64_t scendere::rocksdb_store::count (scendere::transaction const & transacti
 	{
 		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
 	}
+	// These are only estimations, entries are deleted on rollback, pruning or representative changes
+	else if (table_a == tables::account_heights || table_a == tables::delegators || table_a == tables::pending_amounts)
+	{
+		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
+	}
 	// Accounts and blocks should only be used in tests and CLI commands to check database consistency
 	// otherwise there can be performance issues.
 	else if (table_a == tables::accounts)
@@ -749,7 +896,92 @@ void scendere::rocksdb_store::on_flush (rocksdb::FlushJobInfo const & flush_job_
 
 std::vector<scendere::tables> scendere::rocksdb_store::all_tables () const
 {
-	return std::vector<scendere::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
+	return std::vector<scendere::tables>{ tables::account_heights, tables::accounts, tables::blocks, tables::confirmation_height, tables::delegators, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pending_amounts, tables::pruned, tables::unchecked, tables::vote };
+}
+
+void scendere::rocksdb_store::table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const
+{
+	auto & sink (sink_make_a ());
+	std::unique_ptr<rocksdb::Iterator> iterator (db->NewIterator (rocksdb::ReadOptions{}, table_to_column_family (table_a)));
+	for (iterator->SeekToFirst (); iterator->Valid (); iterator->Next ())
+	{
+		sink.put (iterator->key ().data (), iterator->key ().size (), iterator->value ().data (), iterator->value ().size ());
+	}
+	release_assert (iterator->status ().ok ());
+}
+
+std::unique_ptr<scendere::table_sink> scendere::rocksdb_store::table_sink_make (tables table_a)
+{
+	auto handle (table_to_column_family (table_a));
+	boost::system::error_code error_mkdir;
+	boost::filesystem::create_directories (path / "ingest", error_mkdir);
+	auto file (path / "ingest" / boost::str (boost::format ("%1%_%2%.sst") % handle->GetName () % sink_files++));
+	return std::make_unique<scendere::rocksdb_table_sink> (rocksdb::Options (rocksdb::DBOptions{}, get_cf_options (handle->GetName ())), handle, file);
+}
+
+bool scendere::rocksdb_store::table_sinks_commit (tables table_a, std::vector<std::unique_ptr<scendere::table_sink>> & sinks_a)
+{
+	auto error (false);
+	std::vector<std::string> files;
+	for (auto & sink : sinks_a)
+	{
+		auto & sink_l (*boost::polymorphic_downcast<scendere::rocksdb_table_sink *> (sink.get ()));
+		if (sink_l.count () > 0)
+		{
+			if (sink_l.status.ok ())
+			{
+				sink_l.status = sink_l.writer.Finish ();
+			}
+			error |= !sink_l.status.ok ();
+			files.push_back (sink_l.file.string ());
+		}
+	}
+	if (!error && !files.empty ())
+	{
+		// The sinks hold disjoint key ranges so every file goes in at once, straight to the bottom level of an empty column family
+		rocksdb::IngestExternalFileOptions options;
+		options.move_files = true;
+		auto status (db->IngestExternalFile (table_to_column_family (table_a), files, options));
+		if (!status.ok ())
+		{
+			logger.always_log ("Ingesting table files failed: ", status.ToString ());
+			error = true;
+		}
+	}
+	sinks_a.clear ();
+	for (auto const & file : files)
+	{
+		boost::system::error_code error_remove;
+		boost::filesystem::remove (file, error_remove);
+	}
+	return error;
+}
+
+scendere::rocksdb_table_sink::rocksdb_table_sink (rocksdb::Options const & options_a, rocksdb::ColumnFamilyHandle * handle_a, boost::filesystem::path const & file_a) :
+	writer (rocksdb::EnvOptions{}, options_a, handle_a),
+	file (file_a)
+{
+}
+
+void scendere::rocksdb_table_sink::put (void const * key_a, std::size_t key_size_a, void const * value_a, std::size_t value_size_a)
+{
+	if (status.ok ())
+	{
+		if (count_m == 0)
+		{
+			status = writer.Open (file.string ());
+		}
+		if (status.ok ())
+		{
+			status = writer.Put (rocksdb::Slice (static_cast<char const *> (key_a), key_size_a), rocksdb::Slice (static_cast<char const *> (value_a), value_size_a));
+		}
+	}
+	++count_m;
+}
+
+uint64_t scendere::rocksdb_table_sink::count () const
+{
+	return count_m;
 }
 
 bool scendere::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
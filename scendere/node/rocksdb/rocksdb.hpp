@@ -5,12 +5,15 @@
 #include <scendere/lib/numbers.hpp>
 #include <scendere/node/rocksdb/rocksdb_iterator.hpp>
 #include <scendere/secure/common.hpp>
+#include <scendere/secure/store/account_height_store_partial.hpp>
 #include <scendere/secure/store/account_store_partial.hpp>
 #include <scendere/secure/store/confirmation_height_store_partial.hpp>
+#include <scendere/secure/store/delegator_store_partial.hpp>
 #include <scendere/secure/store/final_vote_store_partial.hpp>
 #include <scendere/secure/store/frontier_store_partial.hpp>
 #include <scendere/secure/store/online_weight_partial.hpp>
 #include <scendere/secure/store/peer_store_partial.hpp>
+#include <scendere/secure/store/pending_amount_store_partial.hpp>
 #include <scendere/secure/store/pending_store_partial.hpp>
 #include <scendere/secure/store/pruned_store_partial.hpp>
 #include <scendere/secure/store/unchecked_store_partial.hpp>
@@ -21,6 +24,7 @@
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -50,6 +54,23 @@ private:
 	scendere::rocksdb_store & rocksdb_store;
 };
 
+/** Writes the entries it is given to a sorted table file, which is ingested into the column family on commit */
+class rocksdb_table_sink final : public scendere::table_sink
+{
+public:
+	rocksdb_table_sink (rocksdb::Options const &, rocksdb::ColumnFamilyHandle *, boost::filesystem::path const &);
+	void put (void const * key_a, std::size_t key_size_a, void const * value_a, std::size_t value_size_a) override;
+	uint64_t count () const override;
+
+	rocksdb::SstFileWriter writer;
+	boost::filesystem::path const file;
+	/** First error from the writer, the file is only opened once it has an entry as empty files cannot be ingested */
+	rocksdb::Status status;
+
+private:
+	uint64_t count_m{ 0 };
+};
+
 /**
  * rocksdb implementation of the block store
  */
@@ -67,6 +88,9 @@ private:
 	scendere::confirmation_height_store_partial<rocksdb::Slice, rocksdb_store> confirmation_height_store_partial;
 	scendere::final_vote_store_partial<rocksdb::Slice, rocksdb_store> final_vote_store_partial;
 	scendere::version_rocksdb_store version_rocksdb_store;
+	scendere::account_height_store_partial<rocksdb::Slice, rocksdb_store> account_height_store_partial;
+	scendere::delegator_store_partial<rocksdb::Slice, rocksdb_store> delegator_store_partial;
+	scendere::pending_amount_store_partial<rocksdb::Slice, rocksdb_store> pending_amount_store_partial;
 
 public:
 	friend class scendere::unchecked_rocksdb_store;
@@ -78,11 +102,13 @@ public:
 	scendere::read_transaction tx_begin_read () const override;
 
 	std::string vendor_get () const override;
+	uint64_t write_sequence () const override;
 
 	uint64_t count (scendere::transaction const & transaction_a, tables table_a) const override;
 
 	bool exists (scendere::transaction const & transaction_a, tables table_a, scendere::rocksdb_val const & key_a) const;
 	int get (scendere::transaction const & transaction_a, tables table_a, scendere::rocksdb_val const & key_a, scendere::rocksdb_val & value_a) const;
+	std::vector<int> get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::rocksdb_val> const & keys_a, std::vector<scendere::rocksdb_val> & values_a) const;
 	int put (scendere::write_transaction const & transaction_a, tables table_a, scendere::rocksdb_val const & key_a, scendere::rocksdb_val const & value_a);
 	int del (scendere::write_transaction const & transaction_a, tables table_a, scendere::rocksdb_val const & key_a);
 
@@ -90,6 +116,9 @@ public:
 
 	bool copy_db (boost::filesystem::path const & destination) override;
 	void rebuild_db (scendere::write_transaction const & transaction_a) override;
+	void table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const override;
+	std::unique_ptr<scendere::table_sink> table_sink_make (tables table_a) override;
+	bool table_sinks_commit (tables table_a, std::vector<std::unique_ptr<scendere::table_sink>> & sinks_a) override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -112,6 +141,9 @@ public:
 private:
 	bool error{ false };
 	scendere::logger_mt & logger;
+	boost::filesystem::path const path;
+	/** Numbers the files written by table sinks */
+	std::atomic<uint64_t> sink_files{ 0 };
 	scendere::ledger_constants & constants;
 	// Optimistic transactions are used in write mode
 	rocksdb::OptimisticTransactionDB * optimistic_db = nullptr;
@@ -145,6 +177,7 @@ private:
 	int clear (rocksdb::ColumnFamilyHandle * column_family);
 
 	void open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a);
+	void upgrade_v24_to_v25 ();
 
 	void construct_column_family_mutexes ();
 	rocksdb::Options get_db_options ();
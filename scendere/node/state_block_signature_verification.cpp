@@ -136,12 +136,13 @@ void scendere::state_block_signature_verification::verify_state_blocks (std::deq
 			hashes.push_back (block->hash ());
 			messages.push_back (hashes.back ().bytes.data ());
 			lengths.push_back (sizeof (decltype (hashes)::value_type));
+			// State and open blocks carry their signer, legacy send/receive/change blocks are verified against the supplied account
 			scendere::account account_l = block->account ();
-			if (!block->link ().is_zero () && epochs.is_epoch_link (block->link ()))
+			if (block->type () == scendere::block_type::state && !block->link ().is_zero () && epochs.is_epoch_link (block->link ()))
 			{
 				account_l = epochs.signer (epochs.epoch (block->link ()));
 			}
-			else if (!account.is_zero ())
+			else if (account_l.is_zero ())
 			{
 				account_l = account;
 			}
@@ -154,7 +155,7 @@ void scendere::state_block_signature_verification::verify_state_blocks (std::deq
 		signature_checker.verify (check);
 		if (node_config.logging.timing_logging () && timer_l.stop () > std::chrono::milliseconds (10))
 		{
-			logger.try_log (boost::str (boost::format ("Batch verified %1% state blocks in %2% %3%") % size % timer_l.value ().count () % timer_l.unit ()));
+			logger.try_log (boost::str (boost::format ("Batch verified %1% blocks in %2% %3%") % size % timer_l.value ().count () % timer_l.unit ()));
 		}
 		blocks_verified_callback (items, verifications, hashes, blocks_signatures);
 	}
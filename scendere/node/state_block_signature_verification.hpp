@@ -14,6 +14,11 @@ class logger_mt;
 class node_config;
 class signature_checker;
 
+/**
+ * Batch signature verification ahead of the block processor. Despite the name, every block type whose signer is known is handled:
+ * state and open blocks are checked against their own account or the epoch signer, legacy send/receive/change blocks against the account
+ * supplied with them, such as the account of a bootstrap pull
+ */
 class state_block_signature_verification
 {
 public:
@@ -130,6 +130,7 @@ bool scendere::transport::tcp_channels::insert (std::shared_ptr<scendere::transp
 			}
 			channels.get<endpoint_tag> ().emplace (channel_a, socket_a, bootstrap_server_a);
 			attempts.get<endpoint_tag> ().erase (endpoint);
+			publish_snapshot ();
 			error = false;
 			lock.unlock ();
 			node.network.channel_observer (channel_a);
@@ -146,22 +147,22 @@ void scendere::transport::tcp_channels::erase (scendere::tcp_endpoint const & en
 {
 	scendere::lock_guard<scendere::mutex> lock (mutex);
 	channels.get<endpoint_tag> ().erase (endpoint_a);
+	publish_snapshot ();
 }
 
 std::size_t scendere::transport::tcp_channels::size () const
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	return channels.size ();
+	return snapshot ()->channels.size ();
 }
 
 std::shared_ptr<scendere::transport::channel_tcp> scendere::transport::tcp_channels::find_channel (scendere::tcp_endpoint const & endpoint_a) const
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
+	auto snapshot_l (snapshot ());
 	std::shared_ptr<scendere::transport::channel_tcp> result;
-	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
-	if (existing != channels.get<endpoint_tag> ().end ())
+	auto existing (snapshot_l->endpoints.find (endpoint_a));
+	if (existing != snapshot_l->endpoints.end ())
 	{
-		result = existing->channel;
+		result = existing->second;
 	}
 	return result;
 }
@@ -170,19 +171,20 @@ std::unordered_set<std::shared_ptr<scendere::transport::channel>> scendere::tran
 {
 	std::unordered_set<std::shared_ptr<scendere::transport::channel>> result;
 	result.reserve (count_a);
-	scendere::lock_guard<scendere::mutex> lock (mutex);
+	auto snapshot_l (snapshot ());
+	auto const & channels_l (snapshot_l->channels);
 	// Stop trying to fill result with random samples after this many attempts
 	auto random_cutoff (count_a * 2);
-	auto peers_size (channels.size ());
+	auto peers_size (channels_l.size ());
 	// Usually count_a will be much smaller than peers.size()
 	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
+	if (!channels_l.empty ())
 	{
 		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
 		{
 			auto index (scendere::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (peers_size - 1)));
 
-			auto channel = channels.get<random_access_tag> ()[index].channel;
+			auto const & channel = channels_l[index];
 			if (channel->get_network_version () >= min_version && (include_temporary_channels_a || !channel->temporary))
 			{
 				result.insert (channel);
@@ -240,11 +242,11 @@ bool scendere::transport::tcp_channels::store_all (bool clear_peers)
 std::shared_ptr<scendere::transport::channel_tcp> scendere::transport::tcp_channels::find_node_id (scendere::account const & node_id_a)
 {
 	std::shared_ptr<scendere::transport::channel_tcp> result;
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	auto existing (channels.get<node_id_tag> ().find (node_id_a));
-	if (existing != channels.get<node_id_tag> ().end ())
+	auto snapshot_l (snapshot ());
+	auto existing (snapshot_l->node_ids.find (node_id_a));
+	if (existing != snapshot_l->node_ids.end ())
 	{
-		result = existing->channel;
+		result = existing->second;
 	}
 	return result;
 }
@@ -357,6 +359,7 @@ void scendere::transport::tcp_channels::stop ()
 		}
 	}
 	channels.clear ();
+	publish_snapshot ();
 }
 
 bool scendere::transport::tcp_channels::max_ip_connections (scendere::tcp_endpoint const & endpoint_a)
@@ -436,6 +439,7 @@ std::unique_ptr<scendere::container_info_component> scendere::transport::tcp_cha
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "snapshot", snapshot ()->channels.size (), sizeof (decltype (channels_snapshot::endpoints)::value_type) + sizeof (decltype (channels_snapshot::node_ids)::value_type) + sizeof (decltype (channels_snapshot::channels)::value_type) }));
 
 	return composite;
 }
@@ -452,6 +456,7 @@ void scendere::transport::tcp_channels::purge (std::chrono::steady_clock::time_p
 	// Check if any tcp channels belonging to old protocol versions which may still be alive due to async operations
 	auto lower_bound = channels.get<version_tag> ().lower_bound (node.network_params.network.protocol_version_min);
 	channels.get<version_tag> ().erase (channels.get<version_tag> ().begin (), lower_bound);
+	publish_snapshot ();
 }
 
 void scendere::transport::tcp_channels::ongoing_keepalive ()
@@ -499,12 +504,10 @@ void scendere::transport::tcp_channels::ongoing_keepalive ()
 
 void scendere::transport::tcp_channels::list (std::deque<std::shared_ptr<scendere::transport::channel>> & deque_a, uint8_t minimum_version_a, bool include_temporary_channels_a)
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	// clang-format off
-	scendere::transform_if (channels.get<random_access_tag> ().begin (), channels.get<random_access_tag> ().end (), std::back_inserter (deque_a),
-		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a.channel->get_network_version () >= minimum_version_a && (include_temporary_channels_a || !channel_a.channel->temporary); },
-		[](auto const & channel) { return channel.channel; });
-	// clang-format on
+	auto snapshot_l (snapshot ());
+	std::copy_if (snapshot_l->channels.begin (), snapshot_l->channels.end (), std::back_inserter (deque_a), [include_temporary_channels_a, minimum_version_a] (auto const & channel_a) {
+		return channel_a->get_network_version () >= minimum_version_a && (include_temporary_channels_a || !channel_a->temporary);
+	});
 }
 
 void scendere::transport::tcp_channels::modify (std::shared_ptr<scendere::transport::channel_tcp> const & channel_a, std::function<void (std::shared_ptr<scendere::transport::channel_tcp> const &)> modify_callback_a)
@@ -516,6 +519,8 @@ void scendere::transport::tcp_channels::modify (std::shared_ptr<scendere::transp
 		channels.get<endpoint_tag> ().modify (existing, [modify_callback = std::move (modify_callback_a)] (channel_tcp_wrapper & wrapper_a) {
 			modify_callback (wrapper_a.channel);
 		});
+		// The callback may change indexed fields such as the node id
+		publish_snapshot ();
 	}
 }
 
@@ -531,6 +536,27 @@ void scendere::transport::tcp_channels::update (scendere::tcp_endpoint const & e
 	}
 }
 
+auto scendere::transport::tcp_channels::snapshot () const -> std::shared_ptr<channels_snapshot const>
+{
+	return std::atomic_load (&current_snapshot);
+}
+
+void scendere::transport::tcp_channels::publish_snapshot ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto snapshot_l (std::make_shared<channels_snapshot> ());
+	snapshot_l->channels.reserve (channels.size ());
+	snapshot_l->endpoints.reserve (channels.size ());
+	snapshot_l->node_ids.reserve (channels.size ());
+	for (auto const & wrapper : channels.get<random_access_tag> ())
+	{
+		snapshot_l->channels.push_back (wrapper.channel);
+		snapshot_l->endpoints.emplace (wrapper.endpoint (), wrapper.channel);
+		snapshot_l->node_ids.emplace (wrapper.channel->get_node_id (), wrapper.channel);
+	}
+	std::atomic_store (&current_snapshot, std::shared_ptr<channels_snapshot const> (std::move (snapshot_l)));
+}
+
 void scendere::transport::tcp_channels::start_tcp (scendere::endpoint const & endpoint_a)
 {
 	if (node.flags.disable_tcp_realtime)
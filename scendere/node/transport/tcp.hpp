@@ -10,6 +10,7 @@
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -110,7 +111,24 @@ namespace transport
 		void udp_fallback (scendere::endpoint const &);
 		scendere::node & node;
 
+		/**
+		 * Immutable copy of the channel set with hash indices for lookups. Writers keep the multi_index container as the
+		 * source of truth and publish a new snapshot whenever the set of channels changes, so the hot read paths
+		 * (flooding, rep crawler, confirmation solicitor, telemetry) never take the channels mutex.
+		 * Per-channel state such as the version or last packet times is read live from the shared channels.
+		 */
+		class channels_snapshot final
+		{
+		public:
+			std::vector<std::shared_ptr<scendere::transport::channel_tcp>> channels;
+			std::unordered_map<scendere::tcp_endpoint, std::shared_ptr<scendere::transport::channel_tcp>> endpoints;
+			std::unordered_map<scendere::account, std::shared_ptr<scendere::transport::channel_tcp>> node_ids;
+		};
+		std::shared_ptr<channels_snapshot const> snapshot () const;
+
 	private:
+		/** Rebuilds the snapshot from the channels container, must be called with the mutex held after changing the set of channels */
+		void publish_snapshot ();
 		std::function<void (scendere::message const &, std::shared_ptr<scendere::transport::channel> const &)> sink;
 		class endpoint_tag
 		{
@@ -228,6 +246,8 @@ namespace transport
 				mi::member<tcp_endpoint_attempt, std::chrono::steady_clock::time_point, &tcp_endpoint_attempt::last_attempt>>>>
 		attempts;
 		// clang-format on
+		/** Only accessed through std::atomic_load / std::atomic_store */
+		std::shared_ptr<channels_snapshot const> current_snapshot{ std::make_shared<channels_snapshot> () };
 		std::atomic<bool> stopped{ false };
 
 		friend class network_peer_max_tcp_attempts_subnetwork_Test;
@@ -7,6 +7,7 @@
 #include <boost/asio/ip/address_v6.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace
@@ -21,30 +22,38 @@ public:
 	void publish (scendere::publish const & message_a) override
 	{
 		result = scendere::stat::detail::publish;
+		limit_type = scendere::bandwidth_limit_type::publish;
 	}
 	void confirm_req (scendere::confirm_req const & message_a) override
 	{
 		result = scendere::stat::detail::confirm_req;
+		limit_type = scendere::bandwidth_limit_type::confirm_req;
 	}
 	void confirm_ack (scendere::confirm_ack const & message_a) override
 	{
 		result = scendere::stat::detail::confirm_ack;
+		auto is_final (message_a.vote != nullptr && message_a.vote->timestamp () == scendere::vote::timestamp_max);
+		limit_type = is_final ? scendere::bandwidth_limit_type::final_vote : scendere::bandwidth_limit_type::vote;
 	}
 	void bulk_pull (scendere::bulk_pull const & message_a) override
 	{
 		result = scendere::stat::detail::bulk_pull;
+		limit_type = scendere::bandwidth_limit_type::bootstrap;
 	}
 	void bulk_pull_account (scendere::bulk_pull_account const & message_a) override
 	{
 		result = scendere::stat::detail::bulk_pull_account;
+		limit_type = scendere::bandwidth_limit_type::bootstrap;
 	}
 	void bulk_push (scendere::bulk_push const & message_a) override
 	{
 		result = scendere::stat::detail::bulk_push;
+		limit_type = scendere::bandwidth_limit_type::bootstrap;
 	}
 	void frontier_req (scendere::frontier_req const & message_a) override
 	{
 		result = scendere::stat::detail::frontier_req;
+		limit_type = scendere::bandwidth_limit_type::bootstrap;
 	}
 	void node_id_handshake (scendere::node_id_handshake const & message_a) override
 	{
@@ -59,6 +68,8 @@ public:
 		result = scendere::stat::detail::telemetry_ack;
 	}
 	scendere::stat::detail result;
+	/** Keepalives, handshakes and telemetry share the lowest priority class */
+	scendere::bandwidth_limit_type limit_type{ scendere::bandwidth_limit_type::keepalive };
 };
 }
 
@@ -97,21 +108,53 @@ boost::asio::ip::address scendere::transport::ipv4_address_or_ipv6_subnet (boost
 	return address_a.to_v6 ().is_v4_mapped () ? address_a : boost::asio::ip::make_network_v6 (address_a.to_v6 (), ipv6_address_prefix_length).network ();
 }
 
+void scendere::transport::recent_hash_filter::insert (scendere::block_hash const & hash_a)
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	if (inserted >= generation_capacity)
+	{
+		current = 1 - current;
+		generations[current].reset ();
+		inserted = 0;
+	}
+	auto & generation_l (generations[current]);
+	// Block and vote hashes are uniformly distributed, so their words are used directly as the filter hash functions
+	for (auto const & word : hash_a.qwords)
+	{
+		generation_l.set (word % generation_bits);
+	}
+	++inserted;
+}
+
+bool scendere::transport::recent_hash_filter::contains (scendere::block_hash const & hash_a) const
+{
+	scendere::lock_guard<scendere::mutex> lock (mutex);
+	return contains (generations[0], hash_a) || contains (generations[1], hash_a);
+}
+
+bool scendere::transport::recent_hash_filter::contains (generation const & generation_a, scendere::block_hash const & hash_a)
+{
+	return std::all_of (hash_a.qwords.begin (), hash_a.qwords.end (), [&generation_a] (uint64_t word_a) {
+		return generation_a.test (word_a % generation_bits);
+	});
+}
+
 scendere::transport::channel::channel (scendere::node & node_a) :
 	node (node_a)
 {
 	set_network_version (node_a.network_params.network.protocol_version);
 }
 
-void scendere::transport::channel::send (scendere::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, scendere::buffer_drop_policy drop_policy_a)
+bool scendere::transport::channel::send (scendere::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, scendere::buffer_drop_policy drop_policy_a)
 {
 	callback_visitor visitor;
 	message_a.visit (visitor);
 	auto buffer (message_a.to_shared_const_buffer ());
 	auto detail (visitor.result);
 	auto is_droppable_by_limiter = drop_policy_a == scendere::buffer_drop_policy::limiter;
-	auto should_drop (node.network.limiter.should_drop (buffer.size ()));
-	if (!is_droppable_by_limiter || !should_drop)
+	auto should_drop (node.network.limiter.should_drop (buffer.size (), visitor.limit_type));
+	auto dropped (is_droppable_by_limiter && should_drop);
+	if (!dropped)
 	{
 		send_buffer (buffer, callback_a, drop_policy_a);
 		node.stats.inc (scendere::stat::type::message, detail, scendere::stat::dir::out);
@@ -126,11 +169,13 @@ void scendere::transport::channel::send (scendere::message & message_a, std::fun
 		}
 
 		node.stats.inc (scendere::stat::type::drop, detail, scendere::stat::dir::out);
+		node.stats.inc (scendere::stat::type::bandwidth_limiter, scendere::to_stat_detail (visitor.limit_type), scendere::stat::dir::out);
 		if (node.config.logging.network_packet_logging ())
 		{
 			node.logger.always_log (boost::str (boost::format ("%1% of size %2% dropped") % node.stats.detail_to_string (detail) % buffer.size ()));
 		}
 	}
+	return dropped;
 }
 
 scendere::transport::channel_loopback::channel_loopback (scendere::node & node_a) :
@@ -277,17 +322,134 @@ bool scendere::transport::reserved_address (scendere::endpoint const & endpoint_
 
 using namespace std::chrono_literals;
 
+scendere::stat::detail scendere::to_stat_detail (scendere::bandwidth_limit_type type_a)
+{
+	scendere::stat::detail result{ scendere::stat::detail::all };
+	switch (type_a)
+	{
+		case scendere::bandwidth_limit_type::final_vote:
+			result = scendere::stat::detail::final_vote;
+			break;
+		case scendere::bandwidth_limit_type::vote:
+			result = scendere::stat::detail::confirm_ack;
+			break;
+		case scendere::bandwidth_limit_type::confirm_req:
+			result = scendere::stat::detail::confirm_req;
+			break;
+		case scendere::bandwidth_limit_type::publish:
+			result = scendere::stat::detail::publish;
+			break;
+		case scendere::bandwidth_limit_type::keepalive:
+			result = scendere::stat::detail::keepalive;
+			break;
+		case scendere::bandwidth_limit_type::bootstrap:
+			result = scendere::stat::detail::bootstrap_serving;
+			break;
+		case scendere::bandwidth_limit_type::_last:
+			debug_assert (false);
+			break;
+	}
+	return result;
+}
+
 scendere::bandwidth_limiter::bandwidth_limiter (double const limit_burst_ratio_a, std::size_t const limit_a) :
 	bucket (static_cast<std::size_t> (limit_a * limit_burst_ratio_a), limit_a)
 {
+	for (std::size_t i (0); i < type_count; ++i)
+	{
+		auto type (static_cast<scendere::bandwidth_limit_type> (i));
+		class_buckets[i] = std::make_unique<scendere::rate::token_bucket> (share (std::min (limit_burst_ratio_a, 1.0), limit_a, type), share (1.0, limit_a, type));
+	}
+}
+
+bool scendere::bandwidth_limiter::should_drop (std::size_t const & message_size_a, scendere::bandwidth_limit_type type_a)
+{
+	auto size_l (scendere::narrow_cast<unsigned int> (message_size_a));
+	auto & class_bucket (*class_buckets[static_cast<std::size_t> (type_a)]);
+	bool result (false);
+	if (class_bucket.try_consume (size_l))
+	{
+		// Within the guaranteed share of this class, borrowers usually leave room for it in the shared bucket.
+		// The shared bucket is the hard cap, if it refuses the share is not spent on a dropped message
+		result = !bucket.try_consume (size_l);
+		if (result)
+		{
+			class_bucket.refund (size_l);
+		}
+	}
+	else
+	{
+		// Above its share, a class may only borrow what is left after the unused shares of the other classes
+		std::size_t reserve (0);
+		for (std::size_t i (0); i < type_count; ++i)
+		{
+			if (i != static_cast<std::size_t> (type_a))
+			{
+				reserve += class_buckets[i]->available ();
+			}
+		}
+		result = !bucket.try_consume_leaving (size_l, reserve);
+	}
+	return result;
 }
 
-bool scendere::bandwidth_limiter::should_drop (std::size_t const & message_size_a)
+std::size_t scendere::bandwidth_limiter::burst (scendere::bandwidth_limit_type type_a) const
 {
-	return !bucket.try_consume (scendere::narrow_cast<unsigned int> (message_size_a));
+	return class_buckets[static_cast<std::size_t> (type_a)]->capacity ();
 }
 
 void scendere::bandwidth_limiter::reset (double const limit_burst_ratio_a, std::size_t const limit_a)
 {
 	bucket.reset (static_cast<std::size_t> (limit_a * limit_burst_ratio_a), limit_a);
+	for (std::size_t i (0); i < type_count; ++i)
+	{
+		auto type (static_cast<scendere::bandwidth_limit_type> (i));
+		class_buckets[i]->reset (share (std::min (limit_burst_ratio_a, 1.0), limit_a, type), share (1.0, limit_a, type));
+	}
+}
+
+std::size_t scendere::bandwidth_limiter::weight (scendere::bandwidth_limit_type type_a)
+{
+	std::size_t result{ 0 };
+	switch (type_a)
+	{
+		case scendere::bandwidth_limit_type::final_vote:
+			result = 4;
+			break;
+		case scendere::bandwidth_limit_type::vote:
+			result = 4;
+			break;
+		case scendere::bandwidth_limit_type::confirm_req:
+			result = 2;
+			break;
+		case scendere::bandwidth_limit_type::publish:
+			result = 3;
+			break;
+		case scendere::bandwidth_limit_type::keepalive:
+			result = 1;
+			break;
+		case scendere::bandwidth_limit_type::bootstrap:
+			result = 2;
+			break;
+		case scendere::bandwidth_limit_type::_last:
+			debug_assert (false);
+			break;
+	}
+	return result;
+}
+
+std::size_t scendere::bandwidth_limiter::share (double const ratio_a, std::size_t const limit_a, scendere::bandwidth_limit_type type_a)
+{
+	std::size_t total_weight{ 0 };
+	for (std::size_t i (0); i < type_count; ++i)
+	{
+		total_weight += weight (static_cast<scendere::bandwidth_limit_type> (i));
+	}
+	std::size_t result{ 0 };
+	if (limit_a != 0)
+	{
+		// A limited class must never round down to 0, which the token bucket treats as unlimited
+		result = std::max<std::size_t> (1, static_cast<std::size_t> (limit_a * ratio_a * weight (type_a) / total_weight));
+	}
+	return result;
 }
@@ -8,18 +8,53 @@
 
 #include <boost/asio/ip/network_v6.hpp>
 
+#include <array>
+#include <bitset>
+
 namespace scendere
 {
+/** Outbound traffic classes, in descending priority */
+enum class bandwidth_limit_type : uint8_t
+{
+	final_vote,
+	vote,
+	confirm_req,
+	publish,
+	/** Keepalives, telemetry and handshakes */
+	keepalive,
+	/** Serving bootstrap requests from other nodes */
+	bootstrap,
+	_last // Must be the last enum
+};
+
+scendere::stat::detail to_stat_detail (scendere::bandwidth_limit_type);
+
+/**
+ * Shapes outbound traffic with a token bucket per traffic class, on top of a shared bucket holding the total limit.
+ * The shared bucket is the hard cap, every admitted message is charged against it. Each class is guaranteed a weighted
+ * share of the limit, its bucket holds one second of that share. Traffic above its share may borrow from the shared bucket
+ * as long as the unused shares of the other classes stay in it, so idle capacity is used but lower priority classes cannot
+ * starve the share of higher priority ones.
+ */
 class bandwidth_limiter final
 {
 public:
 	// initialize with limit 0 = unbounded
 	bandwidth_limiter (double, std::size_t);
-	bool should_drop (std::size_t const &);
+	bool should_drop (std::size_t const &, scendere::bandwidth_limit_type = scendere::bandwidth_limit_type::publish);
 	void reset (double, std::size_t);
+	/** Largest message of \p type_a which is always admitted eventually, larger ones must be charged in parts */
+	std::size_t burst (scendere::bandwidth_limit_type type_a) const;
+
+	/** Relative share of the total limit guaranteed to \p type_a */
+	static std::size_t weight (scendere::bandwidth_limit_type type_a);
 
 private:
+	static std::size_t constexpr type_count = static_cast<std::size_t> (scendere::bandwidth_limit_type::_last);
+	static std::size_t share (double, std::size_t, scendere::bandwidth_limit_type);
+
 	scendere::rate::token_bucket bucket;
+	std::array<std::unique_ptr<scendere::rate::token_bucket>, type_count> class_buckets;
 };
 
 namespace transport
@@ -43,6 +78,32 @@ namespace transport
 		tcp = 2,
 		loopback = 3
 	};
+	/**
+	 * Remembers hashes recently exchanged with a single peer, using two alternating Bloom filter generations.
+	 * When the current generation is full the older one is discarded, so entries age out after two generations.
+	 * A false positive means a peer is skipped when flooding although it did not have the item, which the
+	 * filter sizing keeps around 0.02% per generation.
+	 * @note This class is thread-safe.
+	 */
+	class recent_hash_filter final
+	{
+	public:
+		void insert (scendere::block_hash const &);
+		bool contains (scendere::block_hash const &) const;
+
+		static std::size_t constexpr generation_bits = 32 * 1024;
+		static std::size_t constexpr generation_capacity = 1024;
+
+	private:
+		using generation = std::bitset<generation_bits>;
+		static bool contains (generation const &, scendere::block_hash const &);
+
+		std::array<generation, 2> generations;
+		std::size_t current{ 0 };
+		std::size_t inserted{ 0 };
+		mutable scendere::mutex mutex;
+	};
+
 	class channel
 	{
 	public:
@@ -50,7 +111,8 @@ namespace transport
 		virtual ~channel () = default;
 		virtual std::size_t hash_code () const = 0;
 		virtual bool operator== (scendere::transport::channel const &) const = 0;
-		void send (scendere::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr, scendere::buffer_drop_policy policy_a = scendere::buffer_drop_policy::limiter);
+		/** Returns true if the message was dropped by the bandwidth limiter */
+		bool send (scendere::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr, scendere::buffer_drop_policy policy_a = scendere::buffer_drop_policy::limiter);
 		// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 		//
 		virtual void send_buffer (scendere::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, scendere::buffer_drop_policy = scendere::buffer_drop_policy::limiter) = 0;
@@ -130,9 +192,22 @@ namespace transport
 			network_version = network_version_a;
 		}
 
+		/** Records that the peer has \p hash_a, because it was received from or sent to it */
+		void set_known (scendere::block_hash const & hash_a)
+		{
+			known_hashes.insert (hash_a);
+		}
+
+		/** Whether the peer recently sent or received \p hash_a. Rare false positives are possible */
+		bool is_known (scendere::block_hash const & hash_a) const
+		{
+			return known_hashes.contains (hash_a);
+		}
+
 		mutable scendere::mutex channel_mutex;
 
 	private:
+		scendere::transport::recent_hash_filter known_hashes;
 		std::chrono::steady_clock::time_point last_bootstrap_attempt{ std::chrono::steady_clock::time_point () };
 		std::chrono::steady_clock::time_point last_packet_received{ std::chrono::steady_clock::now () };
 		std::chrono::steady_clock::time_point last_packet_sent{ std::chrono::steady_clock::now () };
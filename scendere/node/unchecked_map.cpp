@@ -122,12 +122,13 @@ void scendere::unchecked_map::item_visitor::operator() (query const & item)
 
 void scendere::unchecked_map::write_buffer (decltype (buffer) const & back_buffer)
 {
-	auto transaction = store.tx_begin_write ();
-	item_visitor visitor{ *this, transaction };
-	for (auto const & item : back_buffer)
-	{
-		boost::apply_visitor (visitor, item);
-	}
+	write ([this, &back_buffer] (scendere::write_transaction const & transaction) {
+		item_visitor visitor{ *this, transaction };
+		for (auto const & item : back_buffer)
+		{
+			boost::apply_visitor (visitor, item);
+		}
+	});
 }
 
 void scendere::unchecked_map::run ()
@@ -37,6 +37,8 @@ public:
 public: // Trigger requested dependencies
 	void trigger (scendere::hash_or_account const & dependency);
 	std::function<void (scendere::unchecked_info const &)> satisfied{ [] (scendere::unchecked_info const &) {} };
+	/** Runs the buffered writes, the node shares the commit with other writers through its write_coordinator */
+	std::function<void (std::function<void (scendere::write_transaction const &)> const &)> write{ [this] (std::function<void (scendere::write_transaction const &)> const & action_a) { action_a (store.tx_begin_write ()); } };
 
 private:
 	using insert = std::pair<scendere::hash_or_account, scendere::unchecked_info>;
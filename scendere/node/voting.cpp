@@ -6,6 +6,7 @@
 #include <scendere/node/vote_processor.hpp>
 #include <scendere/node/voting.hpp>
 #include <scendere/node/wallet.hpp>
+#include <scendere/node/write_coordinator.hpp>
 #include <scendere/secure/ledger.hpp>
 #include <scendere/secure/store.hpp>
 
@@ -161,7 +162,7 @@ std::unique_ptr<scendere::container_info_component> scendere::collect_container_
 	return composite;
 }
 
-scendere::vote_generator::vote_generator (scendere::node_config const & config_a, scendere::ledger & ledger_a, scendere::wallets & wallets_a, scendere::vote_processor & vote_processor_a, scendere::local_vote_history & history_a, scendere::network & network_a, scendere::stat & stats_a, bool is_final_a) :
+scendere::vote_generator::vote_generator (scendere::node_config const & config_a, scendere::ledger & ledger_a, scendere::wallets & wallets_a, scendere::vote_processor & vote_processor_a, scendere::local_vote_history & history_a, scendere::network & network_a, scendere::stat & stats_a, scendere::write_coordinator & write_coordinator_a, bool is_final_a) :
 	config (config_a),
 	ledger (ledger_a),
 	wallets (wallets_a),
@@ -170,6 +171,7 @@ scendere::vote_generator::vote_generator (scendere::node_config const & config_a
 	spacing{ config_a.network_params.voting.delay },
 	network (network_a),
 	stats (stats_a),
+	write_coordinator (write_coordinator_a),
 	thread ([this] () { run (); }),
 	is_final (is_final_a)
 {
@@ -192,10 +194,13 @@ void scendere::vote_generator::add (scendere::root const & root_a, scendere::blo
 		auto should_vote (false);
 		if (is_final)
 		{
-			auto transaction (ledger.store.tx_begin_write ({ tables::final_votes }));
-			auto block (ledger.store.block.get (transaction, hash_a));
-			should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block) && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
-			debug_assert (block == nullptr || root_a == block->root ());
+			// Final votes are committed together with other small writes, the vote is only generated once the final vote entry is durable
+			auto written (write_coordinator.submit (scendere::writer::final_votes, { tables::final_votes }, [this, &should_vote, &root_a, &hash_a] (scendere::write_transaction const & transaction_a) {
+				auto block (ledger.store.block.get (transaction_a, hash_a));
+				should_vote = block != nullptr && ledger.dependents_confirmed (transaction_a, *block) && ledger.store.final_vote.put (transaction_a, block->qualified_root (), hash_a);
+				debug_assert (block == nullptr || root_a == block->root ());
+			}));
+			written.wait ();
 		}
 		else
 		{
@@ -234,7 +239,7 @@ std::size_t scendere::vote_generator::generate (std::vector<std::shared_ptr<scen
 {
 	request_t::first_type req_candidates;
 	{
-		auto transaction (ledger.store.tx_begin_read ());
+		auto transaction (ledger.store.tx_begin_read_cached ());
 		auto dependents_confirmed = [&transaction, this] (auto const & block_a) {
 			return this->ledger.dependents_confirmed (transaction, *block_a);
 		};
@@ -27,6 +27,7 @@ class node_config;
 class stat;
 class vote_processor;
 class wallets;
+class write_coordinator;
 namespace transport
 {
 	class channel;
@@ -120,7 +121,7 @@ private:
 	using request_t = std::pair<std::vector<candidate_t>, std::shared_ptr<scendere::transport::channel>>;
 
 public:
-	vote_generator (scendere::node_config const & config_a, scendere::ledger & ledger_a, scendere::wallets & wallets_a, scendere::vote_processor & vote_processor_a, scendere::local_vote_history & history_a, scendere::network & network_a, scendere::stat & stats_a, bool is_final_a);
+	vote_generator (scendere::node_config const & config_a, scendere::ledger & ledger_a, scendere::wallets & wallets_a, scendere::vote_processor & vote_processor_a, scendere::local_vote_history & history_a, scendere::network & network_a, scendere::stat & stats_a, scendere::write_coordinator & write_coordinator_a, bool is_final_a);
 	/** Queue items for vote generation, or broadcast votes already in cache */
 	void add (scendere::root const &, scendere::block_hash const &);
 	/** Queue blocks for vote generation, returning the number of successful candidates.*/
@@ -143,6 +144,7 @@ private:
 	scendere::vote_spacing spacing;
 	scendere::network & network;
 	scendere::stat & stats;
+	scendere::write_coordinator & write_coordinator;
 	mutable scendere::mutex mutex;
 	scendere::condition_variable condition;
 	static std::size_t constexpr max_requests{ 2048 };
@@ -1177,32 +1177,28 @@ bool scendere::wallet::search_receivable (scendere::transaction const & wallet_t
 			// Don't search pending for watch-only accounts
 			if (!scendere::wallet_value (i->second).key.is_zero ())
 			{
-				for (auto j (wallets.node.store.pending.begin (block_transaction, scendere::pending_key (account, 0))), k (wallets.node.store.pending.end ()); j != k && scendere::pending_key (j->first).account == account; ++j)
-				{
-					scendere::pending_key key (j->first);
+				// Amounts below receive_minimum are skipped without being read when the receivable amount index is enabled
+				wallets.node.ledger.receivable_for_each (block_transaction, account, wallets.node.config.receive_minimum.number (), [&] (scendere::pending_key const & key, scendere::pending_info const & pending) {
 					auto hash (key.hash);
-					scendere::pending_info pending (j->second);
 					auto amount (pending.amount.number ());
-					if (wallets.node.config.receive_minimum.number () <= amount)
+					wallets.node.logger.try_log (boost::str (boost::format ("Found a receivable block %1% for account %2%") % hash.to_string () % pending.source.to_account ()));
+					if (wallets.node.ledger.block_confirmed (block_transaction, hash))
 					{
-						wallets.node.logger.try_log (boost::str (boost::format ("Found a receivable block %1% for account %2%") % hash.to_string () % pending.source.to_account ()));
-						if (wallets.node.ledger.block_confirmed (block_transaction, hash))
-						{
-							auto representative = store.representative (wallet_transaction_a);
-							// Receive confirmed block
-							receive_async (hash, representative, amount, account, [] (std::shared_ptr<scendere::block> const &) {});
-						}
-						else if (!wallets.node.confirmation_height_processor.is_processing_block (hash))
+						auto representative = store.representative (wallet_transaction_a);
+						// Receive confirmed block
+						receive_async (hash, representative, amount, account, [] (std::shared_ptr<scendere::block> const &) {});
+					}
+					else if (!wallets.node.confirmation_height_processor.is_processing_block (hash))
+					{
+						auto block (wallets.node.store.block.get (block_transaction, hash));
+						if (block)
 						{
-							auto block (wallets.node.store.block.get (block_transaction, hash));
-							if (block)
-							{
-								// Request confirmation for block which is not being processed yet
-								wallets.node.block_confirm (block);
-							}
+							// Request confirmation for block which is not being processed yet
+							wallets.node.block_confirm (block);
 						}
 					}
-				}
+					return true;
+				});
 			}
 		}
 		wallets.node.logger.try_log ("Receivable block search phase completed");
@@ -0,0 +1,177 @@
+#include <scendere/lib/stats.hpp>
+#include <scendere/lib/threading.hpp>
+#include <scendere/lib/utility.hpp>
+#include <scendere/node/write_coordinator.hpp>
+
+#include <limits>
+#include <set>
+
+scendere::write_coordinator::write_coordinator (scendere::store & store_a, scendere::stat & stats_a, std::size_t batch_max_a, std::chrono::milliseconds batch_max_time_a) :
+	store (store_a),
+	stats (stats_a),
+	batch_max (batch_max_a),
+	batch_max_time (batch_max_time_a),
+	thread ([this] () {
+		scendere::thread_role::set (scendere::thread_role::name::write_coordinator);
+		run ();
+	})
+{
+	stats.define_histogram (scendere::stat::type::write_coordinator, scendere::stat::detail::batch_size, scendere::stat::dir::in, { 1, 2, 4, 8, 16, 64, 256, 1024, std::numeric_limits<uint64_t>::max () });
+	stats.define_histogram (scendere::stat::type::write_coordinator, scendere::stat::detail::commit_latency, scendere::stat::dir::in, { 0, 1, 2, 5, 10, 20, 50, 100, 500, std::numeric_limits<uint64_t>::max () });
+}
+
+scendere::write_coordinator::~write_coordinator ()
+{
+	stop ();
+}
+
+std::future<void> scendere::write_coordinator::submit (scendere::writer writer_a, std::vector<scendere::tables> const & tables_a, action const & action_a)
+{
+	return submit (
+	writer_a, tables_a, [action_a] (scendere::write_transaction const & transaction_a, std::chrono::steady_clock::time_point) {
+		action_a (transaction_a);
+	},
+	std::chrono::milliseconds (0));
+}
+
+std::future<void> scendere::write_coordinator::submit (scendere::writer writer_a, std::vector<scendere::tables> const & tables_a, batch_action const & action_a, std::chrono::milliseconds budget_a)
+{
+	entry entry_l{ writer_a, tables_a, action_a, budget_a, {} };
+	auto result (entry_l.promise.get_future ());
+	scendere::unique_lock<scendere::mutex> lock (mutex);
+	if (!stopped)
+	{
+		queues[writer_a].push_back (std::move (entry_l));
+		++queued;
+		lock.unlock ();
+		condition.notify_all ();
+	}
+	else
+	{
+		lock.unlock ();
+		// Writes arriving during shutdown are not batched
+		{
+			auto transaction (store.tx_begin_write (tables_a));
+			action_a (transaction, std::chrono::steady_clock::now () + budget_a);
+		}
+		entry_l.promise.set_value ();
+	}
+	return result;
+}
+
+void scendere::write_coordinator::flush ()
+{
+	scendere::unique_lock<scendere::mutex> lock (mutex);
+	condition.wait (lock, [this] () {
+		return stopped || (queued == 0 && !writing);
+	});
+}
+
+void scendere::write_coordinator::stop ()
+{
+	{
+		scendere::lock_guard<scendere::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+std::size_t scendere::write_coordinator::size ()
+{
+	scendere::lock_guard<scendere::mutex> guard (mutex);
+	return queued;
+}
+
+void scendere::write_coordinator::run ()
+{
+	scendere::unique_lock<scendere::mutex> lock (mutex);
+	// Queued writes are still committed after stopping so no submitter is left waiting
+	while (!stopped || queued > 0)
+	{
+		if (queued > 0)
+		{
+			auto round (next_round ());
+			writing = true;
+			lock.unlock ();
+			auto deferred (commit (round));
+			lock.lock ();
+			writing = false;
+			// Writes which missed the deadline go back to the front of their queues to keep their order
+			for (auto i (deferred.rbegin ()), n (deferred.rend ()); i != n; ++i)
+			{
+				queues[i->writer].push_front (std::move (*i));
+				++queued;
+			}
+			condition.notify_all (); // Notify flush ()
+		}
+		else
+		{
+			condition.notify_all ();
+			condition.wait (lock, [this] () {
+				return stopped || queued > 0;
+			});
+		}
+	}
+}
+
+auto scendere::write_coordinator::next_round () -> std::deque<entry>
+{
+	debug_assert (!mutex.try_lock ());
+	std::deque<entry> result;
+	while (queued > 0 && result.size () < batch_max)
+	{
+		for (auto & [writer, queue] : queues)
+		{
+			if (!queue.empty () && result.size () < batch_max)
+			{
+				result.push_back (std::move (queue.front ()));
+				queue.pop_front ();
+				--queued;
+			}
+		}
+	}
+	return result;
+}
+
+auto scendere::write_coordinator::commit (std::deque<entry> & round_a) -> std::deque<entry>
+{
+	std::set<scendere::tables> tables_l;
+	for (auto const & entry_l : round_a)
+	{
+		tables_l.insert (entry_l.tables.begin (), entry_l.tables.end ());
+	}
+	std::deque<entry> committed;
+	auto start (std::chrono::steady_clock::now ());
+	{
+		auto transaction (store.tx_begin_write (std::vector<scendere::tables> (tables_l.begin (), tables_l.end ())));
+		// At least one write is run per round so a slow write cannot stall its writer
+		while (!round_a.empty () && (committed.empty () || std::chrono::steady_clock::now () - start < batch_max_time))
+		{
+			auto & front (round_a.front ());
+			front.action_m (transaction, std::chrono::steady_clock::now () + front.budget);
+			committed.push_back (std::move (round_a.front ()));
+			round_a.pop_front ();
+		}
+	}
+	auto latency (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start));
+	for (auto & entry_l : committed)
+	{
+		entry_l.promise.set_value ();
+	}
+	stats.inc (scendere::stat::type::write_coordinator, scendere::stat::detail::commit);
+	stats.add (scendere::stat::type::write_coordinator, scendere::stat::detail::operations, scendere::stat::dir::in, committed.size ());
+	stats.update_histogram (scendere::stat::type::write_coordinator, scendere::stat::detail::batch_size, scendere::stat::dir::in, committed.size ());
+	stats.update_histogram (scendere::stat::type::write_coordinator, scendere::stat::detail::commit_latency, scendere::stat::dir::in, latency.count ());
+	return std::move (round_a);
+}
+
+std::unique_ptr<scendere::container_info_component> scendere::collect_container_info (write_coordinator & write_coordinator, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queued", write_coordinator.size (), sizeof (write_coordinator::entry) }));
+	return composite;
+}
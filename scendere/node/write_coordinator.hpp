@@ -0,0 +1,75 @@
+#pragma once
+
+#include <scendere/lib/locks.hpp>
+#include <scendere/node/write_database_queue.hpp>
+#include <scendere/secure/store.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace scendere
+{
+class container_info_component;
+class stat;
+
+/**
+ * Group commit for ledger writers. Writes are queued per writer and run in a shared write transaction which is committed once for the
+ * whole round. Rounds take one write from each writer in turn so a busy writer cannot hold back the others, and end at batch_max writes
+ * or after batch_max_time, the rest are carried into the next round which starts as soon as the previous one commits.
+ * Writers with large batches, such as cementing, submit batch actions which stop by themselves at a deadline set by the writer's own budget.
+ */
+class write_coordinator final
+{
+public:
+	using action = std::function<void (scendere::write_transaction const &)>;
+	/** Writes as much as it can before the deadline it is given, the writer submits the remainder again */
+	using batch_action = std::function<void (scendere::write_transaction const &, std::chrono::steady_clock::time_point)>;
+
+	write_coordinator (scendere::store &, scendere::stat &, std::size_t batch_max = 1024, std::chrono::milliseconds batch_max_time = std::chrono::milliseconds (100));
+	~write_coordinator ();
+	/** Queues action_a for the next round, the returned future is ready once its transaction has been committed */
+	std::future<void> submit (scendere::writer, std::vector<scendere::tables> const &, action const & action_a);
+	/** Queues a batch for the next round, it is given budget_a from the start of its turn to run */
+	std::future<void> submit (scendere::writer, std::vector<scendere::tables> const &, batch_action const & action_a, std::chrono::milliseconds budget_a);
+	/** Blocks until every write submitted so far has been committed */
+	void flush ();
+	void stop ();
+	std::size_t size ();
+
+private:
+	class entry final
+	{
+	public:
+		scendere::writer writer;
+		std::vector<scendere::tables> tables;
+		batch_action action_m;
+		std::chrono::milliseconds budget;
+		std::promise<void> promise;
+	};
+	void run ();
+	std::deque<entry> next_round ();
+	/** Runs entries until the round deadline and commits them, returns the entries which did not fit */
+	std::deque<entry> commit (std::deque<entry> &);
+	scendere::store & store;
+	scendere::stat & stats;
+	std::size_t const batch_max;
+	std::chrono::milliseconds const batch_max_time;
+	std::map<scendere::writer, std::deque<entry>> queues;
+	std::size_t queued{ 0 };
+	bool writing{ false };
+	bool stopped{ false };
+	scendere::condition_variable condition;
+	scendere::mutex mutex;
+	std::thread thread;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (write_coordinator &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (write_coordinator &, std::string const &);
+}
@@ -15,6 +15,9 @@ enum class writer
 	confirmation_height,
 	process_batch,
 	pruning,
+	// Writers batched by the write_coordinator
+	unchecked,
+	final_votes,
 	testing // Used in tests to emulate a write lock
 };
 
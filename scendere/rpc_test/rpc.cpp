@@ -1,5 +1,6 @@
 #include <scendere/boost/beast/core/flat_buffer.hpp>
 #include <scendere/boost/beast/http.hpp>
+#include <scendere/lib/asio.hpp>
 #include <scendere/lib/rpcconfig.hpp>
 #include <scendere/lib/threading.hpp>
 #include <scendere/node/ipc/ipc_server.hpp>
@@ -967,31 +968,55 @@ TEST (rpc, chain_limit)
 	ASSERT_EQ (block->hash (), blocks[0]);
 }
 
+// Offsets are walked without the account height index and looked up by height with it, both give the same results
 TEST (rpc, chain_offset)
 {
-	scendere::system system;
-	auto node = add_ipc_enabled_node (system);
-	system.wallet (0)->insert_adhoc (scendere::dev::genesis_key.prv);
-	scendere::keypair key;
-	auto genesis (node->latest (scendere::dev::genesis_key.pub));
-	ASSERT_FALSE (genesis.is_zero ());
-	auto block (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, key.pub, 1));
-	ASSERT_NE (nullptr, block);
-	auto const rpc_ctx = add_rpc (system, node);
-	boost::property_tree::ptree request;
-	request.put ("action", "chain");
-	request.put ("block", block->hash ().to_string ());
-	request.put ("count", std::to_string (std::numeric_limits<uint64_t>::max ()));
-	request.put ("offset", 1);
-	auto response (wait_response (system, rpc_ctx, request));
-	auto & blocks_node (response.get_child ("blocks"));
-	std::vector<scendere::block_hash> blocks;
-	for (auto i (blocks_node.begin ()), n (blocks_node.end ()); i != n; ++i)
+	for (auto index : { false, true })
 	{
-		blocks.push_back (scendere::block_hash (i->second.get<std::string> ("")));
+		scendere::system system;
+		scendere::node_config node_config (scendere::get_available_port (), system.logging);
+		node_config.enable_account_height_index = index;
+		auto node = add_ipc_enabled_node (system, node_config);
+		ASSERT_EQ (index, node->ledger.account_heights);
+		system.wallet (0)->insert_adhoc (scendere::dev::genesis_key.prv);
+		scendere::keypair key;
+		auto genesis (node->latest (scendere::dev::genesis_key.pub));
+		ASSERT_FALSE (genesis.is_zero ());
+		auto block1 (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, key.pub, 1));
+		ASSERT_NE (nullptr, block1);
+		auto block2 (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, key.pub, 1));
+		ASSERT_NE (nullptr, block2);
+		auto const rpc_ctx = add_rpc (system, node);
+		auto chain = [&system, &rpc_ctx] (std::string const & action_a, scendere::block_hash const & hash_a, uint64_t offset_a, bool reverse_a = false) {
+			boost::property_tree::ptree request;
+			request.put ("action", action_a);
+			request.put ("block", hash_a.to_string ());
+			request.put ("count", std::to_string (std::numeric_limits<uint64_t>::max ()));
+			request.put ("offset", offset_a);
+			if (reverse_a)
+			{
+				request.put ("reverse", true);
+			}
+			auto response (wait_response (system, rpc_ctx, request));
+			std::vector<scendere::block_hash> blocks;
+			for (auto & i : response.get_child ("blocks"))
+			{
+				blocks.push_back (scendere::block_hash (i.second.get<std::string> ("")));
+			}
+			return blocks;
+		};
+		ASSERT_EQ ((std::vector<scendere::block_hash>{ block1->hash (), genesis }), chain ("chain", block2->hash (), 1));
+		ASSERT_EQ ((std::vector<scendere::block_hash>{ genesis }), chain ("chain", block2->hash (), 2));
+		ASSERT_EQ ((std::vector<scendere::block_hash>{ block1->hash (), block2->hash () }), chain ("successors", genesis, 1));
+		ASSERT_EQ ((std::vector<scendere::block_hash>{ block2->hash () }), chain ("chain", genesis, 2, true));
+		ASSERT_EQ ((std::vector<scendere::block_hash>{ block1->hash (), genesis }), chain ("successors", block2->hash (), 1, true));
+		// Past the open block
+		ASSERT_TRUE (chain ("chain", block2->hash (), 3).empty ());
+		ASSERT_TRUE (chain ("chain", block2->hash (), std::numeric_limits<uint64_t>::max ()).empty ());
+		// Past the head
+		ASSERT_TRUE (chain ("successors", genesis, 3).empty ());
+		ASSERT_TRUE (chain ("successors", genesis, std::numeric_limits<uint64_t>::max ()).empty ());
 	}
-	ASSERT_EQ (1, blocks.size ());
-	ASSERT_EQ (genesis, blocks[0]);
 }
 
 TEST (rpc, frontier)
@@ -1265,6 +1290,60 @@ TEST (rpc, account_history)
 	}
 }
 
+// Offsets are walked without the account height index and looked up by height with it, both give the same results
+TEST (rpc, account_history_offset)
+{
+	for (auto index : { false, true })
+	{
+		scendere::system system;
+		scendere::node_config node_config (scendere::get_available_port (), system.logging);
+		node_config.enable_account_height_index = index;
+		auto node = add_ipc_enabled_node (system, node_config);
+		ASSERT_EQ (index, node->ledger.account_heights);
+		system.wallet (0)->insert_adhoc (scendere::dev::genesis_key.prv);
+		scendere::keypair key;
+		std::vector<std::shared_ptr<scendere::block>> sends;
+		for (auto i (0); i < 3; ++i)
+		{
+			sends.push_back (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, key.pub, 1));
+			ASSERT_NE (nullptr, sends.back ());
+		}
+		auto const rpc_ctx = add_rpc (system, node);
+		auto history = [&system, &rpc_ctx] (uint64_t offset_a, bool reverse_a, boost::optional<scendere::block_hash> const & head_a = boost::none) {
+			boost::property_tree::ptree request;
+			request.put ("action", "account_history");
+			request.put ("account", scendere::dev::genesis_key.pub.to_account ());
+			request.put ("count", 100);
+			request.put ("offset", offset_a);
+			if (reverse_a)
+			{
+				request.put ("reverse", true);
+			}
+			if (head_a)
+			{
+				request.put ("head", head_a->to_string ());
+			}
+			auto response (wait_response (system, rpc_ctx, request, 10s));
+			std::vector<std::string> heights;
+			for (auto & i : response.get_child ("history"))
+			{
+				heights.push_back (i.second.get<std::string> ("height"));
+			}
+			return heights;
+		};
+		ASSERT_EQ ((std::vector<std::string>{ "3", "2", "1" }), history (1, false));
+		ASSERT_EQ ((std::vector<std::string>{ "2", "3", "4" }), history (1, true));
+		ASSERT_EQ ((std::vector<std::string>{ "2", "1" }), history (1, false, sends[1]->hash ()));
+		ASSERT_EQ ((std::vector<std::string>{ "4" }), history (1, true, sends[1]->hash ()));
+		// Past the open block
+		ASSERT_TRUE (history (4, false).empty ());
+		ASSERT_TRUE (history (std::numeric_limits<uint64_t>::max (), false).empty ());
+		// Past the head
+		ASSERT_TRUE (history (4, true).empty ());
+		ASSERT_TRUE (history (std::numeric_limits<uint64_t>::max (), true).empty ());
+	}
+}
+
 TEST (rpc, history_count)
 {
 	scendere::system system;
@@ -2042,6 +2121,105 @@ TEST (rpc, pending_burn)
 	}
 }
 
+// The receivable actions give the same entries with and without the receivable amount index, the index only changes the order of unsorted results
+TEST (rpc, receivable_amount_index)
+{
+	for (auto index : { false, true })
+	{
+		scendere::system system;
+		scendere::node_config node_config (scendere::get_available_port (), system.logging);
+		node_config.enable_receivable_amount_index = index;
+		auto node = add_ipc_enabled_node (system, node_config);
+		ASSERT_EQ (index, node->ledger.pending_amounts);
+		scendere::keypair key1;
+		scendere::account const burn{ 0 };
+		system.wallet (0)->insert_adhoc (scendere::dev::genesis_key.prv);
+		system.wallet (0)->insert_adhoc (key1.prv, false);
+		std::map<scendere::uint128_t, scendere::block_hash> sends;
+		for (auto amount : { 10, 300, 20 })
+		{
+			auto send (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, key1.pub, amount));
+			ASSERT_NE (nullptr, send);
+			sends[amount] = send->hash ();
+		}
+		// The completion marker of the index is filed under the burn account
+		for (auto amount : { 5, 50 })
+		{
+			auto send (system.wallet (0)->send_action (scendere::dev::genesis_key.pub, burn, amount));
+			ASSERT_NE (nullptr, send);
+			sends[amount] = send->hash ();
+		}
+		auto const rpc_ctx = add_rpc (system, node);
+		using entries_t = std::vector<std::pair<scendere::block_hash, scendere::uint128_t>>;
+		auto entries = [] (boost::property_tree::ptree const & blocks_a) {
+			entries_t result;
+			for (auto & i : blocks_a)
+			{
+				scendere::block_hash hash;
+				EXPECT_FALSE (hash.decode_hex (i.first));
+				result.emplace_back (hash, i.second.get<scendere::uint128_t> (i.second.empty () ? "" : "amount"));
+			}
+			return result;
+		};
+		auto sorted = [] (entries_t entries_a) {
+			std::sort (entries_a.begin (), entries_a.end (), [] (auto const & lhs, auto const & rhs) { return lhs.second > rhs.second; });
+			return entries_a;
+		};
+		auto receivable = [&] (scendere::account const & account_a, std::string const & threshold_a, std::string const & offset_a, bool sorting_a, bool source_a = false) {
+			boost::property_tree::ptree request;
+			request.put ("action", "receivable");
+			request.put ("account", account_a.to_account ());
+			request.put ("threshold", threshold_a);
+			request.put ("offset", offset_a);
+			request.put ("sorting", sorting_a);
+			request.put ("source", source_a);
+			request.put ("include_only_confirmed", false);
+			auto response (wait_response (system, rpc_ctx, request));
+			return entries (response.get_child ("blocks"));
+		};
+		entries_t key1_above_15{ { sends[300], 300 }, { sends[20], 20 } };
+		ASSERT_EQ (key1_above_15, sorted (receivable (key1.pub, "15", "0", false)));
+		ASSERT_EQ (key1_above_15, receivable (key1.pub, "15", "0", true));
+		// Sorted results are sliced after sorting in both cases
+		ASSERT_EQ ((entries_t{ { sends[20], 20 }, { sends[10], 10 } }), receivable (key1.pub, "1", "1", true, true));
+		ASSERT_EQ (2, receivable (key1.pub, "1", "1", false, true).size ());
+		ASSERT_TRUE (receivable (key1.pub, "1", "3", false, true).empty ());
+		ASSERT_EQ ((entries_t{ { sends[50], 50 }, { sends[5], 5 } }), receivable (burn, "1", "0", true));
+		ASSERT_EQ ((entries_t{ { sends[50], 50 } }), receivable (burn, "10", "0", false, true));
+
+		{
+			boost::property_tree::ptree request;
+			request.put ("action", "accounts_receivable");
+			boost::property_tree::ptree accounts;
+			for (auto const & account : { key1.pub, burn })
+			{
+				boost::property_tree::ptree entry;
+				entry.put ("", account.to_account ());
+				accounts.push_back (std::make_pair ("", entry));
+			}
+			request.add_child ("accounts", accounts);
+			request.put ("threshold", "15");
+			request.put ("sorting", true);
+			request.put ("include_only_confirmed", false);
+			auto response (wait_response (system, rpc_ctx, request));
+			auto & blocks (response.get_child ("blocks"));
+			ASSERT_EQ (key1_above_15, entries (blocks.get_child (key1.pub.to_account ())));
+			ASSERT_EQ ((entries_t{ { sends[50], 50 } }), entries (blocks.get_child (burn.to_account ())));
+		}
+		{
+			boost::property_tree::ptree request;
+			request.put ("action", "wallet_receivable");
+			request.put ("wallet", node->wallets.items.begin ()->first.to_string ());
+			request.put ("threshold", "15");
+			request.put ("include_only_confirmed", false);
+			auto response (wait_response (system, rpc_ctx, request));
+			auto & blocks (response.get_child ("blocks"));
+			ASSERT_EQ (1, blocks.size ());
+			ASSERT_EQ (key1_above_15, sorted (entries (blocks.get_child (key1.pub.to_account ()))));
+		}
+	}
+}
+
 TEST (rpc, search_receivable)
 {
 	scendere::system system;
@@ -2085,6 +2263,7 @@ TEST (rpc, version)
 	auto genesis_open (node1->latest (scendere::dev::genesis_key.pub));
 	ASSERT_EQ (genesis_open.to_string (), response1.json.get<std::string> ("network_identifier"));
 	ASSERT_EQ (BUILD_INFO, response1.json.get<std::string> ("build_info"));
+	ASSERT_EQ (scendere::asio_backend (), response1.json.get<std::string> ("networking_backend"));
 	auto headers (response1.resp.base ());
 	auto allow (headers.at ("Allow"));
 	auto content_type (headers.at ("Content-Type"));
@@ -5616,6 +5795,15 @@ TEST (rpc, memory_stats)
 		auto response (wait_response (system, rpc_ctx, request));
 		ASSERT_TRUE (!response.empty ());
 	}
+
+	node->store.latency.enable (1);
+	ASSERT_TRUE (node->store.block.exists (node->store.tx_begin_read (), scendere::dev::genesis->hash ()));
+	request.put ("type", "store");
+	{
+		auto response (wait_response (system, rpc_ctx, request));
+		ASSERT_EQ ("true", response.get<std::string> ("enabled"));
+		ASSERT_LE (1, response.get_child ("tables").get_child ("blocks").get_child ("get").get<uint64_t> ("count"));
+	}
 }
 
 TEST (rpc, block_confirmed)
@@ -1,4 +1,5 @@
 #include <scendere/boost/process/child.hpp>
+#include <scendere/lib/asio.hpp>
 #include <scendere/lib/signal_manager.hpp>
 #include <scendere/lib/threading.hpp>
 #include <scendere/lib/tlsconfig.hpp>
@@ -104,6 +105,14 @@ void scendere_daemon::daemon::run (boost::filesystem::path const & data_path, sc
 			config.node.websocket_config.tls_config = tls_config;
 		}
 
+		if (!scendere::asio_backend_supported ())
+		{
+			auto message (boost::str (boost::format ("This build uses the %1% networking backend which is not supported by the running kernel and no epoll build was found next to it, use a build configured with SCENDERE_IO_URING=OFF or SCENDERE_IO_URING_FALLBACK=ON") % scendere::asio_backend ()));
+			std::cerr << message << std::endl;
+			logger.always_log (message);
+			std::exit (1);
+		}
+
 		boost::asio::io_context io_ctx;
 		auto opencl (scendere::opencl_work::create (config.opencl_enable, config.opencl, logger, config.node.network_params.work));
 		scendere::work_pool opencl_work (config.node.network_params.network, config.node.work_threads, config.node.pow_sleep_interval, opencl ? [&opencl] (scendere::work_version const version_a, scendere::root const & root_a, uint64_t difficulty_a, std::atomic<int> & ticket_a) {
@@ -146,6 +155,7 @@ void scendere_daemon::daemon::run (boost::filesystem::path const & data_path, sc
 						  << "Path: " << node->application_path.string () << "\n"
 						  << "Build Info: " << BUILD_INFO << "\n"
 						  << "Database backend: " << node->store.vendor_get () << "\n"
+						  << "Networking backend: " << scendere::asio_backend () << "\n"
 						  << "Start time: " << std::put_time (std::gmtime (&dateTime), "%c UTC") << std::endl;
 
 				auto voting (node->wallets.reps ().voting);
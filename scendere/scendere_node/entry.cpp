@@ -1,4 +1,5 @@
 #include <scendere/crypto_lib/random_pool.hpp>
+#include <scendere/lib/asio.hpp>
 #include <scendere/lib/cli.hpp>
 #include <scendere/lib/utility.hpp>
 #include <scendere/scendere_node/daemon.hpp>
@@ -6,6 +7,7 @@
 #include <scendere/node/daemonconfig.hpp>
 #include <scendere/node/ipc/ipc_server.hpp>
 #include <scendere/node/json_handler.hpp>
+#include <scendere/node/lmdb/lmdb.hpp>
 #include <scendere/node/node.hpp>
 
 #include <boost/dll/runtime_symbol_info.hpp>
@@ -18,6 +20,7 @@
 #include <boost/unordered_set.hpp>
 
 #include <numeric>
+#include <random>
 #include <sstream>
 
 #include <argon2.h>
@@ -64,6 +67,7 @@ public:
 
 int main (int argc, char * const * argv)
 {
+	scendere::asio_backend_fallback (argv);
 	scendere::set_umask ();
 	scendere::node_singleton_memory_pool_purge_guard memory_pool_cleanup_guard;
 	boost::program_options::options_description description ("Command line options");
@@ -93,7 +97,13 @@ int main (int argc, char * const * argv)
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
 		("debug_profile_sign", "Profile signature generation")
+		("debug_profile_network_filter", "Profile concurrent publish filter throughput and duplicate retention, using [threads] and [count]")
+		("debug_profile_bulk_pull_compact", "Profile bulk pull stream size and decoding of [count] state blocks in the regular and compact chain encodings")
+		("debug_block_sizes", "Display the size of the block entries of a synthetic ledger of [count] accounts with Pareto distributed chain lengths, stored with the fixed and with the compact sideband")
+		("debug_profile_read_transactions", "Profile single lookups with a new read transaction each against cached read transactions, [count] lookups from each of [threads] readers")
+		("debug_profile_flood", "Profile peer list reads and flooding with [count] fake tcp peers from [threads] concurrent readers")
 		("debug_profile_process", "Profile active blocks processing (only for scendere_dev_network)")
+		("debug_profile_fast_sync", "Profile bootstrap style processing and cementing of a synthetic ledger of [count] accounts, with and without a bootstrap checkpoint (only for scendere_dev_network)")
 		("debug_profile_votes", "Profile votes processing (only for scendere_dev_network)")
 		("debug_profile_frontiers_confirmation", "Profile frontiers confirmation speed (only for scendere_dev_network)")
 		("debug_random_feed", "Generates output to RNG test suites")
@@ -883,6 +893,304 @@ int main (int argc, char * const * argv)
 			auto end (std::chrono::high_resolution_clock::now ());
 			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
 		}
+		else if (vm.count ("debug_profile_network_filter"))
+		{
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			size_t count (1024 * 1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			// Same memory as the node's publish filter, every item is replayed once after this many other items
+			size_t const filter_size (256 * 1024);
+			size_t const replay_distance (filter_size / 2);
+			for (size_t bucket_size : { 1, 4 })
+			{
+				scendere::network_filter filter (filter_size, bucket_size);
+				std::atomic<size_t> replays (0);
+				std::atomic<size_t> detected (0);
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (unsigned thread (0); thread < threads_count; ++thread)
+				{
+					threads.emplace_back ([&filter, &replays, &detected, count, replay_distance, thread, threads_count] () {
+						std::array<uint64_t, 4> item{ 0, 0, 0, thread };
+						for (size_t i (0); i < count; ++i)
+						{
+							item[0] = i;
+							filter.apply (reinterpret_cast<uint8_t const *> (item.data ()), sizeof (item));
+							// Other threads insert concurrently, so each thread replays at a proportionally shorter distance
+							auto distance (replay_distance / threads_count);
+							if (i >= distance)
+							{
+								item[0] = i - distance;
+								++replays;
+								if (filter.apply (reinterpret_cast<uint8_t const *> (item.data ()), sizeof (item)))
+								{
+									++detected;
+								}
+							}
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+				auto applies (threads_count * count + replays);
+				std::cout << boost::str (boost::format ("Bucket size %1%, %2% threads: %3% applies in %4% us (%5% applies/s), %6% of %7% replays detected (%8%%%)\n") % bucket_size % threads_count % applies % elapsed % (applies * 1000000 / std::max<int64_t> (elapsed, 1)) % detected % replays % (replays ? detected * 100.0 / replays : 0.0));
+			}
+		}
+		else if (vm.count ("debug_block_sizes"))
+		{
+			size_t count (100000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			// Fixed seed so every run measures the same ledger
+			std::mt19937_64 generator (0);
+			std::uniform_real_distribution<double> uniform (0.0, 1.0);
+			// Chains alternate receives and sends, lengths follow a Pareto distribution with a mean of about 5 blocks
+			double const shape (1.24);
+			uint64_t const max_length (1000000);
+			scendere::keypair key;
+			scendere::state_block block (key.pub, scendere::block_hash (1), key.pub, scendere::amount (1), scendere::link (1), key.prv, key.pub, 0);
+			std::vector<uint8_t> block_bytes;
+			{
+				scendere::vectorstream stream (block_bytes);
+				scendere::serialize_block (stream, block);
+			}
+			uint64_t const timestamp_base (1600000000);
+			uint64_t blocks (0);
+			uint64_t fixed_bytes (0);
+			uint64_t compact_bytes (0);
+			for (size_t account (0); account < count; ++account)
+			{
+				auto length (std::min (max_length, static_cast<uint64_t> (1.0 / std::pow (1.0 - uniform (generator), 1.0 / shape))));
+				auto timestamp (timestamp_base + static_cast<uint64_t> (uniform (generator) * 50000000));
+				scendere::uint128_t balance (0);
+				for (uint64_t height (1); height <= length; ++height)
+				{
+					auto is_receive (height % 2 == 1);
+					auto amount (scendere::uint128_t (generator () % 1000000 + 1) * scendere::xrb_ratio);
+					balance = is_receive ? balance + amount : balance - amount / 2;
+					timestamp += generator () % 86400;
+					scendere::block_sideband sideband (scendere::account (account), height < length ? scendere::block_hash (height) : scendere::block_hash (0), balance, height, timestamp, scendere::epoch::epoch_0, !is_receive, is_receive, false, scendere::epoch::epoch_0);
+					// Entries as written before store version 25, converted the same way as on upgrade
+					auto entry (block_bytes);
+					{
+						scendere::vectorstream stream (entry);
+						sideband.serialize (stream, scendere::block_type::state);
+					}
+					auto compact (scendere::block_entry_compact (entry.data (), entry.size ()));
+					release_assert (!compact.empty ());
+					++blocks;
+					fixed_bytes += entry.size ();
+					compact_bytes += compact.size ();
+				}
+			}
+			std::cout << boost::str (boost::format ("%1% accounts, %2% state blocks\n") % count % blocks);
+			std::cout << boost::str (boost::format ("Fixed sideband: %1% bytes (%2$.1f MB)\n") % fixed_bytes % (fixed_bytes / 1e6));
+			std::cout << boost::str (boost::format ("Compact sideband: %1% bytes (%2$.1f MB)\n") % compact_bytes % (compact_bytes / 1e6));
+			std::cout << boost::str (boost::format ("Saved %1$.1f%%, %2$.1f bytes per block\n") % (fixed_bytes > 0 ? 100.0 * (fixed_bytes - compact_bytes) / fixed_bytes : 0.0) % (blocks > 0 ? static_cast<double> (fixed_bytes - compact_bytes) / blocks : 0.0));
+		}
+		else if (vm.count ("debug_profile_read_transactions"))
+		{
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			size_t count (1000000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			size_t const accounts (64 * 1024);
+			auto profile = [threads_count, count, accounts] (std::string const & name_a, std::chrono::milliseconds staleness_a, bool cached_a) {
+				scendere::logger_mt logger;
+				scendere::lmdb_config config;
+				config.read_transaction_staleness = staleness_a;
+				auto path (scendere::unique_path ());
+				{
+					scendere::mdb_store store (logger, path, scendere::dev::constants, scendere::txn_tracking_config{}, std::chrono::milliseconds (5000), config);
+					release_assert (!store.init_error ());
+					{
+						auto transaction (store.tx_begin_write ());
+						for (size_t i (0); i < accounts; ++i)
+						{
+							store.confirmation_height.put (transaction, scendere::account (i), { i, scendere::block_hash (i) });
+						}
+					}
+					std::vector<std::thread> threads;
+					auto begin (std::chrono::steady_clock::now ());
+					for (unsigned thread (0); thread < threads_count; ++thread)
+					{
+						threads.emplace_back ([&store, count, accounts, cached_a, thread] () {
+							for (size_t i (0); i < count; ++i)
+							{
+								scendere::confirmation_height_info info;
+								auto transaction (cached_a ? store.tx_begin_read_cached () : store.tx_begin_read ());
+								release_assert (!store.confirmation_height.get (transaction, scendere::account ((i * 7919 + thread) % accounts), info));
+							}
+						});
+					}
+					for (auto & thread : threads)
+					{
+						thread.join ();
+					}
+					auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+					auto lookups (threads_count * count);
+					std::cout << boost::str (boost::format ("%1%, %2% threads: %3% lookups in %4% us (%5% lookups/s)\n") % name_a % threads_count % lookups % elapsed % (lookups * 1000000 / std::max<int64_t> (elapsed, 1)));
+				}
+				boost::filesystem::remove_all (path);
+			};
+			profile ("New read transaction per lookup", std::chrono::milliseconds (0), false);
+			profile ("Cached read transaction, renewed per lookup", std::chrono::milliseconds (0), true);
+			profile ("Cached read transaction, 50 ms staleness", std::chrono::milliseconds (50), true);
+		}
+		else if (vm.count ("debug_profile_flood"))
+		{
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			size_t count (1024);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			scendere::node_flags node_flags;
+			scendere::update_flags (node_flags, vm);
+			scendere::node_wrapper node_wrapper (scendere::unique_path (), data_path, node_flags);
+			auto node = node_wrapper.node;
+			// The fake peers are on loopback addresses, which are rejected as peers otherwise
+			node->config.allow_local_peers = true;
+			auto work (boost::asio::make_work_guard (*node_wrapper.io_context));
+			std::thread io_thread ([&io_context = *node_wrapper.io_context] () {
+				io_context.run ();
+			});
+			// Fake peers on closed loopback ports, the failed connection still fixes the remote endpoint of each socket.
+			// Each 127.0.0.x address past the first provides 60000 distinct ports
+			std::cout << boost::str (boost::format ("Creating %1% tcp peers\n") % count);
+			std::vector<std::shared_ptr<scendere::socket>> sockets;
+			std::atomic<size_t> completed (0);
+			std::atomic<size_t> inserted (0);
+			for (size_t i (0); i < count; ++i)
+			{
+				auto socket (std::make_shared<scendere::client_socket> (*node));
+				sockets.push_back (socket);
+				boost::asio::ip::address_v4 address (0x7f000002ul + static_cast<uint32_t> (i / 60000));
+				scendere::tcp_endpoint endpoint (boost::asio::ip::make_address_v6 (boost::asio::ip::v4_mapped, address), static_cast<uint16_t> (1024 + i % 60000));
+				socket->async_connect (endpoint, [node, socket, &completed, &inserted] (boost::system::error_code const &) {
+					auto channel (std::make_shared<scendere::transport::channel_tcp> (*node, socket));
+					channel->set_endpoint ();
+					channel->set_node_id (scendere::keypair ().pub);
+					channel->set_network_version (node->network_params.network.protocol_version);
+					if (!node->network.tcp_channels.insert (channel, socket, nullptr))
+					{
+						++inserted;
+					}
+					++completed;
+				});
+			}
+			while (completed < count)
+			{
+				std::this_thread::sleep_for (std::chrono::milliseconds (10));
+			}
+			std::cout << boost::str (boost::format ("%1% peers connected\n") % inserted);
+			if (inserted != count || node->network.size () != count)
+			{
+				std::cerr << boost::str (boost::format ("Only %1% of %2% peers could be added, nothing to profile\n") % node->network.size () % count);
+				node->stop ();
+				work.reset ();
+				io_thread.join ();
+				return -1;
+			}
+			size_t const iterations (10000);
+			auto fanout (node->network.fanout ());
+			auto profile = [threads_count, iterations] (std::string const & name, std::function<void ()> const & action_a) {
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (unsigned thread (0); thread < threads_count; ++thread)
+				{
+					threads.emplace_back ([&action_a, iterations] () {
+						for (size_t i (0); i < iterations; ++i)
+						{
+							action_a ();
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+				auto total (threads_count * iterations);
+				std::cout << boost::str (boost::format ("%1%, %2% threads: %3% calls in %4% us (%5% calls/s)\n") % name % threads_count % total % elapsed % (total * 1000000 / std::max<int64_t> (elapsed, 1)));
+			};
+			profile ("list", [node, fanout] () {
+				node->network.list (fanout);
+			});
+			profile ("random_set", [node, fanout] () {
+				node->network.random_set (fanout);
+			});
+			profile ("find_node_id", [node] () {
+				node->network.tcp_channels.find_node_id (scendere::account (scendere::random_pool::generate_word32 (0, std::numeric_limits<uint32_t>::max ())));
+			});
+			scendere::keepalive keepalive{ node->network_params.network };
+			profile ("flood_message", [node, &keepalive] () {
+				node->network.flood_message (keepalive);
+			});
+			node->stop ();
+			work.reset ();
+			io_thread.join ();
+		}
 		else if (vm.count ("debug_profile_sign"))
 		{
 			std::cerr << "Starting blocks signing profiling\n";
@@ -900,6 +1208,121 @@ int main (int argc, char * const * argv)
 				std::cerr << boost::str (boost::format ("%|1$ 12d|\n") % std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ());
 			}
 		}
+		else if (vm.count ("debug_profile_bulk_pull_compact"))
+		{
+			size_t count (100000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			count = std::max<size_t> (1, count);
+			// One account chain of sends and receives of varying small amounts with a rare representative change, as pulled per account
+			scendere::keypair key;
+			std::vector<scendere::keypair> representatives (4);
+			scendere::state_block_builder builder;
+			std::vector<std::shared_ptr<scendere::block>> blocks;
+			blocks.reserve (count);
+			scendere::block_hash previous (0);
+			scendere::uint128_t balance (std::numeric_limits<scendere::uint128_t>::max () / 2);
+			for (size_t i (0); i < count; ++i)
+			{
+				auto amount (scendere::uint128_t (scendere::random_pool::generate_word32 (1, 1000000)) * scendere::xrb_ratio);
+				balance = i % 3 == 0 ? balance + amount : balance - amount;
+				auto block = builder.make_block ()
+							 .account (key.pub)
+							 .previous (previous)
+							 .representative (representatives[(i / 1000) % representatives.size ()].pub)
+							 .balance (balance)
+							 .link (representatives[i % representatives.size ()].pub)
+							 .sign (key.prv, key.pub)
+							 .work (i)
+							 .build_shared ();
+				previous = block->hash ();
+				blocks.push_back (block);
+			}
+			auto encode = [&blocks] (bool compact_a, bool ascending_a) {
+				std::vector<uint8_t> result;
+				{
+					scendere::bulk_pull_compact_codec codec;
+					scendere::vectorstream stream (result);
+					auto encode_block = [&] (scendere::block const & block_a) {
+						if (compact_a)
+						{
+							codec.serialize (stream, block_a);
+						}
+						else
+						{
+							scendere::serialize_block (stream, block_a);
+						}
+					};
+					if (ascending_a)
+					{
+						for (auto const & block : blocks)
+						{
+							encode_block (*block);
+						}
+					}
+					else
+					{
+						for (auto const & block : boost::adaptors::reverse (blocks))
+						{
+							encode_block (*block);
+						}
+					}
+				}
+				return result;
+			};
+			auto decode = [&blocks] (std::vector<uint8_t> const & stream_a) {
+				scendere::bulk_pull_compact_codec codec;
+				scendere::bufferstream stream (stream_a.data (), stream_a.size ());
+				std::vector<uint8_t> body;
+				std::vector<uint8_t> full;
+				size_t decoded (0);
+				auto begin (std::chrono::steady_clock::now ());
+				uint8_t type (0);
+				while (!scendere::try_read (stream, type))
+				{
+					std::shared_ptr<scendere::block> block;
+					if (type == scendere::bulk_pull_compact_codec::entry_type)
+					{
+						uint8_t size (0);
+						scendere::try_read (stream, size);
+						scendere::read (stream, body, size);
+						if (!codec.deserialize (body.data (), body.size (), full))
+						{
+							scendere::bufferstream full_stream (full.data (), full.size ());
+							block = scendere::deserialize_block (full_stream, scendere::block_type::state);
+						}
+					}
+					else
+					{
+						block = scendere::deserialize_block (stream, static_cast<scendere::block_type> (type));
+					}
+					release_assert (block != nullptr);
+					codec.update (*block);
+					++decoded;
+				}
+				auto end (std::chrono::steady_clock::now ());
+				release_assert (decoded == blocks.size ());
+				return std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ();
+			};
+			for (auto ascending : { false, true })
+			{
+				auto regular (encode (false, ascending));
+				auto compact (encode (true, ascending));
+				auto regular_time (std::max<int64_t> (1, decode (regular)));
+				auto compact_time (std::max<int64_t> (1, decode (compact)));
+				std::cout << boost::str (boost::format ("%1% order, %2% blocks\n") % (ascending ? "Ascending" : "Descending") % count);
+				std::cout << boost::str (boost::format ("  regular: %|1$ 12d| bytes, %2% bytes per block, decoded in %3% us (%4% blocks per second)\n") % regular.size () % (regular.size () / count) % regular_time % (count * 1000000 / regular_time));
+				std::cout << boost::str (boost::format ("  compact: %|1$ 12d| bytes, %2% bytes per block, decoded in %3% us (%4% blocks per second)\n") % compact.size () % (compact.size () / count) % compact_time % (count * 1000000 / compact_time));
+				std::cout << boost::str (boost::format ("  compact size %1%%% of regular\n") % (compact.size () * 100 / regular.size ()));
+			}
+		}
 		else if (vm.count ("debug_profile_process"))
 		{
 			scendere::block_builder builder;
@@ -1015,6 +1438,161 @@ int main (int argc, char * const * argv)
 			std::cout << boost::str (boost::format ("%|1$ 12d| us \n%2% blocks per second\n") % time % (max_blocks * 1000000 / time));
 			release_assert (node->ledger.cache.block_count == max_blocks + 1);
 		}
+		else if (vm.count ("debug_profile_fast_sync"))
+		{
+			scendere::block_builder builder;
+			size_t num_accounts (10000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				try
+				{
+					num_accounts = boost::lexical_cast<size_t> (count_it->second.as<std::string> ());
+				}
+				catch (boost::bad_lexical_cast &)
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			size_t num_iterations (5);
+			size_t max_blocks (2 * num_accounts * num_iterations + num_accounts * 2);
+			auto node_flags = scendere::inactive_node_flag_defaults ();
+			node_flags.read_only = false;
+			node_flags.generate_cache.cemented_count = true;
+			scendere::update_flags (node_flags, vm);
+			std::cout << boost::str (boost::format ("Starting pregenerating %1% blocks\n") % max_blocks);
+			// Chains are kept per account, index 0 is the genesis account
+			std::vector<scendere::account> accounts (num_accounts + 1);
+			std::vector<std::vector<std::shared_ptr<scendere::block>>> chains (num_accounts + 1);
+			{
+				scendere::inactive_node inactive_node (scendere::unique_path (), data_path, node_flags);
+				auto node = inactive_node.node;
+				scendere::block_hash genesis_latest (node->latest (scendere::dev::genesis_key.pub));
+				scendere::uint128_t genesis_balance (std::numeric_limits<scendere::uint128_t>::max ());
+				std::vector<scendere::keypair> keys (num_accounts);
+				std::vector<scendere::root> frontiers (num_accounts);
+				std::vector<scendere::uint128_t> balances (num_accounts, 1000000000);
+				accounts[0] = scendere::dev::genesis_key.pub;
+				for (auto i (0); i != num_accounts; ++i)
+				{
+					genesis_balance = genesis_balance - 1000000000;
+					auto send = builder.state ()
+								.account (scendere::dev::genesis_key.pub)
+								.previous (genesis_latest)
+								.representative (scendere::dev::genesis_key.pub)
+								.balance (genesis_balance)
+								.link (keys[i].pub)
+								.sign (scendere::dev::genesis_key.prv, scendere::dev::genesis_key.pub)
+								.work (*node->work.generate (scendere::work_version::work_1, genesis_latest, node->network_params.work.epoch_1))
+								.build ();
+					genesis_latest = send->hash ();
+					chains[0].push_back (std::move (send));
+
+					auto open = builder.state ()
+								.account (keys[i].pub)
+								.previous (0)
+								.representative (keys[i].pub)
+								.balance (balances[i])
+								.link (genesis_latest)
+								.sign (keys[i].prv, keys[i].pub)
+								.work (*node->work.generate (scendere::work_version::work_1, keys[i].pub, node->network_params.work.epoch_1))
+								.build ();
+					frontiers[i] = open->hash ();
+					accounts[i + 1] = keys[i].pub;
+					chains[i + 1].push_back (std::move (open));
+				}
+				for (auto i (0); i != num_iterations; ++i)
+				{
+					for (auto j (0); j != num_accounts; ++j)
+					{
+						size_t other (num_accounts - j - 1);
+						--balances[j];
+						auto send = builder.state ()
+									.account (keys[j].pub)
+									.previous (frontiers[j].as_block_hash ())
+									.representative (keys[j].pub)
+									.balance (balances[j])
+									.link (keys[other].pub)
+									.sign (keys[j].prv, keys[j].pub)
+									.work (*node->work.generate (scendere::work_version::work_1, frontiers[j], node->network_params.work.epoch_1))
+									.build ();
+						frontiers[j] = send->hash ();
+						chains[j + 1].push_back (std::move (send));
+
+						++balances[other];
+						auto receive = builder.state ()
+									   .account (keys[other].pub)
+									   .previous (frontiers[other].as_block_hash ())
+									   .representative (keys[other].pub)
+									   .balance (balances[other])
+									   .link (frontiers[j].as_block_hash ())
+									   .sign (keys[other].prv, keys[other].pub)
+									   .work (*node->work.generate (scendere::work_version::work_1, frontiers[other], node->network_params.work.epoch_1))
+									   .build ();
+						frontiers[other] = receive->hash ();
+						chains[other + 1].push_back (std::move (receive));
+					}
+				}
+			}
+			// Every chain in the synthetic ledger is confirmed up to its last block, genesis starts at height 1
+			auto profile = [&] (bool use_checkpoint_a) {
+				scendere::inactive_node inactive_node (scendere::unique_path (), data_path, node_flags);
+				auto node = inactive_node.node;
+				if (use_checkpoint_a)
+				{
+					for (auto i (0); i != chains.size (); ++i)
+					{
+						node->bootstrap_initiator.checkpoint.add (accounts[i], chains[i].back ()->hash (), chains[i].size () + (i == 0 ? 1 : 0));
+					}
+				}
+				auto begin (std::chrono::high_resolution_clock::now ());
+				// Account chains arrive from the frontier down, as in bulk pulls
+				for (auto i (0); i != chains.size (); ++i)
+				{
+					for (auto j (chains[i].rbegin ()), n (chains[i].rend ()); j != n; ++j)
+					{
+						node->block_processor.add (scendere::unchecked_info (*j, accounts[i], scendere::signature_verification::unknown));
+					}
+				}
+				scendere::timer<std::chrono::seconds> timer_l (scendere::timer_state::started);
+				while (node->ledger.cache.block_count != max_blocks + 1)
+				{
+					std::this_thread::sleep_for (std::chrono::milliseconds (10));
+					if (timer_l.after_deadline (std::chrono::seconds (15)))
+					{
+						timer_l.restart ();
+						std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked), %3% remaining") % node->ledger.cache.block_count % node->unchecked.count (node->store.tx_begin_read ()) % node->block_processor.size ()) << std::endl;
+					}
+				}
+				node->block_processor.flush ();
+				if (!use_checkpoint_a)
+				{
+					for (auto & chain : chains)
+					{
+						node->confirmation_height_processor.add (chain.back ());
+					}
+				}
+				while (node->ledger.cache.cemented_count != node->ledger.cache.block_count)
+				{
+					std::this_thread::sleep_for (std::chrono::milliseconds (10));
+					if (timer_l.after_deadline (std::chrono::seconds (15)))
+					{
+						timer_l.restart ();
+						std::cout << boost::str (boost::format ("%1% blocks cemented") % node->ledger.cache.cemented_count) << std::endl;
+					}
+				}
+				auto end (std::chrono::high_resolution_clock::now ());
+				node->stop ();
+				return std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ();
+			};
+			std::cout << boost::str (boost::format ("Starting processing and cementing %1% blocks\n") % max_blocks);
+			auto time_normal (profile (false));
+			std::cout << boost::str (boost::format ("Normal:     %|1$ 12d| us, %2% blocks per second\n") % time_normal % (max_blocks * 1000000 / time_normal));
+			auto time_checkpoint (profile (true));
+			std::cout << boost::str (boost::format ("Checkpoint: %|1$ 12d| us, %2% blocks per second\n") % time_checkpoint % (max_blocks * 1000000 / time_checkpoint));
+			scendere::remove_temporary_directories ();
+		}
 		else if (vm.count ("debug_profile_votes"))
 		{
 			scendere::block_builder builder;
@@ -1,3 +1,4 @@
+#include <scendere/lib/asio.hpp>
 #include <scendere/lib/cli.hpp>
 #include <scendere/lib/errors.hpp>
 #include <scendere/lib/signal_manager.hpp>
@@ -11,6 +12,7 @@
 #include <scendere/secure/utility.hpp>
 
 #include <boost/filesystem.hpp>
+#include <boost/format.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/file.hpp>
 #include <boost/program_options.hpp>
@@ -61,6 +63,14 @@ void run (boost::filesystem::path const & data_path, std::vector<std::string> co
 			rpc_config.tls_config = tls_config;
 		}
 
+		if (!scendere::asio_backend_supported ())
+		{
+			auto message (boost::str (boost::format ("This build uses the %1% networking backend which is not supported by the running kernel and no epoll build was found next to it, use a build configured with SCENDERE_IO_URING=OFF or SCENDERE_IO_URING_FALLBACK=ON") % scendere::asio_backend ()));
+			std::cerr << message << std::endl;
+			logger.always_log (message);
+			std::exit (1);
+		}
+
 		boost::asio::io_context io_ctx;
 		scendere::signal_manager sigman;
 		try
@@ -100,6 +110,7 @@ void run (boost::filesystem::path const & data_path, std::vector<std::string> co
 
 int main (int argc, char * const * argv)
 {
+	scendere::asio_backend_fallback (argv);
 	scendere::set_umask ();
 
 	boost::program_options::options_description description ("Command line options");
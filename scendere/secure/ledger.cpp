@@ -2,12 +2,17 @@
 #include <scendere/lib/stats.hpp>
 #include <scendere/lib/utility.hpp>
 #include <scendere/lib/work.hpp>
+#include <scendere/secure/buffer.hpp>
 #include <scendere/secure/common.hpp>
 #include <scendere/secure/ledger.hpp>
 #include <scendere/secure/store.hpp>
 
 #include <crypto/cryptopp/words.h>
 
+#include <boost/format.hpp>
+
+#include <fstream>
+
 namespace
 {
 /**
@@ -37,7 +42,7 @@ public:
 			scendere::account_info info;
 			[[maybe_unused]] auto error (ledger.store.account.get (transaction, pending.source, info));
 			debug_assert (!error);
-			ledger.store.pending.del (transaction, key);
+			ledger.pending_del (transaction, key);
 			ledger.cache.rep_weights.representation_add (info.representative, pending.amount.number ());
 			scendere::account_info new_info (block_a.hashables.previous, info.representative, info.open_block, ledger.balance (transaction, block_a.hashables.previous), scendere::seconds_since_epoch (), info.block_count - 1, scendere::epoch::epoch_0);
 			ledger.update_account (transaction, pending.source, info, new_info);
@@ -63,7 +68,7 @@ public:
 		scendere::account_info new_info (block_a.hashables.previous, info.representative, info.open_block, ledger.balance (transaction, block_a.hashables.previous), scendere::seconds_since_epoch (), info.block_count - 1, scendere::epoch::epoch_0);
 		ledger.update_account (transaction, destination_account, info, new_info);
 		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, scendere::pending_key (destination_account, block_a.hashables.source), { source_account, amount, scendere::epoch::epoch_0 });
+		ledger.pending_put (transaction, scendere::pending_key (destination_account, block_a.hashables.source), { source_account, amount, scendere::epoch::epoch_0 });
 		ledger.store.frontier.del (transaction, hash);
 		ledger.store.frontier.put (transaction, block_a.hashables.previous, destination_account);
 		ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
@@ -78,10 +83,13 @@ public:
 		[[maybe_unused]] bool is_pruned (false);
 		auto source_account (ledger.account_safe (transaction, block_a.hashables.source, is_pruned));
 		ledger.cache.rep_weights.representation_add (block_a.representative (), 0 - amount);
+		scendere::account_info info;
+		[[maybe_unused]] auto error (ledger.store.account.get (transaction, destination_account, info));
+		debug_assert (!error);
 		scendere::account_info new_info;
-		ledger.update_account (transaction, destination_account, new_info, new_info);
+		ledger.update_account (transaction, destination_account, info, new_info);
 		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, scendere::pending_key (destination_account, block_a.hashables.source), { source_account, amount, scendere::epoch::epoch_0 });
+		ledger.pending_put (transaction, scendere::pending_key (destination_account, block_a.hashables.source), { source_account, amount, scendere::epoch::epoch_0 });
 		ledger.store.frontier.del (transaction, hash);
 		ledger.stats.inc (scendere::stat::type::rollback, scendere::stat::detail::open);
 	}
@@ -141,7 +149,7 @@ public:
 			{
 				error = ledger.rollback (transaction, ledger.latest (transaction, block_a.hashables.link.as_account ()), list);
 			}
-			ledger.store.pending.del (transaction, key);
+			ledger.pending_del (transaction, key);
 			ledger.stats.inc (scendere::stat::type::rollback, scendere::stat::detail::send);
 		}
 		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
@@ -150,7 +158,7 @@ public:
 			[[maybe_unused]] bool is_pruned (false);
 			auto source_account (ledger.account_safe (transaction, block_a.hashables.link.as_block_hash (), is_pruned));
 			scendere::pending_info pending_info (source_account, block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
-			ledger.store.pending.put (transaction, scendere::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
+			ledger.pending_put (transaction, scendere::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
 			ledger.stats.inc (scendere::stat::type::rollback, scendere::stat::detail::receive);
 		}
 
@@ -368,11 +376,11 @@ void ledger_processor::state_block_impl (scendere::state_block & block_a)
 						{
 							scendere::pending_key key (block_a.hashables.link.as_account (), hash);
 							scendere::pending_info info (block_a.hashables.account, amount.number (), epoch);
-							ledger.store.pending.put (transaction, key, info);
+							ledger.pending_put (transaction, key, info);
 						}
 						else if (!block_a.hashables.link.is_zero ())
 						{
-							ledger.store.pending.del (transaction, scendere::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
+							ledger.pending_del (transaction, scendere::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
 						}
 
 						scendere::account_info new_info (hash, block_a.representative (), info.open_block.is_zero () ? hash : info.open_block, block_a.hashables.balance, scendere::seconds_since_epoch (), info.block_count + 1, epoch);
@@ -566,7 +574,7 @@ void ledger_processor::send_block (scendere::send_block & block_a)
 								ledger.store.block.put (transaction, hash, block_a);
 								scendere::account_info new_info (hash, info.representative, info.open_block, block_a.hashables.balance, scendere::seconds_since_epoch (), info.block_count + 1, scendere::epoch::epoch_0);
 								ledger.update_account (transaction, account, info, new_info);
-								ledger.store.pending.put (transaction, scendere::pending_key (block_a.hashables.destination, hash), { account, amount, scendere::epoch::epoch_0 });
+								ledger.pending_put (transaction, scendere::pending_key (block_a.hashables.destination, hash), { account, amount, scendere::epoch::epoch_0 });
 								ledger.store.frontier.del (transaction, block_a.hashables.previous);
 								ledger.store.frontier.put (transaction, hash, account);
 								result.previous_balance = info.balance;
@@ -636,7 +644,7 @@ void ledger_processor::receive_block (scendere::receive_block & block_a)
 												debug_assert (!error);
 											}
 #endif
-											ledger.store.pending.del (transaction, key);
+											ledger.pending_del (transaction, key);
 											block_a.sideband_set (scendere::block_sideband (account, 0, new_balance, info.block_count + 1, scendere::seconds_since_epoch (), block_details, scendere::epoch::epoch_0 /* unused */));
 											ledger.store.block.put (transaction, hash, block_a);
 											scendere::account_info new_info (hash, info.representative, info.open_block, new_balance, scendere::seconds_since_epoch (), info.block_count + 1, scendere::epoch::epoch_0);
@@ -708,7 +716,7 @@ void ledger_processor::open_block (scendere::open_block & block_a)
 										debug_assert (!error);
 									}
 #endif
-									ledger.store.pending.del (transaction, key);
+									ledger.pending_del (transaction, key);
 									block_a.sideband_set (scendere::block_sideband (block_a.hashables.account, 0, pending.amount, 1, scendere::seconds_since_epoch (), block_details, scendere::epoch::epoch_0 /* unused */));
 									ledger.store.block.put (transaction, hash, block_a);
 									scendere::account_info new_info (hash, block_a.representative (), hash, pending.amount.number (), scendere::seconds_since_epoch (), 1, scendere::epoch::epoch_0);
@@ -736,7 +744,7 @@ ledger_processor::ledger_processor (scendere::ledger & ledger_a, scendere::write
 }
 } // namespace
 
-scendere::ledger::ledger (scendere::store & store_a, scendere::stat & stat_a, scendere::ledger_constants & constants, scendere::generate_cache const & generate_cache_a) :
+scendere::ledger::ledger (scendere::store & store_a, scendere::stat & stat_a, scendere::ledger_constants & constants, scendere::generate_cache const & generate_cache_a, boost::filesystem::path const & cache_snapshot_a) :
 	constants{ constants },
 	store{ store_a },
 	stats{ stat_a },
@@ -744,13 +752,16 @@ scendere::ledger::ledger (scendere::store & store_a, scendere::stat & stat_a, sc
 {
 	if (!store.init_error ())
 	{
-		initialize (generate_cache_a);
+		initialize (generate_cache_a, cache_snapshot_a);
 	}
 }
 
-void scendere::ledger::initialize (scendere::generate_cache const & generate_cache_a)
+void scendere::ledger::initialize (scendere::generate_cache const & generate_cache_a, boost::filesystem::path const & cache_snapshot_a)
 {
-	if (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count)
+	// Rep weights and counts are only rebuilt from the ledger when there is no usable snapshot
+	auto scan (cache_snapshot_a.empty () || cache_snapshot_read (cache_snapshot_a));
+	cache_complete = !scan || (generate_cache_a.reps && generate_cache_a.account_count && generate_cache_a.block_count && generate_cache_a.cemented_count);
+	if (scan && (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count))
 	{
 		store.account.for_each_par (
 		[this] (scendere::read_transaction const & /*unused*/, scendere::store_iterator<scendere::account, scendere::account_info> i, scendere::store_iterator<scendere::account, scendere::account_info> n) {
@@ -770,7 +781,7 @@ void scendere::ledger::initialize (scendere::generate_cache const & generate_cac
 		});
 	}
 
-	if (generate_cache_a.cemented_count)
+	if (scan && generate_cache_a.cemented_count)
 	{
 		store.confirmation_height.for_each_par (
 		[this] (scendere::read_transaction const & /*unused*/, scendere::store_iterator<scendere::account, scendere::confirmation_height_info> i, scendere::store_iterator<scendere::account, scendere::confirmation_height_info> n) {
@@ -794,6 +805,108 @@ void scendere::ledger::initialize (scendere::generate_cache const & generate_cac
 	}
 }
 
+namespace
+{
+uint8_t constexpr cache_snapshot_version{ 1 };
+}
+
+bool scendere::ledger::cache_snapshot_write (boost::filesystem::path const & path_a)
+{
+	if (!cache_complete)
+	{
+		return true;
+	}
+	std::vector<uint8_t> data;
+	{
+		// Ledger writes update the cache inside their write transactions, holding one keeps the cache in step with the committed sequence
+		auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers, tables::pending, tables::pruned }));
+		auto sequence (store.write_sequence ());
+		if (sequence == 0)
+		{
+			return true;
+		}
+		auto rep_amounts (cache.rep_weights.get_rep_amounts ());
+		scendere::vectorstream stream (data);
+		scendere::write (stream, cache_snapshot_version);
+		scendere::write (stream, sequence);
+		scendere::write (stream, cache.block_count.load ());
+		scendere::write (stream, cache.cemented_count.load ());
+		scendere::write (stream, cache.account_count.load ());
+		scendere::write (stream, static_cast<uint64_t> (rep_amounts.size ()));
+		for (auto const & [representative, amount] : rep_amounts)
+		{
+			scendere::write (stream, representative);
+			scendere::write (stream, scendere::amount{ amount });
+		}
+	}
+	// Written aside and renamed so a crash while saving never leaves a truncated snapshot
+	auto temp_path (path_a);
+	temp_path += ".tmp";
+	auto error (false);
+	{
+		std::ofstream file (temp_path.string (), std::ios::binary | std::ios::trunc);
+		file.write (reinterpret_cast<char const *> (data.data ()), data.size ());
+		file.close ();
+		error = file.fail ();
+	}
+	boost::system::error_code ec;
+	if (!error)
+	{
+		boost::filesystem::rename (temp_path, path_a, ec);
+		error = static_cast<bool> (ec);
+	}
+	if (error)
+	{
+		boost::filesystem::remove (temp_path, ec);
+	}
+	return error;
+}
+
+bool scendere::ledger::cache_snapshot_read (boost::filesystem::path const & path_a)
+{
+	boost::system::error_code ec;
+	if (!boost::filesystem::exists (path_a, ec))
+	{
+		return true;
+	}
+	std::vector<uint8_t> data;
+	{
+		std::ifstream file (path_a.string (), std::ios::binary);
+		data.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+	}
+	// A snapshot is only good for the store state it was taken against, the next shutdown saves a fresh one
+	boost::filesystem::remove (path_a, ec);
+	scendere::bufferstream stream (data.data (), data.size ());
+	uint8_t version;
+	uint64_t sequence;
+	uint64_t block_count;
+	uint64_t cemented_count;
+	uint64_t account_count;
+	uint64_t rep_count;
+	auto error (scendere::try_read (stream, version) || version != cache_snapshot_version);
+	error = error || scendere::try_read (stream, sequence) || sequence == 0 || sequence != store.write_sequence ();
+	error = error || scendere::try_read (stream, block_count) || scendere::try_read (stream, cemented_count) || scendere::try_read (stream, account_count) || scendere::try_read (stream, rep_count);
+	scendere::rep_weights rep_weights_l;
+	for (uint64_t i (0); !error && i < rep_count; ++i)
+	{
+		scendere::account representative;
+		scendere::amount amount;
+		error = scendere::try_read (stream, representative) || scendere::try_read (stream, amount);
+		if (!error)
+		{
+			rep_weights_l.representation_put (representative, amount);
+		}
+	}
+	if (!error)
+	{
+		cache.block_count = block_count;
+		cache.cemented_count = cemented_count;
+		cache.account_count = account_count;
+		cache.rep_weights.copy_from (rep_weights_l);
+	}
+	return error;
+}
+
 // Balance for account containing hash
 scendere::uint128_t scendere::ledger::balance (scendere::transaction const & transaction_a, scendere::block_hash const & hash_a) const
 {
@@ -869,6 +982,10 @@ scendere::process_return scendere::ledger::process (scendere::write_transaction
 	if (processor.result.code == scendere::process_result::progress)
 	{
 		++cache.block_count;
+		if (account_heights)
+		{
+			store.account_height.put (transaction_a, store.block.account_calculated (block_a), block_a.sideband ().height, block_a.hash ());
+		}
 	}
 	return processor.result;
 }
@@ -1057,6 +1174,10 @@ bool scendere::ledger::rollback (scendere::write_transaction const & transaction
 			if (!error)
 			{
 				--cache.block_count;
+				if (account_heights)
+				{
+					store.account_height.del (transaction_a, account_l, block->sideband ().height);
+				}
 			}
 		}
 		else
@@ -1317,6 +1438,18 @@ void scendere::ledger::update_account (scendere::write_transaction const & trans
 		debug_assert (cache.account_count > 0);
 		--cache.account_count;
 	}
+	if (delegators)
+	{
+		auto representative_changed (old_a.head.is_zero () || new_a.head.is_zero () || old_a.representative != new_a.representative);
+		if (!old_a.head.is_zero () && representative_changed)
+		{
+			store.delegator.del (transaction_a, old_a.representative, account_a);
+		}
+		if (!new_a.head.is_zero () && representative_changed)
+		{
+			store.delegator.put (transaction_a, new_a.representative, account_a);
+		}
+	}
 }
 
 std::shared_ptr<scendere::block> scendere::ledger::successor (scendere::transaction const & transaction_a, scendere::qualified_root const & root_a)
@@ -1399,6 +1532,10 @@ uint64_t scendere::ledger::pruning_action (scendere::write_transaction & transac
 		{
 			store.block.del (transaction_a, hash);
 			store.pruned.put (transaction_a, hash);
+			if (account_heights)
+			{
+				store.account_height.del (transaction_a, store.block.account_calculated (*block), block->sideband ().height);
+			}
 			hash = block->previous ();
 			++pruned_count;
 			++cache.pruned_count;
@@ -1421,6 +1558,207 @@ uint64_t scendere::ledger::pruning_action (scendere::write_transaction & transac
 	return pruned_count;
 }
 
+scendere::block_hash scendere::ledger::block_at_height (scendere::transaction const & transaction_a, scendere::account const & account_a, uint64_t height_a) const
+{
+	scendere::block_hash result{ 0 };
+	if (account_heights)
+	{
+		if (height_a > 0)
+		{
+			result = store.account_height.get (transaction_a, account_a, height_a);
+		}
+	}
+	else
+	{
+		scendere::account_info info;
+		if (height_a > 0 && !store.account.get (transaction_a, account_a, info) && height_a <= info.block_count)
+		{
+			if (height_a - 1 < info.block_count - height_a)
+			{
+				result = info.open_block;
+				for (uint64_t height (1); height < height_a && !result.is_zero (); ++height)
+				{
+					result = store.block.successor (transaction_a, result);
+				}
+			}
+			else
+			{
+				result = info.head;
+				for (auto height (info.block_count); height > height_a && !result.is_zero (); --height)
+				{
+					auto block (store.block.get_no_sideband (transaction_a, result));
+					result = block != nullptr ? block->previous () : 0;
+				}
+			}
+		}
+	}
+	return result;
+}
+
+namespace
+{
+/**
+ * Rebuilds an index from every entry of a source table, in batches so the write transactions stay small. The index only counts as complete
+ * once mark_a writes its completion marker with the final batch. put_a indexes one source entry and returns the number of index entries written
+ */
+template <typename Source, typename Index, typename Key, typename Put, typename Mark>
+uint64_t index_build (scendere::store & store_a, scendere::tables table_a, Source & source_a, Index & index_a, Key next_a, Put const & put_a, Mark const & mark_a)
+{
+	uint64_t constexpr batch_size{ 64 * 1024 };
+	{
+		auto transaction (store_a.tx_begin_write ({ table_a }));
+		index_a.clear (transaction);
+	}
+	uint64_t result (0);
+	auto done (false);
+	while (!done)
+	{
+		auto transaction (store_a.tx_begin_write ({ table_a }));
+		uint64_t written (0);
+		auto i (source_a.begin (transaction, next_a));
+		auto n (source_a.end ());
+		for (; i != n && written < batch_size; ++i)
+		{
+			written += put_a (transaction, i->first, i->second);
+		}
+		result += written;
+		done = i == n;
+		if (!done)
+		{
+			next_a = i->first;
+		}
+		else
+		{
+			mark_a (transaction);
+		}
+	}
+	return result;
+}
+}
+
+bool scendere::ledger::account_heights_complete (scendere::transaction const & transaction_a) const
+{
+	// The index is marked complete by an entry at height 0 of the zero account, which is the first key and never a block
+	auto existing (store.account_height.begin (transaction_a));
+	return existing != store.account_height.end () && existing->first.account.is_zero () && existing->first.height == 0;
+}
+
+uint64_t scendere::ledger::account_heights_build ()
+{
+	auto put = [this] (scendere::write_transaction const & transaction_a, scendere::account const & account_a, scendere::account_info const & info_a) {
+		// Chains are walked back from the head until the first pruned block
+		uint64_t written (0);
+		auto hash (info_a.head);
+		while (!hash.is_zero ())
+		{
+			auto block (store.block.get (transaction_a, hash));
+			if (block != nullptr)
+			{
+				store.account_height.put (transaction_a, account_a, block->sideband ().height, hash);
+				++written;
+				hash = block->previous ();
+			}
+			else
+			{
+				hash.clear ();
+			}
+		}
+		return written;
+	};
+	auto mark = [this] (scendere::write_transaction const & transaction_a) {
+		store.account_height.put (transaction_a, 0, 0, 0);
+	};
+	return index_build (store, tables::account_heights, store.account, store.account_height, scendere::account{ 0 }, put, mark);
+}
+
+void scendere::ledger::pending_put (scendere::write_transaction const & transaction_a, scendere::pending_key const & key_a, scendere::pending_info const & info_a)
+{
+	store.pending.put (transaction_a, key_a, info_a);
+	if (pending_amounts)
+	{
+		store.pending_amount.put (transaction_a, { key_a.account, info_a.amount, key_a.hash });
+	}
+}
+
+void scendere::ledger::pending_del (scendere::write_transaction const & transaction_a, scendere::pending_key const & key_a)
+{
+	if (pending_amounts)
+	{
+		scendere::pending_info info;
+		if (!store.pending.get (transaction_a, key_a, info))
+		{
+			store.pending_amount.del (transaction_a, { key_a.account, info.amount, key_a.hash });
+		}
+	}
+	store.pending.del (transaction_a, key_a);
+}
+
+void scendere::ledger::receivable_for_each (scendere::transaction const & transaction_a, scendere::account const & account_a, scendere::uint128_t const & minimum_a, std::function<bool (scendere::pending_key const &, scendere::pending_info const &)> const & action_a) const
+{
+	auto more (true);
+	if (pending_amounts)
+	{
+		for (auto i (store.pending_amount.begin (transaction_a, { account_a, std::numeric_limits<scendere::uint128_t>::max (), 0 })), n (store.pending_amount.end ()); more && i != n && i->first.account == account_a && i->first.amount.number () >= minimum_a; ++i)
+		{
+			scendere::pending_key key (account_a, i->first.hash);
+			scendere::pending_info info;
+			// The completion marker is filed under the zero account and has no pending entry
+			if (!store.pending.get (transaction_a, key, info))
+			{
+				more = action_a (key, info);
+			}
+		}
+	}
+	else
+	{
+		for (auto i (store.pending.begin (transaction_a, scendere::pending_key (account_a, 0))), n (store.pending.end ()); more && i != n && i->first.account == account_a; ++i)
+		{
+			if (i->second.amount.number () >= minimum_a)
+			{
+				more = action_a (i->first, i->second);
+			}
+		}
+	}
+}
+
+bool scendere::ledger::pending_amounts_complete (scendere::transaction const & transaction_a) const
+{
+	// The index is marked complete by an entry with the largest amount and a zero hash for the zero account, which is the first key and never a block
+	auto existing (store.pending_amount.begin (transaction_a));
+	return existing != store.pending_amount.end () && existing->first.account.is_zero () && existing->first.amount.number () == std::numeric_limits<scendere::uint128_t>::max () && existing->first.hash.is_zero ();
+}
+
+uint64_t scendere::ledger::pending_amounts_build ()
+{
+	auto put = [this] (scendere::write_transaction const & transaction_a, scendere::pending_key const & key_a, scendere::pending_info const & info_a) {
+		store.pending_amount.put (transaction_a, { key_a.account, info_a.amount, key_a.hash });
+		return uint64_t{ 1 };
+	};
+	auto mark = [this] (scendere::write_transaction const & transaction_a) {
+		store.pending_amount.put (transaction_a, { 0, std::numeric_limits<scendere::uint128_t>::max (), 0 });
+	};
+	return index_build (store, tables::pending_amounts, store.pending, store.pending_amount, scendere::pending_key{ 0, 0 }, put, mark);
+}
+
+bool scendere::ledger::delegators_complete (scendere::transaction const & transaction_a) const
+{
+	// The index is marked complete by an entry for the zero account under the zero representative, which is the first key and never an account
+	auto existing (store.delegator.begin (transaction_a));
+	return existing != store.delegator.end () && existing->first.representative.is_zero () && existing->first.account.is_zero ();
+}
+
+uint64_t scendere::ledger::delegators_build ()
+{
+	auto put = [this] (scendere::write_transaction const & transaction_a, scendere::account const & account_a, scendere::account_info const & info_a) {
+		store.delegator.put (transaction_a, info_a.representative, account_a);
+		return uint64_t{ 1 };
+	};
+	auto mark = [this] (scendere::write_transaction const & transaction_a) {
+		store.delegator.put (transaction_a, 0, 0);
+	};
+	return index_build (store, tables::delegators, store.account, store.delegator, scendere::account{ 0 }, put, mark);
+}
+
 std::multimap<uint64_t, scendere::uncemented_info, std::greater<>> scendere::ledger::unconfirmed_frontiers () const
 {
 	scendere::locked<std::multimap<uint64_t, scendere::uncemented_info, std::greater<>>> result;
@@ -1452,8 +1790,63 @@ std::multimap<uint64_t, scendere::uncemented_info, std::greater<>> scendere::led
 	return result;
 }
 
+namespace
+{
+/** Forwards the entries of one key range to the destination sink and reports progress over all the ranges of a table */
+class migration_sink final : public scendere::table_sink
+{
+public:
+	migration_sink (scendere::table_sink & sink_a, std::atomic<uint64_t> & read_a, std::function<void (uint64_t)> const & progress_a) :
+		sink{ sink_a },
+		read{ read_a },
+		progress{ progress_a }
+	{
+	}
+
+	void put (void const * key_a, std::size_t key_size_a, void const * value_a, std::size_t value_size_a) override
+	{
+		sink.put (key_a, key_size_a, value_a, value_size_a);
+		auto read_l (read.fetch_add (1, std::memory_order_relaxed) + 1);
+		if (read_l % progress_interval == 0)
+		{
+			progress (read_l);
+		}
+	}
+
+	uint64_t count () const override
+	{
+		return sink.count ();
+	}
+
+	static uint64_t constexpr progress_interval{ 1000000 };
+
+private:
+	scendere::table_sink & sink;
+	std::atomic<uint64_t> & read;
+	std::function<void (uint64_t)> const & progress;
+};
+
+/** Counts the entries of one key range, used to check what was written to the destination */
+class counting_sink final : public scendere::table_sink
+{
+public:
+	void put (void const *, std::size_t, void const *, std::size_t) override
+	{
+		++entries;
+	}
+
+	uint64_t count () const override
+	{
+		return entries;
+	}
+
+private:
+	uint64_t entries{ 0 };
+};
+}
+
 // A precondition is that the store is an LMDB store
-bool scendere::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data_path_a) const
+bool scendere::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data_path_a, std::ostream & progress_a) const
 {
 	boost::system::error_code error_chmod;
 	scendere::set_secure_perm_directory (data_path_a, error_chmod);
@@ -1470,75 +1863,45 @@ bool scendere::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const &
 
 	if (!rocksdb_store->init_error ())
 	{
-		store.block.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
+		// Large tables are read over key ranges in parallel into sorted files, which are ingested whole instead of written through transactions
+		std::vector<std::pair<scendere::tables, char const *>> const tables_l{ { scendere::tables::blocks, "blocks" }, { scendere::tables::pending, "pending" }, { scendere::tables::confirmation_height, "confirmation height" }, { scendere::tables::accounts, "accounts" }, { scendere::tables::frontiers, "frontiers" }, { scendere::tables::pruned, "pruned" }, { scendere::tables::final_votes, "final votes" }, { scendere::tables::account_heights, "account heights" }, { scendere::tables::delegators, "delegators" }, { scendere::tables::pending_amounts, "pending amounts" } };
+		for (auto const & [table, name] : tables_l)
+		{
+			if (!error)
 			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::blocks }));
-
-				std::vector<uint8_t> vector;
+				auto start (std::chrono::steady_clock::now ());
+				// The source is not written to during the migration
+				auto expected (store.count (store.tx_begin_read (), table));
+				std::vector<std::unique_ptr<scendere::table_sink>> sinks;
+				std::deque<migration_sink> range_sinks;
+				scendere::mutex sinks_mutex;
+				std::atomic<uint64_t> read{ 0 };
+				std::function<void (uint64_t)> const progress ([&progress_a, &sinks_mutex, expected, name = name] (uint64_t read_a) {
+					scendere::lock_guard<scendere::mutex> guard (sinks_mutex);
+					progress_a << boost::str (boost::format ("Migrating %1%: read %2% of %3% entries") % name % read_a % expected) << std::endl;
+				});
+				store.table_read_par (table, [&rocksdb_store, &sinks, &range_sinks, &sinks_mutex, &read, &progress, table = table] () -> scendere::table_sink & {
+					scendere::lock_guard<scendere::mutex> guard (sinks_mutex);
+					sinks.push_back (rocksdb_store->table_sink_make (table));
+					return range_sinks.emplace_back (*sinks.back (), read, progress);
+				});
+				range_sinks.clear ();
+				error = rocksdb_store->table_sinks_commit (table, sinks);
+				// Read the destination back, counts of some tables are only estimates on RocksDB
+				std::deque<counting_sink> counting_sinks;
+				rocksdb_store->table_read_par (table, [&counting_sinks, &sinks_mutex] () -> scendere::table_sink & {
+					scendere::lock_guard<scendere::mutex> guard (sinks_mutex);
+					return counting_sinks.emplace_back ();
+				});
+				uint64_t migrated (0);
+				for (auto const & sink : counting_sinks)
 				{
-					scendere::vectorstream stream (vector);
-					scendere::serialize_block (stream, *i->second.block);
-					i->second.sideband.serialize (stream, i->second.block->type ());
+					migrated += sink.count ();
 				}
-				rocksdb_store->block.raw_put (rocksdb_transaction, vector, i->first);
+				error |= migrated != expected;
+				progress_a << boost::str (boost::format ("Migrated %1% of %2% %3% entries in %4% seconds") % migrated % expected % name % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - start).count ()) << std::endl;
 			}
-		});
-
-		store.pending.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::pending }));
-				rocksdb_store->pending.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.confirmation_height.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::confirmation_height }));
-				rocksdb_store->confirmation_height.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.account.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::accounts }));
-				rocksdb_store->account.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.frontier.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::frontiers }));
-				rocksdb_store->frontier.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.pruned.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::pruned }));
-				rocksdb_store->pruned.put (rocksdb_transaction, i->first);
-			}
-		});
-
-		store.final_vote.for_each_par (
-		[&rocksdb_store] (scendere::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { scendere::tables::final_votes }));
-				rocksdb_store->final_vote.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
+		}
 
 		auto lmdb_transaction (store.tx_begin_read ());
 		auto version = store.version.get (lmdb_transaction);
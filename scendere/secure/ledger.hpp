@@ -27,7 +27,8 @@ public:
 class ledger final
 {
 public:
-	ledger (scendere::store &, scendere::stat &, scendere::ledger_constants & constants, scendere::generate_cache const & = scendere::generate_cache ());
+	/** If cache_snapshot names a snapshot written against the current state of the store, the cache is loaded from it instead of scanning the ledger */
+	ledger (scendere::store &, scendere::stat &, scendere::ledger_constants & constants, scendere::generate_cache const & = scendere::generate_cache (), boost::filesystem::path const & cache_snapshot = {});
 	scendere::account account (scendere::transaction const &, scendere::block_hash const &) const;
 	scendere::account account_safe (scendere::transaction const &, scendere::block_hash const &, bool &) const;
 	scendere::uint128_t amount (scendere::transaction const &, scendere::account const &);
@@ -68,7 +69,30 @@ public:
 	scendere::account const & epoch_signer (scendere::link const &) const;
 	scendere::link const & epoch_link (scendere::epoch) const;
 	std::multimap<uint64_t, uncemented_info, std::greater<>> unconfirmed_frontiers () const;
-	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &) const;
+	/** Hash of the block at height_a in the chain of account_a, zero if there is none. Found through the account height index when enabled, otherwise by walking from the nearer end of the chain */
+	scendere::block_hash block_at_height (scendere::transaction const &, scendere::account const &, uint64_t height_a) const;
+	/** Whether the account height index covers every block in the ledger */
+	bool account_heights_complete (scendere::transaction const &) const;
+	/** Rebuilds the account height index over the whole ledger, returns the number of blocks indexed. Not safe while the ledger is being written */
+	uint64_t account_heights_build ();
+	/** Pending writes go through these so the receivable amount index is kept in step when enabled */
+	void pending_put (scendere::write_transaction const &, scendere::pending_key const &, scendere::pending_info const &);
+	void pending_del (scendere::write_transaction const &, scendere::pending_key const &);
+	/** Calls action_a with the receivable entries of account_a of at least minimum_a until it returns false. Visits them by descending amount without reading smaller ones when the receivable amount index is enabled, otherwise in block hash order */
+	void receivable_for_each (scendere::transaction const &, scendere::account const &, scendere::uint128_t const & minimum_a, std::function<bool (scendere::pending_key const &, scendere::pending_info const &)> const & action_a) const;
+	/** Whether the receivable amount index covers every pending entry in the ledger */
+	bool pending_amounts_complete (scendere::transaction const &) const;
+	/** Rebuilds the receivable amount index over the whole ledger, returns the number of entries indexed. Not safe while the ledger is being written */
+	uint64_t pending_amounts_build ();
+	/** Whether the delegator index covers every account in the ledger */
+	bool delegators_complete (scendere::transaction const &) const;
+	/** Rebuilds the delegator index over the whole ledger, returns the number of accounts indexed. Not safe while the ledger is being written */
+	uint64_t delegators_build ();
+	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &, std::ostream & = std::cout) const;
+	/** Saves the cache stamped with the store's write sequence. Returns true on error, if the store does not track a write sequence or if the cache was only partially generated */
+	bool cache_snapshot_write (boost::filesystem::path const &);
+	/** Loads the cache from a snapshot and removes it. Returns true if there is no snapshot or the store has been written since it was saved */
+	bool cache_snapshot_read (boost::filesystem::path const &);
 	static scendere::uint128_t const unit;
 	scendere::ledger_constants & constants;
 	scendere::store & store;
@@ -79,9 +103,17 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	bool pruning{ false };
+	/** Maintain the account height index, only set once it is complete */
+	bool account_heights{ false };
+	/** Maintain the delegator index, only set once it is complete */
+	bool delegators{ false };
+	/** Maintain the receivable amount index, only set once it is complete */
+	bool pending_amounts{ false };
 
 private:
-	void initialize (scendere::generate_cache const &);
+	void initialize (scendere::generate_cache const &, boost::filesystem::path const &);
+	/** Whether the cache counts the whole ledger, either loaded from a snapshot or fully generated. Only a complete cache is saved */
+	bool cache_complete{ false };
 };
 
 std::unique_ptr<container_info_component> collect_container_info (ledger & ledger, std::string const & name);
@@ -4,8 +4,12 @@
 #include <scendere/secure/common.hpp>
 #include <scendere/secure/network_filter.hpp>
 
-scendere::network_filter::network_filter (size_t size_a) :
-	items (size_a, scendere::uint128_t{ 0 })
+#include <algorithm>
+
+scendere::network_filter::network_filter (size_t size_a, size_t bucket_size_a) :
+	bucket_size (std::max<size_t> (bucket_size_a, 1)),
+	bucket_count (std::max<size_t> (size_a / bucket_size, 1)),
+	items (bucket_count * bucket_size, scendere::uint128_t{ 0 })
 {
 	scendere::random_pool::generate_block (key, key.size ());
 }
@@ -14,14 +18,27 @@ bool scendere::network_filter::apply (uint8_t const * bytes_a, size_t count_a, s
 {
 	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
-
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
+	auto bucket (bucket_index (digest));
+	bool existed (false);
 	{
-		// Replace likely old element with a new one
-		element = digest;
+		scendere::lock_guard<scendere::mutex> lock (stripe_mutex (bucket));
+		auto begin (bucket_begin (bucket));
+		auto end (begin + bucket_size);
+		auto empty (end);
+		for (auto i (begin); i != end && !existed; ++i)
+		{
+			existed = *i == digest;
+			if (empty == end && *i == 0)
+			{
+				empty = i;
+			}
+		}
+		if (!existed)
+		{
+			// Prefer an empty slot, otherwise replace a likely old element picked by the upper digest bits
+			auto & element (empty != end ? *empty : begin[static_cast<size_t> (digest >> 64) % bucket_size]);
+			element = digest;
+		}
 	}
 	if (digest_a)
 	{
@@ -32,24 +49,16 @@ bool scendere::network_filter::apply (uint8_t const * bytes_a, size_t count_a, s
 
 void scendere::network_filter::clear (scendere::uint128_t const & digest_a)
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	auto & element (get_element (digest_a));
-	if (element == digest_a)
-	{
-		element = scendere::uint128_t{ 0 };
-	}
+	auto bucket (bucket_index (digest_a));
+	scendere::lock_guard<scendere::mutex> lock (stripe_mutex (bucket));
+	clear_locked (bucket, digest_a);
 }
 
 void scendere::network_filter::clear (std::vector<scendere::uint128_t> const & digests_a)
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = scendere::uint128_t{ 0 };
-		}
+		clear (digest);
 	}
 }
 
@@ -66,8 +75,14 @@ void scendere::network_filter::clear (OBJECT const & object_a)
 
 void scendere::network_filter::clear ()
 {
-	scendere::lock_guard<scendere::mutex> lock (mutex);
-	items.assign (items.size (), scendere::uint128_t{ 0 });
+	for (size_t stripe (0); stripe < stripe_count; ++stripe)
+	{
+		scendere::lock_guard<scendere::mutex> lock (stripes[stripe].mutex);
+		for (auto bucket (stripe); bucket < bucket_count; bucket += stripe_count)
+		{
+			std::fill_n (bucket_begin (bucket), bucket_size, scendere::uint128_t{ 0 });
+		}
+	}
 }
 
 template <typename OBJECT>
@@ -81,12 +96,28 @@ scendere::uint128_t scendere::network_filter::hash (OBJECT const & object_a) con
 	return hash (bytes.data (), bytes.size ());
 }
 
-scendere::uint128_t & scendere::network_filter::get_element (scendere::uint128_t const & hash_a)
+size_t scendere::network_filter::bucket_index (scendere::uint128_t const & hash_a) const
+{
+	debug_assert (bucket_count > 0);
+	return static_cast<size_t> (hash_a % bucket_count);
+}
+
+scendere::mutex & scendere::network_filter::stripe_mutex (size_t bucket_a)
+{
+	return stripes[bucket_a % stripe_count].mutex;
+}
+
+scendere::uint128_t * scendere::network_filter::bucket_begin (size_t bucket_a)
+{
+	debug_assert (!stripe_mutex (bucket_a).try_lock ());
+	debug_assert (bucket_a < bucket_count);
+	return items.data () + bucket_a * bucket_size;
+}
+
+void scendere::network_filter::clear_locked (size_t bucket_a, scendere::uint128_t const & digest_a)
 {
-	debug_assert (!mutex.try_lock ());
-	debug_assert (items.size () > 0);
-	size_t index (hash_a % items.size ());
-	return items[index];
+	auto begin (bucket_begin (bucket_a));
+	std::replace (begin, begin + bucket_size, digest_a, scendere::uint128_t{ 0 });
 }
 
 scendere::uint128_t scendere::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
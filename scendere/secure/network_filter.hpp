@@ -1,11 +1,13 @@
 
 #pragma once
 
+#include <scendere/lib/locks.hpp>
 #include <scendere/lib/numbers.hpp>
 
 #include <crypto/cryptopp/seckey.h>
 #include <crypto/cryptopp/siphash.h>
 
+#include <array>
 #include <mutex>
 
 namespace scendere
@@ -14,13 +16,16 @@ namespace scendere
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
  * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
+ * Elements are grouped in buckets of \p bucket_size_a slots. A bucket size of 1 is a direct-mapped filter, while larger
+ * buckets keep more recent digests alive for the same memory, at the cost of scanning the bucket on every lookup.
+ * Buckets are guarded by a fixed set of striped mutexes so concurrent callers rarely contend on the same lock.
  * @note This class is thread-safe.
  */
 class network_filter final
 {
 public:
 	network_filter () = delete;
-	network_filter (size_t size_a);
+	network_filter (size_t size_a, size_t bucket_size_a = 1);
 	/**
 	 * Reads \p count_a bytes starting from \p bytes_a and inserts the siphash digest in the filter.
 	 * @param \p digest_a if given, will be set to the resulting siphash digest
@@ -65,12 +70,32 @@ public:
 private:
 	using siphash_t = CryptoPP::SipHash<2, 4, true>;
 
+	static size_t constexpr stripe_count = 64;
+
+	/** Padded to a cache line so neighbouring stripes do not false-share */
+	class alignas (64) stripe final
+	{
+	public:
+		scendere::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+	};
+
+	/** @return the index of the bucket holding \p hash_a */
+	size_t bucket_index (scendere::uint128_t const & hash_a) const;
+
+	/** @return the mutex guarding bucket \p bucket_a */
+	scendere::mutex & stripe_mutex (size_t bucket_a);
+
+	/**
+	 * Get the first element of bucket \p bucket_a
+	 * @note must have a lock on the stripe mutex of the bucket
+	 **/
+	scendere::uint128_t * bucket_begin (size_t bucket_a);
+
 	/**
-	 * Get element from digest.
-	 * @note must have a lock on mutex
-	 * @return a reference to the element with key \p hash_a
+	 * Sets the element in bucket \p bucket_a matching \p digest_a exactly to zero, if any
+	 * @note must have a lock on the stripe mutex of the bucket
 	 **/
-	scendere::uint128_t & get_element (scendere::uint128_t const & hash_a);
+	void clear_locked (size_t bucket_a, scendere::uint128_t const & digest_a);
 
 	/**
 	 * Hashes \p count_a bytes starting from \p bytes_a .
@@ -78,8 +103,10 @@ private:
 	 **/
 	scendere::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
 
+	size_t const bucket_size;
+	size_t const bucket_count;
 	std::vector<scendere::uint128_t> items;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	scendere::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+	std::array<stripe, stripe_count> stripes;
 };
 }
@@ -1,6 +1,30 @@
 #include <scendere/lib/threading.hpp>
 #include <scendere/secure/store.hpp>
 
+#include <boost/property_tree/ptree.hpp>
+
+std::vector<uint8_t> scendere::block_entry_compact (uint8_t const * data_a, size_t size_a)
+{
+	std::vector<uint8_t> result;
+	if (size_a > sizeof (scendere::block_type))
+	{
+		auto type (static_cast<scendere::block_type> (data_a[0]));
+		auto block_size (scendere::block::size (type));
+		// Varint heights and timestamps are shorter than their fixed width for any realistic value, so an exact size match identifies the fixed layout
+		if (block_size != 0 && size_a == sizeof (scendere::block_type) + block_size + scendere::block_sideband::size (type))
+		{
+			scendere::bufferstream stream (data_a + sizeof (scendere::block_type) + block_size, size_a - sizeof (scendere::block_type) - block_size);
+			scendere::block_sideband sideband;
+			auto error (sideband.deserialize (stream, type));
+			release_assert (!error);
+			result.assign (data_a, data_a + sizeof (scendere::block_type) + block_size);
+			scendere::vectorstream output (result);
+			sideband.serialize_compact (output, type);
+		}
+	}
+	return result;
+}
+
 scendere::representative_visitor::representative_visitor (scendere::transaction const & transaction_a, scendere::store & store_a) :
 	transaction (transaction_a),
 	store (store_a),
@@ -117,7 +141,10 @@ scendere::store::store (
 	scendere::peer_store & peer_store_a,
 	scendere::confirmation_height_store & confirmation_height_store_a,
 	scendere::final_vote_store & final_vote_store_a,
-	scendere::version_store & version_store_a
+	scendere::version_store & version_store_a,
+	scendere::account_height_store & account_height_store_a,
+	scendere::delegator_store & delegator_store_a,
+	scendere::pending_amount_store & pending_amount_store_a
 ) :
 	block (block_store_a),
 	frontier (frontier_store_a),
@@ -129,11 +156,19 @@ scendere::store::store (
 	peer (peer_store_a),
 	confirmation_height (confirmation_height_store_a),
 	final_vote (final_vote_store_a),
-	version (version_store_a)
+	version (version_store_a),
+	account_height (account_height_store_a),
+	delegator (delegator_store_a),
+	pending_amount (pending_amount_store_a)
 {
 }
 // clang-format on
 
+scendere::read_transaction scendere::store::tx_begin_read_cached () const
+{
+	return tx_begin_read ();
+}
+
 auto scendere::unchecked_store::equal_range (scendere::transaction const & transaction, scendere::block_hash const & dependency) -> std::pair<iterator, iterator>
 {
 	scendere::unchecked_key begin_l{ dependency, 0 };
@@ -163,3 +198,222 @@ std::vector<scendere::unchecked_info> scendere::unchecked_store::get (scendere::
 	}
 	return result;
 }
+
+void scendere::store_latency::enable (unsigned sample_interval_a)
+{
+	debug_assert (sample_interval_a > 0);
+	sample_interval = std::max (1u, sample_interval_a);
+	enabled_m = true;
+}
+
+void scendere::store_latency::disable ()
+{
+	enabled_m = false;
+}
+
+bool scendere::store_latency::enabled () const
+{
+	return enabled_m;
+}
+
+void scendere::store_latency::clear ()
+{
+	for (auto & shard : shards)
+	{
+		for (auto & table : shard)
+		{
+			for (auto & entry : table)
+			{
+				entry.count = 0;
+				entry.timed = 0;
+				entry.total_ns = 0;
+				for (auto & bucket : entry.buckets)
+				{
+					bucket = 0;
+				}
+			}
+		}
+	}
+}
+
+uint64_t scendere::store_latency::count (scendere::tables table_a, scendere::store_latency::operation operation_a) const
+{
+	return totals (static_cast<std::size_t> (table_a), static_cast<std::size_t> (operation_a)).count;
+}
+
+std::size_t scendere::store_latency::shard ()
+{
+	static std::atomic<std::size_t> next{ 0 };
+	thread_local std::size_t const shard_l (next.fetch_add (1, std::memory_order_relaxed) % shard_count);
+	return shard_l;
+}
+
+scendere::store_latency::totals_t scendere::store_latency::totals (std::size_t table_a, std::size_t operation_a) const
+{
+	totals_t result;
+	for (auto const & shard : shards)
+	{
+		auto const & entry_l (shard[table_a][operation_a]);
+		result.count += entry_l.count.load (std::memory_order_relaxed);
+		result.timed += entry_l.timed.load (std::memory_order_relaxed);
+		result.total_ns += entry_l.total_ns.load (std::memory_order_relaxed);
+		for (std::size_t bucket (0); bucket < bucket_count; ++bucket)
+		{
+			result.buckets[bucket] += entry_l.buckets[bucket].load (std::memory_order_relaxed);
+		}
+	}
+	return result;
+}
+
+void scendere::store_latency::record (scendere::tables table_a, scendere::store_latency::operation operation_a, std::chrono::steady_clock::duration duration_a) const
+{
+	auto nanoseconds (static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (duration_a).count ()));
+	std::size_t bucket (0);
+	for (auto remaining (nanoseconds >> 8); remaining != 0 && bucket < bucket_count - 1; remaining >>= 1)
+	{
+		++bucket;
+	}
+	auto & entry_l (entry (table_a, operation_a));
+	entry_l.timed.fetch_add (1, std::memory_order_relaxed);
+	entry_l.total_ns.fetch_add (nanoseconds, std::memory_order_relaxed);
+	entry_l.buckets[bucket].fetch_add (1, std::memory_order_relaxed);
+}
+
+void scendere::store_latency::serialize (boost::property_tree::ptree & tree_a) const
+{
+	tree_a.put ("enabled", enabled ());
+	tree_a.put ("sample_interval", sample_interval.load ());
+	boost::property_tree::ptree tables_l;
+	for (std::size_t table (0); table < table_count; ++table)
+	{
+		boost::property_tree::ptree operations_l;
+		for (std::size_t operation (0); operation < operation_count; ++operation)
+		{
+			auto totals_l (totals (table, operation));
+			if (totals_l.count > 0)
+			{
+				boost::property_tree::ptree operation_l;
+				operation_l.put ("count", totals_l.count);
+				operation_l.put ("timed", totals_l.timed);
+				operation_l.put ("average_ns", totals_l.timed > 0 ? totals_l.total_ns / totals_l.timed : 0);
+				// Keyed by the exclusive upper bound of each bucket in nanoseconds
+				boost::property_tree::ptree histogram_l;
+				for (std::size_t bucket (0); bucket < bucket_count; ++bucket)
+				{
+					auto key (bucket < bucket_count - 1 ? std::to_string (uint64_t{ 1 } << (bucket + 8)) : std::string ("max"));
+					histogram_l.put (key, totals_l.buckets[bucket]);
+				}
+				operation_l.add_child ("histogram", histogram_l);
+				operations_l.add_child (operation_name (static_cast<scendere::store_latency::operation> (operation)), operation_l);
+			}
+		}
+		if (!operations_l.empty ())
+		{
+			tables_l.add_child (table_name (static_cast<scendere::tables> (table)), operations_l);
+		}
+	}
+	tree_a.add_child ("tables", tables_l);
+}
+
+char const * scendere::store_latency::table_name (scendere::tables table_a)
+{
+	char const * result (nullptr);
+	switch (table_a)
+	{
+		case scendere::tables::account_heights:
+			result = "account_heights";
+			break;
+		case scendere::tables::accounts:
+			result = "accounts";
+			break;
+		case scendere::tables::blocks:
+			result = "blocks";
+			break;
+		case scendere::tables::confirmation_height:
+			result = "confirmation_height";
+			break;
+		case scendere::tables::default_unused:
+			result = "default_unused";
+			break;
+		case scendere::tables::delegators:
+			result = "delegators";
+			break;
+		case scendere::tables::final_votes:
+			result = "final_votes";
+			break;
+		case scendere::tables::frontiers:
+			result = "frontiers";
+			break;
+		case scendere::tables::meta:
+			result = "meta";
+			break;
+		case scendere::tables::online_weight:
+			result = "online_weight";
+			break;
+		case scendere::tables::peers:
+			result = "peers";
+			break;
+		case scendere::tables::pending:
+			result = "pending";
+			break;
+		case scendere::tables::pending_amounts:
+			result = "pending_amounts";
+			break;
+		case scendere::tables::pruned:
+			result = "pruned";
+			break;
+		case scendere::tables::unchecked:
+			result = "unchecked";
+			break;
+		case scendere::tables::vote:
+			result = "vote";
+			break;
+	}
+	debug_assert (result != nullptr);
+	return result;
+}
+
+char const * scendere::store_latency::operation_name (scendere::store_latency::operation operation_a)
+{
+	char const * result (nullptr);
+	switch (operation_a)
+	{
+		case scendere::store_latency::operation::get:
+			result = "get";
+			break;
+		case scendere::store_latency::operation::put:
+			result = "put";
+			break;
+		case scendere::store_latency::operation::del:
+			result = "del";
+			break;
+		case scendere::store_latency::operation::exists:
+			result = "exists";
+			break;
+		case scendere::store_latency::operation::iterator:
+			result = "iterator";
+			break;
+	}
+	debug_assert (result != nullptr);
+	return result;
+}
+
+/** Leaves are per table and operation, the count is the number of operations and the element size their average latency in nanoseconds */
+std::unique_ptr<scendere::container_info_component> scendere::collect_container_info (store_latency & store_latency, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (std::size_t table (0); table < store_latency::table_count; ++table)
+	{
+		for (std::size_t operation (0); operation < store_latency::operation_count; ++operation)
+		{
+			auto totals (store_latency.totals (table, operation));
+			if (totals.count > 0)
+			{
+				auto average_ns (totals.timed > 0 ? totals.total_ns / totals.timed : 0);
+				auto leaf_name (std::string (store_latency::table_name (static_cast<scendere::tables> (table))) + "_" + store_latency::operation_name (static_cast<store_latency::operation> (operation)));
+				composite->add_component (std::make_unique<container_info_leaf> (container_info{ leaf_name, totals.count, average_ns }));
+			}
+		}
+	}
+	return composite;
+}
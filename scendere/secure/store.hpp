@@ -11,8 +11,12 @@
 #include <scendere/secure/versioning.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/optional.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <stack>
 
 namespace scendere
@@ -33,6 +37,65 @@ public:
 	scendere::block_sideband sideband;
 };
 
+/**
+ * Re-encodes a blocks table entry written with the fixed size sideband (store versions before 25) using the compact sideband.
+ * Returns an empty vector if the entry is not in the fixed layout, e.g. because it was already converted.
+ */
+std::vector<uint8_t> block_entry_compact (uint8_t const * data_a, size_t size_a);
+
+/**
+ * Key of the account height index, entries of an account are ordered by height
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+	account_height_key (scendere::account const & account_a, uint64_t height_a) :
+		account (account_a),
+		height (height_a)
+	{
+	}
+	scendere::account account{ 0 };
+	uint64_t height{ 0 };
+};
+static_assert (sizeof (scendere::account_height_key) == sizeof (scendere::account) + sizeof (uint64_t), "Packed class");
+
+/**
+ * Key of the delegator index, the accounts delegating to a representative are adjacent
+ */
+class delegator_key final
+{
+public:
+	delegator_key () = default;
+	delegator_key (scendere::account const & representative_a, scendere::account const & account_a) :
+		representative (representative_a),
+		account (account_a)
+	{
+	}
+	scendere::account representative{ 0 };
+	scendere::account account{ 0 };
+};
+static_assert (sizeof (scendere::delegator_key) == sizeof (scendere::account) * 2, "Packed class");
+
+/**
+ * Key of the receivable amount index, entries of an account are ordered by descending amount
+ */
+class pending_amount_key final
+{
+public:
+	pending_amount_key () = default;
+	pending_amount_key (scendere::account const & account_a, scendere::amount const & amount_a, scendere::block_hash const & hash_a) :
+		account (account_a),
+		amount (amount_a),
+		hash (hash_a)
+	{
+	}
+	scendere::account account{ 0 };
+	scendere::amount amount{ 0 };
+	scendere::block_hash hash{ 0 };
+};
+static_assert (sizeof (scendere::pending_amount_key) == sizeof (scendere::account) + sizeof (scendere::amount) + sizeof (scendere::block_hash), "Packed class");
+
 /**
  * Encapsulates database specific container
  */
@@ -103,6 +166,12 @@ public:
 		static_assert (std::is_standard_layout<scendere::pending_key>::value, "Standard layout is required");
 	}
 
+	db_val (scendere::delegator_key const & val_a) :
+		db_val (sizeof (val_a), const_cast<scendere::delegator_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<scendere::delegator_key>::value, "Standard layout is required");
+	}
+
 	db_val (scendere::unchecked_info const & val_a) :
 		buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -151,6 +220,31 @@ public:
 		convert_buffer_to_value ();
 	}
 
+	db_val (scendere::account_height_key const & val_a) :
+		buffer (std::make_shared<std::vector<uint8_t>> ())
+	{
+		{
+			scendere::vectorstream stream (*buffer);
+			scendere::write (stream, val_a.account);
+			// Big endian so the heights of an account are in ascending key order
+			scendere::write (stream, boost::endian::native_to_big (val_a.height));
+		}
+		convert_buffer_to_value ();
+	}
+
+	db_val (scendere::pending_amount_key const & val_a) :
+		buffer (std::make_shared<std::vector<uint8_t>> ())
+	{
+		{
+			scendere::vectorstream stream (*buffer);
+			scendere::write (stream, val_a.account);
+			// Stored as the distance from the maximum so larger amounts come first
+			scendere::write (stream, scendere::amount (std::numeric_limits<scendere::uint128_t>::max () - val_a.amount.number ()));
+			scendere::write (stream, val_a.hash);
+		}
+		convert_buffer_to_value ();
+	}
+
 	db_val (uint64_t val_a) :
 		buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -212,6 +306,36 @@ public:
 		return result;
 	}
 
+	explicit operator scendere::delegator_key () const
+	{
+		scendere::delegator_key result;
+		debug_assert (size () == sizeof (result));
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator scendere::account_height_key () const
+	{
+		scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
+		scendere::account_height_key result;
+		auto error (scendere::try_read (stream, result.account) || scendere::try_read (stream, result.height));
+		(void)error;
+		debug_assert (!error);
+		boost::endian::big_to_native_inplace (result.height);
+		return result;
+	}
+
+	explicit operator scendere::pending_amount_key () const
+	{
+		scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
+		scendere::pending_amount_key result;
+		auto error (scendere::try_read (stream, result.account) || scendere::try_read (stream, result.amount) || scendere::try_read (stream, result.hash));
+		(void)error;
+		debug_assert (!error);
+		result.amount = std::numeric_limits<scendere::uint128_t>::max () - result.amount.number ();
+		return result;
+	}
+
 	explicit operator scendere::confirmation_height_info () const
 	{
 		scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -313,7 +437,7 @@ public:
 		scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
 		scendere::block_w_sideband block_w_sideband;
 		block_w_sideband.block = (scendere::deserialize_block (stream));
-		auto error = block_w_sideband.sideband.deserialize (stream, block_w_sideband.block->type ());
+		auto error = block_w_sideband.sideband.deserialize_compact (stream, block_w_sideband.block->type ());
 		release_assert (!error);
 		block_w_sideband.block->sideband_set (block_w_sideband.sideband);
 		return block_w_sideband;
@@ -539,16 +663,19 @@ private:
 // Keep this in alphabetical order
 enum class tables
 {
+	account_heights,
 	accounts,
 	blocks,
 	confirmation_height,
 	default_unused, // RocksDB only
+	delegators,
 	final_votes,
 	frontiers,
 	meta,
 	online_weight,
 	peers,
 	pending,
+	pending_amounts,
 	pruned,
 	unchecked,
 	vote
@@ -643,6 +770,8 @@ class account_store
 public:
 	virtual void put (scendere::write_transaction const &, scendere::account const &, scendere::account_info const &) = 0;
 	virtual bool get (scendere::transaction const &, scendere::account const &, scendere::account_info &) = 0;
+	/** Looks up accounts_a in one batch, results are in the same order and empty for accounts not in the ledger */
+	virtual std::vector<boost::optional<scendere::account_info>> get_many (scendere::transaction const &, std::vector<scendere::account> const & accounts_a) = 0;
 	virtual void del (scendere::write_transaction const &, scendere::account const &) = 0;
 	virtual bool exists (scendere::transaction const &, scendere::account const &) = 0;
 	virtual size_t count (scendere::transaction const &) = 0;
@@ -718,6 +847,55 @@ public:
 	virtual void for_each_par (std::function<void (scendere::read_transaction const &, scendere::store_iterator<scendere::block_hash, std::nullptr_t>, scendere::store_iterator<scendere::block_hash, std::nullptr_t>)> const & action_a) const = 0;
 };
 
+/**
+ * Manages the account height index, the hash of each block by account and height. Only maintained when the ledger has it enabled
+ */
+class account_height_store
+{
+public:
+	virtual void put (scendere::write_transaction const &, scendere::account const &, uint64_t, scendere::block_hash const &) = 0;
+	/** Returns zero if there is no entry */
+	virtual scendere::block_hash get (scendere::transaction const &, scendere::account const &, uint64_t) const = 0;
+	virtual void del (scendere::write_transaction const &, scendere::account const &, uint64_t) = 0;
+	virtual size_t count (scendere::transaction const &) const = 0;
+	virtual void clear (scendere::write_transaction const &) = 0;
+	virtual scendere::store_iterator<scendere::account_height_key, scendere::block_hash> begin (scendere::transaction const &, scendere::account const &, uint64_t) const = 0;
+	virtual scendere::store_iterator<scendere::account_height_key, scendere::block_hash> begin (scendere::transaction const &) const = 0;
+	virtual scendere::store_iterator<scendere::account_height_key, scendere::block_hash> end () const = 0;
+};
+
+/**
+ * Manages the delegator index, the accounts delegating to each representative. Only maintained when the ledger has it enabled
+ */
+class delegator_store
+{
+public:
+	virtual void put (scendere::write_transaction const &, scendere::account const &, scendere::account const &) = 0;
+	virtual void del (scendere::write_transaction const &, scendere::account const &, scendere::account const &) = 0;
+	virtual bool exists (scendere::transaction const &, scendere::account const &, scendere::account const &) const = 0;
+	virtual size_t count (scendere::transaction const &) const = 0;
+	virtual void clear (scendere::write_transaction const &) = 0;
+	virtual scendere::store_iterator<scendere::delegator_key, std::nullptr_t> begin (scendere::transaction const &, scendere::account const &, scendere::account const &) const = 0;
+	virtual scendere::store_iterator<scendere::delegator_key, std::nullptr_t> begin (scendere::transaction const &) const = 0;
+	virtual scendere::store_iterator<scendere::delegator_key, std::nullptr_t> end () const = 0;
+};
+
+/**
+ * Manages the receivable amount index, the pending entries of each account by descending amount. Only maintained when the ledger has it enabled
+ */
+class pending_amount_store
+{
+public:
+	virtual void put (scendere::write_transaction const &, scendere::pending_amount_key const &) = 0;
+	virtual void del (scendere::write_transaction const &, scendere::pending_amount_key const &) = 0;
+	virtual bool exists (scendere::transaction const &, scendere::pending_amount_key const &) const = 0;
+	virtual size_t count (scendere::transaction const &) const = 0;
+	virtual void clear (scendere::write_transaction const &) = 0;
+	virtual scendere::store_iterator<scendere::pending_amount_key, std::nullptr_t> begin (scendere::transaction const &, scendere::pending_amount_key const &) const = 0;
+	virtual scendere::store_iterator<scendere::pending_amount_key, std::nullptr_t> begin (scendere::transaction const &) const = 0;
+	virtual scendere::store_iterator<scendere::pending_amount_key, std::nullptr_t> end () const = 0;
+};
+
 /**
  * Manages confirmation height storage and iteration
  */
@@ -805,6 +983,8 @@ public:
 	virtual scendere::block_hash successor (scendere::transaction const &, scendere::block_hash const &) const = 0;
 	virtual void successor_clear (scendere::write_transaction const &, scendere::block_hash const &) = 0;
 	virtual std::shared_ptr<scendere::block> get (scendere::transaction const &, scendere::block_hash const &) const = 0;
+	/** Looks up hashes_a in one batch, results are in the same order and null for blocks not in the ledger */
+	virtual std::vector<std::shared_ptr<scendere::block>> get_many (scendere::transaction const &, std::vector<scendere::block_hash> const & hashes_a) const = 0;
 	virtual std::shared_ptr<scendere::block> get_no_sideband (scendere::transaction const &, scendere::block_hash const &) const = 0;
 	virtual std::shared_ptr<scendere::block> random (scendere::transaction const &) = 0;
 	virtual void del (scendere::write_transaction const &, scendere::block_hash const &) = 0;
@@ -822,6 +1002,125 @@ public:
 	virtual uint64_t account_height (scendere::transaction const & transaction_a, scendere::block_hash const & hash_a) const = 0;
 };
 
+/**
+ * Receives entries of one table as stored by a backend, in ascending key order. Used to load tables in bulk outside of transactions
+ */
+class table_sink
+{
+public:
+	virtual ~table_sink () = default;
+	virtual void put (void const * key_a, std::size_t key_size_a, void const * value_a, std::size_t value_size_a) = 0;
+	virtual uint64_t count () const = 0;
+};
+
+/**
+ * Per table counts and latency histograms of store operations, disabled by default.
+ * Updates are relaxed atomics on entries sharded by thread and padded to cache lines. One in sample_interval operations of each table
+ * and operation is timed, counts include every operation.
+ */
+class store_latency final
+{
+public:
+	enum class operation
+	{
+		get,
+		put,
+		del,
+		exists,
+		iterator
+	};
+	static std::size_t constexpr operation_count = static_cast<std::size_t> (operation::iterator) + 1;
+	static std::size_t constexpr table_count = static_cast<std::size_t> (scendere::tables::vote) + 1;
+	/** Bucket i holds latencies below 2^(i + 8) nanoseconds, the last bucket also holds anything slower */
+	static std::size_t constexpr bucket_count = 20;
+	/** Threads are spread over shards so hot tables are not updated through a single cache line */
+	static std::size_t constexpr shard_count = 4;
+
+	/** Counts an operation on construction and, when sampled, records its latency on destruction */
+	class measurement final
+	{
+	public:
+		measurement (scendere::store_latency const & latency_a, scendere::tables table_a, scendere::store_latency::operation operation_a) :
+			latency{ latency_a },
+			table{ table_a },
+			operation_m{ operation_a }
+		{
+			if (latency.enabled_m.load (std::memory_order_relaxed))
+			{
+				auto count_l (latency.entry (table, operation_m).count.fetch_add (1, std::memory_order_relaxed) + 1);
+				if (count_l % latency.sample_interval.load (std::memory_order_relaxed) == 0)
+				{
+					timed = true;
+					start = std::chrono::steady_clock::now ();
+				}
+			}
+		}
+		~measurement ()
+		{
+			if (timed)
+			{
+				latency.record (table, operation_m, std::chrono::steady_clock::now () - start);
+			}
+		}
+		measurement (measurement const &) = delete;
+		measurement & operator= (measurement const &) = delete;
+
+	private:
+		scendere::store_latency const & latency;
+		scendere::tables table;
+		scendere::store_latency::operation operation_m;
+		bool timed{ false };
+		std::chrono::steady_clock::time_point start;
+	};
+
+	void enable (unsigned sample_interval_a);
+	void disable ();
+	bool enabled () const;
+	void clear ();
+	/** Operations counted on table_a, zero while disabled */
+	uint64_t count (scendere::tables table_a, scendere::store_latency::operation operation_a) const;
+	void serialize (boost::property_tree::ptree &) const;
+
+	static char const * table_name (scendere::tables);
+	static char const * operation_name (scendere::store_latency::operation);
+
+private:
+	class alignas (64) entry_t final
+	{
+	public:
+		std::atomic<uint64_t> count{ 0 };
+		std::atomic<uint64_t> timed{ 0 };
+		std::atomic<uint64_t> total_ns{ 0 };
+		std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+	};
+	using shard_t = std::array<std::array<entry_t, operation_count>, table_count>;
+	/** Sum of an entry over all shards */
+	class totals_t final
+	{
+	public:
+		uint64_t count{ 0 };
+		uint64_t timed{ 0 };
+		uint64_t total_ns{ 0 };
+		std::array<uint64_t, bucket_count> buckets{};
+	};
+	totals_t totals (std::size_t table_a, std::size_t operation_a) const;
+	/** Shard of the calling thread */
+	static std::size_t shard ();
+	entry_t & entry (scendere::tables table_a, scendere::store_latency::operation operation_a) const
+	{
+		return shards[shard ()][static_cast<std::size_t> (table_a)][static_cast<std::size_t> (operation_a)];
+	}
+	void record (scendere::tables, scendere::store_latency::operation, std::chrono::steady_clock::duration) const;
+
+	mutable std::array<shard_t, shard_count> shards;
+	std::atomic<bool> enabled_m{ false };
+	std::atomic<unsigned> sample_interval{ 16 };
+
+	friend std::unique_ptr<container_info_component> collect_container_info (store_latency &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (store_latency & store_latency, std::string const & name);
+
 class unchecked_map;
 /**
  * Store manager
@@ -841,7 +1140,10 @@ public:
 		scendere::peer_store &,
 		scendere::confirmation_height_store &,
 		scendere::final_vote_store &,
-		scendere::version_store &
+		scendere::version_store &,
+		scendere::account_height_store &,
+		scendere::delegator_store &,
+		scendere::pending_amount_store &
 	);
 	// clang-format on
 	virtual ~store () = default;
@@ -863,12 +1165,24 @@ public:
 	confirmation_height_store & confirmation_height;
 	final_vote_store & final_vote;
 	version_store & version;
+	account_height_store & account_height;
+	delegator_store & delegator;
+	pending_amount_store & pending_amount;
 
 	virtual unsigned max_block_write_batch_num () const = 0;
 
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 	virtual void rebuild_db (scendere::write_transaction const & transaction_a) = 0;
 
+	/** Number of entries in table_a, an estimate for some tables on some backends */
+	virtual uint64_t count (scendere::transaction const & transaction_a, tables table_a) const = 0;
+	/** Reads table_a as stored over key ranges in parallel, sink_make_a is called once per range and gets its entries in key order */
+	virtual void table_read_par (tables table_a, std::function<scendere::table_sink & ()> const & sink_make_a) const = 0;
+	/** Starts a sink loading entries into table_a, the sinks of one load must cover disjoint key ranges */
+	virtual std::unique_ptr<scendere::table_sink> table_sink_make (tables table_a) = 0;
+	/** Makes the entries of every sink visible in table_a, returns true on error */
+	virtual bool table_sinks_commit (tables table_a, std::vector<std::unique_ptr<scendere::table_sink>> & sinks_a) = 0;
+
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 	virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
@@ -881,8 +1195,17 @@ public:
 	/** Start read-only transaction */
 	virtual scendere::read_transaction tx_begin_read () const = 0;
 
+	/** Start read-only transaction for a few lookups, backends may reuse the calling thread's recent snapshot. Not to be held across waits */
+	virtual scendere::read_transaction tx_begin_read_cached () const;
+
 	virtual std::string vendor_get () const = 0;
 
+	/** Moves forward with every committed write, persisted with the data. Zero if the backend does not persist its data */
+	virtual uint64_t write_sequence () const = 0;
+
+	/** Operation counts and latencies of the table accessors, see diagnostics_config::store_latency */
+	scendere::store_latency latency;
+
 	friend class unchecked_map;
 };
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <scendere/secure/store_partial.hpp>
+
+namespace scendere
+{
+template <typename Val, typename Derived_Store>
+class store_partial;
+
+template <typename Val, typename Derived_Store>
+void release_assert_success (store_partial<Val, Derived_Store> const &, int const);
+
+template <typename Val, typename Derived_Store>
+class account_height_store_partial : public account_height_store
+{
+private:
+	scendere::store_partial<Val, Derived_Store> & store;
+
+	friend void release_assert_success<Val, Derived_Store> (store_partial<Val, Derived_Store> const &, int const);
+
+public:
+	explicit account_height_store_partial (scendere::store_partial<Val, Derived_Store> & store_a) :
+		store (store_a){};
+
+	void put (scendere::write_transaction const & transaction_a, scendere::account const & account_a, uint64_t height_a, scendere::block_hash const & hash_a) override
+	{
+		auto status = store.put (transaction_a, tables::account_heights, scendere::account_height_key{ account_a, height_a }, hash_a);
+		release_assert_success (store, status);
+	}
+
+	scendere::block_hash get (scendere::transaction const & transaction_a, scendere::account const & account_a, uint64_t height_a) const override
+	{
+		scendere::db_val<Val> value;
+		auto status (store.get (transaction_a, tables::account_heights, scendere::db_val<Val> (scendere::account_height_key{ account_a, height_a }), value));
+		release_assert (store.success (status) || store.not_found (status));
+		scendere::block_hash result{ 0 };
+		if (store.success (status))
+		{
+			result = static_cast<scendere::block_hash> (value);
+		}
+		return result;
+	}
+
+	void del (scendere::write_transaction const & transaction_a, scendere::account const & account_a, uint64_t height_a) override
+	{
+		auto status = store.del (transaction_a, tables::account_heights, scendere::account_height_key{ account_a, height_a });
+		release_assert_success (store, status);
+	}
+
+	size_t count (scendere::transaction const & transaction_a) const override
+	{
+		return store.count (transaction_a, tables::account_heights);
+	}
+
+	void clear (scendere::write_transaction const & transaction_a) override
+	{
+		auto status = store.drop (transaction_a, tables::account_heights);
+		release_assert_success (store, status);
+	}
+
+	scendere::store_iterator<scendere::account_height_key, scendere::block_hash> begin (scendere::transaction const & transaction_a, scendere::account const & account_a, uint64_t height_a) const override
+	{
+		return store.template make_iterator<scendere::account_height_key, scendere::block_hash> (transaction_a, tables::account_heights, scendere::db_val<Val> (scendere::account_height_key{ account_a, height_a }));
+	}
+
+	scendere::store_iterator<scendere::account_height_key, scendere::block_hash> begin (scendere::transaction const & transaction_a) const override
+	{
+		return store.template make_iterator<scendere::account_height_key, scendere::block_hash> (transaction_a, tables::account_heights);
+	}
+
+	scendere::store_iterator<scendere::account_height_key, scendere::block_hash> end () const override
+	{
+		return scendere::store_iterator<scendere::account_height_key, scendere::block_hash> (nullptr);
+	}
+};
+
+}
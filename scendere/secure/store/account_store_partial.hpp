@@ -51,6 +51,32 @@ public:
 		return result;
 	}
 
+	std::vector<boost::optional<scendere::account_info>> get_many (scendere::transaction const & transaction_a, std::vector<scendere::account> const & accounts_a) override
+	{
+		std::vector<scendere::db_val<Val>> keys;
+		keys.reserve (accounts_a.size ());
+		for (auto const & account : accounts_a)
+		{
+			keys.emplace_back (account);
+		}
+		std::vector<scendere::db_val<Val>> values;
+		auto statuses (store.get_many (transaction_a, tables::accounts, keys, values));
+		std::vector<boost::optional<scendere::account_info>> result (accounts_a.size ());
+		for (auto i (0); i < statuses.size (); ++i)
+		{
+			release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+			if (store.success (statuses[i]))
+			{
+				scendere::account_info info;
+				scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+				auto error (info.deserialize (stream));
+				release_assert (!error);
+				result[i] = info;
+			}
+		}
+		return result;
+	}
+
 	void del (scendere::write_transaction const & transaction_a, scendere::account const & account_a) override
 	{
 		auto status = store.del (transaction_a, tables::accounts, account_a);
@@ -38,7 +38,7 @@ public:
 		{
 			scendere::vectorstream stream (vector);
 			scendere::serialize_block (stream, block_a);
-			block_a.sideband ().serialize (stream, block_a.type ());
+			block_a.sideband ().serialize_compact (stream, block_a.type ());
 		}
 		raw_put (transaction_a, vector, hash_a);
 		scendere::block_predecessor_set<Val, Derived_Store> predecessor (transaction_a, *this);
@@ -85,20 +85,25 @@ public:
 
 	std::shared_ptr<scendere::block> get (scendere::transaction const & transaction_a, scendere::block_hash const & hash_a) const override
 	{
-		auto value (block_raw_get (transaction_a, hash_a));
-		std::shared_ptr<scendere::block> result;
-		if (value.size () != 0)
+		return block_from_raw (block_raw_get (transaction_a, hash_a));
+	}
+
+	std::vector<std::shared_ptr<scendere::block>> get_many (scendere::transaction const & transaction_a, std::vector<scendere::block_hash> const & hashes_a) const override
+	{
+		std::vector<scendere::db_val<Val>> keys;
+		keys.reserve (hashes_a.size ());
+		for (auto const & hash : hashes_a)
 		{
-			scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			scendere::block_type type;
-			auto error (try_read (stream, type));
-			release_assert (!error);
-			result = scendere::deserialize_block (stream, type);
-			release_assert (result != nullptr);
-			scendere::block_sideband sideband;
-			error = (sideband.deserialize (stream, type));
-			release_assert (!error);
-			result->sideband_set (sideband);
+			keys.emplace_back (hash);
+		}
+		std::vector<scendere::db_val<Val>> values;
+		auto statuses (store.get_many (transaction_a, tables::blocks, keys, values));
+		std::vector<std::shared_ptr<scendere::block>> result;
+		result.reserve (hashes_a.size ());
+		for (auto i (0); i < statuses.size (); ++i)
+		{
+			release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+			result.push_back (store.success (statuses[i]) ? block_from_raw (values[i]) : nullptr);
 		}
 		return result;
 	}
@@ -249,9 +254,29 @@ protected:
 		return result;
 	}
 
+	std::shared_ptr<scendere::block> block_from_raw (scendere::db_val<Val> const & value_a) const
+	{
+		std::shared_ptr<scendere::block> result;
+		if (value_a.size () != 0)
+		{
+			scendere::bufferstream stream (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
+			scendere::block_type type;
+			auto error (try_read (stream, type));
+			release_assert (!error);
+			result = scendere::deserialize_block (stream, type);
+			release_assert (result != nullptr);
+			scendere::block_sideband sideband;
+			error = (sideband.deserialize_compact (stream, type));
+			release_assert (!error);
+			result->sideband_set (sideband);
+		}
+		return result;
+	}
+
 	size_t block_successor_offset (scendere::transaction const & transaction_a, size_t entry_size_a, scendere::block_type type_a) const
 	{
-		return entry_size_a - scendere::block_sideband::size (type_a);
+		// The sideband is variable length so the successor is located from the front, right after the block type and block
+		return sizeof (scendere::block_type) + scendere::block::size (type_a);
 	}
 
 	static scendere::block_type block_type_from_raw (void * data_a)
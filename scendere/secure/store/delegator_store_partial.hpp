@@ -0,0 +1,69 @@
+#pragma once
+
+#include <scendere/secure/store_partial.hpp>
+
+namespace scendere
+{
+template <typename Val, typename Derived_Store>
+class store_partial;
+
+template <typename Val, typename Derived_Store>
+void release_assert_success (store_partial<Val, Derived_Store> const &, int const);
+
+template <typename Val, typename Derived_Store>
+class delegator_store_partial : public delegator_store
+{
+private:
+	scendere::store_partial<Val, Derived_Store> & store;
+
+	friend void release_assert_success<Val, Derived_Store> (store_partial<Val, Derived_Store> const &, int const);
+
+public:
+	explicit delegator_store_partial (scendere::store_partial<Val, Derived_Store> & store_a) :
+		store (store_a){};
+
+	void put (scendere::write_transaction const & transaction_a, scendere::account const & representative_a, scendere::account const & account_a) override
+	{
+		auto status = store.put_key (transaction_a, tables::delegators, scendere::delegator_key{ representative_a, account_a });
+		release_assert_success (store, status);
+	}
+
+	void del (scendere::write_transaction const & transaction_a, scendere::account const & representative_a, scendere::account const & account_a) override
+	{
+		auto status = store.del (transaction_a, tables::delegators, scendere::delegator_key{ representative_a, account_a });
+		release_assert_success (store, status);
+	}
+
+	bool exists (scendere::transaction const & transaction_a, scendere::account const & representative_a, scendere::account const & account_a) const override
+	{
+		return store.exists (transaction_a, tables::delegators, scendere::db_val<Val> (scendere::delegator_key{ representative_a, account_a }));
+	}
+
+	size_t count (scendere::transaction const & transaction_a) const override
+	{
+		return store.count (transaction_a, tables::delegators);
+	}
+
+	void clear (scendere::write_transaction const & transaction_a) override
+	{
+		auto status = store.drop (transaction_a, tables::delegators);
+		release_assert_success (store, status);
+	}
+
+	scendere::store_iterator<scendere::delegator_key, std::nullptr_t> begin (scendere::transaction const & transaction_a, scendere::account const & representative_a, scendere::account const & account_a) const override
+	{
+		return store.template make_iterator<scendere::delegator_key, std::nullptr_t> (transaction_a, tables::delegators, scendere::db_val<Val> (scendere::delegator_key{ representative_a, account_a }));
+	}
+
+	scendere::store_iterator<scendere::delegator_key, std::nullptr_t> begin (scendere::transaction const & transaction_a) const override
+	{
+		return store.template make_iterator<scendere::delegator_key, std::nullptr_t> (transaction_a, tables::delegators);
+	}
+
+	scendere::store_iterator<scendere::delegator_key, std::nullptr_t> end () const override
+	{
+		return scendere::store_iterator<scendere::delegator_key, std::nullptr_t> (nullptr);
+	}
+};
+
+}
@@ -6,13 +6,16 @@
 #include <scendere/lib/timer.hpp>
 #include <scendere/secure/buffer.hpp>
 #include <scendere/secure/store.hpp>
+#include <scendere/secure/store/account_height_store_partial.hpp>
 #include <scendere/secure/store/account_store_partial.hpp>
 #include <scendere/secure/store/block_store_partial.hpp>
 #include <scendere/secure/store/confirmation_height_store_partial.hpp>
+#include <scendere/secure/store/delegator_store_partial.hpp>
 #include <scendere/secure/store/final_vote_store_partial.hpp>
 #include <scendere/secure/store/frontier_store_partial.hpp>
 #include <scendere/secure/store/online_weight_partial.hpp>
 #include <scendere/secure/store/peer_store_partial.hpp>
+#include <scendere/secure/store/pending_amount_store_partial.hpp>
 #include <scendere/secure/store/pending_store_partial.hpp>
 #include <scendere/secure/store/pruned_store_partial.hpp>
 #include <scendere/secure/store/unchecked_store_partial.hpp>
@@ -20,6 +23,11 @@
 
 #include <crypto/cryptopp/words.h>
 
+#include <boost/polymorphic_cast.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 #include <thread>
 
 class store_partial;
@@ -43,15 +51,43 @@ void release_assert_success (store_partial<Val, Derived_Store> const & store, in
 	}
 }
 
+template <typename Val, typename Derived_Store>
+class account_height_store_partial;
+
 template <typename Val, typename Derived_Store>
 class account_store_partial;
 
+template <typename Val, typename Derived_Store>
+class delegator_store_partial;
+
+template <typename Val, typename Derived_Store>
+class pending_amount_store_partial;
+
 template <typename Val, typename Derived_Store>
 class unchecked_store_partial;
 
 template <typename Val, typename Derived_Store>
 class block_store_partial;
 
+/** Default table sink, entries are held in memory and written in a single write transaction on commit */
+class table_sink_buffer final : public scendere::table_sink
+{
+public:
+	void put (void const * key_a, std::size_t key_size_a, void const * value_a, std::size_t value_size_a) override
+	{
+		auto key (static_cast<uint8_t const *> (key_a));
+		auto value (static_cast<uint8_t const *> (value_a));
+		entries.emplace_back (std::vector<uint8_t> (key, key + key_size_a), std::vector<uint8_t> (value, value + value_size_a));
+	}
+
+	uint64_t count () const override
+	{
+		return entries.size ();
+	}
+
+	std::vector<std::pair<std::vector<uint8_t>, std::vector<uint8_t>>> entries;
+};
+
 /** This base class implements the store interface functions which have DB agnostic functionality. It also maps all the store classes. */
 template <typename Val, typename Derived_Store>
 class store_partial : public store
@@ -68,6 +104,9 @@ class store_partial : public store
 	friend class scendere::confirmation_height_store_partial<Val, Derived_Store>;
 	friend class scendere::final_vote_store_partial<Val, Derived_Store>;
 	friend class scendere::version_store_partial<Val, Derived_Store>;
+	friend class scendere::account_height_store_partial<Val, Derived_Store>;
+	friend class scendere::delegator_store_partial<Val, Derived_Store>;
+	friend class scendere::pending_amount_store_partial<Val, Derived_Store>;
 
 public:
 	// clang-format off
@@ -83,7 +122,10 @@ public:
 		scendere::peer_store_partial<Val, Derived_Store> & peer_store_partial_a,
 		scendere::confirmation_height_store_partial<Val, Derived_Store> & confirmation_height_store_partial_a,
 		scendere::final_vote_store_partial<Val, Derived_Store> & final_vote_store_partial_a,
-		scendere::version_store_partial<Val, Derived_Store> & version_store_partial_a) :
+		scendere::version_store_partial<Val, Derived_Store> & version_store_partial_a,
+		scendere::account_height_store_partial<Val, Derived_Store> & account_height_store_partial_a,
+		scendere::delegator_store_partial<Val, Derived_Store> & delegator_store_partial_a,
+		scendere::pending_amount_store_partial<Val, Derived_Store> & pending_amount_store_partial_a) :
 		constants{ constants },
 		store{
 			block_store_partial_a,
@@ -96,7 +138,10 @@ public:
 			peer_store_partial_a,
 			confirmation_height_store_partial_a,
 			final_vote_store_partial_a,
-			version_store_partial_a
+			version_store_partial_a,
+			account_height_store_partial_a,
+			delegator_store_partial_a,
+			pending_amount_store_partial_a
 		}
 	{}
 	// clang-format on
@@ -128,24 +173,50 @@ public:
 
 	bool exists (scendere::transaction const & transaction_a, tables table_a, scendere::db_val<Val> const & key_a) const
 	{
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::exists);
 		return static_cast<const Derived_Store &> (*this).exists (transaction_a, table_a, key_a);
 	}
 
+	std::unique_ptr<scendere::table_sink> table_sink_make (tables) override
+	{
+		return std::make_unique<scendere::table_sink_buffer> ();
+	}
+
+	bool table_sinks_commit (tables table_a, std::vector<std::unique_ptr<scendere::table_sink>> & sinks_a) override
+	{
+		auto transaction (tx_begin_write ({ table_a }));
+		auto error (false);
+		for (auto & sink : sinks_a)
+		{
+			for (auto & [key, value] : boost::polymorphic_downcast<scendere::table_sink_buffer *> (sink.get ())->entries)
+			{
+				error |= !success (put (transaction, table_a, scendere::db_val<Val> (key.size (), key.data ()), scendere::db_val<Val> (value.size (), value.data ())));
+			}
+		}
+		sinks_a.clear ();
+		return error;
+	}
+
+	using store::count;
+
 	int const minimum_version{ 14 };
 
 protected:
 	scendere::ledger_constants & constants;
-	int const version_number{ 21 };
+	int const version_number{ 25 };
 
 	template <typename Key, typename Value>
 	scendere::store_iterator<Key, Value> make_iterator (scendere::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
 	{
+		// Covers positioning the iterator on its first entry, moving it along is not measured
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::iterator);
 		return static_cast<Derived_Store const &> (*this).template make_iterator<Key, Value> (transaction_a, table_a, direction_asc);
 	}
 
 	template <typename Key, typename Value>
 	scendere::store_iterator<Key, Value> make_iterator (scendere::transaction const & transaction_a, tables table_a, scendere::db_val<Val> const & key) const
 	{
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::iterator);
 		return static_cast<Derived_Store const &> (*this).template make_iterator<Key, Value> (transaction_a, table_a, key);
 	}
 
@@ -161,11 +232,35 @@ protected:
 
 	int get (scendere::transaction const & transaction_a, tables table_a, scendere::db_val<Val> const & key_a, scendere::db_val<Val> & value_a) const
 	{
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::get);
 		return static_cast<Derived_Store const &> (*this).get (transaction_a, table_a, key_a, value_a);
 	}
 
+	/** Looks up keys_a in one batch, values_a is filled in the same order. Returns the status of each lookup */
+	std::vector<int> get_many (scendere::transaction const & transaction_a, tables table_a, std::vector<scendere::db_val<Val>> const & keys_a, std::vector<scendere::db_val<Val>> & values_a) const
+	{
+		// A batch counts as one get
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::get);
+		return static_cast<Derived_Store const &> (*this).get_many (transaction_a, table_a, keys_a, values_a);
+	}
+
+	/** Positions of keys_a in key order, batched lookups done in this order visit each page or block of a table once */
+	static std::vector<std::size_t> key_order (std::vector<scendere::db_val<Val>> const & keys_a)
+	{
+		std::vector<std::size_t> result (keys_a.size ());
+		std::iota (result.begin (), result.end (), 0);
+		std::sort (result.begin (), result.end (), [&keys_a] (std::size_t const lhs, std::size_t const rhs) {
+			auto const & left (keys_a[lhs]);
+			auto const & right (keys_a[rhs]);
+			auto compare (std::memcmp (left.data (), right.data (), std::min (left.size (), right.size ())));
+			return compare < 0 || (compare == 0 && left.size () < right.size ());
+		});
+		return result;
+	}
+
 	int put (scendere::write_transaction const & transaction_a, tables table_a, scendere::db_val<Val> const & key_a, scendere::db_val<Val> const & value_a)
 	{
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::put);
 		return static_cast<Derived_Store &> (*this).put (transaction_a, table_a, key_a, value_a);
 	}
 
@@ -177,10 +272,10 @@ protected:
 
 	int del (scendere::write_transaction const & transaction_a, tables table_a, scendere::db_val<Val> const & key_a)
 	{
+		scendere::store_latency::measurement measurement (latency, table_a, scendere::store_latency::operation::del);
 		return static_cast<Derived_Store &> (*this).del (transaction_a, table_a, key_a);
 	}
 
-	virtual uint64_t count (scendere::transaction const & transaction_a, tables table_a) const = 0;
 	virtual int drop (scendere::write_transaction const & transaction_a, tables table_a) = 0;
 	virtual bool not_found (int status) const = 0;
 	virtual bool success (int status) const = 0;